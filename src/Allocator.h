@@ -0,0 +1,460 @@
+#ifndef Allocator_h
+#define Allocator_h
+
+// Local include.
+#include "Configuration.h"
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#if THINGSBOARD_ENABLE_PSRAM
+#include <esp_heap_caps.h>
+#endif // THINGSBOARD_ENABLE_PSRAM
+
+
+/// ---------------------------------
+/// Allocator policies.
+/// ---------------------------------
+// Every allocator policy has to implement the same three methods the allocator of the ArduinoJson BasicJsonDocument expects
+// (see https://arduinojson.org/v6/api/basicjsondocument/), meaning void* allocate(size_t), void deallocate(void*) and void* reallocate(void*, size_t).
+// Allocation failures are signaled by returning nullptr, like malloc does. This allows to use the same policy for the internal JsonDocuments
+// as well as for every other internal buffer of the ThingsBoard and ThingsBoardHttp class, which makes it possible to restrict all heap allocations
+// of the library to a fixed memory budget or to place them onto psram instead of onto the sram.
+// The library handles a failed allocation with one of two policies, depending on whether the caller is able to report the failure or not:
+// Temporary buffers and JsonDocuments are allocated right before sending or after receiving a message, a failure is logged and the message is rejected.
+// Containers that store the subscribed callbacks, meaning the std::vector with the Allocator_Adapter or the Vector replacement if the C++ STL is not used, abort instead,
+// because their interface does not allow reporting the failure and silently dropping a subscribed callback would leave the device in an inconsistent state.
+// The policies with internal state (tracking, arena and pool) keep that state in static storage per template instantiation,
+// because ArduinoJson default constructs the allocator. The state is not guarded against concurrent access, so if an instance might be accessed from multiple tasks at once
+// (for example when the Espressif_MQTT_Client calls the received message callback from its own task) the memory should be allocated with the default policies instead.
+
+
+/// @brief Size of the header placed in front of each allocation by the policies that need to remember the size of an allocation,
+/// is the size of the biggest fundamental alignment to ensure the returned memory is still correctly aligned for every type
+constexpr size_t ALLOCATION_HEADER_SIZE = alignof(max_align_t) > sizeof(size_t) ? alignof(max_align_t) : sizeof(size_t);
+
+
+/// @brief Allocator policy that simply forwards to malloc, free and realloc, which is the same behaviour as the DefaultAllocator of ArduinoJson
+struct Heap_Allocator {
+    /// @brief Allocates the given amount of bytes
+    /// @param size Amount of bytes that should be allocated
+    /// @return Pointer to the allocated memory or nullptr if the allocation failed
+    inline void* allocate(size_t size) {
+        return malloc(size);
+    }
+
+    /// @brief Frees memory previously returned by allocate or reallocate
+    /// @param pointer Pointer to the memory that should be freed, nullptr is ignored
+    inline void deallocate(void* pointer) {
+        free(pointer);
+    }
+
+    /// @brief Changes the size of memory previously returned by allocate or reallocate
+    /// @param pointer Pointer to the memory that should be resized
+    /// @param new_size Amount of bytes the memory should have afterwards
+    /// @return Pointer to the resized memory or nullptr if the allocation failed, in which case the given memory is still valid
+    inline void* reallocate(void* pointer, size_t new_size) {
+        return realloc(pointer, new_size);
+    }
+};
+
+#if THINGSBOARD_ENABLE_PSRAM
+/// @brief Allocator policy that places all memory onto the external psram instead of onto the sram.
+/// See https://arduinojson.org/v6/how-to/use-external-ram-on-esp32/ for more information
+struct SpiRam_Allocator {
+    /// @brief Allocates the given amount of bytes on the psram
+    /// @param size Amount of bytes that should be allocated
+    /// @return Pointer to the allocated memory or nullptr if the allocation failed
+    inline void* allocate(size_t size) {
+        return heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+    }
+
+    /// @brief Frees memory previously returned by allocate or reallocate
+    /// @param pointer Pointer to the memory that should be freed, nullptr is ignored
+    inline void deallocate(void* pointer) {
+        heap_caps_free(pointer);
+    }
+
+    /// @brief Changes the size of memory previously returned by allocate or reallocate
+    /// @param pointer Pointer to the memory that should be resized
+    /// @param new_size Amount of bytes the memory should have afterwards
+    /// @return Pointer to the resized memory or nullptr if the allocation failed, in which case the given memory is still valid
+    inline void* reallocate(void* pointer, size_t new_size) {
+        return heap_caps_realloc(pointer, new_size, MALLOC_CAP_SPIRAM);
+    }
+};
+
+// Previous name of the psram allocator, kept so existing code still compiles
+using SpiRamAllocator = SpiRam_Allocator;
+
+// Allocator policy used if no other policy is passed as a template argument
+using Default_Allocator = SpiRam_Allocator;
+#else
+// Allocator policy used if no other policy is passed as a template argument
+using Default_Allocator = Heap_Allocator;
+#endif // THINGSBOARD_ENABLE_PSRAM
+
+
+/// @brief Allocator policy decorator that keeps track of the amount of bytes currently allocated by the underlying policy and the peak of that value,
+/// and optionally refuses every allocation that would exceed the given budget. Allows to measure how much memory the library actually needs
+/// and then pin it to that amount, so it can never starve the rest of the application
+/// @tparam Base Allocator policy that should be used to actually allocate the memory, default = Default_Allocator
+/// @tparam Budget Maximum amount of bytes that may be allocated at once, 0 means no limit, default = 0
+template <typename Base = Default_Allocator, size_t Budget = 0U>
+class Tracking_Allocator {
+  public:
+    /// @brief Allocates the given amount of bytes, if the allocation does not exceed the budget
+    /// @param size Amount of bytes that should be allocated
+    /// @return Pointer to the allocated memory or nullptr if the allocation failed or would have exceeded the budget
+    inline void* allocate(size_t size) {
+        if (!Fits_Budget(size)) {
+            Failures()++;
+            return nullptr;
+        }
+        uint8_t* block = static_cast<uint8_t*>(Base().allocate(size + ALLOCATION_HEADER_SIZE));
+        if (block == nullptr) {
+            Failures()++;
+            return nullptr;
+        }
+        memcpy(block, &size, sizeof(size));
+        Record_Allocation(size);
+        return block + ALLOCATION_HEADER_SIZE;
+    }
+
+    /// @brief Frees memory previously returned by allocate or reallocate
+    /// @param pointer Pointer to the memory that should be freed, nullptr is ignored
+    inline void deallocate(void* pointer) {
+        if (pointer == nullptr) {
+            return;
+        }
+        uint8_t* block = static_cast<uint8_t*>(pointer) - ALLOCATION_HEADER_SIZE;
+        Used() -= Get_Size(block);
+        Base().deallocate(block);
+    }
+
+    /// @brief Changes the size of memory previously returned by allocate or reallocate, if the additional memory does not exceed the budget
+    /// @param pointer Pointer to the memory that should be resized
+    /// @param new_size Amount of bytes the memory should have afterwards
+    /// @return Pointer to the resized memory or nullptr if the allocation failed, in which case the given memory is still valid
+    inline void* reallocate(void* pointer, size_t new_size) {
+        if (pointer == nullptr) {
+            return allocate(new_size);
+        }
+        uint8_t* block = static_cast<uint8_t*>(pointer) - ALLOCATION_HEADER_SIZE;
+        const size_t old_size = Get_Size(block);
+        if (new_size > old_size && !Fits_Budget(new_size - old_size)) {
+            Failures()++;
+            return nullptr;
+        }
+        uint8_t* new_block = static_cast<uint8_t*>(Base().reallocate(block, new_size + ALLOCATION_HEADER_SIZE));
+        if (new_block == nullptr) {
+            Failures()++;
+            return nullptr;
+        }
+        memcpy(new_block, &new_size, sizeof(new_size));
+        Used() -= old_size;
+        Record_Allocation(new_size);
+        return new_block + ALLOCATION_HEADER_SIZE;
+    }
+
+    /// @brief Gets the amount of bytes that are currently allocated, excluding the internal header of each allocation
+    /// @return Currently allocated bytes
+    inline static size_t Get_Used() {
+        return Used();
+    }
+
+    /// @brief Gets the biggest amount of bytes that were allocated at once, since the start or since the last call to Reset_Peak
+    /// @return Peak of the allocated bytes
+    inline static size_t Get_Peak() {
+        return Peak();
+    }
+
+    /// @brief Gets the amount of allocations that failed, either because the underlying policy failed or because they would have exceeded the budget
+    /// @return Amount of failed allocations
+    inline static size_t Get_Failures() {
+        return Failures();
+    }
+
+    /// @brief Resets the peak to the amount of bytes that are currently allocated
+    inline static void Reset_Peak() {
+        Peak() = Used();
+    }
+
+  private:
+    /// @brief Checks whether the given additional amount of bytes would still fit into the budget
+    /// @param size Additional amount of bytes we want to allocate
+    /// @return Whether the allocation would fit into the budget or not
+    inline static bool Fits_Budget(const size_t& size) {
+        return Budget == 0U || (size <= Budget && Used() <= Budget - size);
+    }
+
+    /// @brief Adds the given amount of bytes to the currently used bytes and updates the peak
+    /// @param size Amount of bytes that were allocated
+    inline static void Record_Allocation(const size_t& size) {
+        Used() += size;
+        if (Used() > Peak()) {
+            Peak() = Used();
+        }
+    }
+
+    /// @brief Reads the size of the allocation from the header in front of it
+    /// @param block Start of the allocation including the header
+    /// @return Size of the allocation excluding the header
+    inline static size_t Get_Size(const uint8_t* block) {
+        size_t size = 0U;
+        memcpy(&size, block, sizeof(size));
+        return size;
+    }
+
+    // Function local statics are used instead of static data members, so the state can be kept in the header only template without requiring C++17 inline variables
+    inline static size_t& Used() { static size_t used = 0U; return used; }
+    inline static size_t& Peak() { static size_t peak = 0U; return peak; }
+    inline static size_t& Failures() { static size_t failures = 0U; return failures; }
+};
+
+
+/// @brief Allocator policy that hands out memory from a fixed size statically allocated buffer, by simply increasing an offset for each allocation.
+/// Freeing memory that was not the last allocation does not make that memory reusable immediately, instead the complete arena is reset once every allocation has been freed.
+/// This fits the allocation pattern of the library very well, because nearly all internal buffers only live for the duration of a single method call,
+/// meaning the arena is normally completely empty again after each sent or received message and never fragments the heap
+/// @tparam Size Amount of bytes the arena consists of, is the maximum amount of memory the library can ever allocate at once
+template <size_t Size>
+class Arena_Allocator {
+  public:
+    /// @brief Allocates the given amount of bytes from the arena
+    /// @param size Amount of bytes that should be allocated
+    /// @return Pointer to the allocated memory or nullptr if the arena does not have enough space left
+    inline void* allocate(size_t size) {
+        const size_t needed = Align(size) + ALLOCATION_HEADER_SIZE;
+        if (needed < size || needed > Size - Offset()) {
+            return nullptr;
+        }
+        uint8_t* block = Buffer() + Offset();
+        memcpy(block, &size, sizeof(size));
+        Offset() += needed;
+        Live()++;
+        if (Offset() > Peak()) {
+            Peak() = Offset();
+        }
+        return block + ALLOCATION_HEADER_SIZE;
+    }
+
+    /// @brief Frees memory previously returned by allocate or reallocate, the memory can only be reused
+    /// if it was the last allocation or once every other allocation has been freed as well
+    /// @param pointer Pointer to the memory that should be freed, nullptr is ignored
+    inline void deallocate(void* pointer) {
+        if (pointer == nullptr) {
+            return;
+        }
+        uint8_t* block = static_cast<uint8_t*>(pointer) - ALLOCATION_HEADER_SIZE;
+        Live()--;
+        if (Live() == 0U) {
+            Offset() = 0U;
+        }
+        else if (Is_Last(block)) {
+            Offset() = block - Buffer();
+        }
+    }
+
+    /// @brief Changes the size of memory previously returned by allocate or reallocate, is done in place if it was the last allocation
+    /// @param pointer Pointer to the memory that should be resized
+    /// @param new_size Amount of bytes the memory should have afterwards
+    /// @return Pointer to the resized memory or nullptr if the arena does not have enough space left, in which case the given memory is still valid
+    inline void* reallocate(void* pointer, size_t new_size) {
+        if (pointer == nullptr) {
+            return allocate(new_size);
+        }
+        uint8_t* block = static_cast<uint8_t*>(pointer) - ALLOCATION_HEADER_SIZE;
+        size_t old_size = 0U;
+        memcpy(&old_size, block, sizeof(old_size));
+
+        if (Is_Last(block)) {
+            const size_t start = block - Buffer();
+            const size_t needed = Align(new_size) + ALLOCATION_HEADER_SIZE;
+            if (needed < new_size || needed > Size - start) {
+                return nullptr;
+            }
+            memcpy(block, &new_size, sizeof(new_size));
+            Offset() = start + needed;
+            if (Offset() > Peak()) {
+                Peak() = Offset();
+            }
+            return pointer;
+        }
+        else if (new_size <= old_size) {
+            // Shrinking an allocation that is not the last one can not free any memory, but the existing memory can still be used
+            return pointer;
+        }
+
+        void* new_pointer = allocate(new_size);
+        if (new_pointer == nullptr) {
+            return nullptr;
+        }
+        memcpy(new_pointer, pointer, old_size);
+        deallocate(pointer);
+        return new_pointer;
+    }
+
+    /// @brief Gets the amount of bytes of the arena that are currently in use, including the internal header and alignment of each allocation
+    /// @return Currently used bytes of the arena
+    inline static size_t Get_Used() {
+        return Offset();
+    }
+
+    /// @brief Gets the biggest amount of bytes of the arena that were in use at once, allows to decide how big the arena actually has to be
+    /// @return Peak of the used bytes of the arena
+    inline static size_t Get_Peak() {
+        return Peak();
+    }
+
+  private:
+    /// @brief Rounds the given size up to the next multiple of the allocation header size, to keep every allocation correctly aligned
+    /// @param size Size that should be rounded up
+    /// @return Aligned size
+    inline static size_t Align(const size_t& size) {
+        return (size + ALLOCATION_HEADER_SIZE - 1U) & ~(ALLOCATION_HEADER_SIZE - 1U);
+    }
+
+    /// @brief Checks whether the given allocation is the last one in the arena
+    /// @param block Start of the allocation including the header
+    /// @return Whether the allocation is the last one or not
+    inline static bool Is_Last(const uint8_t* block) {
+        size_t size = 0U;
+        memcpy(&size, block, sizeof(size));
+        return block + ALLOCATION_HEADER_SIZE + Align(size) == Buffer() + Offset();
+    }
+
+    // Function local statics are used instead of static data members, so the state can be kept in the header only template without requiring C++17 inline variables
+    inline static uint8_t* Buffer() { alignas(max_align_t) static uint8_t buffer[Size]; return buffer; }
+    inline static size_t& Offset() { static size_t offset = 0U; return offset; }
+    inline static size_t& Live() { static size_t live = 0U; return live; }
+    inline static size_t& Peak() { static size_t peak = 0U; return peak; }
+};
+
+
+/// @brief Allocator policy that hands out fixed size blocks from a statically allocated pool. Every allocation takes one complete block,
+/// meaning allocations bigger than the block size always fail. Allocating and freeing takes constant time and can never fragment the memory,
+/// but the block size has to be at least as big as the biggest internal buffer, so it fits best if the sent and received payloads have a similar size
+/// @tparam Block_Size Amount of bytes each block consists of, is the biggest allocation that can be handled
+/// @tparam Block_Amount Amount of blocks in the pool, is the maximum amount of allocations that can exist at once
+template <size_t Block_Size, size_t Block_Amount>
+class Pool_Allocator {
+  public:
+    /// @brief Allocates a free block from the pool
+    /// @param size Amount of bytes that should be allocated, has to be smaller or equal to Block_Size
+    /// @return Pointer to the allocated block or nullptr if the size is too big or there is no free block left
+    inline void* allocate(size_t size) {
+        if (size > Block_Size) {
+            return nullptr;
+        }
+        bool* used = Used();
+        for (size_t index = 0U; index < Block_Amount; index++) {
+            if (!used[index]) {
+                used[index] = true;
+                return Buffer() + index * BLOCK_STRIDE;
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief Returns a block previously returned by allocate or reallocate to the pool
+    /// @param pointer Pointer to the block that should be freed, nullptr is ignored
+    inline void deallocate(void* pointer) {
+        if (pointer == nullptr) {
+            return;
+        }
+        const size_t index = (static_cast<uint8_t*>(pointer) - Buffer()) / BLOCK_STRIDE;
+        Used()[index] = false;
+    }
+
+    /// @brief Changes the size of a block previously returned by allocate or reallocate,
+    /// because every block has the same size this only succeeds if the new size still fits into a block
+    /// @param pointer Pointer to the block that should be resized
+    /// @param new_size Amount of bytes the block should have afterwards
+    /// @return The same pointer or nullptr if the new size is bigger than Block_Size, in which case the given block is still valid
+    inline void* reallocate(void* pointer, size_t new_size) {
+        if (pointer == nullptr) {
+            return allocate(new_size);
+        }
+        return new_size <= Block_Size ? pointer : nullptr;
+    }
+
+    /// @brief Gets the amount of blocks that are currently in use
+    /// @return Currently used blocks of the pool
+    inline static size_t Get_Used() {
+        size_t amount = 0U;
+        const bool* used = Used();
+        for (size_t index = 0U; index < Block_Amount; index++) {
+            amount += used[index] ? 1U : 0U;
+        }
+        return amount;
+    }
+
+  private:
+    // Distance between the start of two blocks, rounded up so every block is correctly aligned
+    static constexpr size_t BLOCK_STRIDE = (Block_Size + ALLOCATION_HEADER_SIZE - 1U) & ~(ALLOCATION_HEADER_SIZE - 1U);
+
+    // Function local statics are used instead of static data members, so the state can be kept in the header only template without requiring C++17 inline variables
+    inline static uint8_t* Buffer() { alignas(max_align_t) static uint8_t buffer[BLOCK_STRIDE * Block_Amount]; return buffer; }
+    inline static bool* Used() { static bool used[Block_Amount] = {}; return used; }
+};
+
+
+/// @brief Adapter that allows to use any of the allocator policies as the allocator of C++ STL containers like std::vector or std::basic_string.
+/// The STL expects allocations to never return nullptr, because it would normally throw an exception instead,
+/// therefore a failed allocation aborts, which is the same behaviour operator new has if exceptions are disabled
+/// @tparam T Type of the elements that are allocated
+/// @tparam Policy Allocator policy that should be used to actually allocate the memory
+template <typename T, typename Policy>
+class Allocator_Adapter {
+  public:
+    using value_type = T;
+
+    /// @brief Rebinds the adapter to another element type, required by containers that allocate internal node types
+    template <typename U>
+    struct rebind {
+        using other = Allocator_Adapter<U, Policy>;
+    };
+
+    /// @brief Constructor
+    inline Allocator_Adapter() = default;
+
+    /// @brief Converting constructor, required by containers that allocate internal node types
+    template <typename U>
+    inline Allocator_Adapter(const Allocator_Adapter<U, Policy>&) {
+        // Nothing to do
+    }
+
+    /// @brief Allocates memory for the given amount of elements
+    /// @param amount Amount of elements that should fit into the allocated memory
+    /// @return Pointer to the allocated memory
+    inline T* allocate(size_t amount) {
+        void* pointer = Policy().allocate(amount * sizeof(T));
+        if (pointer == nullptr) {
+            abort();
+        }
+        return static_cast<T*>(pointer);
+    }
+
+    /// @brief Frees memory previously returned by allocate
+    /// @param pointer Pointer to the memory that should be freed
+    inline void deallocate(T* pointer, size_t) {
+        Policy().deallocate(pointer);
+    }
+
+    /// @brief Every adapter with the same policy can free the memory allocated by another, because the state of the policy is static
+    template <typename U>
+    inline bool operator==(const Allocator_Adapter<U, Policy>&) const {
+        return true;
+    }
+
+    /// @brief Every adapter with the same policy can free the memory allocated by another, because the state of the policy is static
+    template <typename U>
+    inline bool operator!=(const Allocator_Adapter<U, Policy>&) const {
+        return false;
+    }
+};
+
+#endif // Allocator_h
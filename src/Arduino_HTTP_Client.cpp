@@ -9,6 +9,10 @@ Arduino_HTTP_Client::Arduino_HTTP_Client(Client& transport_client, const char *h
     // Nothing to do
 }
 
+void Arduino_HTTP_Client::set_timeout(const unsigned long& timeout_milliseconds) {
+    m_http_client.setTimeout(timeout_milliseconds);
+}
+
 void Arduino_HTTP_Client::set_keep_alive(const bool& keep_alive) {
     if (keep_alive) {
         m_http_client.connectionKeepAlive();
@@ -23,6 +27,10 @@ void Arduino_HTTP_Client::stop() {
     m_http_client.stop();
 }
 
+bool Arduino_HTTP_Client::connected() {
+    return m_http_client.connected();
+}
+
 int Arduino_HTTP_Client::post(const char *url_path, const char *content_type, const char *request_body) {
     return m_http_client.post(url_path, content_type, request_body);
 }
@@ -44,4 +52,37 @@ String Arduino_HTTP_Client::get_response_body() {
 #endif // THINGSBOARD_ENABLE_STL
 }
 
+int Arduino_HTTP_Client::read_response_body(uint8_t *buffer, const size_t& size) {
+    const int error = m_http_client.skipResponseHeaders();
+    if (error != HTTP_SUCCESS) {
+        return error;
+    }
+    else if (size == 0U || m_http_client.endOfBodyReached()) {
+        return 0;
+    }
+
+    // Bytes are read one by one, because only the single byte read() method handles chunked transfer encoding
+    size_t count = 0U;
+    while (count < size && m_http_client.available() > 0) {
+        const int read_byte = m_http_client.read();
+        if (read_byte < 0) {
+            break;
+        }
+        buffer[count++] = static_cast<uint8_t>(read_byte);
+    }
+    if (count > 0U) {
+        return count;
+    }
+    // Responses without a content length header end once the server closes the connection
+    else if (!m_http_client.connected()) {
+        return 0;
+    }
+
+    // Wait for the next byte for at most the timeout set with set_timeout(), readBytes() uses the same single byte read() method internally
+    if (m_http_client.readBytes(reinterpret_cast<char*>(buffer), 1U) == 1U) {
+        return 1;
+    }
+    return (m_http_client.endOfBodyReached() || !m_http_client.connected()) ? 0 : HTTP_ERROR_TIMED_OUT;
+}
+
 #endif // ARDUINO
@@ -24,12 +24,19 @@ class Arduino_HTTP_Client : public IHTTP_Client {
     /// because using an unencrpyted connection, will allow 3rd parties to listen to the communication and impersonate the server sending payloads which might influence the device in unexpected ways
     Arduino_HTTP_Client(Client& transport_client, const char *host, const uint16_t& port);
 
+    /// @brief Sets the maximum amount of time read_response_body() waits for the next part of the response body to arrive, before reading it is aborted.
+    /// Applied to the underlying Stream with setTimeout(), which also bounds the other blocking reads of the ArduinoHttpClient
+    /// @param timeout_milliseconds Maximum time in milliseconds to wait for the next byte, default = 1000 milliseconds as defined by the Stream class
+    void set_timeout(const unsigned long& timeout_milliseconds);
+
     void set_keep_alive(const bool& keep_alive) override;
 
     int connect(const char *host, const uint16_t& port) override;
 
     void stop() override;
 
+    bool connected() override;
+
     int post(const char *url_path, const char *content_type, const char *request_body) override;
 
     int get_response_status_code() override;
@@ -42,6 +49,8 @@ class Arduino_HTTP_Client : public IHTTP_Client {
     String get_response_body() override;
 #endif // THINGSBOARD_ENABLE_STL
 
+    int read_response_body(uint8_t *buffer, const size_t& size) override;
+
   private:
     HttpClient m_http_client; // Underlying HTTP client instance used to send data
 };
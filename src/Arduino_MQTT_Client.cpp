@@ -3,14 +3,26 @@
 
 #ifdef ARDUINO
 
+#if !THINGSBOARD_ENABLE_STL
+Arduino_MQTT_Client *Arduino_MQTT_Client::m_looping_instance = nullptr;
+#endif // !THINGSBOARD_ENABLE_STL
+
 Arduino_MQTT_Client::Arduino_MQTT_Client() :
     m_mqtt_client()
+#if !THINGSBOARD_ENABLE_STL
+    , m_received_data_callback(nullptr)
+    , m_received_data_context(nullptr)
+#endif // !THINGSBOARD_ENABLE_STL
 {
     // Nothing to do
 }
 
 Arduino_MQTT_Client::Arduino_MQTT_Client(Client& transport_client) :
     m_mqtt_client(transport_client)
+#if !THINGSBOARD_ENABLE_STL
+    , m_received_data_callback(nullptr)
+    , m_received_data_context(nullptr)
+#endif // !THINGSBOARD_ENABLE_STL
 {
     // Nothing to do
 }
@@ -19,9 +31,17 @@ void Arduino_MQTT_Client::set_client(Client& transport_client) {
     m_mqtt_client.setClient(transport_client);
 }
 
+#if THINGSBOARD_ENABLE_STL
 void Arduino_MQTT_Client::set_callback(function cb) {
     m_mqtt_client.setCallback(cb);
 }
+#else
+void Arduino_MQTT_Client::set_callback(function cb, void *context) {
+    m_received_data_callback = cb;
+    m_received_data_context = context;
+    m_mqtt_client.setCallback(Arduino_MQTT_Client::static_mqtt_callback);
+}
+#endif // THINGSBOARD_ENABLE_STL
 
 bool Arduino_MQTT_Client::set_buffer_size(const uint16_t& buffer_size) {
     return m_mqtt_client.setBufferSize(buffer_size);
@@ -44,7 +64,16 @@ void Arduino_MQTT_Client::disconnect() {
 }
 
 bool Arduino_MQTT_Client::loop() {
+#if THINGSBOARD_ENABLE_STL
     return m_mqtt_client.loop();
+#else
+    // Restore the previous instance afterwards, in case loop() of another instance is called from inside a received message callback
+    Arduino_MQTT_Client *previous_instance = m_looping_instance;
+    m_looping_instance = this;
+    const bool result = m_mqtt_client.loop();
+    m_looping_instance = previous_instance;
+    return result;
+#endif // THINGSBOARD_ENABLE_STL
 }
 
 bool Arduino_MQTT_Client::publish(const char *topic, const uint8_t *payload, const size_t& length) {
@@ -83,4 +112,14 @@ size_t Arduino_MQTT_Client::write(const uint8_t *buffer, size_t size) {
 
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
 
+#if !THINGSBOARD_ENABLE_STL
+void Arduino_MQTT_Client::static_mqtt_callback(char *topic, uint8_t *payload, unsigned int length) {
+    if (m_looping_instance == nullptr || m_looping_instance->m_received_data_callback == nullptr) {
+        return;
+    }
+
+    m_looping_instance->m_received_data_callback(m_looping_instance->m_received_data_context, topic, payload, length);
+}
+#endif // !THINGSBOARD_ENABLE_STL
+
 #endif // ARDUINO
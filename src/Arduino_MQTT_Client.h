@@ -27,7 +27,11 @@ class Arduino_MQTT_Client : public IMQTT_Client {
     /// but the actual type of connection does not matter (Ethernet or WiFi)
     void set_client(Client& transport_client);
 
+#if THINGSBOARD_ENABLE_STL
     void set_callback(function cb) override;
+#else
+    void set_callback(function cb, void *context) override;
+#endif // THINGSBOARD_ENABLE_STL
 
     bool set_buffer_size(const uint16_t& buffer_size) override;
 
@@ -66,7 +70,21 @@ class Arduino_MQTT_Client : public IMQTT_Client {
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
 
   private:
-    PubSubClient m_mqtt_client; // Underlying MQTT client instance used to send data
+    PubSubClient m_mqtt_client;                     // Underlying MQTT client instance used to send data
+#if !THINGSBOARD_ENABLE_STL
+    function m_received_data_callback;              // Callback that will be called as soon as the mqtt client receives any data
+    void *m_received_data_context;                  // Context passed as the first argument to the received data callback
+
+    // PubSubClient only allows a free-standing function without any context as a callback, but it only ever calls it from inside its loop() method.
+    // Therefore the instance that is currently inside loop() is kept, which allows to forward the message to the correct instance, even if multiple instances exist
+    static Arduino_MQTT_Client *m_looping_instance;
+
+    /// @brief Static callback subscribed to the PubSubClient, forwards the received message to the callback of the instance that is currently inside loop()
+    /// @param topic Topic the message was received over
+    /// @param payload Payload of the received message
+    /// @param length Length of the payload in bytes
+    static void static_mqtt_callback(char *topic, uint8_t *payload, unsigned int length);
+#endif // !THINGSBOARD_ENABLE_STL
 };
 
 #endif // ARDUINO
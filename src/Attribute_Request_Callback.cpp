@@ -4,6 +4,11 @@
 Attribute_Request_Callback::Attribute_Request_Callback() :
     Callback(nullptr, ATT_REQUEST_CB_IS_NULL),
     m_attributes(),
+#if THINGSBOARD_ENABLE_STL
+    m_timeout(0U),
+    m_timeout_callback(),
+    m_deadline(0U),
+#endif // THINGSBOARD_ENABLE_STL
     m_request_id(0U),
     m_attribute_key(nullptr)
 {
@@ -41,7 +46,35 @@ void Attribute_Request_Callback::Set_Attribute_Key(const char *attribute_key) {
 
 #if THINGSBOARD_ENABLE_STL
 
-const std::vector<const char *>& Attribute_Request_Callback::Get_Attributes() const {
+const uint64_t& Attribute_Request_Callback::Get_Timeout() const {
+    return m_timeout;
+}
+
+void Attribute_Request_Callback::Set_Timeout(const uint64_t& timeout_microseconds) {
+    m_timeout = timeout_microseconds;
+}
+
+const Attribute_Request_Callback::timeoutFn& Attribute_Request_Callback::Get_Timeout_Callback() const {
+    return m_timeout_callback;
+}
+
+void Attribute_Request_Callback::Set_Timeout_Callback(timeoutFn timeoutCb) {
+    m_timeout_callback = timeoutCb;
+}
+
+const uint64_t& Attribute_Request_Callback::Get_Deadline() const {
+    return m_deadline;
+}
+
+void Attribute_Request_Callback::Set_Deadline(const uint64_t& deadline) {
+    m_deadline = deadline;
+}
+
+#endif // THINGSBOARD_ENABLE_STL
+
+#if THINGSBOARD_ENABLE_STL
+
+const Attribute_Request_Callback::Attribute_Keys& Attribute_Request_Callback::Get_Attributes() const {
     return m_attributes;
 }
 
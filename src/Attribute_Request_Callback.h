@@ -3,12 +3,12 @@
 
 // Local includes.
 #include "Callback.h"
+#if THINGSBOARD_ENABLE_STL
+#include "StaticVector.h"
+#endif // THINGSBOARD_ENABLE_STL
 
 // Library includes.
 #include <ArduinoJson.h>
-#if THINGSBOARD_ENABLE_STL
-#include <vector>
-#endif // THINGSBOARD_ENABLE_STL
 
 
 /// ---------------------------------
@@ -36,6 +36,13 @@ using Attribute_Data = const JsonObjectConst;
 /// Documentation about the specific use of Requesting client-side or shared scope atrributes in ThingsBoard can be found here https://thingsboard.io/docs/reference/mqtt-api/#request-attribute-values-from-the-server
 class Attribute_Request_Callback : public Callback<void, const Attribute_Data&> {
   public:
+#if THINGSBOARD_ENABLE_STL
+    /// @brief Timeout callback signature, called if the response has not been received in time
+    using timeoutFn = Inplace_Function<void(void)>;
+    /// @brief Requested client-side or shared attribute keys, stored inline so creating or copying the callback never allocates memory on the heap
+    using Attribute_Keys = StaticVector<const char *, THINGSBOARD_MAX_ATTRIBUTE_KEYS>;
+#endif // THINGSBOARD_ENABLE_STL
+
     /// @brief Constructs empty callback, will result in never being called
     Attribute_Request_Callback();
 
@@ -43,21 +50,19 @@ class Attribute_Request_Callback : public Callback<void, const Attribute_Data&>
 
     /// @brief Constructs callback, will be called upon client-side or shared attribute request arrival
     /// where the given multiple requested client-side or shared attributes were sent by the cloud and received by the client.
-    /// Directly forwards the given arguments to the overloaded vector constructor,
-    /// meaning all combinatons of arguments that would initalize a vector can be used to call this constructor.
-    /// See possible vector constructors https://en.cppreference.com/w/cpp/container/vector/vector, for the possible passed parameters.
-    /// The possibilites mainly consist out of the fill constructor, where a value and a number n is given and then that many elements of the value will be copied into
-    /// or be created with their default value, or out of the range constructor where we can pass an interator the start of another data container
-    /// and to the end of the data container (last element + 1)
-    /// and then every element between those iteratos will be copied, in the same order as in the original data container.
-    /// The last option is a copy constructor where we pass a vector and the values of that vector will be copied into our buffer
-    /// @tparam ...Args Holds the multiple arguments that will simply be forwarded to the vector constructor and therefore allow to use every overloaded vector constructor without having to implement them
+    /// Copies the keys in the given range into the callback, meaning the data container they were read from does not have to outlive the callback,
+    /// but the strings the keys point to do. At most THINGSBOARD_MAX_ATTRIBUTE_KEYS keys are copied, further keys are ignored
+    /// @tparam InputIterator Class that points to the begin and end iterator of the given data container
     /// @param callback Callback method that will be called upon data arrival with the given data that was received serialized into a JsonDocument
-    /// @param ...args Arguments that will be forwarded into the overloaded vector constructor see https://en.cppreference.com/w/cpp/container/vector/vector for more information
-    template<typename... Args>
-    inline Attribute_Request_Callback(function callback, Args... args)
+    /// @param first_itr Iterator pointing to the first key that should be copied
+    /// @param last_itr Iterator pointing to the end of the keys that should be copied (last element + 1)
+    template<typename InputIterator>
+    inline Attribute_Request_Callback(function callback, InputIterator first_itr, const InputIterator& last_itr)
       : Callback(callback, ATT_REQUEST_CB_IS_NULL)
-      , m_attributes(std::forward<Args>(args)...)
+      , m_attributes(first_itr, last_itr)
+      , m_timeout(0U)
+      , m_timeout_callback()
+      , m_deadline(0U)
       , m_request_id(0U)
       , m_attribute_key(nullptr)
     {
@@ -104,30 +109,56 @@ class Attribute_Request_Callback : public Callback<void, const Attribute_Data&>
     /// "client" for client-side attributes and "shared" for shared scope attributes
     void Set_Attribute_Key(const char *attribute_key);
 
+#if THINGSBOARD_ENABLE_STL
+
+    /// @brief Gets the time in microseconds we wait for the response to the client-side or shared attribute request, before it counts as a timeout
+    /// @return Time we wait for the response, 0 if we wait forever
+    const uint64_t& Get_Timeout() const;
+
+    /// @brief Sets the time in microseconds we wait for the response to the client-side or shared attribute request, before it counts as a timeout.
+    /// Once the timeout has passed the timeout callback is called and the request is removed, meaning a late response is ignored,
+    /// which ensures requests the server never responds to do not keep their slot forever
+    /// @param timeout_microseconds Time we wait for the response, 0 waits forever
+    void Set_Timeout(const uint64_t& timeout_microseconds);
+
+    /// @brief Gets the callback that is called if the response to the client-side or shared attribute request has not been received before the timeout has passed
+    /// @return Callback that is called if the request timed out
+    const timeoutFn& Get_Timeout_Callback() const;
+
+    /// @brief Sets the callback that is called if the response to the client-side or shared attribute request has not been received before the timeout has passed
+    /// @param timeoutCb Callback that is called if the request timed out, an empty callback only removes the request
+    void Set_Timeout_Callback(timeoutFn timeoutCb);
+
+    /// @brief Gets the time the request times out at
+    /// @return Timestamp in microseconds the request times out at, 0 if the request never times out
+    const uint64_t& Get_Deadline() const;
+
+    /// @brief Sets the time the request times out at.
+    /// Not meant for external use, because the value is overwritten by the ThingsBoard class once the request has been sent anyway,
+    /// this is the case because only the ThingsBoard class knows when the request has actually been sent
+    /// @param deadline Timestamp in microseconds the request times out at, 0 if the request never times out
+    void Set_Deadline(const uint64_t& deadline);
+
+#endif // THINGSBOARD_ENABLE_STL
+
 #if THINGSBOARD_ENABLE_STL
 
     /// @brief Gets all the requested client-side or shared attributes that will result,
     /// in the subscribed method being called when the response with their current value
     /// is sent from the cloud and received by the client
     /// @return Requested client-side or shared attributes
-    const std::vector<const char *>& Get_Attributes() const;
+    const Attribute_Keys& Get_Attributes() const;
 
     /// @brief Sets all the requested client-side or shared attributes that will result,
     /// in the subscribed method being called when the response with their current value
     /// is sent from the cloud and received by the client.
-    /// Directly forwards the given arguments to the overloaded vector assign method,
-    /// meaning all combinatons of arguments that can call the assign method on a vector can be used to call this method.
-    /// See possible overloaded vector assign methods https://en.cppreference.com/w/cpp/container/vector/assign, for the possible passed parameters.
-    /// The possibilites mainly consist out of the fill assign method, where a value and a number n is given and then that many elements of the value will be copied into
-    /// or be created with their default value, or out of the range assign method where we can pass an interator the start of another data container
-    /// and to the end of the data container (last element + 1)
-    /// and then every element between those iteratos will be copied, in the same order as in the original data container.
-    /// The last option is a copy assign method where we pass a vector and the values of that vector will be copied into our buffer
-    /// @tparam ...Args Holds the multiple arguments that will simply be forwarded to the vector assign method and therefore allow to use every overloaded vector assign without having to implement them
-    /// @param ...args Arguments that will be forwarded into the overloaded vector assign method see https://en.cppreference.com/w/cpp/container/vector/assign for more information
-    template<typename... Args>
-    inline void Set_Attributes(Args... args) {
-        m_attributes.assign(std::forward<Args>(args)...);
+    /// At most THINGSBOARD_MAX_ATTRIBUTE_KEYS keys are copied, further keys are ignored
+    /// @tparam InputIterator Class that points to the begin and end iterator of the given data container
+    /// @param first_itr Iterator pointing to the first key that should be copied
+    /// @param last_itr Iterator pointing to the end of the keys that should be copied (last element + 1)
+    template<typename InputIterator>
+    inline void Set_Attributes(InputIterator first_itr, const InputIterator& last_itr) {
+        m_attributes.assign(first_itr, last_itr);
     }
 
 #else
@@ -148,7 +179,10 @@ class Attribute_Request_Callback : public Callback<void, const Attribute_Data&>
 
   private:
 #if THINGSBOARD_ENABLE_STL
-    std::vector<const char *>      m_attributes;      // Attribute we want to request
+    Attribute_Keys                 m_attributes;      // Attribute we want to request
+    uint64_t                       m_timeout;         // Time we wait for the response, 0 if we wait forever
+    timeoutFn                      m_timeout_callback; // Callback that is called if the response has not been received in time
+    uint64_t                       m_deadline;        // Timestamp the request times out at, 0 if it never times out
 #else
     const char                     *m_attributes;     // Attribute we want to request
 #endif // THINGSBOARD_ENABLE_STL
@@ -0,0 +1,368 @@
+#ifndef Attribute_Store_h
+#define Attribute_Store_h
+
+// Local include.
+#include "Configuration.h"
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <ArduinoJson.h>
+#if THINGSBOARD_ENABLE_STL
+#include <type_traits>
+#endif // THINGSBOARD_ENABLE_STL
+
+
+/// @brief Local store of client-side attributes, which keeps the current value of each attribute in a fixed capacity typed key-value table.
+/// Changing a value with Set() only marks the attribute as changed if the value actually differs from the stored one, sendChangedAttributes() of the ThingsBoard class
+/// then publishes only the changed attributes in one single message, meaning multiple changes between two calls are coalesced. Additionally the stored values can be read locally with Get()
+/// and the store can be filled with the response of a Client_Attributes_Request with Update(), so that reading the current values does not need a round trip to the server.
+/// Keys and string values are copied into the table, meaning no memory is ever allocated and the passed strings do not need to be kept alive
+/// @tparam MaxKeys Maximum amount of attributes that can be stored
+/// @tparam MaxKeyLength Maximum length of the key of an attribute including the null terminator, longer keys are refused, default = 32
+/// @tparam MaxStringLength Maximum length of a string value including the null terminator, longer strings are refused, default = 32
+template <size_t MaxKeys, size_t MaxKeyLength = 32U, size_t MaxStringLength = 32U>
+class Attribute_Store {
+  public:
+    /// @brief Constructs an empty store
+    inline Attribute_Store() :
+        m_entries(),
+        m_size(0U)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Sets the given attribute to the given boolean value, marks it as changed if the value differs from the stored one
+    /// @param key Key of the attribute, is copied into the store
+    /// @param value Value of the attribute
+    /// @return Whether the value could be stored or not, fails if the store is full or the key is too long
+    inline bool Set(const char *key, bool value) {
+        Value stored;
+        stored.boolean = value;
+        return Store(key, Value_Type::BOOL, stored, nullptr, true);
+    }
+
+    /// @brief Sets the given attribute to the given integral value, marks it as changed if the value differs from the stored one
+    /// @tparam T Type of the passed value, is required to be integral
+    /// @param key Key of the attribute, is copied into the store
+    /// @param value Value of the attribute
+    /// @return Whether the value could be stored or not, fails if the store is full or the key is too long
+    template <typename T,
+#if THINGSBOARD_ENABLE_STL
+              typename std::enable_if<std::is_integral<T>::value>::type* = nullptr>
+#else
+              typename ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::enable_if<ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::is_integral<T>::value>::type* = nullptr>
+#endif // THINGSBOARD_ENABLE_STL
+    inline bool Set(const char *key, T value) {
+        Value stored;
+        stored.integer = value;
+        return Store(key, Value_Type::INTEGER, stored, nullptr, true);
+    }
+
+    /// @brief Sets the given attribute to the given floating point value, marks it as changed if the value differs from the stored one
+    /// @tparam T Type of the passed value, is required to be a floating point
+    /// @param key Key of the attribute, is copied into the store
+    /// @param value Value of the attribute
+    /// @return Whether the value could be stored or not, fails if the store is full or the key is too long
+    template <typename T,
+#if THINGSBOARD_ENABLE_STL
+              typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
+#else
+              typename ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::enable_if<ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::is_floating_point<T>::value>::type* = nullptr>
+#endif // THINGSBOARD_ENABLE_STL
+    inline bool Set(const char *key, T value) {
+        Value stored;
+        stored.real = value;
+        return Store(key, Value_Type::REAL, stored, nullptr, true);
+    }
+
+    /// @brief Sets the given attribute to the given string value, marks it as changed if the value differs from the stored one
+    /// @param key Key of the attribute, is copied into the store
+    /// @param value Value of the attribute, is copied into the store
+    /// @return Whether the value could be stored or not, fails if the store is full or the key or value is too long
+    inline bool Set(const char *key, const char *value) {
+        if (value == nullptr) {
+            return false;
+        }
+        return Store(key, Value_Type::STRING, Value(), value, true);
+    }
+
+    /// @brief Reads the stored boolean value of the given attribute
+    /// @param key Key of the attribute
+    /// @param value Variable the value is copied into
+    /// @return Whether the attribute has been stored and is a boolean or not
+    inline bool Get(const char *key, bool& value) const {
+        const Entry *entry = Find_Entry(key);
+        if (entry == nullptr || entry->type != Value_Type::BOOL) {
+            return false;
+        }
+        value = entry->value.boolean;
+        return true;
+    }
+
+    /// @brief Reads the stored integral value of the given attribute
+    /// @param key Key of the attribute
+    /// @param value Variable the value is copied into
+    /// @return Whether the attribute has been stored and is an integer or not
+    inline bool Get(const char *key, int64_t& value) const {
+        const Entry *entry = Find_Entry(key);
+        if (entry == nullptr || entry->type != Value_Type::INTEGER) {
+            return false;
+        }
+        value = entry->value.integer;
+        return true;
+    }
+
+    /// @brief Reads the stored numeric value of the given attribute, integers are converted
+    /// @param key Key of the attribute
+    /// @param value Variable the value is copied into
+    /// @return Whether the attribute has been stored and is numeric or not
+    inline bool Get(const char *key, double& value) const {
+        const Entry *entry = Find_Entry(key);
+        if (entry == nullptr) {
+            return false;
+        }
+        else if (entry->type == Value_Type::INTEGER) {
+            value = static_cast<double>(entry->value.integer);
+            return true;
+        }
+        else if (entry->type != Value_Type::REAL) {
+            return false;
+        }
+        value = entry->value.real;
+        return true;
+    }
+
+    /// @brief Reads the stored string value of the given attribute
+    /// @param key Key of the attribute
+    /// @param value Variable the pointer to the stored string is copied into, stays valid until the attribute is changed
+    /// @return Whether the attribute has been stored and is a string or not
+    inline bool Get(const char *key, const char*& value) const {
+        const Entry *entry = Find_Entry(key);
+        if (entry == nullptr || entry->type != Value_Type::STRING) {
+            return false;
+        }
+        value = entry->text;
+        return true;
+    }
+
+    /// @brief Whether the given attribute has been stored or not
+    /// @param key Key of the attribute
+    /// @return Whether the attribute has been stored or not
+    inline bool Contains(const char *key) const {
+        return Find_Entry(key) != nullptr;
+    }
+
+    /// @brief Gets the amount of stored attributes
+    /// @return Amount of stored attributes
+    inline const size_t& Size() const {
+        return m_size;
+    }
+
+    /// @brief Gets the amount of attributes that have changed since they were published last
+    /// @return Amount of changed attributes
+    inline size_t Get_Changed_Count() const {
+        size_t count = 0U;
+        for (size_t i = 0U; i < m_size; i++) {
+            if (m_entries[i].changed) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    /// @brief Marks every stored attribute as changed, meaning the complete store is published the next time,
+    /// should be called after the connection to the server has been reestablished if the server might have missed previous changes
+    inline void Mark_All_Changed() {
+        for (size_t i = 0U; i < m_size; i++) {
+            m_entries[i].changed = true;
+        }
+    }
+
+    /// @brief Stores the received attributes without marking them as changed, because they already match the values on the server.
+    /// Meant to be called with the data received in the callback of a Client_Attributes_Request, attributes that have been changed locally
+    /// but not published yet keep their local value, because it is newer than the one on the server. Objects and arrays are skipped
+    /// @param data Received attributes, keys and strings are copied into the store
+    /// @return Whether every received attribute could be stored or not
+    inline bool Update(const JsonObjectConst& data) {
+        bool result = true;
+        for (const JsonPairConst pair : data) {
+            const char *key = pair.key().c_str();
+            const Entry *entry = Find_Entry(key);
+            if (entry != nullptr && entry->changed) {
+                continue;
+            }
+            const JsonVariantConst variant = pair.value();
+            Value value;
+            if (variant.is<bool>()) {
+                value.boolean = variant.as<bool>();
+                result &= Store(key, Value_Type::BOOL, value, nullptr, false);
+            }
+            else if (variant.is<int64_t>()) {
+                value.integer = variant.as<int64_t>();
+                result &= Store(key, Value_Type::INTEGER, value, nullptr, false);
+            }
+            else if (variant.is<double>()) {
+                value.real = variant.as<double>();
+                result &= Store(key, Value_Type::REAL, value, nullptr, false);
+            }
+            else if (variant.is<const char*>()) {
+                result &= Store(key, Value_Type::STRING, value, variant.as<const char*>(), false);
+            }
+        }
+        return result;
+    }
+
+    /// @brief Copies the first changed attributes into the given json object, keys and strings are not copied but referenced,
+    /// therefore the store may not be changed until the json object has been serialized
+    /// @param object Json object the changed attributes are copied into
+    /// @param max_count Maximum amount of changed attributes that are copied, default = MaxKeys meaning every changed attribute
+    /// @return Whether every changed attribute could be copied into the json object or not
+    inline bool Serialize_Changed(const JsonVariant& object, const size_t& max_count = MaxKeys) const {
+        size_t count = 0U;
+        for (size_t i = 0U; i < m_size && count < max_count; i++) {
+            const Entry& entry = m_entries[i];
+            if (!entry.changed) {
+                continue;
+            }
+            count++;
+            bool result = false;
+            // Keys are passed as const char* so ArduinoJson references them instead of copying them into the JsonDocument
+            const char *key = entry.key;
+            switch (entry.type) {
+                case Value_Type::BOOL:
+                    result = object[key].set(entry.value.boolean);
+                    break;
+                case Value_Type::INTEGER:
+                    result = object[key].set(entry.value.integer);
+                    break;
+                case Value_Type::REAL:
+                    result = object[key].set(entry.value.real);
+                    break;
+                case Value_Type::STRING:
+                    result = object[key].set(static_cast<const char*>(entry.text));
+                    break;
+            }
+            if (!result) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Marks the first changed attributes as unchanged, called once the changed attributes have been successfully published,
+    /// passing the same maximum amount as to Serialize_Changed() marks exactly the published attributes as unchanged
+    /// @param max_count Maximum amount of changed attributes that are marked as unchanged, default = MaxKeys meaning every changed attribute
+    inline void Clear_Changed(const size_t& max_count = MaxKeys) {
+        size_t count = 0U;
+        for (size_t i = 0U; i < m_size && count < max_count; i++) {
+            if (m_entries[i].changed) {
+                m_entries[i].changed = false;
+                count++;
+            }
+        }
+    }
+
+  private:
+    /// @brief Type of the value stored for an attribute
+    enum class Value_Type : const uint8_t {
+        BOOL,
+        INTEGER,
+        REAL,
+        STRING
+    };
+
+    /// @brief Numeric value stored for an attribute, strings are stored separately
+    union Value {
+        bool boolean;
+        int64_t integer;
+        double real;
+    };
+
+    /// @brief Key and value of a single stored attribute
+    struct Entry {
+        char key[MaxKeyLength];       // Key of the attribute
+        Value_Type type;              // Type of the stored value
+        Value value;                  // Stored value, if it is not a string
+        char text[MaxStringLength];   // Stored value, if it is a string
+        bool changed;                 // Whether the value has changed since it was published last
+    };
+
+    /// @brief Gets the entry of the given key
+    /// @param key Key of the attribute
+    /// @return Entry of the given key or nullptr if the attribute has not been stored
+    inline const Entry* Find_Entry(const char *key) const {
+        if (key == nullptr) {
+            return nullptr;
+        }
+        for (size_t i = 0U; i < m_size; i++) {
+            if (strncmp(m_entries[i].key, key, MaxKeyLength) == 0) {
+                return &m_entries[i];
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief Stores the given value for the given key, adds a new entry if the key has not been stored yet
+    /// @param key Key of the attribute
+    /// @param type Type of the given value
+    /// @param value Given value, if it is not a string
+    /// @param text Given value, if it is a string
+    /// @param mark_changed Whether the attribute should be marked as changed if the value differs from the stored one
+    /// @return Whether the value could be stored or not
+    inline bool Store(const char *key, const Value_Type& type, const Value& value, const char *text, const bool& mark_changed) {
+        if (key == nullptr || strlen(key) >= MaxKeyLength || (text != nullptr && strlen(text) >= MaxStringLength)) {
+            return false;
+        }
+        Entry *entry = const_cast<Entry*>(Find_Entry(key));
+        if (entry == nullptr) {
+            if (m_size >= MaxKeys) {
+                return false;
+            }
+            entry = &m_entries[m_size++];
+            strncpy(entry->key, key, MaxKeyLength);
+            entry->changed = mark_changed;
+        }
+        else if (!Is_Equal(*entry, type, value, text)) {
+            entry->changed = entry->changed || mark_changed;
+        }
+        else {
+            return true;
+        }
+        entry->type = type;
+        entry->value = value;
+        if (text != nullptr) {
+            strncpy(entry->text, text, MaxStringLength);
+        }
+        return true;
+    }
+
+    /// @brief Whether the stored value of the given entry is equal to the given value or not
+    /// @param entry Entry of the attribute
+    /// @param type Type of the given value
+    /// @param value Given value, if it is not a string
+    /// @param text Given value, if it is a string
+    /// @return Whether the values are equal or not
+    static inline bool Is_Equal(const Entry& entry, const Value_Type& type, const Value& value, const char *text) {
+        if (entry.type != type) {
+            return false;
+        }
+        switch (type) {
+            case Value_Type::BOOL:
+                return entry.value.boolean == value.boolean;
+            case Value_Type::INTEGER:
+                return entry.value.integer == value.integer;
+            case Value_Type::REAL:
+                return entry.value.real == value.real;
+            case Value_Type::STRING:
+                return strncmp(entry.text, text, MaxStringLength) == 0;
+        }
+        return false;
+    }
+
+    Entry m_entries[MaxKeys]; // Key and value of each stored attribute
+    size_t m_size;            // Amount of stored attributes
+};
+
+#endif // Attribute_Store_h
@@ -4,14 +4,13 @@
 // Local includes.
 #include "Configuration.h"
 
-// Library includes.
 #if THINGSBOARD_ENABLE_STL
-#include <functional>
+#include "Inplace_Function.h"
 #endif // THINGSBOARD_ENABLE_STL
 
 
-/// @brief General purpose callback wrapper. Expects either c-style or c++ style function pointer,
-/// depending on if the C++ STL has been implemented on the given device or not
+/// @brief General purpose callback wrapper. Expects either c-style function pointer or any callable object that fits into THINGSBOARD_INPLACE_FUNCTION_SIZE,
+/// depending on if the C++ STL has been implemented on the given device or not. The callable object is stored inline, meaning creating, copying or calling the callback never allocates memory on the heap
 /// @tparam returnType Type the given callback method should return
 /// @tparam argumentTypes Types the given callback method should receive
 template<typename returnType, typename... argumentTypes>
@@ -19,7 +18,7 @@ class Callback {
   public:
     /// @brief Callback signature
 #if THINGSBOARD_ENABLE_STL
-    using function = std::function<returnType(argumentTypes... arguments)>;
+    using function = Inplace_Function<returnType(argumentTypes... arguments)>;
 #else
     using function = returnType (*)(argumentTypes... arguments);
 #endif // THINGSBOARD_ENABLE_STL
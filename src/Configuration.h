@@ -1,8 +1,6 @@
 #ifndef Configuration_h
 #define Configuration_h
 
-#define THINGSBOARD_ENABLE_SWOTA 1
-
 // Include sdkconfig file it it exists to allow overwriting of some defines with the configuration entered in the Espressif IDF menuconfig.
 // Only available when compiling for Espressif IDF, but allows to more easily change some configurations with a GUI instead of code.
 #  ifdef __has_include
@@ -43,6 +41,21 @@
 #    endif
 #  endif
 
+// Amount of bytes each callback stored internally can have at most, only used if THINGSBOARD_ENABLE_STL is set, because c-style function pointers are used otherwise.
+// Callbacks are stored inline in an Inplace_Function instead of in a std::function, meaning they never allocate memory on the heap, but a callable object that is bigger causes a compile time error.
+// The default allows lambdas that capture up to 4 pointers, for example [this] or [&value, this], member functions bound to an instance with std::bind and c-style function pointers.
+// Can be increased with a #define before including ThingsBoard, if lambdas capturing more or bigger values should be passed as callbacks.
+#  ifndef THINGSBOARD_INPLACE_FUNCTION_SIZE
+#    define THINGSBOARD_INPLACE_FUNCTION_SIZE (4U * sizeof(void *))
+#  endif
+
+// Amount of keys each shared attribute update or client-side and shared attribute request callback can hold at most, only used if THINGSBOARD_ENABLE_STL is set, because a comma seperated string is used otherwise.
+// The keys are stored inline in the callback instead of in a std::vector, meaning creating or copying the callback never allocates memory on the heap, but keys exceeding the amount are ignored.
+// Can be increased with a #define before including ThingsBoard, if a single callback should subscribe or request more keys.
+#  ifndef THINGSBOARD_MAX_ATTRIBUTE_KEYS
+#    define THINGSBOARD_MAX_ATTRIBUTE_KEYS 8U
+#  endif
+
 // Enable the usage of OTA (Over the air) updates, only possible with STL base functionality, theoretically possible without STL support,
 // but the code would have to be adjusted at compile time depending on if the C++ STL is supported or not and that has not been implemented for OTA yet.
 #  ifndef THINGSBOARD_ENABLE_OTA
@@ -53,8 +66,14 @@
 #    endif
 #  endif
 
-// Use the esp_timer header internally for handling timeouts and callbacks, as long as the header exists, because it is more efficient than the Arduino Ticker implementation,
-// because we can stop the timer without having to delete it, removing the need to create a new timer to restart it. Because instead we can simply stop and start again.
+// Enable the usage of software OTA (Over the air) updates, which are downloaded by the same engine as the firmware updates,
+// therefore only possible if OTA updates are enabled.
+#  ifndef THINGSBOARD_ENABLE_SWOTA
+#    define THINGSBOARD_ENABLE_SWOTA THINGSBOARD_ENABLE_OTA
+#  endif
+
+// Use the esp_timer header internally for measuring time and the esp_random header for generating random numbers, as long as the esp_timer header exists,
+// because it is more precise than the Arduino micros() implementation and does not overflow after roughly 70 minutes.
 #  ifdef __has_include
 #    if  __has_include(<esp_timer.h>)
 #      ifndef THINGSBOARD_USE_ESP_TIMER
@@ -85,6 +104,24 @@
 #    define THINGSBOARD_USE_ESP_MQTT 0
 #  endif
 
+// Use the POSIX socket and epoll headers internally for handling the sending and receiving of MQTT data, as long as the headers exist and we are not compiling for Arduino,
+// to allow users running the library natively on Linux, for example on edge gateways or to test against a local broker, to use the Linux_MQTT_Client.
+#  ifdef __has_include
+#    if  __has_include(<sys/epoll.h>) && __has_include(<sys/socket.h>) && !defined(ARDUINO)
+#      ifndef THINGSBOARD_USE_LINUX_MQTT
+#        define THINGSBOARD_USE_LINUX_MQTT 1
+#      endif
+#    else
+#      ifndef THINGSBOARD_USE_LINUX_MQTT
+#        define THINGSBOARD_USE_LINUX_MQTT 0
+#      endif
+#    endif
+#  else
+#    ifndef THINGSBOARD_USE_LINUX_MQTT
+#      define THINGSBOARD_USE_LINUX_MQTT 0
+#    endif
+#  endif
+
 // Use the mbed_tls header internally for handling the creation of hashes from binary data, as long as the header exists,
 // because if it is already included we do not need to rely on and incude external lbiraries like Seeed_mbedtls.h, which implements the same features.
 #  ifdef __has_include
@@ -101,6 +138,22 @@
 #    define THINGSBOARD_USE_MBED_TLS 0
 #  endif
 
+// Use the FreeRTOS semaphore header internally for guarding the timer wheel and the pending client-side requests with a mutex, as long as the header exists,
+// because MQTT clients like the Espressif_MQTT_Client receive messages from their own task, while the timeouts are handled by the task that calls loop().
+#  ifdef __has_include
+#    if  __has_include(<freertos/FreeRTOS.h>) && __has_include(<freertos/semphr.h>)
+#      ifndef THINGSBOARD_USE_FREERTOS_MUTEX
+#        define THINGSBOARD_USE_FREERTOS_MUTEX 1
+#      endif
+#    else
+#      ifndef THINGSBOARD_USE_FREERTOS_MUTEX
+#        define THINGSBOARD_USE_FREERTOS_MUTEX 0
+#      endif
+#    endif
+#  else
+#    define THINGSBOARD_USE_FREERTOS_MUTEX 0
+#  endif
+
 // Use the esp_ota_ops header internally for handling the writing of ota update data, as long as the header exists,
 // to allow users that do have the needed component to use the Espressif_Updater instead of only the Arduino_ESP32_Updater.
 #  ifdef __has_include
@@ -159,6 +212,25 @@
 #    endif
 #  endif
 
+// Enables the ThingsBoard class to keep lightweight counters about the sent and received messages and bytes per topic class, (de-)serialization failures,
+// messages dropped because they were too big, latency histograms of the subscribed RPC callbacks and the OTA chunk round trip times, as well as the largest heap allocation per allocation path.
+// The counters can be read with getPerformanceCounters() and optionally be published periodically as telemetry data. Requires some additional ram and flash memory and a few additional instructions per message.
+// Can also optionally be configured via the ESP-IDF menuconfig, if that is the done the value is set to the value entered in the menuconfig,
+// if the value is manually overriden tough with a #define before including ThingsBoard then the hardcoded value takes precendence.
+#  ifndef THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+#    ifndef CONFIG_THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+#      define THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS 0
+#    else
+#      define THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS CONFIG_THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+#    endif
+#  endif
+
+// Allows to replace the time source of Helper::getMicroseconds() with Helper::setClock(), which is used by the host-side tests in the test folder to replay timeouts against a simulated clock,
+// instead of having to wait for real time to pass. Disabled by default, because devices should always use the time source of the platform, which also removes the additional check from every time measurement.
+#  ifndef THINGSBOARD_ENABLE_CLOCK_OVERRIDE
+#    define THINGSBOARD_ENABLE_CLOCK_OVERRIDE 0
+#  endif
+
 // Enables the usage of an additonal library as a fallback, to directly serialize a json message that is sent to the cloud,
 // if the size of that message would be bigger than the internal buffer size of the client.
 // Allows sending much bigger messages than would otherwise be possible, and without the need to increase stack or heap requirements, but at the cost of increased send times.
@@ -3,6 +3,7 @@
 
 // Local includes.
 #include "Configuration.h"
+#include "Allocator.h"
 
 // Library includes.
 #if THINGSBOARD_ENABLE_PROGMEM
@@ -31,6 +32,9 @@ class ThingsBoardDefaultLogger;
 #ifndef strncmp_P
 #define strncmp_P   strncmp
 #endif // strncmp_P
+#ifndef memcpy_P
+#define memcpy_P    memcpy
+#endif // memcpy_P
 #endif // THINGSBOARD_ENABLE_PROGMEM
 
 
@@ -47,6 +51,8 @@ constexpr char TOO_MANY_JSON_FIELDS[] PROGMEM = "Too many JSON fields passed (%u
 constexpr char CONNECT_FAILED[] PROGMEM = "Connecting to server failed";
 constexpr char UNABLE_TO_SERIALIZE_JSON[] PROGMEM = "Unable to serialize json data";
 constexpr char UNABLE_TO_ALLOCATE_MEMORY[] PROGMEM = "Allocating memory for the JsonDocument failed, passed JsonObject or JsonVariant is NULL";
+constexpr char UNABLE_TO_ALLOCATE_BUFFER[] PROGMEM = "Allocating (%u) bytes failed, increase the memory available to the allocator accordingly";
+constexpr char UNABLE_TO_DE_SERIALIZE_JSON[] PROGMEM = "Unable to de-serialize received json data with error (DeserializationError::%s)";
 #else
 constexpr char UNABLE_TO_SERIALIZE[] = "Unable to serialize key-value json";
 #if !THINGSBOARD_ENABLE_DYNAMIC
@@ -55,29 +61,78 @@ constexpr char TOO_MANY_JSON_FIELDS[] = "Too many JSON fields passed (%u), incre
 constexpr char CONNECT_FAILED[] = "Connecting to server failed";
 constexpr char UNABLE_TO_SERIALIZE_JSON[] = "Unable to serialize json data";
 constexpr char UNABLE_TO_ALLOCATE_MEMORY[] = "Allocating memory for the JsonDocument failed, passed JsonObject or JsonVariant is NULL";
+constexpr char UNABLE_TO_ALLOCATE_BUFFER[] = "Allocating (%u) bytes failed, increase the memory available to the allocator accordingly";
+constexpr char UNABLE_TO_DE_SERIALIZE_JSON[] = "Unable to de-serialize received json data with error (DeserializationError::%s)";
 #endif // THINGSBOARD_ENABLE_PROGMEM
 
+// Shared attribute response keys.
+#if THINGSBOARD_ENABLE_PROGMEM
+constexpr char SHARED_RESPONSE_KEY[] PROGMEM = "shared";
+constexpr char COLON PROGMEM = ':';
+#else
+constexpr char SHARED_RESPONSE_KEY[] = "shared";
+constexpr char COLON = ':';
+#endif // THINGSBOARD_ENABLE_PROGMEM
 
-#if THINGSBOARD_ENABLE_PSRAM
-#include <esp_heap_caps.h>
+#if THINGSBOARD_ENABLE_OTA
 
-struct SpiRamAllocator {
-  void* allocate(size_t size) {
-    return heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
-  }
+// Firmware data keys.
+#if THINGSBOARD_ENABLE_PROGMEM
+constexpr char CURR_FW_TITLE_KEY[] PROGMEM = "current_fw_title";
+constexpr char CURR_FW_VER_KEY[] PROGMEM = "current_fw_version";
+constexpr char FW_ERROR_KEY[] PROGMEM = "fw_error";
+constexpr char FW_STATE_KEY[] PROGMEM = "fw_state";
+constexpr char FW_VER_KEY[] PROGMEM = "fw_version";
+constexpr char FW_TITLE_KEY[] PROGMEM = "fw_title";
+constexpr char FW_CHKS_KEY[] PROGMEM = "fw_checksum";
+constexpr char FW_CHKS_ALGO_KEY[] PROGMEM = "fw_checksum_algorithm";
+constexpr char FW_SIZE_KEY[] PROGMEM = "fw_size";
+constexpr char CHECKSUM_AGORITM_MD5[] PROGMEM = "MD5";
+constexpr char CHECKSUM_AGORITM_SHA256[] PROGMEM = "SHA256";
+constexpr char CHECKSUM_AGORITM_SHA384[] PROGMEM = "SHA384";
+constexpr char CHECKSUM_AGORITM_SHA512[] PROGMEM = "SHA512";
+#else
+constexpr char CURR_FW_TITLE_KEY[] = "current_fw_title";
+constexpr char CURR_FW_VER_KEY[] = "current_fw_version";
+constexpr char FW_ERROR_KEY[] = "fw_error";
+constexpr char FW_STATE_KEY[] = "fw_state";
+constexpr char FW_VER_KEY[] = "fw_version";
+constexpr char FW_TITLE_KEY[] = "fw_title";
+constexpr char FW_CHKS_KEY[] = "fw_checksum";
+constexpr char FW_CHKS_ALGO_KEY[] = "fw_checksum_algorithm";
+constexpr char FW_SIZE_KEY[] = "fw_size";
+constexpr char CHECKSUM_AGORITM_MD5[] = "MD5";
+constexpr char CHECKSUM_AGORITM_SHA256[] = "SHA256";
+constexpr char CHECKSUM_AGORITM_SHA384[] = "SHA384";
+constexpr char CHECKSUM_AGORITM_SHA512[] = "SHA512";
+#endif // THINGSBOARD_ENABLE_PROGMEM
 
-  void deallocate(void* pointer) {
-    heap_caps_free(pointer);
-  }
+// Log messages.
+#if THINGSBOARD_ENABLE_PROGMEM
+constexpr char NO_FW[] PROGMEM = "No new firmware assigned on the given device";
+constexpr char EMPTY_FW[] PROGMEM = "Given firmware was NULL";
+constexpr char FW_UP_TO_DATE[] PROGMEM = "Firmware is already up to date";
+constexpr char FW_NOT_FOR_US[] PROGMEM = "Firmware is not for us (title is different)";
+constexpr char FW_CHKS_ALGO_NOT_SUPPORTED[] PROGMEM = "Checksum algorithm (%s) is not supported";
+constexpr char RESETTING_FAILED[] PROGMEM = "Preparing for OTA firmware updates failed, attributes might be NULL";
+constexpr char NUMBER_PRINTF[] PROGMEM = "%u";
+#else
+constexpr char NO_FW[] = "No new firmware assigned on the given device";
+constexpr char EMPTY_FW[] = "Given firmware was NULL";
+constexpr char FW_UP_TO_DATE[] = "Firmware is already up to date";
+constexpr char FW_NOT_FOR_US[] = "Firmware is not for us (title is different)";
+constexpr char FW_CHKS_ALGO_NOT_SUPPORTED[] = "Checksum algorithm (%s) is not supported";
+constexpr char RESETTING_FAILED[] = "Preparing for OTA firmware updates failed, attributes might be NULL";
+constexpr char NUMBER_PRINTF[] = "%u";
+#endif // THINGSBOARD_ENABLE_PROGMEM
 
-  void* reallocate(void* ptr, size_t new_size) {
-    return heap_caps_realloc(ptr, new_size, MALLOC_CAP_SPIRAM);
-  }
-};
+#endif // THINGSBOARD_ENABLE_OTA
 
-using TBJsonDocument = BasicJsonDocument<SpiRamAllocator>;
-#elif THINGSBOARD_ENABLE_DYNAMIC
-using TBJsonDocument = DynamicJsonDocument;
-#endif
+
+#if THINGSBOARD_ENABLE_PSRAM || THINGSBOARD_ENABLE_DYNAMIC
+// JsonDocument that allocates its memory with the default allocator policy,
+// meaning the memory is placed onto psram if THINGSBOARD_ENABLE_PSRAM is set and onto the sram otherwise
+using TBJsonDocument = BasicJsonDocument<Default_Allocator>;
+#endif // THINGSBOARD_ENABLE_PSRAM || THINGSBOARD_ENABLE_DYNAMIC
 
 #endif // Constants_h
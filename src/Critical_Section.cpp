@@ -0,0 +1,33 @@
+// Header include.
+#include "Critical_Section.h"
+
+Critical_Section::Critical_Section()
+#if THINGSBOARD_USE_FREERTOS_MUTEX
+  : m_mutex_buffer()
+  , m_mutex(xSemaphoreCreateMutexStatic(&m_mutex_buffer))
+#endif // THINGSBOARD_USE_FREERTOS_MUTEX
+{
+    // Nothing to do
+}
+
+void Critical_Section::Enter() {
+#if THINGSBOARD_USE_FREERTOS_MUTEX
+    (void)xSemaphoreTake(m_mutex, portMAX_DELAY);
+#endif // THINGSBOARD_USE_FREERTOS_MUTEX
+}
+
+void Critical_Section::Exit() {
+#if THINGSBOARD_USE_FREERTOS_MUTEX
+    (void)xSemaphoreGive(m_mutex);
+#endif // THINGSBOARD_USE_FREERTOS_MUTEX
+}
+
+Critical_Section_Lock::Critical_Section_Lock(Critical_Section& section) :
+    m_section(section)
+{
+    m_section.Enter();
+}
+
+Critical_Section_Lock::~Critical_Section_Lock() {
+    m_section.Exit();
+}
@@ -0,0 +1,64 @@
+#ifndef Critical_Section_h
+#define Critical_Section_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_USE_FREERTOS_MUTEX
+// Library includes.
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif // THINGSBOARD_USE_FREERTOS_MUTEX
+
+
+/// @brief Guards internal state that is accessed both by the task that calls the loop() method of the ThingsBoard instance
+/// and by the task of an MQTT client that receives messages on its own, like the Espressif_MQTT_Client. Uses a statically allocated FreeRTOS mutex if THINGSBOARD_USE_FREERTOS_MUTEX is enabled,
+/// instead of a portMUX spinlock, because containers that allocate memory are modified while it is held. Without FreeRTOS every MQTT client receives messages from inside of loop(), therefore the class does nothing.
+/// The section is not recursive and may never be held while calling user callbacks or the MQTT client, because the esp mqtt client holds its own lock while it calls the received message callback,
+/// which would otherwise deadlock if the task that calls loop() attempts to publish while holding the section. Instead anything that was found while it was held has to be handled after leaving it
+class Critical_Section {
+  public:
+    /// @brief Constructs the section, is not entered initially
+    Critical_Section();
+
+    /// @brief Copy constructor, deleted because the mutex may not be copied
+    Critical_Section(const Critical_Section&) = delete;
+
+    /// @brief Copy assignment operator, deleted because the mutex may not be copied
+    Critical_Section& operator=(const Critical_Section&) = delete;
+
+    /// @brief Waits until no other task is inside of the section and enters it
+    void Enter();
+
+    /// @brief Leaves the section, has to be called by the same task that entered it
+    void Exit();
+
+  private:
+#if THINGSBOARD_USE_FREERTOS_MUTEX
+    StaticSemaphore_t m_mutex_buffer; // Memory of the mutex, ensures creating it never allocates or fails
+    SemaphoreHandle_t m_mutex;        // Mutex only one task can take at once
+#endif // THINGSBOARD_USE_FREERTOS_MUTEX
+};
+
+
+/// @brief Enters the given critical section for as long as the instance is alive, which ensures the section is left again on every return path
+class Critical_Section_Lock {
+  public:
+    /// @brief Constructor, waits until the given section can be entered
+    /// @param section Section that should be entered, is not copied and therefore has to be kept alive as long as the instance
+    explicit Critical_Section_Lock(Critical_Section& section);
+
+    /// @brief Destructor, leaves the section again
+    ~Critical_Section_Lock();
+
+    /// @brief Copy constructor, deleted because the section would otherwise be left twice
+    Critical_Section_Lock(const Critical_Section_Lock&) = delete;
+
+    /// @brief Copy assignment operator, deleted because the section would otherwise be left twice
+    Critical_Section_Lock& operator=(const Critical_Section_Lock&) = delete;
+
+  private:
+    Critical_Section& m_section; // Section that has been entered
+};
+
+#endif // Critical_Section_h
@@ -0,0 +1,162 @@
+#ifndef Deadband_Filter_h
+#define Deadband_Filter_h
+
+// Local include.
+#include "ITelemetry_Filter.h"
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+
+/// @brief Telemetry filter implementation that keeps the last sent value of each configured key and suppresses sending new values that are still inside of the deadband of that key.
+/// Numeric values are only sent if they differ from the last sent value by more than the deadband, which is the bigger one of the absolute deadband
+/// and the relative deadband multiplied with the absolute last sent value. NaN and infinite values have no distance to other values and are therefore sent whenever they are not the same as the last sent value.
+/// Booleans are sent whenever they toggle, regardless of the deadband. Strings are only sent if they differ from the last sent string, which is compared by its hash.
+/// Additionally each key can have a heartbeat interval, after which the value is sent even if it has not changed, so that the server can still tell a stuck sensor from an offline device.
+/// Keys that have not been added to the filter are never suppressed. The key table is fixed size and the keys are not copied, therefore no memory is ever allocated
+/// @tparam MaxKeys Maximum amount of keys that can be added to the filter
+template <size_t MaxKeys>
+class Deadband_Filter : public ITelemetry_Filter {
+  public:
+    /// @brief Constructs an empty filter, that does not suppress any key-value pair until keys have been added with Add_Key()
+    inline Deadband_Filter() :
+        m_entries(),
+        m_size(0U)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Adds the given key to the filter or changes its deadband if it has already been added
+    /// @param key Key of the key-value pairs that should be filtered, is not copied and therefore has to be kept alive as long as the filter is used
+    /// @param absolute_deadband Absolute amount a numeric value has to change by to be sent again, 0 sends every change
+    /// @param relative_deadband Relative amount a numeric value has to change by to be sent again, in relation to the last sent value, 0.05 means 5%, 0 disables the relative deadband
+    /// @param heartbeat_interval Time in microseconds after which the value is sent even if it has not changed, 0 disables the heartbeat, default = 0
+    /// @return Whether the key could be added or not, fails if the key table is already full
+    inline bool Add_Key(const char *key, const double& absolute_deadband, const double& relative_deadband, const uint64_t& heartbeat_interval = 0U) {
+        if (key == nullptr) {
+            return false;
+        }
+        Entry *entry = Find_Entry(key);
+        if (entry == nullptr) {
+            if (m_size >= MaxKeys) {
+                return false;
+            }
+            entry = &m_entries[m_size++];
+            entry->key = key;
+            entry->sent = false;
+        }
+        entry->absolute_deadband = absolute_deadband;
+        entry->relative_deadband = relative_deadband;
+        entry->heartbeat_interval = heartbeat_interval;
+        return true;
+    }
+
+    /// @brief Forgets the last sent value of every key, meaning the next value of every key is sent regardless of its deadband,
+    /// should be called after the connection to the server has been reestablished to ensure the server has the current values
+    inline void Reset() {
+        for (size_t i = 0U; i < m_size; i++) {
+            m_entries[i].sent = false;
+        }
+    }
+
+    bool Should_Send(const Telemetry& data, const uint64_t& now) const override {
+        const Entry *entry = Find_Entry(data.Get_Key());
+        if (entry == nullptr || !entry->sent) {
+            return true;
+        }
+        else if (entry->heartbeat_interval != 0U && now - entry->last_sent_time >= entry->heartbeat_interval) {
+            return true;
+        }
+
+        double value = 0.0;
+        if (!data.Get_Number(value)) {
+            return Hash_String(data.Get_String()) != entry->last_hash;
+        }
+        // Any deadband of at least 1 would otherwise swallow every toggle of a boolean
+        else if (data.Is_Boolean()) {
+            return value != entry->last_value;
+        }
+        // The difference to or from NaN or infinity is never inside of the deadband, which would otherwise suppress every following value forever
+        else if (!isfinite(value) || !isfinite(entry->last_value)) {
+            return !(value == entry->last_value || (isnan(value) && isnan(entry->last_value)));
+        }
+        const double relative_band = entry->relative_deadband * fabs(entry->last_value);
+        const double band = relative_band > entry->absolute_deadband ? relative_band : entry->absolute_deadband;
+        return fabs(value - entry->last_value) > band;
+    }
+
+    void Mark_Sent(const Telemetry& data, const uint64_t& now) override {
+        Entry *entry = Find_Entry(data.Get_Key());
+        if (entry == nullptr) {
+            return;
+        }
+        double value = 0.0;
+        if (data.Get_Number(value)) {
+            entry->last_value = value;
+        }
+        else {
+            entry->last_hash = Hash_String(data.Get_String());
+        }
+        entry->last_sent_time = now;
+        entry->sent = true;
+    }
+
+  private:
+    /// @brief Configuration and last sent value of a single key
+    struct Entry {
+        const char *key;             // Key of the filtered key-value pairs
+        double absolute_deadband;    // Absolute amount a numeric value has to change by to be sent again
+        double relative_deadband;    // Relative amount a numeric value has to change by to be sent again
+        uint64_t heartbeat_interval; // Time in microseconds after which the value is sent even if it has not changed
+        double last_value;           // Last sent numeric value
+        uint32_t last_hash;          // Hash of the last sent string value
+        uint64_t last_sent_time;     // Time in microseconds the last value has been sent at
+        bool sent;                   // Whether any value has been sent yet
+    };
+
+    /// @brief Gets the entry of the given key
+    /// @param key Key of the key-value pair
+    /// @return Entry of the given key or nullptr if the key has not been added to the filter
+    inline const Entry* Find_Entry(const char *key) const {
+        if (key == nullptr) {
+            return nullptr;
+        }
+        for (size_t i = 0U; i < m_size; i++) {
+            // Most callers pass the same constant as key that was used to add it, therefore compare the pointer first to skip the string comparison
+            if (m_entries[i].key == key || strcmp(m_entries[i].key, key) == 0) {
+                return &m_entries[i];
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief Gets the entry of the given key
+    /// @param key Key of the key-value pair
+    /// @return Entry of the given key or nullptr if the key has not been added to the filter
+    inline Entry* Find_Entry(const char *key) {
+        return const_cast<Entry*>(static_cast<const Deadband_Filter*>(this)->Find_Entry(key));
+    }
+
+    /// @brief Calculates the 32-bit FNV-1a hash of the given string, which allows to detect if a string changed without having to copy it
+    /// @param text String that should be hashed, nullptr is hashed like an empty string
+    /// @return Hash of the given string
+    static inline uint32_t Hash_String(const char *text) {
+        uint32_t hash = 2166136261U;
+        if (text == nullptr) {
+            return hash;
+        }
+        for (; *text != '\0'; text++) {
+            hash ^= static_cast<uint8_t>(*text);
+            hash *= 16777619U;
+        }
+        return hash;
+    }
+
+    Entry m_entries[MaxKeys]; // Configuration and last sent value of each added key
+    size_t m_size;            // Amount of keys that have been added
+};
+
+#endif // Deadband_Filter_h
@@ -0,0 +1,287 @@
+#ifndef Delta_Updater_h
+#define Delta_Updater_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_ENABLE_OTA
+
+// Local includes.
+#include "IUpdater.h"
+#include "IPatch_Source.h"
+#include "HashGenerator.h"
+
+// Library includes.
+#include <string.h>
+
+
+// Magic the patch received by the Delta_Updater has to start with, to ensure it was created for that format.
+constexpr char DELTA_PATCH_MAGIC[] = "TBDIFF10";
+constexpr size_t DELTA_PATCH_MAGIC_SIZE = sizeof(DELTA_PATCH_MAGIC) - 1U;
+
+/// @brief IUpdater decorator that applies the received binary data as a patch to the currently installed image, read from the given IPatch_Source,
+/// and passes the reconstructed image to the given updater, which allows to only download the difference between the installed and the new image.
+/// The patch is applied while it is received and only needs a buffer of BufferSize bytes, independent of the image or patch size.
+/// The patch uses the control, diff and extra blocks known from bsdiff, but interleaves them and leaves them uncompressed, so that it can be streamed.
+/// It starts with the magic "TBDIFF10" and the size of the reconstructed image as a 32-bit little endian integer, followed by any amount of records.
+/// Each record consists of the diff length, the extra length and the seek offset, as 32-bit little endian integers, with only the seek offset being signed.
+/// They are followed by diff length bytes, which are added to the same amount of bytes read from the installed image, and extra length bytes, which are copied as is.
+/// Afterwards the read position in the installed image is moved by the seek offset. The patch can be compressed by additionally wrapping this decorator in a Heatshrink_Updater.
+/// The checksum set on the server is calculated from the patch and therefore checked by the update process as usual,
+/// additionally the checksum of the reconstructed image can be checked in end() by setting it with Set_Target_Checksum()
+/// @tparam BufferSize Size of the buffer the bytes read from the installed image are patched in before they are written with the given updater, default = 256
+template <size_t BufferSize = 256U>
+class Delta_Updater : public IUpdater {
+  static_assert(BufferSize > 0U, "Patch buffer can not be empty");
+
+  public:
+    /// @brief Constructor
+    /// @param source Patch source implementation the currently installed image is read with, is not copied and therefore has to be kept alive as long as the decorator is used
+    /// @param updater Updater implementation the reconstructed image is written with, is not copied and therefore has to be kept alive as long as the decorator is used
+    inline Delta_Updater(IPatch_Source& source, IUpdater& updater) :
+        m_source(source),
+        m_updater(updater),
+        m_checksum(),
+        m_checksum_size(0U),
+        m_checksum_algorithm(),
+        m_hash(),
+        m_buffer(),
+        m_record(),
+        m_record_size(0U),
+        m_state(Patch_State::HEADER),
+        m_diff_remaining(0U),
+        m_extra_remaining(0U),
+        m_seek(0),
+        m_source_offset(0U),
+        m_patch_size(0U),
+        m_received(0U),
+        m_target_size(0U),
+        m_produced(0U)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Sets the checksum the reconstructed image is checked against in end(), in addition to the checksum of the patch that is checked by the update process itself.
+    /// Has to be called before the update is started, passing nullptr disables the check again
+    /// @param checksum_algorithm Algorithm used to calculate the checksum
+    /// @param checksum Expected checksum of the reconstructed image, as a hex string, is decoded once and compared in its binary form
+    /// @return Whether the given checksum is a valid hex string or nullptr, if it is not the check is disabled
+    inline bool Set_Target_Checksum(const mbedtls_md_type_t& checksum_algorithm, const char *checksum) {
+        m_checksum_algorithm = checksum_algorithm;
+        m_checksum_size = HashGenerator::decode_hex(checksum, m_checksum, sizeof(m_checksum));
+        return checksum == nullptr || m_checksum_size != 0U;
+    }
+
+    bool begin(const size_t& data_size) override {
+        Reset_Patch();
+        m_patch_size = data_size;
+        return true;
+    }
+
+    size_t write(uint8_t* payload, const size_t& total_bytes) override {
+        size_t offset = 0U;
+        while (offset < total_bytes) {
+            const size_t remaining = total_bytes - offset;
+            size_t handled_bytes = 0U;
+
+            switch (m_state) {
+                case Patch_State::HEADER:
+                case Patch_State::CONTROL:
+                    handled_bytes = Append_To_Record(payload + offset, remaining);
+                    if (m_record_size == RECORD_SIZE && !Parse_Record()) {
+                        return offset;
+                    }
+                    break;
+                case Patch_State::DIFF:
+                    handled_bytes = Apply_Diff(payload + offset, remaining);
+                    break;
+                case Patch_State::EXTRA:
+                    handled_bytes = Copy_Extra(payload + offset, remaining);
+                    break;
+            }
+
+            if (handled_bytes == 0U) {
+                return offset;
+            }
+            offset += handled_bytes;
+            m_received += handled_bytes;
+            Advance_State();
+        }
+        return total_bytes;
+    }
+
+    bool supports_read() const override {
+        // The patched data written with the given updater differs in size and content from the received data the server calculated the checksum from,
+        // therefore reading it back can never result in the expected checksum and OTA_Hash_Mode::WRITTEN_DATA has to be rejected when the update is started
+        return false;
+    }
+
+    void reset() override {
+        Reset_Patch();
+        m_updater.reset();
+    }
+
+    bool end() override {
+        // The patch has to end after a complete record, without any missing diff or extra bytes
+        if (m_state != Patch_State::CONTROL || m_record_size != 0U || m_received != m_patch_size || m_produced != m_target_size) {
+            return false;
+        }
+        if (m_checksum_size != 0U && !m_hash.compare_hash(m_checksum, m_checksum_size)) {
+            return false;
+        }
+        return m_updater.end();
+    }
+
+  private:
+    /// @brief Part of the patch that is currently being received
+    enum class Patch_State : const uint8_t {
+        HEADER,  // Magic and size of the reconstructed image
+        CONTROL, // Diff length, extra length and seek offset of the next record
+        DIFF,    // Bytes that are added to the bytes read from the installed image
+        EXTRA    // Bytes that are copied as is
+    };
+
+    static constexpr size_t RECORD_SIZE = DELTA_PATCH_MAGIC_SIZE + 4U; // Size of the header and of the control part of each record
+
+    /// @brief Copies as many of the given bytes into the header or control record as still fit into it
+    /// @param payload Data that should be buffered
+    /// @param total_bytes Amount of bytes in the given data
+    /// @return Amount of bytes that have been copied into the record
+    inline size_t Append_To_Record(const uint8_t *payload, const size_t& total_bytes) {
+        const size_t missing = RECORD_SIZE - m_record_size;
+        const size_t copied_bytes = total_bytes < missing ? total_bytes : missing;
+        memcpy(m_record + m_record_size, payload, copied_bytes);
+        m_record_size += copied_bytes;
+        return copied_bytes;
+    }
+
+    /// @brief Parses the completely received header or control record and initalizes the underlying updater once the header has been received
+    /// @return Whether the record is valid and initalizing the underlying updater was successful or not
+    inline bool Parse_Record() {
+        m_record_size = 0U;
+        if (m_state == Patch_State::HEADER) {
+            if (memcmp(m_record, DELTA_PATCH_MAGIC, DELTA_PATCH_MAGIC_SIZE) != 0) {
+                return false;
+            }
+            m_target_size = Read_Integer(DELTA_PATCH_MAGIC_SIZE);
+            m_state = Patch_State::CONTROL;
+            if (m_checksum_size != 0U) {
+                m_hash.start(m_checksum_algorithm);
+            }
+            return m_updater.begin(m_target_size);
+        }
+
+        m_diff_remaining = Read_Integer(0U);
+        m_extra_remaining = Read_Integer(4U);
+        m_seek = static_cast<int32_t>(Read_Integer(8U));
+        if (m_diff_remaining > m_target_size - m_produced || m_extra_remaining > m_target_size - m_produced - m_diff_remaining) {
+            return false;
+        }
+        m_state = Patch_State::DIFF;
+        return true;
+    }
+
+    /// @brief Reads a 32-bit little endian integer from the received header or control record
+    /// @param offset Offset of the integer in the record
+    /// @return Read integer
+    inline uint32_t Read_Integer(const size_t& offset) const {
+        return static_cast<uint32_t>(m_record[offset]) | (static_cast<uint32_t>(m_record[offset + 1U]) << 8U) |
+            (static_cast<uint32_t>(m_record[offset + 2U]) << 16U) | (static_cast<uint32_t>(m_record[offset + 3U]) << 24U);
+    }
+
+    /// @brief Adds as many of the given diff bytes as fit into the buffer to the bytes read from the installed image and writes the result
+    /// @param payload Diff bytes of the current record
+    /// @param total_bytes Amount of bytes in the given data
+    /// @return Amount of diff bytes that have been applied, 0 if reading the installed image or writing the result failed
+    inline size_t Apply_Diff(const uint8_t *payload, const size_t& total_bytes) {
+        size_t applied_bytes = total_bytes < m_diff_remaining ? total_bytes : m_diff_remaining;
+        applied_bytes = applied_bytes < BufferSize ? applied_bytes : BufferSize;
+        if (m_source.read(m_source_offset, m_buffer, applied_bytes) != applied_bytes) {
+            return 0U;
+        }
+        for (size_t i = 0U; i < applied_bytes; i++) {
+            m_buffer[i] += payload[i];
+        }
+        if (!Write_Output(m_buffer, applied_bytes)) {
+            return 0U;
+        }
+        m_source_offset += applied_bytes;
+        m_diff_remaining -= applied_bytes;
+        return applied_bytes;
+    }
+
+    /// @brief Writes as many of the given extra bytes as belong to the current record, without copying them
+    /// @param payload Extra bytes of the current record
+    /// @param total_bytes Amount of bytes in the given data
+    /// @return Amount of extra bytes that have been written, 0 if writing them failed
+    inline size_t Copy_Extra(uint8_t *payload, const size_t& total_bytes) {
+        const size_t copied_bytes = total_bytes < m_extra_remaining ? total_bytes : m_extra_remaining;
+        if (!Write_Output(payload, copied_bytes)) {
+            return 0U;
+        }
+        m_extra_remaining -= copied_bytes;
+        return copied_bytes;
+    }
+
+    /// @brief Moves on to the next part of the patch, once the diff or extra bytes of the current record have been completely handled.
+    /// Applies the seek offset once the record has been completely handled
+    inline void Advance_State() {
+        if (m_state == Patch_State::DIFF && m_diff_remaining == 0U) {
+            m_state = Patch_State::EXTRA;
+        }
+        if (m_state == Patch_State::EXTRA && m_extra_remaining == 0U) {
+            // An invalid seek offset does not need to be checked here, because reading the installed image at that offset fails
+            m_source_offset += m_seek;
+            m_state = Patch_State::CONTROL;
+        }
+    }
+
+    /// @brief Writes the given part of the reconstructed image with the underlying updater
+    /// @param data Part of the reconstructed image
+    /// @param total_bytes Amount of bytes in the given data
+    /// @return Whether the given data has been written successfully or not
+    inline bool Write_Output(uint8_t *data, const size_t& total_bytes) {
+        if (m_checksum_size != 0U && !m_hash.update(data, total_bytes)) {
+            return false;
+        }
+        m_produced += total_bytes;
+        return m_updater.write(data, total_bytes) == total_bytes;
+    }
+
+    /// @brief Resets the patch application to the initial state, without informing the underlying updater
+    inline void Reset_Patch() {
+        m_record_size = 0U;
+        m_state = Patch_State::HEADER;
+        m_diff_remaining = 0U;
+        m_extra_remaining = 0U;
+        m_seek = 0;
+        m_source_offset = 0U;
+        m_patch_size = 0U;
+        m_received = 0U;
+        m_target_size = 0U;
+        m_produced = 0U;
+    }
+
+    IPatch_Source& m_source;                 // Patch source implementation the currently installed image is read with
+    IUpdater& m_updater;                     // Updater implementation the reconstructed image is written with
+    uint8_t m_checksum[MBEDTLS_MD_MAX_SIZE]; // Binary form of the expected checksum of the reconstructed image
+    size_t m_checksum_size;                  // Size of the expected checksum in bytes, 0 if it should not be checked
+    mbedtls_md_type_t m_checksum_algorithm;  // Algorithm used to calculate the checksum of the reconstructed image
+    HashGenerator m_hash;                    // Class instance that generates the checksum of the reconstructed image
+    uint8_t m_buffer[BufferSize];            // Bytes read from the installed image, that the diff bytes are added to
+    uint8_t m_record[RECORD_SIZE];           // Header or control record, while it is still being received
+    size_t m_record_size;                    // Amount of bytes of the header or control record that have been received
+    Patch_State m_state;                     // Part of the patch that is currently being received
+    size_t m_diff_remaining;                 // Amount of diff bytes of the current record that have not been received yet
+    size_t m_extra_remaining;                // Amount of extra bytes of the current record that have not been received yet
+    int32_t m_seek;                          // Offset the read position in the installed image is moved by, once the current record has been handled
+    size_t m_source_offset;                  // Position in the installed image the next diff bytes are applied to
+    size_t m_patch_size;                     // Total size of the received patch
+    size_t m_received;                       // Amount of bytes of the patch that have been received
+    size_t m_target_size;                    // Total size of the reconstructed image
+    size_t m_produced;                       // Amount of bytes of the reconstructed image that have been written
+};
+
+#endif // THINGSBOARD_ENABLE_OTA
+
+#endif // Delta_Updater_h
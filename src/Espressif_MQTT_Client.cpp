@@ -9,20 +9,20 @@
 // to ensure other errors are indentified as well
 constexpr int MQTT_FAILURE_MESSAGE_ID = -1;
 
-Espressif_MQTT_Client *Espressif_MQTT_Client::m_instance = nullptr;
-
 Espressif_MQTT_Client::Espressif_MQTT_Client() :
     m_received_data_callback(nullptr),
+#if !THINGSBOARD_ENABLE_STL
+    m_received_data_context(nullptr),
+#endif // !THINGSBOARD_ENABLE_STL
     m_connected(false),
     m_enqueue_messages(false),
     m_mqtt_configuration(),
     m_mqtt_client(nullptr)
 {
-    m_instance = this;
+    // Nothing to do
 }
 
 Espressif_MQTT_Client::~Espressif_MQTT_Client() {
-    m_instance = nullptr;
     (void)esp_mqtt_client_destroy(m_mqtt_client);
 }
 
@@ -104,9 +104,16 @@ void Espressif_MQTT_Client::set_enqueue_messages(const bool& enqueue_messages) {
     m_enqueue_messages = enqueue_messages;
 }
 
+#if THINGSBOARD_ENABLE_STL
 void Espressif_MQTT_Client::set_callback(function callback) {
     m_received_data_callback = callback;
 }
+#else
+void Espressif_MQTT_Client::set_callback(function callback, void *context) {
+    m_received_data_callback = callback;
+    m_received_data_context = context;
+}
+#endif // THINGSBOARD_ENABLE_STL
 
 bool Espressif_MQTT_Client::set_buffer_size(const uint16_t& buffer_size) {
     // ESP_IDF_VERSION_MAJOR Version 5 is a major breaking changes were the complete esp_mqtt_client_config_t structure changed completely
@@ -186,9 +193,9 @@ bool Espressif_MQTT_Client::connect(const char *client_id, const char *user_name
     // additionally before we attempt to connect with the client we have to ensure it is configued by then.
     m_mqtt_client = esp_mqtt_client_init(&m_mqtt_configuration);
 
-    // The last argument may be used to pass data to the event handler, here that would be the static_mqtt_event_handler. But for our use case this is not needed,
-    // because the static_mqtt_event_handler calls a private method on this class again anyway, meaning we already have access to all private member variables that are required
-    esp_err_t error = esp_mqtt_client_register_event(m_mqtt_client, esp_mqtt_event_id_t::MQTT_EVENT_ANY, Espressif_MQTT_Client::static_mqtt_event_handler, nullptr);
+    // The last argument is passed to the static_mqtt_event_handler, we pass the instance itself so the event is forwarded to the client that registered it,
+    // which allows to use multiple clients at the same time, each connected to a different broker
+    esp_err_t error = esp_mqtt_client_register_event(m_mqtt_client, esp_mqtt_event_id_t::MQTT_EVENT_ANY, Espressif_MQTT_Client::static_mqtt_event_handler, this);
 
     if (error != ESP_OK) {
         return false;
@@ -278,10 +285,16 @@ void Espressif_MQTT_Client::mqtt_event_handler(void *handler_args, esp_event_bas
             }
 
             if (m_received_data_callback != nullptr) {
-                char topic[event->topic_len]; //edited by DD
+                // The topic received from esp-mqtt is not null-terminated, therefore it has to be copied first
+                char topic[event->topic_len + 1U]; //edited by DD
                 memcpy(topic, event->topic, event->topic_len); //edited by DD
-                
+                topic[event->topic_len] = '\0';
+
+#if THINGSBOARD_ENABLE_STL
                 m_received_data_callback(topic/*event->topic*/, reinterpret_cast<uint8_t*>(event->data), event->data_len); // edited by DD
+#else
+                m_received_data_callback(m_received_data_context, topic, reinterpret_cast<uint8_t*>(event->data), event->data_len);
+#endif // THINGSBOARD_ENABLE_STL
             }
             break;
         case esp_mqtt_event_id_t::MQTT_EVENT_ERROR:
@@ -297,11 +310,12 @@ void Espressif_MQTT_Client::mqtt_event_handler(void *handler_args, esp_event_bas
 }
 
 void Espressif_MQTT_Client::static_mqtt_event_handler(void *handler_args, esp_event_base_t base, int32_t event_id, void *event_data) {
-    if (m_instance == nullptr) {
+    if (handler_args == nullptr) {
         return;
     }
 
-    m_instance->mqtt_event_handler(handler_args, base, static_cast<esp_mqtt_event_id_t>(event_id), event_data);
+    Espressif_MQTT_Client *instance = static_cast<Espressif_MQTT_Client *>(handler_args);
+    instance->mqtt_event_handler(handler_args, base, static_cast<esp_mqtt_event_id_t>(event_id), event_data);
 }
 
 #endif // THINGSBOARD_USE_ESP_MQTT
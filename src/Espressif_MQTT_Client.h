@@ -87,7 +87,11 @@ class Espressif_MQTT_Client : public IMQTT_Client {
     /// @param enqueue_messages Whether to enqueue published messages or not, where setting the value to true means that the messages are enqueued and therefor non blocking on the called from task
     void set_enqueue_messages(const bool& enqueue_messages);
 
+#if THINGSBOARD_ENABLE_STL
     void set_callback(function callback) override;
+#else
+    void set_callback(function callback, void *context) override;
+#endif // THINGSBOARD_ENABLE_STL
 
     bool set_buffer_size(const uint16_t& buffer_size) override;
 
@@ -111,13 +115,14 @@ class Espressif_MQTT_Client : public IMQTT_Client {
 
 private:
     function m_received_data_callback;             // Callback that will be called as soon as the mqtt client receives any data
+#if !THINGSBOARD_ENABLE_STL
+    void *m_received_data_context;                 // Context passed as the first argument to the received data callback
+#endif // !THINGSBOARD_ENABLE_STL
     bool m_connected;                              // Whether the client has received the connected or disconnected event
     bool m_enqueue_messages;                       // Whether we enqueue messages making nearly all ThingsBoard calls non blocking or wheter we publish instead
     esp_mqtt_client_config_t m_mqtt_configuration; // Configuration of the underlying mqtt client, saved as a private variable to allow changes after inital configuration with the same options for all non changed settings
     esp_mqtt_client_handle_t m_mqtt_client;        // Handle to the underlying mqtt client, used to establish the communication
 
-    static Espressif_MQTT_Client *m_instance;      // Instance to the created class, will be set once the constructor has been called and reset once the destructor has been called, used to call private member method from static callback
-
     /// @brief Is internally used to allow changes to the underlying configuration of the esp_mqtt_client_handle_t after it has connected,
     /// to for example increase the buffer size or increase the timeouts or stack size, allows to change the underlying client configuration,
     /// without the need to completly disconnect and reconnect the client
@@ -55,6 +55,20 @@ void Espressif_Updater::reset() {
     (void)esp_ota_abort(m_ota_handle);
 }
 
+bool Espressif_Updater::supports_read() const {
+    return true;
+}
+
+size_t Espressif_Updater::read(const size_t& offset, uint8_t* buffer, const size_t& total_bytes) {
+    // With flash encryption enabled the OTA API only writes whole 16 byte blocks, meaning the last few bytes are only written in end() and can not be read back before that
+    const esp_partition_t *update_partition = static_cast<const esp_partition_t*>(m_update_partition);
+    if (update_partition == nullptr || offset > update_partition->size || total_bytes > update_partition->size - offset) {
+        return 0U;
+    }
+    const esp_err_t error = esp_partition_read(update_partition, offset, buffer, total_bytes);
+    return (error == ESP_OK) ? total_bytes : 0U;
+}
+
 bool Espressif_Updater::end() {
     esp_err_t error = esp_ota_end(m_ota_handle);
     if (error != ESP_OK) {
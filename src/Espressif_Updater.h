@@ -23,6 +23,10 @@ class Espressif_Updater : public IUpdater {
     size_t write(uint8_t* payload, const size_t& total_bytes) override;
 
     void reset() override;
+
+    bool supports_read() const override;
+
+    size_t read(const size_t& offset, uint8_t* buffer, const size_t& total_bytes) override;
   
     bool end() override;
 
@@ -0,0 +1,79 @@
+// Header include.
+#include "File_Updater.h"
+
+#if THINGSBOARD_ENABLE_OTA
+
+File_Updater::File_Updater(const char *path) :
+    m_path(path),
+    m_file(nullptr),
+    m_size(0U),
+    m_written(0U)
+{
+    // Nothing to do
+}
+
+File_Updater::~File_Updater() {
+    reset();
+}
+
+bool File_Updater::begin(const size_t& file_size) {
+    reset();
+    if (m_path == nullptr) {
+        return false;
+    }
+
+    // Opened for reading as well, which allows to read the written data back before the file is closed
+    m_file = fopen(m_path, "w+b");
+    if (m_file == nullptr) {
+        return false;
+    }
+    m_size = file_size;
+    return true;
+}
+
+size_t File_Updater::write(uint8_t* payload, const size_t& total_bytes) {
+    if (m_file == nullptr) {
+        return 0U;
+    }
+    const size_t written_bytes = fwrite(payload, 1U, total_bytes, m_file);
+    m_written += written_bytes;
+    return written_bytes;
+}
+
+void File_Updater::reset() {
+    if (m_file != nullptr) {
+        (void)fclose(m_file);
+        m_file = nullptr;
+    }
+    m_size = 0U;
+    m_written = 0U;
+}
+
+bool File_Updater::supports_read() const {
+    return true;
+}
+
+size_t File_Updater::read(const size_t& offset, uint8_t* buffer, const size_t& total_bytes) {
+    if (m_file == nullptr || offset > m_written || total_bytes > m_written - offset) {
+        return 0U;
+    }
+    // Switching from writing to reading requires a seek, afterwards the position is restored to the end, so further writes append again
+    if (fseek(m_file, static_cast<long>(offset), SEEK_SET) != 0) {
+        return 0U;
+    }
+    const size_t read_bytes = fread(buffer, 1U, total_bytes, m_file);
+    (void)fseek(m_file, 0L, SEEK_END);
+    return read_bytes;
+}
+
+bool File_Updater::end() {
+    if (m_file == nullptr) {
+        return false;
+    }
+    // Closing flushes the remaining buffered data, which can still fail if the file system is full
+    const bool closed = fclose(m_file) == 0;
+    m_file = nullptr;
+    return closed && m_written == m_size;
+}
+
+#endif // THINGSBOARD_ENABLE_OTA
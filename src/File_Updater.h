@@ -0,0 +1,50 @@
+#ifndef File_Updater_h
+#define File_Updater_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_ENABLE_OTA
+
+// Local include.
+#include "IUpdater.h"
+
+// Library include.
+#include <stdio.h>
+
+
+/// @brief IUpdater implementation that writes the given binary data into a file at the given path, works with any file system that is accessible over the C standard library,
+/// for example a SPIFFS or LittleFS partition mounted into the virtual file system on Espressif IDF or the normal file system on Linux.
+/// Mounting the file system is not done by this class and has to be done before the update is started
+class File_Updater : public IUpdater {
+  public:
+    /// @brief Constructor
+    /// @param path Path of the file the received binary data is written into, the file is overwritten if it already exists.
+    /// Is not copied and therefore has to be kept alive as long as the updater is used
+    File_Updater(const char *path);
+
+    /// @brief Destructor, closes the file if an update is still running
+    ~File_Updater();
+
+    bool begin(const size_t& file_size) override;
+  
+    size_t write(uint8_t* payload, const size_t& total_bytes) override;
+
+    void reset() override;
+
+    bool supports_read() const override;
+
+    size_t read(const size_t& offset, uint8_t* buffer, const size_t& total_bytes) override;
+  
+    bool end() override;
+
+  private:
+    const char *m_path;      // Path of the file the received binary data is written into
+    FILE       *m_file;      // Currently opened file, nullptr if no update is running
+    size_t     m_size;       // Total size of the data that should be written
+    size_t     m_written;    // Amount of bytes that have already been written
+};
+
+#endif // THINGSBOARD_ENABLE_OTA
+
+#endif // File_Updater_h
@@ -0,0 +1,86 @@
+#ifndef HTTP_Response_Reader_h
+#define HTTP_Response_Reader_h
+
+// Local include.
+#include "IHTTP_Client.h"
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+
+/// @brief Reader that allows to deserialize the response body of a previously sent request directly from the IHTTP_Client,
+/// by implementing the read() and readBytes() methods ArduinoJson expects from a custom reader (https://arduinojson.org/v6/api/json/deserializejson/#custom-reader).
+/// The body is read into a small internal buffer in multiple parts, meaning arbitrarily large responses can be deserialized without ever holding the complete body in memory
+/// @tparam BufferSize Amount of bytes read from the client at once, bigger values need more stack but call the client less often, default = 64
+template <size_t BufferSize = 64U>
+class HTTP_Response_Reader {
+  public:
+    /// @brief Constructor
+    /// @param client Client the response body is read from, has to have received a successful response already
+    inline HTTP_Response_Reader(IHTTP_Client& client) :
+        m_client(client),
+        m_buffer(),
+        m_position(0U),
+        m_length(0U),
+        m_error(0)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Reads a single byte of the response body
+    /// @return The read byte or -1 if the complete body has been read or reading failed
+    inline int read() {
+        if (m_position == m_length && !fill()) {
+            return -1;
+        }
+        return m_buffer[m_position++];
+    }
+
+    /// @brief Reads multiple bytes of the response body into the given buffer
+    /// @param buffer Buffer the bytes should be copied into
+    /// @param length Maximum amount of bytes that should be read
+    /// @return Amount of bytes copied into the buffer, smaller than the given length if the complete body has been read or reading failed
+    inline size_t readBytes(char *buffer, size_t length) {
+        size_t copied = 0U;
+        while (copied < length && (m_position != m_length || fill())) {
+            const size_t available = m_length - m_position;
+            const size_t count = available < (length - copied) ? available : (length - copied);
+            memcpy(buffer + copied, m_buffer + m_position, count);
+            m_position += count;
+            copied += count;
+        }
+        return copied;
+    }
+
+    /// @brief Gets the internal error code returned by the client, if reading the response body failed
+    /// @return Negative internal error code of the client or 0 if no error occured
+    inline const int& Get_Error() const {
+        return m_error;
+    }
+
+  private:
+    /// @brief Reads the next part of the response body into the internal buffer
+    /// @return Whether atleast one byte has been read or not
+    inline bool fill() {
+        if (m_error != 0) {
+            return false;
+        }
+        const int read = m_client.read_response_body(m_buffer, BufferSize);
+        if (read < 0) {
+            m_error = read;
+        }
+        m_position = 0U;
+        m_length = read > 0 ? read : 0U;
+        return m_length != 0U;
+    }
+
+    IHTTP_Client& m_client;       // Client the response body is read from
+    uint8_t m_buffer[BufferSize]; // Part of the response body that has been read from the client, but not by the caller yet
+    size_t m_position;            // Index of the next byte in the buffer that has not been read by the caller yet
+    size_t m_length;              // Amount of bytes in the buffer that have been read from the client
+    int m_error;                  // Internal error code returned by the client, if reading the response body failed
+};
+
+#endif // HTTP_Response_Reader_h
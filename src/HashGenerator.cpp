@@ -3,9 +3,21 @@
 
 #if THINGSBOARD_ENABLE_OTA
 
-// Library includes.
-#include <sstream>
-#include <iomanip>
+// Library include.
+#include <string.h>
+
+// Digits used to encode a byte into two hex characters.
+constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+/// @brief Decodes a single hex digit into its value
+/// @param digit Hex digit, with either lowercase or uppercase letters
+/// @return Value of the given hex digit, -1 if the given character is not a hex digit
+constexpr int8_t Hex_Digit_Value(const char& digit) {
+    return (digit >= '0' && digit <= '9') ? static_cast<int8_t>(digit - '0')
+        : (digit >= 'a' && digit <= 'f') ? static_cast<int8_t>(digit - 'a' + 10)
+        : (digit >= 'A' && digit <= 'F') ? static_cast<int8_t>(digit - 'A' + 10)
+        : static_cast<int8_t>(-1);
+}
 
 HashGenerator::HashGenerator() :
     m_ctx()
@@ -39,25 +51,49 @@ bool HashGenerator::update(const uint8_t* data, const size_t& len) {
     return mbedtls_md_update(&m_ctx, data, len) == 0;
 }
 
-std::string HashGenerator::get_hash_string() {
-    // Calculate the current hash value
-    uint8_t hash[MBEDTLS_MD_MAX_SIZE];
-    finish(hash);
-
-    // Convert the hash value to a string
-    std::stringstream ss;
+size_t HashGenerator::get_hash(uint8_t *hash) {
+    if (mbedtls_md_finish(&m_ctx, hash) != 0) {
+        return 0U;
+    }
     // MBEDTLS Version 3 is a major breaking changes were accessing the internal structures requires the MBEDTLS_PRIVATE macro
 #if MBEDTLS_VERSION_MAJOR < 3
-    for (size_t i = 0; i < mbedtls_md_get_size(m_ctx.md_info); i++)
+    return mbedtls_md_get_size(m_ctx.md_info);
 #else
-    for (size_t i = 0; i < mbedtls_md_get_size(m_ctx.MBEDTLS_PRIVATE(md_info)); i++)
+    return mbedtls_md_get_size(m_ctx.MBEDTLS_PRIVATE(md_info));
 #endif
-        ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(hash[i]);
-    return ss.str();
 }
 
-void HashGenerator::finish(unsigned char *hash) {
-    mbedtls_md_finish(&m_ctx, hash);
+bool HashGenerator::compare_hash(const uint8_t *expected, const size_t& expected_size) {
+    uint8_t hash[MBEDTLS_MD_MAX_SIZE];
+    const size_t hash_size = get_hash(hash);
+    return hash_size != 0U && hash_size == expected_size && memcmp(hash, expected, hash_size) == 0;
+}
+
+size_t HashGenerator::decode_hex(const char *hex, uint8_t *bytes, const size_t& capacity) {
+    if (hex == nullptr) {
+        return 0U;
+    }
+    const size_t length = strlen(hex);
+    if (length % 2U != 0U || length / 2U > capacity) {
+        return 0U;
+    }
+    for (size_t i = 0U; i < length / 2U; i++) {
+        const int8_t high = Hex_Digit_Value(hex[i * 2U]);
+        const int8_t low = Hex_Digit_Value(hex[(i * 2U) + 1U]);
+        if (high < 0 || low < 0) {
+            return 0U;
+        }
+        bytes[i] = static_cast<uint8_t>((high << 4U) | low);
+    }
+    return length / 2U;
+}
+
+void HashGenerator::encode_hex(const uint8_t *bytes, const size_t& size, char *hex) {
+    for (size_t i = 0U; i < size; i++) {
+        hex[i * 2U] = HEX_DIGITS[bytes[i] >> 4U];
+        hex[(i * 2U) + 1U] = HEX_DIGITS[bytes[i] & 0x0FU];
+    }
+    hex[size * 2U] = '\0';
 }
 
 #endif // THINGSBOARD_ENABLE_OTA
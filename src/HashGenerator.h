@@ -12,7 +12,8 @@
 #else
 #include <Seeed_mbedtls.h>
 #endif // THINGSBOARD_USE_MBED_TLS
-#include <string>
+#include <stddef.h>
+#include <stdint.h>
 
 
 /// @brief Wrapper class which allows generating a hash of the given type from any arbitrary byte payload, which is hashable in chunks.
@@ -21,7 +22,8 @@
 /// The ESP Mbed TLS implementationt works with both Espressif IDF v4.X and v5.X, meaning it is version idependent, this is the case
 /// because depending on the used version the implementation automatically adjusts to still initalize correctly.
 /// The class instance is meant to be started with start() which will then create the configuration for a hash of the given type
-/// and we then expect the complete binary payload to be called in multiple calls to update() and the final result to be read with get_hash_string()
+/// and we then expect the complete binary payload to be called in multiple calls to update() and the final result to be read with get_hash() or compared with compare_hash().
+/// The hash is compared in its binary form, therefore an expected hex checksum has to be decoded once with decode_hex() beforehand, which avoids any string formatting or heap allocations
 /// Documentation about the specific use and caviates of the ESP Mbedt TLS implementation can be found here https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/protocols/mbedtls.html
 class HashGenerator {
   public:
@@ -41,16 +43,32 @@ class HashGenerator {
     /// @return Whether updating the hash for the given bytes was successful or not
     bool update(const uint8_t* data, const size_t& len);
 
-    /// @brief Returns the final hash value as a string
-    /// @return String containing the final hash value for the passed bytes
-    std::string get_hash_string();
+    /// @brief Calculates the final hash value
+    /// @param hash Output byte array that the hash value will be copied into, has to be at least MBEDTLS_MD_MAX_SIZE bytes big
+    /// @return Size of the hash value in bytes, 0 if calculating it failed
+    size_t get_hash(uint8_t *hash);
+
+    /// @brief Calculates the final hash value and compares it with the given expected hash value
+    /// @param expected Expected hash value in its binary form, see decode_hex() to convert a hex checksum
+    /// @param expected_size Size of the expected hash value in bytes
+    /// @return Whether the calculated hash value is the same as the expected one or not
+    bool compare_hash(const uint8_t *expected, const size_t& expected_size);
+
+    /// @brief Decodes the given hex string, with either lowercase or uppercase digits, into its binary form
+    /// @param hex Null-terminated hex string that should be decoded
+    /// @param bytes Output byte array that the decoded bytes will be copied into
+    /// @param capacity Size of the output byte array in bytes
+    /// @return Amount of decoded bytes, 0 if the given string has an odd length, contains characters that are not hex digits or does not fit into the output byte array
+    static size_t decode_hex(const char *hex, uint8_t *bytes, const size_t& capacity);
+
+    /// @brief Encodes the given bytes into a lowercase hex string, used to display a hash value
+    /// @param bytes Bytes that should be encoded
+    /// @param size Amount of bytes that should be encoded
+    /// @param hex Output string that the null-terminated hex string will be copied into, has to be at least (size * 2) + 1 characters big
+    static void encode_hex(const uint8_t *bytes, const size_t& size, char *hex);
 
   private:
     mbedtls_md_context_t m_ctx; // Context used to access the already written bytes and update them latter
-
-    /// @brief Calculates the final hash value
-    /// @param hash Output byte array that the hash value will be copied into
-    void finish(unsigned char *hash);
 };
 
 #endif // THINGSBOARD_ENABLE_OTA
@@ -0,0 +1,245 @@
+#ifndef Heatshrink_Updater_h
+#define Heatshrink_Updater_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_ENABLE_OTA
+
+// Local includes.
+#include "IUpdater.h"
+#include "HashGenerator.h"
+
+// Library includes.
+#include <string.h>
+
+
+/// @brief IUpdater decorator that decompresses the received binary data, before it is passed to the given updater, which allows to upload compressed images to the server,
+/// to decrease the amount of data that has to be downloaded. The received data has to start with the size of the decompressed data as a 32-bit little endian integer,
+/// followed by the data compressed with heatshrink (https://github.com/atomicobject/heatshrink), using the same window and lookahead size as given to the template.
+/// The decompression uses a bounded window of 2^WindowBits bytes and does not allocate any memory, but because the decompressed size is only known
+/// once the first 4 bytes have been received, begin() of the given updater is only called from the first call to write().
+/// The checksum set on the server is calculated from the compressed data and therefore checked by the update process as usual,
+/// additionally the checksum of the decompressed data can be checked in end() by setting it with Set_Decompressed_Checksum()
+/// @tparam WindowBits Base 2 logarithm of the window size in bytes, has to be the same value the data was compressed with (-w), default = 11
+/// @tparam LookaheadBits Base 2 logarithm of the longest back reference in bytes, has to be the same value the data was compressed with (-l), default = 4
+/// @tparam OutputSize Size of the buffer the decompressed data is collected in before it is written with the given updater, default = 256
+template <uint8_t WindowBits = 11U, uint8_t LookaheadBits = 4U, size_t OutputSize = 256U>
+class Heatshrink_Updater : public IUpdater {
+  static_assert(WindowBits >= 4U && WindowBits <= 15U, "Heatshrink window size has to be between 4 and 15 bits");
+  static_assert(LookaheadBits >= 3U && LookaheadBits < WindowBits, "Heatshrink lookahead size has to be at least 3 bits and smaller than the window size");
+  static_assert(OutputSize > 0U, "Output buffer can not be empty");
+
+  public:
+    /// @brief Constructor
+    /// @param updater Updater implementation the decompressed data is written with, is not copied and therefore has to be kept alive as long as the decorator is used
+    inline Heatshrink_Updater(IUpdater& updater) :
+        m_updater(updater),
+        m_checksum(),
+        m_checksum_size(0U),
+        m_checksum_algorithm(),
+        m_hash(),
+        m_window(),
+        m_output(),
+        m_output_size(0U),
+        m_head(0U),
+        m_bit_buffer(0U),
+        m_bit_count(0U),
+        m_header(0U),
+        m_header_size(0U),
+        m_compressed_size(0U),
+        m_received(0U),
+        m_decompressed_size(0U),
+        m_produced(0U)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Sets the checksum the decompressed data is checked against in end(), in addition to the checksum of the compressed data that is checked by the update process itself.
+    /// Has to be called before the update is started, passing nullptr disables the check again
+    /// @param checksum_algorithm Algorithm used to calculate the checksum
+    /// @param checksum Expected checksum of the decompressed data, as a hex string, is decoded once and compared in its binary form
+    /// @return Whether the given checksum is a valid hex string or nullptr, if it is not the check is disabled
+    inline bool Set_Decompressed_Checksum(const mbedtls_md_type_t& checksum_algorithm, const char *checksum) {
+        m_checksum_algorithm = checksum_algorithm;
+        m_checksum_size = HashGenerator::decode_hex(checksum, m_checksum, sizeof(m_checksum));
+        return checksum == nullptr || m_checksum_size != 0U;
+    }
+
+    bool begin(const size_t& data_size) override {
+        Reset_Decoder();
+        m_compressed_size = data_size;
+        return true;
+    }
+
+    size_t write(uint8_t* payload, const size_t& total_bytes) override {
+        for (size_t i = 0U; i < total_bytes; i++) {
+            const uint8_t byte = payload[i];
+            m_received++;
+
+            // Collect the decompressed size first, which is needed to initalize the underlying updater
+            if (m_header_size < HEADER_SIZE) {
+                m_header |= static_cast<uint32_t>(byte) << (m_header_size * 8U);
+                if (++m_header_size == HEADER_SIZE && !Begin_Decompressed()) {
+                    return i;
+                }
+                continue;
+            }
+
+            m_bit_buffer = (m_bit_buffer << 8U) | byte;
+            m_bit_count += 8U;
+            if (!Decode()) {
+                return i;
+            }
+        }
+        return total_bytes;
+    }
+
+    bool supports_read() const override {
+        // The decompressed data written with the given updater differs in size and content from the received data the server calculated the checksum from,
+        // therefore reading it back can never result in the expected checksum and OTA_Hash_Mode::WRITTEN_DATA has to be rejected when the update is started
+        return false;
+    }
+
+    void reset() override {
+        Reset_Decoder();
+        m_updater.reset();
+    }
+
+    bool end() override {
+        // The leftover bits are only padding, which is not enough for another literal or back reference
+        if (m_header_size < HEADER_SIZE || m_received != m_compressed_size || !Flush_Output() || m_produced != m_decompressed_size) {
+            return false;
+        }
+        if (m_checksum_size != 0U && !m_hash.compare_hash(m_checksum, m_checksum_size)) {
+            return false;
+        }
+        return m_updater.end();
+    }
+
+  private:
+    static constexpr uint8_t HEADER_SIZE = 4U;                                  // Size of the little endian decompressed size, that the received data starts with
+    static constexpr size_t WINDOW_SIZE = 1U << WindowBits;                     // Size of the window back references point into
+    static constexpr size_t WINDOW_MASK = WINDOW_SIZE - 1U;                     // Mask to wrap positions around the end of the window
+    static constexpr uint8_t LITERAL_BITS = 1U + 8U;                            // Amount of bits needed for a tag bit followed by a literal
+    static constexpr uint8_t BACK_REFERENCE_BITS = 1U + WindowBits + LookaheadBits; // Amount of bits needed for a tag bit followed by a back reference
+
+    /// @brief Initalizes the underlying updater with the decompressed size, once it has been completely received
+    /// @return Whether initalizing the underlying updater was successful or not
+    inline bool Begin_Decompressed() {
+        m_decompressed_size = m_header;
+        if (m_checksum_size != 0U) {
+            m_hash.start(m_checksum_algorithm);
+        }
+        return m_updater.begin(m_decompressed_size);
+    }
+
+    /// @brief Decodes as many literals and back references as are completely contained in the buffered bits
+    /// @return Whether decoding and writing the decompressed data was successful or not
+    inline bool Decode() {
+        while (m_bit_count != 0U) {
+            const bool literal = Peek_Bits(1U) != 0U;
+            if (m_bit_count < (literal ? LITERAL_BITS : BACK_REFERENCE_BITS)) {
+                return true;
+            }
+            (void)Read_Bits(1U);
+
+            if (literal) {
+                if (!Emit(static_cast<uint8_t>(Read_Bits(8U)))) {
+                    return false;
+                }
+                continue;
+            }
+
+            const size_t offset = Read_Bits(WindowBits) + 1U;
+            const size_t count = Read_Bits(LookaheadBits) + 1U;
+            for (size_t i = 0U; i < count; i++) {
+                if (!Emit(m_window[(m_head - offset) & WINDOW_MASK])) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /// @brief Reads the given amount of the oldest buffered bits, without removing them from the buffer
+    /// @param amount Amount of bits that should be read, has to be buffered already
+    /// @return Read bits, with the oldest one as the most significant bit
+    inline uint32_t Peek_Bits(const uint8_t& amount) const {
+        return static_cast<uint32_t>(m_bit_buffer >> (m_bit_count - amount)) & ((1U << amount) - 1U);
+    }
+
+    /// @brief Reads and removes the given amount of the oldest buffered bits
+    /// @param amount Amount of bits that should be read, has to be buffered already
+    /// @return Read bits, with the oldest one as the most significant bit
+    inline uint32_t Read_Bits(const uint8_t& amount) {
+        const uint32_t bits = Peek_Bits(amount);
+        m_bit_count -= amount;
+        return bits;
+    }
+
+    /// @brief Appends the given decompressed byte to the window and the output buffer, which is written once it is full
+    /// @param byte Decompressed byte
+    /// @return Whether the byte was expected and writing the output buffer was successful or not
+    inline bool Emit(const uint8_t& byte) {
+        if (m_produced >= m_decompressed_size) {
+            return false;
+        }
+        m_produced++;
+        m_window[m_head & WINDOW_MASK] = byte;
+        m_head++;
+        m_output[m_output_size++] = byte;
+        return m_output_size < OutputSize || Flush_Output();
+    }
+
+    /// @brief Writes the collected decompressed data with the underlying updater and empties the output buffer afterwards
+    /// @return Whether the complete output buffer has been written successfully or not
+    inline bool Flush_Output() {
+        const size_t output_size = m_output_size;
+        m_output_size = 0U;
+        if (output_size == 0U) {
+            return true;
+        }
+        if (m_checksum_size != 0U && !m_hash.update(m_output, output_size)) {
+            return false;
+        }
+        return m_updater.write(m_output, output_size) == output_size;
+    }
+
+    /// @brief Resets the decompression to the initial state, without informing the underlying updater
+    inline void Reset_Decoder() {
+        memset(m_window, 0, sizeof(m_window));
+        m_output_size = 0U;
+        m_head = 0U;
+        m_bit_buffer = 0U;
+        m_bit_count = 0U;
+        m_header = 0U;
+        m_header_size = 0U;
+        m_compressed_size = 0U;
+        m_received = 0U;
+        m_decompressed_size = 0U;
+        m_produced = 0U;
+    }
+
+    IUpdater& m_updater;                     // Updater implementation the decompressed data is written with
+    uint8_t m_checksum[MBEDTLS_MD_MAX_SIZE]; // Binary form of the expected checksum of the decompressed data
+    size_t m_checksum_size;                  // Size of the expected checksum in bytes, 0 if it should not be checked
+    mbedtls_md_type_t m_checksum_algorithm;  // Algorithm used to calculate the checksum of the decompressed data
+    HashGenerator m_hash;                    // Class instance that generates the checksum of the decompressed data
+    uint8_t m_window[WINDOW_SIZE];           // Last decompressed bytes, which back references point into
+    uint8_t m_output[OutputSize];            // Decompressed data, that has not been written yet
+    size_t m_output_size;                    // Amount of bytes in the output buffer
+    size_t m_head;                           // Total amount of bytes written into the window, the position of the next byte is this value wrapped around the window size
+    uint64_t m_bit_buffer;                   // Received bits that have not been decoded yet, with the newest one as the least significant bit
+    uint8_t m_bit_count;                     // Amount of valid bits in the bit buffer
+    uint32_t m_header;                       // Decompressed size, while it is still being received
+    uint8_t m_header_size;                   // Amount of bytes of the decompressed size that have been received
+    size_t m_compressed_size;                // Total size of the received data, including the decompressed size
+    size_t m_received;                       // Amount of bytes that have been received
+    size_t m_decompressed_size;              // Total size of the decompressed data
+    size_t m_produced;                       // Amount of bytes that have been decompressed
+};
+
+#endif // THINGSBOARD_ENABLE_OTA
+
+#endif // Heatshrink_Updater_h
@@ -9,6 +9,19 @@
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
+#if THINGSBOARD_USE_ESP_TIMER
+#include <esp_timer.h>
+#if __has_include(<esp_random.h>)
+#include <esp_random.h>
+#else
+#include <esp_system.h>
+#endif // __has_include(<esp_random.h>)
+#elif defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include <chrono>
+#include <random>
+#endif // THINGSBOARD_USE_ESP_TIMER
 
 uint8_t Helper::detectSize(const char *msg, ...) {
       va_list args;
@@ -35,3 +48,57 @@ size_t Helper::getOccurences(const char *str, char symbol) {
     }
     return count;
 }
+
+uint32_t Helper::calculateCrc32(const uint8_t *data, const size_t& size) {
+    // Precalculated CRC-32 of every possible 4 bit value, with the reversed polynomial 0xEDB88320
+    static constexpr uint32_t CRC32_TABLE[16U] = {
+        0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU, 0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+        0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU, 0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+    };
+    uint32_t crc = 0xFFFFFFFFU;
+    for (size_t i = 0U; i < size; i++) {
+        crc = CRC32_TABLE[(crc ^ data[i]) & 0x0FU] ^ (crc >> 4U);
+        crc = CRC32_TABLE[(crc ^ (data[i] >> 4U)) & 0x0FU] ^ (crc >> 4U);
+    }
+    return ~crc;
+}
+
+#if THINGSBOARD_ENABLE_CLOCK_OVERRIDE
+// Time source set with setClock(), nullptr if the default time source of the platform is used
+static uint64_t (*custom_clock)(void) = nullptr;
+#endif // THINGSBOARD_ENABLE_CLOCK_OVERRIDE
+
+uint64_t Helper::getMicroseconds() {
+#if THINGSBOARD_ENABLE_CLOCK_OVERRIDE
+    if (custom_clock != nullptr) {
+        return custom_clock();
+    }
+#endif // THINGSBOARD_ENABLE_CLOCK_OVERRIDE
+#if THINGSBOARD_USE_ESP_TIMER
+    return esp_timer_get_time();
+#elif defined(ARDUINO)
+    // Overflows after roughly 70 minutes, which results in a single wrong measurement whenever the overflow occurs between two calls
+    return micros();
+#else
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif // THINGSBOARD_USE_ESP_TIMER
+}
+
+#if THINGSBOARD_ENABLE_CLOCK_OVERRIDE
+
+void Helper::setClock(uint64_t (*clock)(void)) {
+    custom_clock = clock;
+}
+
+#endif // THINGSBOARD_ENABLE_CLOCK_OVERRIDE
+
+uint32_t Helper::getRandom() {
+#if THINGSBOARD_USE_ESP_TIMER
+    return esp_random();
+#elif defined(ARDUINO)
+    return random(INT32_MAX);
+#else
+    static std::random_device device;
+    return device();
+#endif // THINGSBOARD_USE_ESP_TIMER
+}
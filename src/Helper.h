@@ -9,6 +9,7 @@
 #include <ArduinoJson.h>
 #if THINGSBOARD_ENABLE_STL
 #include <iterator>
+#include <utility>
 #endif // THINGSBOARD_ENABLE_STL
 
 
@@ -28,6 +29,32 @@ class Helper {
     /// @return Amount of occurences of the given symbol
     static size_t getOccurences(const char *str, char symbol);
 
+    /// @brief Returns the current value of a monotonic clock in microseconds, used to measure the time internal processes take
+    /// or to check if a certain amount of time has passed. Uses the esp timer if it exists, Arduino micros() if Arduino is used
+    /// and the steady clock of the C++ STL otherwise. Only the difference between two values is meaningful, not the value itself
+    /// @return Microseconds since an unspecified point in time, normally the start of the device
+    static uint64_t getMicroseconds();
+
+#if THINGSBOARD_ENABLE_CLOCK_OVERRIDE
+    /// @brief Replaces the time source getMicroseconds() reads from, which allows the tests to run every timeout of the library against a simulated clock,
+    /// instead of having to wait for real time to pass. Should be set before the loop() method of any instance is called the first time, because time moving backwards
+    /// delays every already started timeout until the new time source has caught up with the previous one
+    /// @param clock Method returning the current time in microseconds, nullptr restores the default time source of the platform
+    static void setClock(uint64_t (*clock)(void));
+#endif // THINGSBOARD_ENABLE_CLOCK_OVERRIDE
+
+    /// @brief Returns a random number, used to spread out actions that would otherwise be executed by many devices at the same time.
+    /// Uses the hardware random number generator of the esp if it exists, Arduino random() if Arduino is used and the random device of the C++ STL otherwise
+    /// @return Random number between 0 and 2^32 - 1, apart from Arduino where the number is only between 0 and 2^31 - 2
+    static uint32_t getRandom();
+
+    /// @brief Calculates the CRC-32 (IEEE 802.3, the same one used by zlib and Ethernet) of the given data,
+    /// uses a table with only 16 entries to keep the flash usage minimal, while still processing 4 bits at once
+    /// @param data Data the CRC-32 should be calculated for
+    /// @param size Amount of bytes in the given data
+    /// @return CRC-32 of the given data
+    static uint32_t calculateCrc32(const uint8_t *data, const size_t& size);
+
     /// @brief Calculates the total size of the string the serializeJson method would produce including the null end terminator.
     /// See https://arduinojson.org/v6/api/json/measurejson/ for more information on the underlying method used
     /// @tparam TSource Source class that should be used to serialize the json that is sent to the server
@@ -55,6 +82,24 @@ class Helper {
         container.erase(index);
 #endif // THINGSBOARD_ENABLE_STL
     }
+
+    /// @brief Removes the element with the given index in constant time, by moving the last element into its place and then removing the last element instead.
+    /// Changes the order of the remaining elements, therefore it should only be used for data containers where the order does not matter
+    /// @tparam DataContainer Class which allows to pass any arbitrary data container that contains the size(), operator[] and erase() method
+    /// @param container Data container holding the elements we want to remove an element from
+    /// @param index Index we want to delete the element at
+    template<class DataContainer>
+    inline static void remove_unordered(DataContainer& container, const size_t& index) {
+        const size_t last = container.size() - 1U;
+        if (index != last) {
+#if THINGSBOARD_ENABLE_STL
+            container[index] = std::move(container[last]);
+#else
+            container[index] = container[last];
+#endif // THINGSBOARD_ENABLE_STL
+        }
+        remove(container, last);
+    }
 };
 
 #endif // Helper
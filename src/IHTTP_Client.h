@@ -2,6 +2,8 @@
 #define IHTTP_Client_h
 
 // Library include.
+#include <stddef.h>
+#include <stdint.h>
 #if THINGSBOARD_ENABLE_STL
 #include <string>
 #else
@@ -35,6 +37,11 @@ class IHTTP_Client {
     /// @brief Disconnects the given device from the current host and clears about any remaining bytes still in the reponse body
     virtual void stop() = 0;
 
+    /// @brief Returns whether the underlying connection to the host is still open, allows to reuse an already established connection for multiple requests,
+    /// instead of having to establish a new connection, which especially when using HTTPS requires an expensive TLS handshake for every request
+    /// @return Whether the client is currently connected or not
+    virtual bool connected() = 0;
+
     /// @brief Connects to the server and sends a POST request with a body and content type
     /// @param url_path URL the POST request should be sent too
     /// @param content_type Type of the content that is sent will be JSON data most of the time
@@ -62,6 +69,19 @@ class IHTTP_Client {
 #else
     virtual String get_response_body() = 0;
 #endif // THINGSBOARD_ENABLE_STL
+
+    /// @brief Reads the next part of the response body of a previously sent message into the given buffer, instead of copying the complete body into a string object.
+    /// Allows to process arbitrarily large responses in constant memory, skips any response headers if they have not been read already,
+    /// should be called after calling get_response_status_code() and ensuring the request was successful and then repeatedly until it returns 0
+    /// @param buffer Buffer the next part of the response body should be copied into
+    /// @param size Size of the given buffer, the maximum amount of bytes that are read at once
+    /// @return Amount of bytes copied into the buffer, 0 if the complete body has been read or a negative internal error code if reading failed,
+    /// the default implementation does not support streaming and always returns -1, which fails streamGetRequest() and sendGetRequestJson() and closes kept alive connections after every request
+    virtual int read_response_body(uint8_t *buffer, const size_t& size) {
+        (void)buffer;
+        (void)size;
+        return -1;
+    }
 };
 
 #endif // IHTTP_Client_h
@@ -38,13 +38,23 @@ class IMQTT_Client {
 #if THINGSBOARD_ENABLE_STL
     using function = std::function<void(char *topic, uint8_t *payload, unsigned int length)>;
 #else
-    using function = void (*)(char *topic, uint8_t *payload, unsigned int length);
+    using function = void (*)(void *context, char *topic, uint8_t *payload, unsigned int length);
 #endif // THINGSBOARD_ENABLE_STL
 
+#if THINGSBOARD_ENABLE_STL
     /// @brief Sets the callback that is called, if any message is received by the MQTT broker, including the topic string that the message was received over,
     /// as well as the payload data and the size of that payload data
     /// @param callback Method that should be called on received MQTT response
     virtual void set_callback(function callback) = 0;
+#else
+    /// @brief Sets the callback that is called, if any message is received by the MQTT broker, including the topic string that the message was received over,
+    /// as well as the payload data and the size of that payload data.
+    /// Without the C++ STL the callback can only be a free-standing function, therefore the given context is passed back as the first argument,
+    /// which allows to forward the message to the instance that subscribed the callback, even if multiple instances exist at the same time
+    /// @param callback Method that should be called on received MQTT response
+    /// @param context Pointer that is passed as the first argument to the callback, normally the instance that should receive the message
+    virtual void set_callback(function callback, void *context) = 0;
+#endif // THINGSBOARD_ENABLE_STL
 
     /// @brief Changes the size of the buffer for sent and received MQTT messages,
     /// using a bigger value than uint16_t for passing the buffer size does not make any sense because the maximum message size received
@@ -0,0 +1,28 @@
+#ifndef IPatch_Source_h
+#define IPatch_Source_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_ENABLE_OTA
+
+// Library include.
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// @brief Patch source interface that contains the method that a class that can read the currently installed image has to implement,
+/// which is the image a delta update received by the Delta_Updater is applied to
+class IPatch_Source {
+  public:
+    /// @brief Reads the given amount of bytes of the currently installed image, starting at the given offset
+    /// @param offset Offset in bytes from the start of the image, the data should be read from
+    /// @param buffer Buffer the read data is copied into, has to be at least as big as the given amount of bytes
+    /// @param total_bytes Amount of bytes that should be read
+    /// @return Total amount of bytes that were successfully read, is smaller than the given amount of bytes if the range is outside of the image
+    virtual size_t read(const size_t& offset, uint8_t* buffer, const size_t& total_bytes) = 0;
+};
+
+#endif // THINGSBOARD_ENABLE_OTA
+
+#endif // IPatch_Source_h
@@ -0,0 +1,29 @@
+#ifndef ITelemetry_Filter_h
+#define ITelemetry_Filter_h
+
+// Local include.
+#include "Telemetry.h"
+
+// Library include.
+#include <stdint.h>
+
+
+/// @brief Telemetry filter interface that contains the methods that a class that decides whether a key-value pair should be sent to the server or suppressed has to implement,
+/// allows to skip sending values that have not changed enough since they were sent last. Is called for every key-value pair passed to sendTelemetry(), sendTelemetryData(),
+/// sendAttributes() or sendAttributeData() if it has been set with setTelemetryFilter() or setAttributeFilter()
+class ITelemetry_Filter {
+  public:
+    /// @brief Whether the given key-value pair should be sent to the server or suppressed
+    /// @param data Key-value pair that should be sent
+    /// @param now Current time in microseconds, from the same clock as Helper::getMicroseconds()
+    /// @return Whether the key-value pair should be sent or not
+    virtual bool Should_Send(const Telemetry& data, const uint64_t& now) const = 0;
+
+    /// @brief Informs the filter that the given key-value pair has been successfully sent to the server,
+    /// only called for key-value pairs that Should_Send() previously allowed to be sent
+    /// @param data Key-value pair that has been sent
+    /// @param now Current time in microseconds, same value that was previously passed to Should_Send()
+    virtual void Mark_Sent(const Telemetry& data, const uint64_t& now) = 0;
+};
+
+#endif // ITelemetry_Filter_h
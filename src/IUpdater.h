@@ -28,6 +28,26 @@ class IUpdater {
     /// @brief Resets the writing of the given data so it can be restarted with begin
     virtual void reset() = 0;
   
+    /// @brief Whether the updater can read back the written data with read(), which is checked when the update is started with OTA_Hash_Mode::WRITTEN_DATA,
+    /// so that an updater which does not support it fails the update immediately, instead of only once the complete binary has been downloaded
+    /// @return Whether read() is implemented and returns exactly the bytes the server calculated the checksum from, the default implementation does not support reading and always returns false
+    virtual bool supports_read() const {
+        return false;
+    }
+
+    /// @brief Reads back the given amount of already written bytes, which allows to verify the data that actually ended up in memory once it has been completely written.
+    /// Is called before end(), implementing it is optional and only needed to use OTA_Hash_Mode::WRITTEN_DATA, in which case supports_read() has to be overridden as well
+    /// @param offset Offset in bytes from the start of the written data, the data should be read from
+    /// @param buffer Buffer the read data is copied into, has to be at least as big as the given amount of bytes
+    /// @param total_bytes Amount of bytes that should be read
+    /// @return Total amount of bytes that were successfully read, the default implementation does not support reading and always returns 0
+    virtual size_t read(const size_t& offset, uint8_t* buffer, const size_t& total_bytes) {
+        (void)offset;
+        (void)buffer;
+        (void)total_bytes;
+        return 0U;
+    }
+
     /// @brief Ends the update and returns wheter it was successfully completed
     /// @return Whether the complete amount of bytes initally given was successfully written or not
     virtual bool end() = 0;
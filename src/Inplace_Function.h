@@ -0,0 +1,230 @@
+#ifndef Inplace_Function_h
+#define Inplace_Function_h
+
+// Local include.
+#include "Configuration.h"
+
+// Only requires the type traits of the C++ STL, OTA updates store their callbacks in an Inplace_Function as well, even if the C++ STL has been disabled
+#if THINGSBOARD_ENABLE_STL || THINGSBOARD_ENABLE_OTA
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+template <typename Signature, size_t Capacity = THINGSBOARD_INPLACE_FUNCTION_SIZE>
+class Inplace_Function;
+
+/// @brief Whether the given callable object type can be called with the argument types of the given signature and its result converted into the return type of the signature,
+/// allows to remove the constructor of the Inplace_Function from overload resolution for any other type, instead of failing deep inside of the call to the stored object
+/// @tparam Stored Type of the callable object
+/// @tparam Signature Signature the callable object should be called with
+template <typename Stored, typename Signature, typename = void>
+struct Inplace_Function_Is_Callable : std::false_type {};
+
+template <typename Stored, typename returnType, typename... argumentTypes>
+struct Inplace_Function_Is_Callable<Stored, returnType(argumentTypes...), decltype(void(std::declval<Stored&>()(std::declval<argumentTypes>()...)))> :
+    std::integral_constant<bool, std::is_void<returnType>::value || std::is_convertible<decltype(std::declval<Stored&>()(std::declval<argumentTypes>()...)), returnType>::value> {};
+
+/// @brief Replacement for std::function, that stores the given callable object inside a fixed size buffer in the class itself instead of on the heap.
+/// Storing a callable object that is bigger than the given capacity causes a compile time error instead of an allocation, meaning copying, moving or calling the function never allocates any memory.
+/// The type is erased over two plain function pointers, one to call the stored object and one to copy, move or destroy it, which is cheaper than the virtual dispatch most std::function implementations use.
+/// Lambdas that only capture this or a few pointers, member functions bound to an instance and c-style function pointers all fit into the default capacity
+/// @tparam returnType Type the stored callable object should return
+/// @tparam argumentTypes Types the stored callable object should receive
+/// @tparam Capacity Amount of bytes the stored callable object may have at most, default = THINGSBOARD_INPLACE_FUNCTION_SIZE
+template <typename returnType, typename... argumentTypes, size_t Capacity>
+class Inplace_Function<returnType(argumentTypes...), Capacity> {
+  public:
+    /// @brief Constructs an empty function, calling it is undefined, therefore it should be checked with operator bool beforehand
+    inline Inplace_Function() :
+        m_storage(),
+        m_invoke(nullptr),
+        m_manage(nullptr)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Constructs an empty function, allows to pass nullptr the same way as with std::function or a c-style function pointer
+    inline Inplace_Function(std::nullptr_t) :
+        Inplace_Function()
+    {
+        // Nothing to do
+    }
+
+    /// @brief Constructs a function that stores a copy of the given callable object
+    /// @tparam Functor Type of the callable object, has to be callable with the given argument types and fit into the given capacity
+    /// @param functor Callable object that should be stored, if it is a nullptr c-style function pointer the function is empty instead
+    template <typename Functor, typename = typename std::enable_if<!std::is_same<typename std::decay<Functor>::type, Inplace_Function>::value &&
+                                                                   Inplace_Function_Is_Callable<typename std::decay<Functor>::type, returnType(argumentTypes...)>::value>::type>
+    inline Inplace_Function(Functor&& functor) :
+        Inplace_Function()
+    {
+        using Stored = typename std::decay<Functor>::type;
+        static_assert(sizeof(Stored) <= Capacity, "Callable object is too big for the inplace storage, increase THINGSBOARD_INPLACE_FUNCTION_SIZE accordingly");
+        static_assert(alignof(Stored) <= alignof(max_align_t), "Callable object requires a bigger alignment than the inplace storage provides");
+        if (Is_Null(functor)) {
+            return;
+        }
+        new (&m_storage) Stored(std::forward<Functor>(functor));
+        m_invoke = &Invoke<Stored>;
+        m_manage = &Manage<Stored>;
+    }
+
+    /// @brief Copy constructor
+    /// @param other Function the stored callable object should be copied from
+    inline Inplace_Function(const Inplace_Function& other) :
+        Inplace_Function()
+    {
+        if (other.m_manage != nullptr) {
+            other.m_manage(Operation::COPY, &m_storage, &other.m_storage);
+        }
+        m_invoke = other.m_invoke;
+        m_manage = other.m_manage;
+    }
+
+    /// @brief Move constructor
+    /// @param other Function the stored callable object should be moved from, is empty afterwards
+    inline Inplace_Function(Inplace_Function&& other) :
+        Inplace_Function()
+    {
+        if (other.m_manage != nullptr) {
+            other.m_manage(Operation::MOVE, &m_storage, &other.m_storage);
+        }
+        m_invoke = other.m_invoke;
+        m_manage = other.m_manage;
+        other.reset();
+    }
+
+    /// @brief Destructor
+    inline ~Inplace_Function() {
+        reset();
+    }
+
+    /// @brief Copy assignment operator
+    /// @param other Function the stored callable object should be copied from
+    /// @return Reference to this function
+    inline Inplace_Function& operator=(const Inplace_Function& other) {
+        if (this != &other) {
+            reset();
+            if (other.m_manage != nullptr) {
+                other.m_manage(Operation::COPY, &m_storage, &other.m_storage);
+            }
+            m_invoke = other.m_invoke;
+            m_manage = other.m_manage;
+        }
+        return *this;
+    }
+
+    /// @brief Move assignment operator
+    /// @param other Function the stored callable object should be moved from, is empty afterwards
+    /// @return Reference to this function
+    inline Inplace_Function& operator=(Inplace_Function&& other) {
+        if (this != &other) {
+            reset();
+            if (other.m_manage != nullptr) {
+                other.m_manage(Operation::MOVE, &m_storage, &other.m_storage);
+            }
+            m_invoke = other.m_invoke;
+            m_manage = other.m_manage;
+            other.reset();
+        }
+        return *this;
+    }
+
+    /// @brief Destroys the stored callable object, meaning the function is empty afterwards
+    /// @return Reference to this function
+    inline Inplace_Function& operator=(std::nullptr_t) {
+        reset();
+        return *this;
+    }
+
+    /// @brief Returns whether a callable object is stored or not
+    /// @return Whether the function can be called
+    inline explicit operator bool() const {
+        return m_invoke != nullptr;
+    }
+
+    /// @brief Calls the stored callable object with the given arguments, the function has to not be empty
+    /// @param arguments Arguments that should be forwarded to the stored callable object
+    /// @return Value returned by the stored callable object
+    inline returnType operator()(argumentTypes... arguments) const {
+        return m_invoke(&m_storage, std::forward<argumentTypes>(arguments)...);
+    }
+
+  private:
+    /// @brief Operations the manage function pointer has to handle for the stored type
+    enum class Operation : const uint8_t {
+        COPY,
+        MOVE,
+        DESTROY
+    };
+
+    using Invoke_Function = returnType (*)(void *storage, argumentTypes&&... arguments);
+    using Manage_Function = void (*)(const Operation& operation, void *destination, void *source);
+
+    /// @brief Destroys the stored callable object if there is one
+    inline void reset() {
+        if (m_manage != nullptr) {
+            m_manage(Operation::DESTROY, &m_storage, nullptr);
+        }
+        m_invoke = nullptr;
+        m_manage = nullptr;
+    }
+
+    /// @brief Calls the callable object of the given type placed in the given storage
+    /// @tparam Stored Type of the stored callable object
+    /// @param storage Storage the callable object has been placed in
+    /// @param arguments Arguments that should be forwarded to the stored callable object
+    /// @return Value returned by the stored callable object
+    template <typename Stored>
+    inline static returnType Invoke(void *storage, argumentTypes&&... arguments) {
+        return (*static_cast<Stored*>(storage))(std::forward<argumentTypes>(arguments)...);
+    }
+
+    /// @brief Copies, moves or destroys the callable object of the given type placed in the given storage
+    /// @tparam Stored Type of the stored callable object
+    /// @param operation Operation that should be executed
+    /// @param destination Storage the callable object should be copied or moved into, or the storage of the object that should be destroyed
+    /// @param source Storage the callable object should be copied or moved from, unused when destroying
+    template <typename Stored>
+    inline static void Manage(const Operation& operation, void *destination, void *source) {
+        switch (operation) {
+            case Operation::COPY:
+                new (destination) Stored(*static_cast<const Stored*>(source));
+                break;
+            case Operation::MOVE:
+                new (destination) Stored(std::move(*static_cast<Stored*>(source)));
+                break;
+            case Operation::DESTROY:
+                static_cast<Stored*>(destination)->~Stored();
+                break;
+        }
+    }
+
+    /// @brief Checks whether the given callable object is a nullptr c-style function pointer
+    /// @return Always false, because any other callable object can not be null
+    template <typename Functor>
+    inline static bool Is_Null(const Functor&) {
+        return false;
+    }
+
+    /// @brief Checks whether the given callable object is a nullptr c-style function pointer
+    /// @param functor C-style function pointer that should be checked
+    /// @return Whether the given function pointer is a nullptr
+    template <typename functionReturnType, typename... functionArgumentTypes>
+    inline static bool Is_Null(functionReturnType (* const& functor)(functionArgumentTypes...)) {
+        return functor == nullptr;
+    }
+
+    mutable typename std::aligned_storage<Capacity, alignof(max_align_t)>::type m_storage; // Inline storage the callable object is placed in, mutable because std::function allows calling non-const callable objects from a const function as well
+    Invoke_Function m_invoke;                                                               // Calls the stored callable object, nullptr if the function is empty
+    Manage_Function m_manage;                                                               // Copies, moves or destroys the stored callable object, nullptr if the function is empty
+};
+
+#endif // THINGSBOARD_ENABLE_STL || THINGSBOARD_ENABLE_OTA
+
+#endif // Inplace_Function_h
@@ -0,0 +1,687 @@
+// Header include.
+#include "Linux_MQTT_Client.h"
+
+#if THINGSBOARD_USE_LINUX_MQTT
+
+// Local includes.
+#include "Helper.h"
+
+// Library includes.
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Control packet types shifted into the upper nibble of the first byte of the fixed header,
+// SUBSCRIBE and UNSUBSCRIBE additionally contain the reserved flags required by the MQTT 3.1.1 specification
+constexpr uint8_t MQTT_CONNECT = 0x10;
+constexpr uint8_t MQTT_CONNACK = 0x20;
+constexpr uint8_t MQTT_PUBLISH = 0x30;
+constexpr uint8_t MQTT_PUBACK = 0x40;
+constexpr uint8_t MQTT_SUBSCRIBE = 0x82;
+constexpr uint8_t MQTT_UNSUBSCRIBE = 0xA2;
+constexpr uint8_t MQTT_PINGREQ = 0xC0;
+constexpr uint8_t MQTT_PINGRESP = 0xD0;
+constexpr uint8_t MQTT_DISCONNECT = 0xE0;
+constexpr uint8_t MQTT_PACKET_TYPE_MASK = 0xF0;
+
+constexpr uint8_t MQTT_PROTOCOL_LEVEL = 4U;
+constexpr uint8_t MQTT_CONNECT_CLEAN_SESSION = 0x02;
+constexpr uint8_t MQTT_CONNECT_PASSWORD = 0x40;
+constexpr uint8_t MQTT_CONNECT_USER_NAME = 0x80;
+constexpr uint8_t MQTT_MAX_REMAINING_LENGTH_BYTES = 4U;
+constexpr uint16_t DEFAULT_BUFFER_SIZE = 256U;
+constexpr uint16_t DEFAULT_KEEP_ALIVE_SECONDS = 15U;
+constexpr uint32_t DEFAULT_NETWORK_TIMEOUT = 10000U;
+constexpr size_t READ_CHUNK_SIZE = 1024U;
+constexpr uint64_t MICROSECONDS_PER_SECOND = 1000000U;
+constexpr uint64_t MICROSECONDS_PER_MILLISECOND = 1000U;
+
+/// @brief Encodes the given length into the variable length encoding used for the remaining length of the fixed header
+/// @param length Length that should be encoded, has to be smaller than 268435456
+/// @param buffer Buffer the encoded length should be written into, has to be atleast 4 bytes big
+/// @return Amount of bytes written into the buffer
+static size_t encode_remaining_length(uint32_t length, uint8_t *buffer) {
+    size_t written = 0U;
+    do {
+        uint8_t encoded_byte = length % 128U;
+        length /= 128U;
+        if (length > 0U) {
+            encoded_byte |= 0x80;
+        }
+        buffer[written++] = encoded_byte;
+    } while (length > 0U);
+    return written;
+}
+
+/// @brief Writes the given value as a two byte big endian integer into the given buffer, as expected by MQTT for packet identifiers and string lengths
+/// @param value Value that should be written
+/// @param buffer Buffer the value should be written into, has to be atleast 2 bytes big
+static void encode_uint16(const uint16_t& value, uint8_t *buffer) {
+    buffer[0U] = static_cast<uint8_t>(value >> 8U);
+    buffer[1U] = static_cast<uint8_t>(value & 0xFF);
+}
+
+Linux_MQTT_Client::Linux_MQTT_Client() :
+    m_received_data_callback(nullptr),
+#if !THINGSBOARD_ENABLE_STL
+    m_received_data_context(nullptr),
+#endif // !THINGSBOARD_ENABLE_STL
+    m_domain(nullptr),
+    m_port(0U),
+    m_socket(-1),
+    m_epoll(-1),
+    m_registered_events(0U),
+    m_keep_alive_seconds(DEFAULT_KEEP_ALIVE_SECONDS),
+    m_network_timeout(DEFAULT_NETWORK_TIMEOUT),
+    m_last_outbound(0U),
+    m_last_inbound(0U),
+    m_ping_outstanding(false),
+    m_connack_received(false),
+    m_connack_return_code(0U),
+    m_packet_id(0U),
+    m_buffer(nullptr),
+    m_buffer_size(0U),
+    m_retired_buffer(nullptr),
+    m_dispatching(false),
+    m_read_state(Read_State::FIXED_HEADER),
+    m_packet_header(0U),
+    m_remaining_length(0U),
+    m_length_multiplier(1U),
+    m_received_length(0U)
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+    , m_stream_remaining(0U)
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+{
+    (void)set_buffer_size(DEFAULT_BUFFER_SIZE);
+}
+
+Linux_MQTT_Client::~Linux_MQTT_Client() {
+    close_socket();
+    free(m_buffer);
+    m_buffer = nullptr;
+    free(m_retired_buffer);
+    m_retired_buffer = nullptr;
+}
+
+void Linux_MQTT_Client::set_keep_alive_timeout(const uint16_t& keep_alive_timeout_seconds) {
+    m_keep_alive_seconds = keep_alive_timeout_seconds;
+}
+
+void Linux_MQTT_Client::set_network_timeout(const uint32_t& network_timeout_milliseconds) {
+    m_network_timeout = network_timeout_milliseconds;
+}
+
+bool Linux_MQTT_Client::wait(const int& timeout_milliseconds) {
+    if (!connected()) {
+        return false;
+    }
+
+    int timeout = timeout_milliseconds;
+    if (m_keep_alive_seconds != 0U) {
+        // Wake up in time to send the PINGREQ in loop(), because otherwise the broker would close the connection
+        const uint64_t last_activity = m_last_inbound < m_last_outbound ? m_last_inbound : m_last_outbound;
+        const uint64_t next_ping = last_activity + (m_keep_alive_seconds * MICROSECONDS_PER_SECOND);
+        const uint64_t now = Helper::getMicroseconds();
+        const int keep_alive_timeout = next_ping > now ? static_cast<int>((next_ping - now) / MICROSECONDS_PER_MILLISECOND) : 0;
+        if (timeout < 0 || keep_alive_timeout < timeout) {
+            timeout = keep_alive_timeout;
+        }
+    }
+    return wait_for(EPOLLIN, timeout);
+}
+
+int Linux_MQTT_Client::get_file_descriptor() const {
+    return m_socket;
+}
+
+#if THINGSBOARD_ENABLE_STL
+void Linux_MQTT_Client::set_callback(function callback) {
+    m_received_data_callback = callback;
+}
+#else
+void Linux_MQTT_Client::set_callback(function callback, void *context) {
+    m_received_data_callback = callback;
+    m_received_data_context = context;
+}
+#endif // THINGSBOARD_ENABLE_STL
+
+bool Linux_MQTT_Client::set_buffer_size(const uint16_t& buffer_size) {
+    uint8_t *buffer = static_cast<uint8_t *>(malloc(buffer_size));
+    if (buffer == nullptr) {
+        return false;
+    }
+
+    // Keep the already received part of a control packet, if the buffer is changed in between two calls to loop()
+    if (!m_dispatching && m_buffer != nullptr) {
+        size_t copied = m_received_length < m_buffer_size ? m_received_length : m_buffer_size;
+        copied = copied < buffer_size ? copied : buffer_size;
+        memcpy(buffer, m_buffer, copied);
+    }
+
+    // The topic and payload passed to the currently called callback still point into the previous buffer,
+    // therefore the first replaced buffer is only freed once the callback has returned
+    if (m_dispatching && m_retired_buffer == nullptr) {
+        m_retired_buffer = m_buffer;
+    }
+    else {
+        free(m_buffer);
+    }
+    m_buffer = buffer;
+    m_buffer_size = buffer_size;
+    return true;
+}
+
+uint16_t Linux_MQTT_Client::get_buffer_size() {
+    return m_buffer_size;
+}
+
+void Linux_MQTT_Client::set_server(const char *domain, const uint16_t& port) {
+    m_domain = domain;
+    m_port = port;
+}
+
+bool Linux_MQTT_Client::connect(const char *client_id, const char *user_name, const char *password) {
+    // Always start a new clean session, even if we are still connected
+    close_socket();
+    if (!open_socket()) {
+        return false;
+    }
+
+    if (client_id == nullptr) {
+        client_id = "";
+    }
+    uint8_t connect_flags = MQTT_CONNECT_CLEAN_SESSION;
+    if (user_name != nullptr) {
+        connect_flags |= MQTT_CONNECT_USER_NAME;
+    }
+    // The MQTT 3.1.1 specification does not allow a password without a user name
+    if (user_name != nullptr && password != nullptr) {
+        connect_flags |= MQTT_CONNECT_PASSWORD;
+    }
+
+    uint8_t variable_header[10U] = { 0U, 4U, 'M', 'Q', 'T', 'T', MQTT_PROTOCOL_LEVEL, connect_flags, 0U, 0U };
+    encode_uint16(m_keep_alive_seconds, variable_header + 8U);
+    uint8_t client_id_length[2U] = {};
+    uint8_t user_name_length[2U] = {};
+    uint8_t password_length[2U] = {};
+
+    struct iovec buffers[8U] = {};
+    size_t count = 1U;
+    buffers[count++] = { variable_header, sizeof(variable_header) };
+    encode_uint16(strlen(client_id), client_id_length);
+    buffers[count++] = { client_id_length, sizeof(client_id_length) };
+    buffers[count++] = { const_cast<char *>(client_id), strlen(client_id) };
+    if (connect_flags & MQTT_CONNECT_USER_NAME) {
+        encode_uint16(strlen(user_name), user_name_length);
+        buffers[count++] = { user_name_length, sizeof(user_name_length) };
+        buffers[count++] = { const_cast<char *>(user_name), strlen(user_name) };
+    }
+    if (connect_flags & MQTT_CONNECT_PASSWORD) {
+        encode_uint16(strlen(password), password_length);
+        buffers[count++] = { password_length, sizeof(password_length) };
+        buffers[count++] = { const_cast<char *>(password), strlen(password) };
+    }
+    if (!send_packet(MQTT_CONNECT, buffers, count)) {
+        return false;
+    }
+
+    const uint64_t deadline = Helper::getMicroseconds() + (m_network_timeout * MICROSECONDS_PER_MILLISECOND);
+    while (!m_connack_received) {
+        const uint64_t now = Helper::getMicroseconds();
+        if (now >= deadline || !wait_for(EPOLLIN, static_cast<int>((deadline - now) / MICROSECONDS_PER_MILLISECOND)) || !read_available()) {
+            close_socket();
+            return false;
+        }
+    }
+
+    if (m_connack_return_code != 0U) {
+        close_socket();
+        return false;
+    }
+    return true;
+}
+
+void Linux_MQTT_Client::disconnect() {
+    if (m_socket < 0) {
+        return;
+    }
+    struct iovec buffers[1U] = {};
+    (void)send_packet(MQTT_DISCONNECT, buffers, 1U);
+    close_socket();
+}
+
+bool Linux_MQTT_Client::loop() {
+    if (!connected() || !read_available()) {
+        return false;
+    }
+
+    if (m_keep_alive_seconds == 0U) {
+        return connected();
+    }
+
+    const uint64_t now = Helper::getMicroseconds();
+    const uint64_t keep_alive = m_keep_alive_seconds * MICROSECONDS_PER_SECOND;
+    if (now - m_last_inbound < keep_alive && now - m_last_outbound < keep_alive) {
+        return connected();
+    }
+
+    // Broker did not respond to our previous PINGREQ in time, meaning the connection has been lost without the socket noticing
+    if (m_ping_outstanding) {
+        close_socket();
+        return false;
+    }
+
+    struct iovec buffers[1U] = {};
+    if (!send_packet(MQTT_PINGREQ, buffers, 1U)) {
+        return false;
+    }
+    m_last_inbound = now;
+    m_ping_outstanding = true;
+    return connected();
+}
+
+bool Linux_MQTT_Client::publish(const char *topic, const uint8_t *payload, const size_t& length) {
+    if (!connected()) {
+        return false;
+    }
+
+    const size_t topic_length = strlen(topic);
+    if (2U + topic_length + length > m_buffer_size) {
+        return false;
+    }
+
+    uint8_t encoded_topic_length[2U] = {};
+    encode_uint16(topic_length, encoded_topic_length);
+    struct iovec buffers[4U] = {
+        {},
+        { encoded_topic_length, sizeof(encoded_topic_length) },
+        { const_cast<char *>(topic), topic_length },
+        { const_cast<uint8_t *>(payload), length }
+    };
+    return send_packet(MQTT_PUBLISH, buffers, 4U);
+}
+
+bool Linux_MQTT_Client::subscribe(const char *topic) {
+    return send_subscription(MQTT_SUBSCRIBE, topic);
+}
+
+bool Linux_MQTT_Client::unsubscribe(const char *topic) {
+    return send_subscription(MQTT_UNSUBSCRIBE, topic);
+}
+
+bool Linux_MQTT_Client::connected() {
+    return m_socket >= 0 && m_connack_received && m_connack_return_code == 0U;
+}
+
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+
+bool Linux_MQTT_Client::begin_publish(const char *topic, const size_t& length) {
+    if (!connected()) {
+        return false;
+    }
+
+    const size_t topic_length = strlen(topic);
+    uint8_t fixed_header[1U + MQTT_MAX_REMAINING_LENGTH_BYTES] = { MQTT_PUBLISH };
+    const size_t header_length = 1U + encode_remaining_length(2U + topic_length + length, fixed_header + 1U);
+    uint8_t encoded_topic_length[2U] = {};
+    encode_uint16(topic_length, encoded_topic_length);
+    struct iovec buffers[3U] = {
+        { fixed_header, header_length },
+        { encoded_topic_length, sizeof(encoded_topic_length) },
+        { const_cast<char *>(topic), topic_length }
+    };
+    if (!write_all(buffers, 3U)) {
+        return false;
+    }
+    m_stream_remaining = length;
+    return true;
+}
+
+bool Linux_MQTT_Client::end_publish() {
+    const bool result = connected() && m_stream_remaining == 0U;
+    m_stream_remaining = 0U;
+    return result;
+}
+
+size_t Linux_MQTT_Client::write(uint8_t payload_byte) {
+    return write(&payload_byte, 1U);
+}
+
+size_t Linux_MQTT_Client::write(const uint8_t *buffer, size_t size) {
+    if (!connected() || size > m_stream_remaining) {
+        return 0U;
+    }
+    struct iovec buffers[1U] = { { const_cast<uint8_t *>(buffer), size } };
+    if (!write_all(buffers, 1U)) {
+        return 0U;
+    }
+    m_stream_remaining -= size;
+    return size;
+}
+
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+
+bool Linux_MQTT_Client::open_socket() {
+    if (m_domain == nullptr) {
+        return false;
+    }
+
+    char port[6U] = {};
+    (void)snprintf(port, sizeof(port), "%u", m_port);
+    struct addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo *addresses = nullptr;
+    if (getaddrinfo(m_domain, port, &hints, &addresses) != 0) {
+        return false;
+    }
+
+    m_epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll < 0) {
+        freeaddrinfo(addresses);
+        return false;
+    }
+
+    // Attempt each resolved address until one of them accepts the connection, the connection is established asynchronously,
+    // which allows to abort it once the network timeout has passed instead of waiting for the much longer timeout of the kernel
+    for (struct addrinfo *address = addresses; address != nullptr; address = address->ai_next) {
+        m_socket = socket(address->ai_family, address->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, address->ai_protocol);
+        if (m_socket < 0) {
+            continue;
+        }
+
+        // Control packets are written with a single system call each, therefore waiting for more data to fill a segment only adds latency
+        const int enable = 1;
+        (void)setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        struct epoll_event event = {};
+        event.events = EPOLLOUT;
+        event.data.fd = m_socket;
+        m_registered_events = EPOLLOUT;
+        int error = 0;
+        socklen_t error_length = sizeof(error);
+        if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_socket, &event) == 0
+          && (::connect(m_socket, address->ai_addr, address->ai_addrlen) == 0
+            || (errno == EINPROGRESS && wait_for(EPOLLOUT, m_network_timeout)))
+          && getsockopt(m_socket, SOL_SOCKET, SO_ERROR, &error, &error_length) == 0 && error == 0) {
+            freeaddrinfo(addresses);
+            m_last_inbound = Helper::getMicroseconds();
+            m_last_outbound = m_last_inbound;
+            return true;
+        }
+
+        (void)epoll_ctl(m_epoll, EPOLL_CTL_DEL, m_socket, nullptr);
+        (void)close(m_socket);
+        m_socket = -1;
+    }
+
+    freeaddrinfo(addresses);
+    close_socket();
+    return false;
+}
+
+void Linux_MQTT_Client::close_socket() {
+    if (m_socket >= 0) {
+        (void)close(m_socket);
+        m_socket = -1;
+    }
+    if (m_epoll >= 0) {
+        (void)close(m_epoll);
+        m_epoll = -1;
+    }
+    m_registered_events = 0U;
+    m_ping_outstanding = false;
+    m_connack_received = false;
+    m_connack_return_code = 0U;
+    m_read_state = Read_State::FIXED_HEADER;
+    m_received_length = 0U;
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+    m_stream_remaining = 0U;
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+}
+
+bool Linux_MQTT_Client::wait_for(const uint32_t& events, const int& timeout_milliseconds) {
+    if (m_socket < 0 || m_epoll < 0) {
+        return false;
+    }
+
+    if (m_registered_events != events) {
+        struct epoll_event event = {};
+        event.events = events;
+        event.data.fd = m_socket;
+        if (epoll_ctl(m_epoll, EPOLL_CTL_MOD, m_socket, &event) != 0) {
+            return false;
+        }
+        m_registered_events = events;
+    }
+
+    struct epoll_event event = {};
+    int ready = 0;
+    do {
+        ready = epoll_wait(m_epoll, &event, 1, timeout_milliseconds);
+    } while (ready < 0 && errno == EINTR);
+
+    // Errors or the broker closing the connection are also reported if we wait for EPOLLIN, because the following read will notice them and close the socket
+    if (ready <= 0) {
+        return false;
+    }
+    return (event.events & events) != 0U || (events == EPOLLIN && (event.events & (EPOLLERR | EPOLLHUP)) != 0U);
+}
+
+bool Linux_MQTT_Client::write_all(struct iovec *buffers, size_t count) {
+    while (count > 0U && m_socket >= 0) {
+        struct msghdr message = {};
+        message.msg_iov = buffers;
+        message.msg_iovlen = count;
+        const ssize_t written = sendmsg(m_socket, &message, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            else if ((errno == EAGAIN || errno == EWOULDBLOCK) && wait_for(EPOLLOUT, m_network_timeout)) {
+                continue;
+            }
+            close_socket();
+            return false;
+        }
+
+        // Skip the completly written buffers and adjust the partially written buffer, so the next call continues where the previous one stopped
+        size_t remaining = written;
+        while (count > 0U && remaining >= buffers->iov_len) {
+            remaining -= buffers->iov_len;
+            buffers++;
+            count--;
+        }
+        if (count > 0U) {
+            buffers->iov_base = static_cast<uint8_t *>(buffers->iov_base) + remaining;
+            buffers->iov_len -= remaining;
+        }
+    }
+
+    if (m_socket < 0) {
+        return false;
+    }
+    m_last_outbound = Helper::getMicroseconds();
+    return true;
+}
+
+bool Linux_MQTT_Client::send_packet(const uint8_t& header, struct iovec *buffers, const size_t& count) {
+    size_t remaining_length = 0U;
+    for (size_t i = 1U; i < count; i++) {
+        remaining_length += buffers[i].iov_len;
+    }
+
+    uint8_t fixed_header[1U + MQTT_MAX_REMAINING_LENGTH_BYTES] = { header };
+    const size_t header_length = 1U + encode_remaining_length(remaining_length, fixed_header + 1U);
+    buffers[0U] = { fixed_header, header_length };
+    return write_all(buffers, count);
+}
+
+bool Linux_MQTT_Client::send_subscription(const uint8_t& header, const char *topic) {
+    if (!connected()) {
+        return false;
+    }
+
+    // Packet identifier 0 is not allowed by the MQTT 3.1.1 specification
+    m_packet_id++;
+    if (m_packet_id == 0U) {
+        m_packet_id++;
+    }
+
+    const size_t topic_length = strlen(topic);
+    uint8_t variable_header[4U] = {};
+    encode_uint16(m_packet_id, variable_header);
+    encode_uint16(topic_length, variable_header + 2U);
+    uint8_t requested_qos = 0U;
+    struct iovec buffers[4U] = {
+        {},
+        { variable_header, sizeof(variable_header) },
+        { const_cast<char *>(topic), topic_length },
+        { &requested_qos, sizeof(requested_qos) }
+    };
+    // Only SUBSCRIBE contains the requested QoS after the topic filter
+    return send_packet(header, buffers, header == MQTT_SUBSCRIBE ? 4U : 3U);
+}
+
+bool Linux_MQTT_Client::read_available() {
+    uint8_t chunk[READ_CHUNK_SIZE];
+
+    while (m_socket >= 0) {
+        const ssize_t received = recv(m_socket, chunk, sizeof(chunk), 0);
+        if (received == 0) {
+            close_socket();
+            return false;
+        }
+        else if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return true;
+            }
+            close_socket();
+            return false;
+        }
+        m_last_inbound = Helper::getMicroseconds();
+
+        // The socket might be closed by a callback, while the received chunk is still being parsed
+        for (size_t index = 0U; index < static_cast<size_t>(received) && m_socket >= 0; ) {
+            switch (m_read_state) {
+                case Read_State::FIXED_HEADER:
+                    m_packet_header = chunk[index++];
+                    m_remaining_length = 0U;
+                    m_length_multiplier = 1U;
+                    m_read_state = Read_State::REMAINING_LENGTH;
+                    break;
+                case Read_State::REMAINING_LENGTH: {
+                    const uint8_t encoded_byte = chunk[index++];
+                    m_remaining_length += (encoded_byte & 0x7F) * m_length_multiplier;
+                    m_length_multiplier *= 128U;
+                    if (encoded_byte & 0x80) {
+                        // Remaining length is encoded with atleast 1 and at most 4 bytes, anything else is a malformed control packet
+                        if (m_length_multiplier > (128U * 128U * 128U)) {
+                            close_socket();
+                            return false;
+                        }
+                        break;
+                    }
+                    m_received_length = 0U;
+                    m_read_state = Read_State::BODY;
+                    if (m_remaining_length == 0U) {
+                        handle_packet();
+                        m_read_state = Read_State::FIXED_HEADER;
+                    }
+                    break;
+                }
+                case Read_State::BODY: {
+                    const size_t available = static_cast<size_t>(received) - index;
+                    const size_t missing = m_remaining_length - m_received_length;
+                    const size_t count = available < missing ? available : missing;
+                    // Bytes that do not fit into the buffer anymore are skipped, the control packet is then discarded once it has been received completly
+                    if (m_received_length < m_buffer_size) {
+                        const size_t free_space = m_buffer_size - m_received_length;
+                        memcpy(m_buffer + m_received_length, chunk + index, count < free_space ? count : free_space);
+                    }
+                    m_received_length += count;
+                    index += count;
+                    if (m_received_length == m_remaining_length) {
+                        if (m_remaining_length <= m_buffer_size) {
+                            handle_packet();
+                        }
+                        m_read_state = Read_State::FIXED_HEADER;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void Linux_MQTT_Client::handle_packet() {
+    switch (m_packet_header & MQTT_PACKET_TYPE_MASK) {
+        case MQTT_CONNACK:
+            if (m_remaining_length >= 2U) {
+                m_connack_return_code = m_buffer[1U];
+                m_connack_received = true;
+            }
+            break;
+        case MQTT_PINGRESP:
+            m_ping_outstanding = false;
+            break;
+        case MQTT_PUBLISH: {
+            if (m_remaining_length < 2U) {
+                break;
+            }
+            const uint8_t qos = (m_packet_header >> 1U) & 0x03;
+            const uint16_t topic_length = (m_buffer[0U] << 8U) | m_buffer[1U];
+            size_t payload_offset = 2U + topic_length;
+            if (qos > 0U) {
+                payload_offset += 2U;
+            }
+            if (payload_offset > m_remaining_length) {
+                break;
+            }
+
+            // We only ever subscribe with QoS 0, meaning the broker downgrades all messages to QoS 0,
+            // but a message with QoS 1 is still acknowledged to ensure the broker does not resend it
+            if (qos == 1U) {
+                struct iovec buffers[2U] = { {}, { m_buffer + payload_offset - 2U, 2U } };
+                if (!send_packet(MQTT_PUBACK, buffers, 2U)) {
+                    break;
+                }
+            }
+
+            // Move the topic over its length prefix to be able to null-terminate it without copying it into another buffer,
+            // the terminator overwrites the last byte of the topic that has already been moved, therefore the payload is not changed
+            memmove(m_buffer, m_buffer + 2U, topic_length);
+            m_buffer[topic_length] = '\0';
+            if (m_received_data_callback == nullptr) {
+                break;
+            }
+            m_dispatching = true;
+#if THINGSBOARD_ENABLE_STL
+            m_received_data_callback(reinterpret_cast<char *>(m_buffer), m_buffer + payload_offset, m_remaining_length - payload_offset);
+#else
+            m_received_data_callback(m_received_data_context, reinterpret_cast<char *>(m_buffer), m_buffer + payload_offset, m_remaining_length - payload_offset);
+#endif // THINGSBOARD_ENABLE_STL
+            m_dispatching = false;
+            free(m_retired_buffer);
+            m_retired_buffer = nullptr;
+            break;
+        }
+        default:
+            // SUBACK and UNSUBACK do not need to be handled, because we do not wait for them
+            break;
+    }
+}
+
+#endif // THINGSBOARD_USE_LINUX_MQTT
@@ -0,0 +1,172 @@
+#ifndef Linux_MQTT_Client_h
+#define Linux_MQTT_Client_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_USE_LINUX_MQTT
+
+// Local includes.
+#include "IMQTT_Client.h"
+
+
+/// @brief MQTT Client interface implementation that uses non-blocking POSIX sockets and epoll under the hood to establish and communicate over a MQTT 3.1.1 connection,
+/// allows to run the ThingsBoard client natively on Linux, for example on edge gateways, or to test and profile it against a local broker like mosquitto without any radio in between.
+/// Only implements the subset of the MQTT 3.1.1 protocol (https://docs.oasis-open.org/mqtt/mqtt/v3.1.1/os/mqtt-v3.1.1-os.html) that is required by the ThingsBoard client,
+/// meaning messages are published and subscribed with QoS 0, the keep alive mechanism is handled in loop() and incoming messages with QoS 1 are acknowledged.
+/// Published messages are written directly from the given topic and payload with a single scatter-gather system call, meaning they are never copied into an internal buffer.
+/// Received messages are read in bigger chunks and parsed incrementally, meaning loop() never blocks and a message can be received over multiple calls to loop().
+/// The connection is not encrypted, therefore it should only be used in trusted networks or in combination with a local TLS terminating proxy like stunnel.
+/// Additionally the client does not reconnect automatically, instead connected() has to be checked and connect() has to be called again if the connection has been lost
+class Linux_MQTT_Client : public IMQTT_Client {
+  public:
+    /// @brief Constructs a IMQTT_Client implementation without an established connection, the server has to be set with set_server() and then connect() has to be called
+    Linux_MQTT_Client();
+
+    /// @brief Destructor, closes the connection if it has not been closed yet and frees the internal buffer
+    ~Linux_MQTT_Client();
+
+    /// @brief Sets the keep alive timeout in seconds, which is sent to the broker when connecting, the default value is 15 seconds.
+    /// If no other packet has been sent in that time, loop() sends a PINGREQ control packet to the broker and if the broker does not respond in the same amount of time the connection is closed.
+    /// Has to be called before connect() to be applied, a value of 0 disables the keep alive mechanism
+    /// @param keep_alive_timeout_seconds Timeout until we send another PINGREQ control packet to the broker to establish that we are still connected
+    void set_keep_alive_timeout(const uint16_t& keep_alive_timeout_seconds);
+
+    /// @brief Sets the amount of time in milliseconds that we wait until we expect a network operation, meaning establishing the connection, receiving the CONNACK
+    /// or writing a message into the socket, to have successfully finished. The default value is 10 seconds. If that is not the case the operation is aborted and the connection is closed
+    /// @param network_timeout_milliseconds Time in milliseconds that we wait until we abort the network operation if it has not completed yet
+    void set_network_timeout(const uint32_t& network_timeout_milliseconds);
+
+    /// @brief Blocks until data has been received from the broker, the keep alive timeout requires sending a PINGREQ or the given amount of time has passed.
+    /// Allows applications that only react to received messages to sleep instead of calling loop() in a busy loop, loop() should be called afterwards to handle the received data
+    /// @param timeout_milliseconds Maximum amount of time in milliseconds that we wait for, -1 waits until data has been received or the keep alive timeout requires sending a PINGREQ
+    /// @return Whether data has been received and can now be handled with loop() or not
+    bool wait(const int& timeout_milliseconds);
+
+    /// @brief Gets the file descriptor of the underlying socket, allows to add it to an already existing epoll or poll instance of the application
+    /// @return File descriptor of the underlying socket or -1 if we are not connected
+    int get_file_descriptor() const;
+
+#if THINGSBOARD_ENABLE_STL
+    void set_callback(function callback) override;
+#else
+    void set_callback(function callback, void *context) override;
+#endif // THINGSBOARD_ENABLE_STL
+
+    bool set_buffer_size(const uint16_t& buffer_size) override;
+
+    uint16_t get_buffer_size() override;
+
+    void set_server(const char *domain, const uint16_t& port) override;
+
+    bool connect(const char *client_id, const char *user_name, const char *password) override;
+
+    void disconnect() override;
+
+    bool loop() override;
+
+    bool publish(const char *topic, const uint8_t *payload, const size_t& length) override;
+
+    bool subscribe(const char *topic) override;
+
+    bool unsubscribe(const char *topic) override;
+
+    bool connected() override;
+
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+
+    bool begin_publish(const char *topic, const size_t& length) override;
+
+    bool end_publish() override;
+
+    //----------------------------------------------------------------------------
+    // Print interface
+    //----------------------------------------------------------------------------
+
+    size_t write(uint8_t payload_byte) override;
+
+    size_t write(const uint8_t *buffer, size_t size) override;
+
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+
+  private:
+    /// @brief Part of the received control packet the incremental parser currently expects
+    enum class Read_State : const uint8_t {
+        FIXED_HEADER,
+        REMAINING_LENGTH,
+        BODY
+    };
+
+    function m_received_data_callback;    // Callback that will be called as soon as the mqtt client receives any data
+#if !THINGSBOARD_ENABLE_STL
+    void *m_received_data_context;        // Context passed as the first argument to the received data callback
+#endif // !THINGSBOARD_ENABLE_STL
+    const char *m_domain;                 // Domain or ip address of the broker, is not copied and therefore has to be kept alive by the user until connect() has been called
+    uint16_t m_port;                      // Port of the broker
+    int m_socket;                         // File descriptor of the non-blocking socket connected to the broker, -1 if we are not connected
+    int m_epoll;                          // File descriptor of the epoll instance the socket is registered to, used to wait for the socket to become readable or writeable
+    uint32_t m_registered_events;         // Events the socket is currently registered for in the epoll instance
+    uint16_t m_keep_alive_seconds;        // Keep alive timeout sent to the broker when connecting
+    uint32_t m_network_timeout;           // Timeout in milliseconds for blocking network operations
+    uint64_t m_last_outbound;             // Time in microseconds the last control packet has been sent to the broker
+    uint64_t m_last_inbound;              // Time in microseconds the last control packet has been received from the broker
+    bool m_ping_outstanding;              // Whether we have sent a PINGREQ and are still waiting for the PINGRESP
+    bool m_connack_received;              // Whether the CONNACK has been received for the current connection attempt
+    uint8_t m_connack_return_code;        // Return code of the received CONNACK, 0 means the connection has been accepted
+    uint16_t m_packet_id;                 // Packet identifier of the last sent SUBSCRIBE or UNSUBSCRIBE control packet
+    uint8_t *m_buffer;                    // Buffer received control packets are copied into, once they have been received completly they are handled
+    uint16_t m_buffer_size;               // Size of the buffer, limits the variable header and payload of sent and received control packets, received control packets that are bigger are discarded
+    uint8_t *m_retired_buffer;            // Previous buffer replaced by set_buffer_size() while a received message was being handled, freed once the callback has returned, because its topic and payload still point into it
+    bool m_dispatching;                   // Whether the received data callback is currently being called
+    Read_State m_read_state;              // Part of the received control packet the incremental parser currently expects
+    uint8_t m_packet_header;              // First byte of the currently received control packet, containing the type and the flags
+    uint32_t m_remaining_length;          // Length of the variable header and payload of the currently received control packet
+    uint32_t m_length_multiplier;         // Multiplier of the next byte of the variable length encoded remaining length
+    uint32_t m_received_length;           // Amount of bytes of the variable header and payload of the currently received control packet that have been received already
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+    size_t m_stream_remaining;            // Amount of payload bytes that still have to be written with write() after begin_publish() has been called
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+
+    /// @brief Creates the non-blocking socket and the epoll instance and waits until the connection to the configured broker has been established
+    /// @return Whether establishing the connection was successful or not
+    bool open_socket();
+
+    /// @brief Closes the socket and the epoll instance and resets the state of the incremental parser
+    void close_socket();
+
+    /// @brief Waits until the socket is ready for the given events or the given amount of time has passed
+    /// @param events Epoll events we want to wait for, either EPOLLIN or EPOLLOUT
+    /// @param timeout_milliseconds Maximum amount of time in milliseconds that we wait for, 0 returns immediately and -1 waits forever
+    /// @return Whether the socket is ready for the given events or not, false if an error occured or the connection has been closed by the broker
+    bool wait_for(const uint32_t& events, const int& timeout_milliseconds);
+
+    /// @brief Writes all the given buffers into the socket, waits until the socket is writeable again if the kernel buffer is full
+    /// @param buffers Buffers that should be written in the given order, are modified to keep track of the already written bytes
+    /// @param count Amount of buffers
+    /// @return Whether all bytes have been written or not, closes the connection if that is not the case
+    bool write_all(struct iovec *buffers, size_t count);
+
+    /// @brief Sends the fixed header with the given remaining length followed by the given buffers
+    /// @param header First byte of the fixed header, containing the type and the flags
+    /// @param buffers Buffers containing the variable header and the payload, the first entry is reserved for the fixed header
+    /// @param count Amount of buffers including the reserved first entry
+    /// @return Whether the complete control packet has been written or not
+    bool send_packet(const uint8_t& header, struct iovec *buffers, const size_t& count);
+
+    /// @brief Sends a SUBSCRIBE or UNSUBSCRIBE control packet for the given topic
+    /// @param header First byte of the fixed header, either SUBSCRIBE or UNSUBSCRIBE with the required reserved flags
+    /// @param topic Topic we want to subscribe or unsubscribe
+    /// @return Whether the complete control packet has been written or not
+    bool send_subscription(const uint8_t& header, const char *topic);
+
+    /// @brief Reads all available data from the socket and passes it to the incremental parser
+    /// @return Whether reading was successful or not, false if the connection has been closed
+    bool read_available();
+
+    /// @brief Handles a completly received control packet, which has been copied into the internal buffer
+    void handle_packet();
+};
+
+#endif // THINGSBOARD_USE_LINUX_MQTT
+
+#endif // Linux_MQTT_Client_h
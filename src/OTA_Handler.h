@@ -8,8 +8,10 @@
 
 // Local include.
 #include "Callback_Watchdog.h"
+#include "Constants.h"
 #include "HashGenerator.h"
 #include "Helper.h"
+#include "Inplace_Function.h"
 #include "OTA_Update_Callback.h"
 #include "OTA_Failure_Response.h"
 
@@ -17,7 +19,7 @@
 /// ---------------------------------
 /// Constant strings in flash memory.
 /// ---------------------------------
-// Firmware data keys.
+// Update states, shared by every downloaded artifact type.
 #if THINGSBOARD_ENABLE_PROGMEM
 constexpr char FW_STATE_DOWNLOADING[] PROGMEM = "DOWNLOADING";
 constexpr char FW_STATE_DOWNLOADED[] PROGMEM = "DOWNLOADED";
@@ -36,250 +38,415 @@ constexpr char FW_STATE_FAILED[] = "FAILED";
 
 // Log messages.
 #if THINGSBOARD_ENABLE_PROGMEM
-constexpr char UNABLE_TO_REQUEST_CHUNCKS[] PROGMEM = "Unable to request firmware chunk";
+constexpr char UNABLE_TO_REQUEST_CHUNCKS[] PROGMEM = "Unable to request chunk";
 constexpr char RECEIVED_UNEXPECTED_CHUNK[] PROGMEM = "Received chunk (%u), not the same as requested chunk (%u)";
 constexpr char ERROR_UPDATE_BEGIN[] PROGMEM = "Failed to initalize flash updater";
 constexpr char ERROR_UPDATE_WRITE[] PROGMEM = "Only wrote (%u) bytes of binary data to flash memory instead of expected (%u)";
 constexpr char UPDATING_HASH_FAILED[] PROGMEM = "Updating hash failed";
+constexpr char READING_WRITTEN_DATA_FAILED[] PROGMEM = "Reading back the written binary data to hash it failed";
+constexpr char UPDATER_READ_NOT_SUPPORTED[] PROGMEM = "Hashing the written binary data requires an updater that supports read()";
 constexpr char ERROR_UPDATE_END[] PROGMEM = "Error (%u) during flash updater not all bytes written";
 constexpr char CHKS_VER_FAILED[] PROGMEM = "Checksum verification failed";
-constexpr char FW_CHUNK[] PROGMEM = "Receive chunk (%u), with size (%u) bytes";
+constexpr char CHUNK_RECEIVED[] PROGMEM = "Receive chunk (%u), with size (%u) bytes";
+constexpr char CHUNK_CRC_MISMATCH[] PROGMEM = "CRC-32 of chunk (%u) is not the same as expected, requesting it again";
+constexpr char CHUNK_CRC_AMOUNT_MISMATCH[] PROGMEM = "Amount of chunk CRC-32 values (%u) is not the same as the amount of chunks (%u), chunks are not verified";
 constexpr char HASH_ACTUAL[] PROGMEM = "(%s) actual checksum: (%s)";
 constexpr char HASH_EXPECTED[] PROGMEM = "(%s) expected checksum: (%s)";
 constexpr char CHKS_VER_SUCCESS[] PROGMEM = "Checksum is the same as expected";
-constexpr char FW_UPDATE_ABORTED[] PROGMEM = "Firmware update aborted";
-constexpr char FW_UPDATE_SUCCESS[] PROGMEM = "Update success";
+constexpr char UPDATE_ABORTED[] PROGMEM = "Update aborted";
+constexpr char UPDATE_SUCCESS[] PROGMEM = "Update success";
 #else
-constexpr char UNABLE_TO_REQUEST_CHUNCKS[] = "Unable to request firmware chunk";
+constexpr char UNABLE_TO_REQUEST_CHUNCKS[] = "Unable to request chunk";
 constexpr char RECEIVED_UNEXPECTED_CHUNK[] = "Received chunk (%u), not the same as requested chunk (%u)";
 constexpr char ERROR_UPDATE_BEGIN[] = "Failed to initalize flash updater";
 constexpr char ERROR_UPDATE_WRITE[] = "Only wrote (%u) bytes of binary data to flash memory instead of expected (%u)";
 constexpr char UPDATING_HASH_FAILED[] = "Updating hash failed";
+constexpr char READING_WRITTEN_DATA_FAILED[] = "Reading back the written binary data to hash it failed";
+constexpr char UPDATER_READ_NOT_SUPPORTED[] = "Hashing the written binary data requires an updater that supports read()";
 constexpr char ERROR_UPDATE_END[] = "Error during flash updater not all bytes written";
 constexpr char CHKS_VER_FAILED[] = "Checksum verification failed";
-constexpr char FW_CHUNK[] = "Receive chunk (%u), with size (%u) bytes";
+constexpr char CHUNK_RECEIVED[] = "Receive chunk (%u), with size (%u) bytes";
+constexpr char CHUNK_CRC_MISMATCH[] = "CRC-32 of chunk (%u) is not the same as expected, requesting it again";
+constexpr char CHUNK_CRC_AMOUNT_MISMATCH[] = "Amount of chunk CRC-32 values (%u) is not the same as the amount of chunks (%u), chunks are not verified";
 constexpr char HASH_ACTUAL[] = "(%s) actual checksum: (%s)";
 constexpr char HASH_EXPECTED[] = "(%s) expected checksum: (%s)";
 constexpr char CHKS_VER_SUCCESS[] = "Checksum is the same as expected";
-constexpr char FW_UPDATE_ABORTED[] = "Firmware update aborted";
-constexpr char FW_UPDATE_SUCCESS[] = "Update success";
+constexpr char UPDATE_ABORTED[] = "Update aborted";
+constexpr char UPDATE_SUCCESS[] = "Update success";
+#endif // THINGSBOARD_ENABLE_PROGMEM
+
+// Size of the blocks the written binary data is read back and hashed in, when hashing the written data.
+#if THINGSBOARD_ENABLE_PROGMEM
+constexpr size_t HASH_BLOCK_SIZE PROGMEM = 512U;
+#else
+constexpr size_t HASH_BLOCK_SIZE = 512U;
+#endif // THINGSBOARD_ENABLE_PROGMEM
+
+// Size of the buffers the received algorithm and checksum strings are copied into, the longest supported algorithm name and the hex string of the biggest supported hash.
+#if THINGSBOARD_ENABLE_PROGMEM
+constexpr size_t CHECKSUM_ALGORITHM_SIZE PROGMEM = sizeof(CHECKSUM_AGORITM_SHA512);
+constexpr size_t CHECKSUM_SIZE PROGMEM = (MBEDTLS_MD_MAX_SIZE * 2U) + 1U;
+#else
+constexpr size_t CHECKSUM_ALGORITHM_SIZE = sizeof(CHECKSUM_AGORITM_SHA512);
+constexpr size_t CHECKSUM_SIZE = (MBEDTLS_MD_MAX_SIZE * 2U) + 1U;
 #endif // THINGSBOARD_ENABLE_PROGMEM
 
 
-/// @brief Handles the complete processing of received binary firmware data, including flashing it onto the device,
-/// creating a hash of the received data and in the end ensuring that the complete OTA firmware was flashes successfully and that the hash is the one we initally received
+/// @brief Generic download engine that handles the complete processing of a received binary artifact, including writing it with the updater of the given callback,
+/// creating a hash of the received data and in the end ensuring that the complete artifact was written successfully and that the hash is the one we initally received.
+/// Does not know which artifact is downloaded or over which topics, requesting the chunks and sending the state is done by the given callbacks,
+/// therefore firmware and software updates simply use their own instance, which allows to download both at the same time
 /// @tparam Logger Logging class that should be used to print messages generated by internal processes
 template<typename Logger>
 class OTA_Handler {
   public:
     /// @brief Constructor
-    /// @param publish_callback Callback that is used to request the firmware chunk of the firmware binary with the given chunk number
-    /// @param send_fw_state_callback Callback that is used to send information about the current state of the over the air update
+    /// @param timer_wheel Timer wheel the chunk request timeouts are scheduled on, is not copied and therefore has to be kept alive as long as the handler is used
+    /// @param publish_callback Callback that is used to request the chunk of the binary with the given chunk number
+    /// @param send_state_callback Callback that is used to send information about the current state of the over the air update
     /// @param finish_callback Callback that is called once the update has been finished and the user should be informed of the failure or success of the over the air update
-    inline OTA_Handler(std::function<bool(const size_t&)> publish_callback, std::function<bool(const char *, const char *)> send_fw_state_callback, std::function<bool(void)> finish_callback)
-        : m_fw_callback(nullptr)
+    inline OTA_Handler(Timer_Wheel& timer_wheel, Inplace_Function<bool(const size_t&)> publish_callback, Inplace_Function<bool(const char *, const char *)> send_state_callback, Inplace_Function<bool(void)> finish_callback)
+        : m_callback(nullptr)
         , m_publish_callback(publish_callback)
-        , m_send_fw_state_callback(send_fw_state_callback)
+        , m_send_state_callback(send_state_callback)
         , m_finish_callback(finish_callback)
-        , m_fw_size(0U)
-        , m_fw_algorithm()
-        , m_fw_checksum()
-        , m_fw_checksum_algorithm()
+        , m_size(0U)
+        , m_algorithm()
+        , m_checksum()
+        , m_expected_hash()
+        , m_expected_hash_size(0U)
+        , m_checksum_algorithm()
+        , m_updater(nullptr)
         , m_hash()
         , m_total_chunks(0U)
+        , m_verify_chunks(false)
         , m_requested_chunks(0U)
         , m_retries(0U)
-        , m_watchdog(std::bind(&OTA_Handler::Handle_Request_Timeout, this))
+        , m_start_time(0U)
+        , m_request_allowed_time(0U)
+        , m_request_delayed(false)
+        , m_watchdog(timer_wheel, [this]() { Handle_Request_Timeout(); })
     {
       // Nothing to do
     }
 
-    /// @brief Starts the firmware update with requesting the first firmware packet and initalizes the underlying needed components
-    /// @param fw_callback Callback method that contains configuration information, about the over the air update
-    /// @param fw_size Complete size of the firmware binary that will be downloaded and flashed onto this device
-    /// @param fw_algorithm String of the algorithm type used to hash the firmware binary
-    /// @param fw_checksum Checksum of the complete firmware binary, should be the same as the actually written data in the end
-    /// @param fw_checksum_algorithm Algorithm type used to hash the firmware binary
-    inline void Start_Firmware_Update(const OTA_Update_Callback *fw_callback, const size_t& fw_size, const std::string& fw_algorithm, const std::string& fw_checksum, const mbedtls_md_type_t& fw_checksum_algorithm) {
-        m_fw_callback = fw_callback;
-        m_fw_size = fw_size;
-        m_total_chunks = (m_fw_size / m_fw_callback->Get_Chunk_Size()) + 1U;
-        m_fw_algorithm = fw_algorithm;
-        m_fw_checksum = fw_checksum;
-        m_fw_checksum_algorithm = fw_checksum_algorithm;
-        m_fw_updater = m_fw_callback->Get_Updater();
-
-        if (!m_publish_callback || !m_send_fw_state_callback || !m_finish_callback || !m_fw_updater) {
+    /// @brief Starts the update with requesting the first packet and initalizes the underlying needed components
+    /// @param callback Callback method that contains configuration information, about the over the air update
+    /// @param size Complete size of the binary that will be downloaded and written onto this device
+    /// @param algorithm String of the algorithm type used to hash the binary, is copied and therefore only has to be kept alive for the duration of the call
+    /// @param checksum Checksum of the complete binary as a hex string, should be the same as the actually written data in the end, is copied and therefore only has to be kept alive for the duration of the call
+    /// @param checksum_algorithm Algorithm type used to hash the binary
+    inline void Start_Update(const OTA_Update_Callback *callback, const size_t& size, const char *algorithm, const char *checksum, const mbedtls_md_type_t& checksum_algorithm) {
+        m_callback = callback;
+        m_size = size;
+        // Round up, because a binary whose size is a multiple of the chunk size would otherwise request an additional empty chunk past its end,
+        // an empty binary still requests its single empty chunk, so that the updater is started and ended like for any other binary
+        const uint16_t& chunk_size = m_callback->Get_Chunk_Size();
+        const size_t data_chunks = (m_size + chunk_size - 1U) / chunk_size;
+        m_total_chunks = m_size == 0U ? 1U : data_chunks;
+        // The CRC-32 values are only valid for the chunk size they were calculated with, if the chunk size was changed after they were set,
+        // every chunk would fail its verification and be requested again until the update fails, therefore the verification is disabled instead.
+        // Compared against the chunks that contain data, because the single empty chunk of an empty binary does not have a CRC-32
+        const size_t& chunk_checksums_amount = m_callback->Get_Chunk_Checksums_Amount();
+        m_verify_chunks = m_callback->Get_Chunk_Checksums() != nullptr;
+        if (m_verify_chunks && chunk_checksums_amount != data_chunks) {
+          char message[Helper::detectSize(CHUNK_CRC_AMOUNT_MISMATCH, static_cast<unsigned int>(chunk_checksums_amount), static_cast<unsigned int>(data_chunks))];
+          snprintf_P(message, sizeof(message), CHUNK_CRC_AMOUNT_MISMATCH, static_cast<unsigned int>(chunk_checksums_amount), static_cast<unsigned int>(data_chunks));
+          Logger::log(message);
+          m_verify_chunks = false;
+        }
+        // The strings are only copied to log them once the update has finished, a longer string is truncated, which does not influence the verification
+        (void)snprintf(m_algorithm, sizeof(m_algorithm), "%s", algorithm != nullptr ? algorithm : "");
+        (void)snprintf(m_checksum, sizeof(m_checksum), "%s", checksum != nullptr ? checksum : "");
+        // Decode the expected checksum only once, so it can be compared in its binary form once the update has finished,
+        // an invalid or too long checksum results in a size of 0, which never matches the calculated hash and therefore fails the update
+        m_expected_hash_size = HashGenerator::decode_hex(checksum, m_expected_hash, sizeof(m_expected_hash));
+        m_checksum_algorithm = checksum_algorithm;
+        m_updater = m_callback->Get_Updater();
+
+        if (!m_publish_callback || !m_send_state_callback || !m_finish_callback || !m_updater) {
           Logger::log(OTA_CB_IS_NULL);
-          (void)m_send_fw_state_callback(FW_STATE_FAILED, OTA_CB_IS_NULL);
-            return Handle_Failure(OTA_Failure_Response::RETRY_NOTHING);
+          (void)m_send_state_callback(FW_STATE_FAILED, OTA_CB_IS_NULL);
+          return Handle_Failure(OTA_Failure_Response::RETRY_NOTHING);
+        }
+
+        // Fail before anything is downloaded, because the checksum could otherwise only be found to never match once the complete binary has been downloaded
+        if (m_callback->Get_Hash_Mode() == OTA_Hash_Mode::WRITTEN_DATA && !m_updater->supports_read()) {
+          Logger::log(UPDATER_READ_NOT_SUPPORTED);
+          (void)m_send_state_callback(FW_STATE_FAILED, UPDATER_READ_NOT_SUPPORTED);
+          return Handle_Failure(OTA_Failure_Response::RETRY_NOTHING);
         }
-        Request_First_Firmware_Packet();
+
+        // The start jitter is only applied once, restarting the update because of a failure requests the first chunk again as soon as the rate limit allows it
+        const uint64_t& start_jitter = m_callback->Get_Start_Jitter();
+        const uint64_t jitter = (start_jitter != 0U) ? (((static_cast<uint64_t>(Helper::getRandom()) << 32U) | Helper::getRandom()) % (start_jitter + 1U)) : 0U;
+        m_start_time = Helper::getMicroseconds() + jitter;
+        m_request_allowed_time = 0U;
+        Request_First_Packet();
     }
 
-    /// @brief Stops the firmware update completly and informs that user that the update has failed because it has been aborted, ongoing communication is discarded.
-    /// Be aware the written partition is not erased so the already written binary firmware data still remains in the flash partition,
-    /// shouldn't really matter, because if we start the update process again the partition will be overwritten anyway and a partially written firmware will not be bootable
-    inline void Stop_Firmware_Update() {
+    /// @brief Stops the update completly and informs that user that the update has failed because it has been aborted, ongoing communication is discarded.
+    /// Be aware the written partition is not erased so the already written binary data still remains in the flash partition,
+    /// shouldn't really matter, because if we start the update process again the partition will be overwritten anyway and a partially written firmware will not be bootable.
+    /// Does nothing if no update is currently running
+    inline void Stop_Update() {
+        if (m_callback == nullptr) {
+          return;
+        }
         m_watchdog.detach();
-        m_fw_updater->reset();
-        Logger::log(FW_UPDATE_ABORTED);
-        (void)m_send_fw_state_callback(FW_STATE_FAILED, FW_UPDATE_ABORTED);
+        m_request_delayed = false;
+        m_updater->reset();
+        Logger::log(UPDATE_ABORTED);
+        (void)m_send_state_callback(FW_STATE_FAILED, UPDATE_ABORTED);
         Handle_Failure(OTA_Failure_Response::RETRY_NOTHING);
-        m_fw_callback = nullptr;
     }
 
-    /// @brief Uses the given firmware packet data and process it. Starting with writing the given amount of bytes of the packet data into flash memory and
+    /// @brief Whether an update is currently running or not
+    /// @return Whether an update has been started and has not been finished or stopped yet
+    inline bool Is_Running() const {
+        return m_callback != nullptr;
+    }
+
+    /// @brief Uses the given packet data and process it. Starting with writing the given amount of bytes of the packet data into flash memory and
     /// into a hash function that will be used to compare the expected complete binary file and the actually received binary file
     /// @param current_chunk Index of the chunk we recieved the binary data for
-    /// @param payload Firmware packet data of the current chunk
-    /// @param total_bytes Amount of bytes in the current firmware packet data
-    inline void Process_Firmware_Packet(const size_t& current_chunk, uint8_t *payload, const size_t& total_bytes) {
-        (void)m_send_fw_state_callback(FW_STATE_DOWNLOADING, nullptr);
+    /// @param payload Packet data of the current chunk
+    /// @param total_bytes Amount of bytes in the current packet data
+    inline void Process_Packet(const size_t& current_chunk, uint8_t *payload, const size_t& total_bytes) {
+        // Packets that were already in flight when the update ended are discarded
+        if (m_callback == nullptr) {
+          return;
+        }
+        (void)m_send_state_callback(FW_STATE_DOWNLOADING, nullptr);
 
         if (current_chunk != m_requested_chunks) {
-          char message[Helper::detectSize(RECEIVED_UNEXPECTED_CHUNK, current_chunk, m_requested_chunks)];
-          snprintf_P(message, sizeof(message), RECEIVED_UNEXPECTED_CHUNK, current_chunk, m_requested_chunks);
+          char message[Helper::detectSize(RECEIVED_UNEXPECTED_CHUNK, static_cast<unsigned int>(current_chunk), static_cast<unsigned int>(m_requested_chunks))];
+          snprintf_P(message, sizeof(message), RECEIVED_UNEXPECTED_CHUNK, static_cast<unsigned int>(current_chunk), static_cast<unsigned int>(m_requested_chunks));
           Logger::log(message);
           return;
         }
 
         m_watchdog.detach();
+        m_request_delayed = false;
 
-        char message[Helper::detectSize(FW_CHUNK, current_chunk, total_bytes)];
-        snprintf_P(message, sizeof(message), FW_CHUNK, current_chunk, total_bytes);
+        char message[Helper::detectSize(CHUNK_RECEIVED, static_cast<unsigned int>(current_chunk), static_cast<unsigned int>(total_bytes))];
+        snprintf_P(message, sizeof(message), CHUNK_RECEIVED, static_cast<unsigned int>(current_chunk), static_cast<unsigned int>(total_bytes));
         Logger::log(message);
 
+        // Discard a corrupted chunk before it is written, this only requires requesting that chunk again, instead of restarting the complete update once the final checksum does not match
+        if (!Verify_Chunk(current_chunk, payload, total_bytes)) {
+            char message[Helper::detectSize(CHUNK_CRC_MISMATCH, static_cast<unsigned int>(current_chunk))];
+            snprintf_P(message, sizeof(message), CHUNK_CRC_MISMATCH, static_cast<unsigned int>(current_chunk));
+            Logger::log(message);
+            return Handle_Failure(OTA_Failure_Response::RETRY_CHUNK);
+        }
+
         if (current_chunk == 0U) {
             // Initialize Flash
-            if (!m_fw_updater->begin(m_fw_size)) {
+            if (!m_updater->begin(m_size)) {
               Logger::log(ERROR_UPDATE_BEGIN);
-              (void)m_send_fw_state_callback(FW_STATE_FAILED, ERROR_UPDATE_BEGIN);
+              (void)m_send_state_callback(FW_STATE_FAILED, ERROR_UPDATE_BEGIN);
               return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE);
             }
         }
 
         // Write received binary data to flash partition
-        const size_t written_bytes = m_fw_updater->write(payload, total_bytes);
+        const size_t written_bytes = m_updater->write(payload, total_bytes);
         if (written_bytes != total_bytes) {
-            char message[Helper::detectSize(ERROR_UPDATE_WRITE, written_bytes, total_bytes)];
-            snprintf_P(message, sizeof(message), ERROR_UPDATE_WRITE, written_bytes, total_bytes);
+            char message[Helper::detectSize(ERROR_UPDATE_WRITE, static_cast<unsigned int>(written_bytes), static_cast<unsigned int>(total_bytes))];
+            snprintf_P(message, sizeof(message), ERROR_UPDATE_WRITE, static_cast<unsigned int>(written_bytes), static_cast<unsigned int>(total_bytes));
             Logger::log(message);
-            (void)m_send_fw_state_callback(FW_STATE_FAILED, message);
+            (void)m_send_state_callback(FW_STATE_FAILED, message);
             return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE);
         }
 
-        // Update value only if writing to flash was a success
-        if (!m_hash.update(payload, total_bytes)) {
+        // Update value only if writing to flash was a success, when hashing the written data it is instead read back and hashed once the update has finished
+        if (m_callback->Get_Hash_Mode() == OTA_Hash_Mode::RECEIVED_DATA && !m_hash.update(payload, total_bytes)) {
             Logger::log(UPDATING_HASH_FAILED);
-            (void)m_send_fw_state_callback(FW_STATE_FAILED, UPDATING_HASH_FAILED);
+            (void)m_send_state_callback(FW_STATE_FAILED, UPDATING_HASH_FAILED);
             return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE);
         }
 
         m_requested_chunks = current_chunk + 1;
-        m_fw_callback->Call_Progress_Callback<Logger>(m_requested_chunks, m_total_chunks);
+        m_callback->Call_Progress_Callback<Logger>(m_requested_chunks, m_total_chunks);
 
         // Ensure to check if the update was cancelled during the progress callback,
-        // if it was the callback variable was reset and there is no need to request the next firmware packet
-        if (m_fw_callback == nullptr) {
+        // if it was the callback variable was reset and there is no need to request the next packet
+        if (m_callback == nullptr) {
           return;
         }
 
         // Reset retries as the current chunk has been downloaded and handled successfully
-        m_retries = m_fw_callback->Get_Chunk_Retries();
-        Request_Next_Firmware_Packet();
+        m_retries = m_callback->Get_Chunk_Retries();
+        Request_Next_Packet();
     }
 
   private:
-    const OTA_Update_Callback *m_fw_callback;                                 // Callback method that contains configuration information, about the over the air update
-    std::function<bool(const size_t&)> m_publish_callback;                    // Callback that is used to request the firmware chunk of the firmware binary with the given chunk number
-    std::function<bool(const char *, const char *)> m_send_fw_state_callback; // Callback that is used to send information about the current state of the over the air update
-    std::function<bool(void)> m_finish_callback;                              // Callback that is called once the update has been finished and the user should be informed of the failure or success of the over the air update
-    size_t m_fw_size;                                                         // Total size of the firmware binary we will receive. Allows for a binary size of up to theoretically 4 GB
-    std::string m_fw_algorithm;                                               // String of the algorithm type used to hash the firmware binary
-    std::string m_fw_checksum;                                                // Checksum of the complete firmware binary, should be the same as the actually written data in the end
-    mbedtls_md_type_t m_fw_checksum_algorithm;                                // Algorithm type used to hash the firmware binary
-    IUpdater *m_fw_updater;                                                   // Interface implementation that writes received firmware binary data onto the given device
-    HashGenerator m_hash;                                                     // Class instance that allows to generate a hash from received firmware binary data
-    size_t m_total_chunks;                                                    // Total amount of chunks that need to be received to get the complete firmware binary
-    size_t m_requested_chunks;                                                // Amount of successfully requested and received firmware binary chunks
+    const OTA_Update_Callback *m_callback;                                    // Callback method that contains configuration information, about the over the air update
+    Inplace_Function<bool(const size_t&)> m_publish_callback;                 // Callback that is used to request the chunk of the binary with the given chunk number
+    Inplace_Function<bool(const char *, const char *)> m_send_state_callback; // Callback that is used to send information about the current state of the over the air update
+    Inplace_Function<bool(void)> m_finish_callback;                           // Callback that is called once the update has been finished and the user should be informed of the failure or success of the over the air update
+    size_t m_size;                                                            // Total size of the binary we will receive. Allows for a binary size of up to theoretically 4 GB
+    char m_algorithm[CHECKSUM_ALGORITHM_SIZE];                                // String of the algorithm type used to hash the binary
+    char m_checksum[CHECKSUM_SIZE];                                           // Checksum of the complete binary as a hex string, should be the same as the actually written data in the end
+    uint8_t m_expected_hash[MBEDTLS_MD_MAX_SIZE];                             // Binary form of the checksum of the complete binary, decoded once the update is started
+    size_t m_expected_hash_size;                                              // Size of the binary form of the checksum in bytes, 0 if the checksum is not a valid hex string
+    mbedtls_md_type_t m_checksum_algorithm;                                   // Algorithm type used to hash the binary
+    IUpdater *m_updater;                                                      // Interface implementation that writes received binary data onto the given device
+    HashGenerator m_hash;                                                     // Class instance that allows to generate a hash from received binary data
+    size_t m_total_chunks;                                                    // Total amount of chunks that need to be received to get the complete binary
+    bool m_verify_chunks;                                                     // Whether the received chunks are verified against their expected CRC-32, only if one has been set for every chunk
+    size_t m_requested_chunks;                                                // Amount of successfully requested and received binary chunks
     uint8_t m_retries;                                                        // Amount of request retries we attempt for each chunk, increasing makes the connection more stable
+    uint64_t m_start_time;                                                    // Time in microseconds before which no chunk is requested, to randomly spread out the start of the update
+    uint64_t m_request_allowed_time;                                          // Time in microseconds at which the token bucket of the rate limit would be completely empty, the next chunk may be requested once it is less than the burst ahead of the current time
+    bool m_request_delayed;                                                   // Whether the watchdog currently delays the next chunk request, instead of waiting for the response to the requested chunk
     Callback_Watchdog m_watchdog;                                             // Class instances that allows to timeout if we do not receive a response for a requested chunk in the given time
 
-    /// @brief Restarts or starts the firmware update and its needed components and then requests the first firmware chunk
-    inline void Request_First_Firmware_Packet() {
+    /// @brief Restarts or starts the update and its needed components and then requests the first chunk
+    inline void Request_First_Packet() {
         m_requested_chunks = 0U;
-        m_retries = m_fw_callback->Get_Chunk_Retries();
-        m_hash.start(m_fw_checksum_algorithm);
+        m_retries = m_callback->Get_Chunk_Retries();
+        m_hash.start(m_checksum_algorithm);
         m_watchdog.detach();
-        m_fw_updater->reset();
-        Request_Next_Firmware_Packet();
+        m_request_delayed = false;
+        m_updater->reset();
+        Request_Next_Packet();
     }
 
-    /// @brief Requests the next firmware chunk of the OTA firmware if there are any left
+    /// @brief Requests the next chunk of the binary if there are any left
     /// and starts the timer that ensures we request the same chunk again if we have not received a response yet
-    inline void Request_Next_Firmware_Packet() {
+    inline void Request_Next_Packet() {
         // Check if we have already requested and handled the last remaining chunk
         if (m_requested_chunks >= m_total_chunks) {
-            Finish_Firmware_Update();   
+            Finish_Update();   
+            return;
+        }
+
+        // Reuse the watchdog to delay the request, until the start jitter has passed, the download window is open and the rate limit allows another request
+        const uint64_t delay = Get_Request_Delay();
+        if (delay != 0U) {
+            m_request_delayed = true;
+            m_watchdog.once(delay);
             return;
         }
 
         if (!m_publish_callback(m_requested_chunks)) {
           Logger::log(UNABLE_TO_REQUEST_CHUNCKS);
-          (void)m_send_fw_state_callback(FW_STATE_FAILED, UNABLE_TO_REQUEST_CHUNCKS);
+          (void)m_send_state_callback(FW_STATE_FAILED, UNABLE_TO_REQUEST_CHUNCKS);
         }
 
         // Watchdog gets started no matter if publishing request was successful or not in hopes,
         // that after the given timeout the callback calls this method again and can then publish the request successfully.
-        m_watchdog.once(m_fw_callback->Get_Timeout());
+        m_watchdog.once(m_callback->Get_Timeout());
     }
 
-    /// @brief Completes the firmware update, which consists of checking the complete hash of the firmware binary if the initally received value,
-    /// both should be the same and if that is not the case that means that we received invalid firmware binary data and have to restart the update.
+    /// @brief Completes the update, which consists of checking the complete hash of the binary if the initally received value,
+    /// both should be the same and if that is not the case that means that we received invalid binary data and have to restart the update.
     /// If checking the hash was successfull we attempt to finish flashing the ota partition and then inform the user that the update was successfull
-    inline void Finish_Firmware_Update() {
-        (void)m_send_fw_state_callback(FW_STATE_DOWNLOADED, nullptr);
+    inline void Finish_Update() {
+        (void)m_send_state_callback(FW_STATE_DOWNLOADED, nullptr);
+
+        if (m_callback->Get_Hash_Mode() == OTA_Hash_Mode::WRITTEN_DATA && !Hash_Written_Data()) {
+            Logger::log(READING_WRITTEN_DATA_FAILED);
+            (void)m_send_state_callback(FW_STATE_FAILED, READING_WRITTEN_DATA_FAILED);
+            return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE);
+        }
 
-        const std::string calculated_hash = m_hash.get_hash_string();
-        char actual[JSON_STRING_SIZE(strlen(HASH_ACTUAL)) + JSON_STRING_SIZE(m_fw_algorithm.size()) + JSON_STRING_SIZE(calculated_hash.size())];
-        snprintf_P(actual, sizeof(actual), HASH_ACTUAL, m_fw_algorithm.c_str(), calculated_hash.c_str());
+        uint8_t calculated_hash[MBEDTLS_MD_MAX_SIZE];
+        const size_t calculated_hash_size = m_hash.get_hash(calculated_hash);
+        char calculated_checksum[(MBEDTLS_MD_MAX_SIZE * 2U) + 1U];
+        HashGenerator::encode_hex(calculated_hash, calculated_hash_size, calculated_checksum);
+        char actual[JSON_STRING_SIZE(strlen(HASH_ACTUAL)) + sizeof(m_algorithm) + JSON_STRING_SIZE(calculated_hash_size * 2U)];
+        snprintf_P(actual, sizeof(actual), HASH_ACTUAL, m_algorithm, calculated_checksum);
         Logger::log(actual);
 
-        char expected[JSON_STRING_SIZE(strlen(HASH_EXPECTED)) + JSON_STRING_SIZE(m_fw_algorithm.size()) + JSON_STRING_SIZE(m_fw_checksum.size())];
-        snprintf_P(expected, sizeof(expected), HASH_EXPECTED, m_fw_algorithm.c_str(), m_fw_checksum.c_str());
+        char expected[JSON_STRING_SIZE(strlen(HASH_EXPECTED)) + sizeof(m_algorithm) + sizeof(m_checksum)];
+        snprintf_P(expected, sizeof(expected), HASH_EXPECTED, m_algorithm, m_checksum);
         Logger::log(expected);
 
         // Check if the initally received checksum is the same as the one we calculated from the received binary data,
-        // if not we assume the binary data has been changed or not completly downloaded --> Firmware update failed
-        if (m_fw_checksum.compare(calculated_hash) != 0) {
+        // if not we assume the binary data has been changed or not completly downloaded --> Update failed
+        if (calculated_hash_size == 0U || calculated_hash_size != m_expected_hash_size || memcmp(calculated_hash, m_expected_hash, calculated_hash_size) != 0) {
             Logger::log(CHKS_VER_FAILED);
-            (void)m_send_fw_state_callback(FW_STATE_FAILED, CHKS_VER_FAILED);
+            (void)m_send_state_callback(FW_STATE_FAILED, CHKS_VER_FAILED);
             return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE);
         }
 
         Logger::log(CHKS_VER_SUCCESS);
 
-        if (!m_fw_updater->end()) {
+        if (!m_updater->end()) {
             Logger::log(ERROR_UPDATE_END);
-            (void)m_send_fw_state_callback(FW_STATE_FAILED, ERROR_UPDATE_END);
+            (void)m_send_state_callback(FW_STATE_FAILED, ERROR_UPDATE_END);
             return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE);
         }
 
-        Logger::log(FW_UPDATE_SUCCESS);
-        (void)m_send_fw_state_callback(FW_STATE_UPDATING, nullptr);
+        Logger::log(UPDATE_SUCCESS);
+        (void)m_send_state_callback(FW_STATE_UPDATING, nullptr);
+
+        End_Update(true);
+    }
 
-        m_fw_callback->Call_Callback<Logger>(true);
-        (void)m_finish_callback();
+    /// @brief Verifies the received chunk against its expected CRC-32, if the verification has been enabled when the update was started
+    /// @param current_chunk Index of the received chunk
+    /// @param payload Received binary data of the chunk
+    /// @param total_bytes Amount of bytes in the received binary data
+    /// @return Whether the chunk has the expected CRC-32 or is not verified
+    inline bool Verify_Chunk(const size_t& current_chunk, const uint8_t *payload, const size_t& total_bytes) const {
+        if (!m_verify_chunks || current_chunk >= m_callback->Get_Chunk_Checksums_Amount()) {
+            return true;
+        }
+        return Helper::calculateCrc32(payload, total_bytes) == m_callback->Get_Chunk_Checksums()[current_chunk];
     }
 
-    /// @brief Handles errors with the received failure response so that the firmware update can regenerate from any possible issue.
+    /// @brief Calculates how long the next chunk request has to be delayed, because of the start jitter, the download window or the rate limit,
+    /// if the request is not delayed it consumes one token of the rate limit
+    /// @return Time in microseconds the next chunk request has to be delayed, 0 if it can be requested immediately
+    inline uint64_t Get_Request_Delay() {
+        const uint64_t now = Helper::getMicroseconds();
+        if (now < m_start_time) {
+            return m_start_time - now;
+        }
+
+        const OTA_Update_Callback::downloadWindowFn& download_window = m_callback->Get_Download_Window_Callback();
+        if (download_window && !download_window()) {
+            return DOWNLOAD_WINDOW_POLL_INTERVAL;
+        }
+
+        const uint64_t& request_interval = m_callback->Get_Request_Interval();
+        if (request_interval == 0U) {
+            return 0U;
+        }
+        // Token bucket expressed as the time at which it would be empty, which allows requests as long as that time is less than the burst ahead of the current time
+        const uint64_t burst_time = (m_callback->Get_Request_Burst() - 1U) * request_interval;
+        if (m_request_allowed_time > now + burst_time) {
+            return m_request_allowed_time - now - burst_time;
+        }
+        m_request_allowed_time = (m_request_allowed_time > now ? m_request_allowed_time : now) + request_interval;
+        return 0U;
+    }
+
+    /// @brief Reads back the complete written binary data from the updater and hashes it in one bulk pass,
+    /// which verifies the data that actually ended up in memory and allows the hashing to use big blocks, where hardware accelerated hash engines are the most efficient
+    /// @return Whether reading back and hashing the complete written binary data was successful or not
+    inline bool Hash_Written_Data() {
+        uint8_t block[HASH_BLOCK_SIZE];
+        for (size_t offset = 0U; offset < m_size; offset += HASH_BLOCK_SIZE) {
+            const size_t remaining = m_size - offset;
+            const size_t block_size = remaining < HASH_BLOCK_SIZE ? remaining : HASH_BLOCK_SIZE;
+            if (m_updater->read(offset, block, block_size) != block_size || !m_hash.update(block, block_size)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Handles errors with the received failure response so that the update can regenerate from any possible issue.
     /// Will only execute the given failure response as long as there are still retries remaining, if there are not any further issue will cause the update to be aborted
     /// @param failure_response Possible response to a failure that the method should handle
     inline void Handle_Failure(const OTA_Failure_Response& failure_response) {
       if (m_retries <= 0) {
-          m_fw_callback->Call_Callback<Logger>(false);
-          (void)m_finish_callback();
+          End_Update(false);
           return;
       }
 
@@ -289,14 +456,13 @@ class OTA_Handler {
 
       switch (failure_response) {
         case OTA_Failure_Response::RETRY_CHUNK:
-          Request_Next_Firmware_Packet();
+          Request_Next_Packet();
           break;
         case OTA_Failure_Response::RETRY_UPDATE:
-          Request_First_Firmware_Packet();
+          Request_First_Packet();
           break;
         case OTA_Failure_Response::RETRY_NOTHING:
-          m_fw_callback->Call_Callback<Logger>(false);
-          (void)m_finish_callback();
+          End_Update(false);
           break;
         default:
           // Nothing to do
@@ -304,8 +470,24 @@ class OTA_Handler {
       }
     }
 
-    /// @brief Callback that will be called if we did not receive the firmware chunk response in the given timeout time
+    /// @brief Ends the update and informs the user and the owner of this handler about the result,
+    /// afterwards the handler does not process any further packets until the next update is started
+    /// @param success Whether the update was successful or not
+    inline void End_Update(const bool& success) {
+      const OTA_Update_Callback *callback = m_callback;
+      m_callback = nullptr;
+      callback->Call_Callback<Logger>(success);
+      (void)m_finish_callback();
+    }
+
+    /// @brief Callback that will be called if we did not receive the chunk response in the given timeout time
     inline void Handle_Request_Timeout() {
+        // The watchdog only delayed the next request and did not wait for a response, therefore it is not a failure
+        if (m_request_delayed) {
+            m_request_delayed = false;
+            Request_Next_Packet();
+            return;
+        }
         Handle_Failure(OTA_Failure_Response::RETRY_CHUNK);
     }
 };
@@ -0,0 +1,15 @@
+#ifndef OTA_Hash_Mode_h
+#define OTA_Hash_Mode_h
+
+// Library include.
+#include <stdint.h>
+
+
+/// @brief Possible points in the OTA update at which the hash of the binary is calculated, to verify it against the checksum received from the server,
+/// allows to choose between verifying the received data while it is downloaded and verifying the data that actually ended up in memory in one bulk pass once it has been completely written
+enum class OTA_Hash_Mode : const uint8_t {
+    RECEIVED_DATA, // Each received chunk is hashed in the receive callback, directly after it has been written, works with every updater implementation
+    WRITTEN_DATA // Nothing is hashed while downloading, instead the complete binary is read back from the updater and hashed in large blocks once it has been written, which keeps the receive callback short and additionally detects corrupted writes, requires an updater that supports read()
+};
+
+#endif // OTA_Hash_Mode_h
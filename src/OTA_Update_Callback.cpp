@@ -23,7 +23,14 @@ OTA_Update_Callback::OTA_Update_Callback(progressFn progressCb, function endCb,
     m_updater(updater),
     m_retries(chunkRetries),
     m_size(chunkSize),
-    m_timeout(timeout)
+    m_timeout(timeout),
+    m_hash_mode(OTA_Hash_Mode::RECEIVED_DATA),
+    m_chunk_checksums(nullptr),
+    m_chunk_checksums_amount(0U),
+    m_start_jitter(0U),
+    m_request_interval(0U),
+    m_request_burst(1U),
+    m_downloadWindowCb()
 {
     // Nothing to do
 }
@@ -80,4 +87,55 @@ void OTA_Update_Callback::Set_Timeout(const uint64_t &timeout_microseconds) {
     m_timeout = timeout_microseconds;
 }
 
+const OTA_Hash_Mode& OTA_Update_Callback::Get_Hash_Mode() const {
+    return m_hash_mode;
+}
+
+void OTA_Update_Callback::Set_Hash_Mode(const OTA_Hash_Mode &hash_mode) {
+    m_hash_mode = hash_mode;
+}
+
+const uint32_t* OTA_Update_Callback::Get_Chunk_Checksums() const {
+    return m_chunk_checksums;
+}
+
+const size_t& OTA_Update_Callback::Get_Chunk_Checksums_Amount() const {
+    return m_chunk_checksums_amount;
+}
+
+void OTA_Update_Callback::Set_Chunk_Checksums(const uint32_t *chunkChecksums, const size_t &amount) {
+    m_chunk_checksums = chunkChecksums;
+    m_chunk_checksums_amount = (chunkChecksums != nullptr) ? amount : 0U;
+}
+
+const uint64_t& OTA_Update_Callback::Get_Start_Jitter() const {
+    return m_start_jitter;
+}
+
+void OTA_Update_Callback::Set_Start_Jitter(const uint64_t &startJitter) {
+    m_start_jitter = startJitter;
+}
+
+const uint64_t& OTA_Update_Callback::Get_Request_Interval() const {
+    return m_request_interval;
+}
+
+const uint8_t& OTA_Update_Callback::Get_Request_Burst() const {
+    return m_request_burst;
+}
+
+void OTA_Update_Callback::Set_Request_Rate_Limit(const uint64_t &requestInterval, const uint8_t &requestBurst) {
+    m_request_interval = requestInterval;
+    // A burst of 0 would never allow any request, therefore at least one request is always allowed
+    m_request_burst = (requestBurst != 0U) ? requestBurst : 1U;
+}
+
+const OTA_Update_Callback::downloadWindowFn& OTA_Update_Callback::Get_Download_Window_Callback() const {
+    return m_downloadWindowCb;
+}
+
+void OTA_Update_Callback::Set_Download_Window_Callback(downloadWindowFn downloadWindowCb) {
+    m_downloadWindowCb = downloadWindowCb;
+}
+
 #endif // THINGSBOARD_ENABLE_OTA
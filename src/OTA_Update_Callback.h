@@ -7,7 +7,9 @@
 #if THINGSBOARD_ENABLE_OTA
 
 // Local includes.
+#include "Inplace_Function.h"
 #include "IUpdater.h"
+#include "OTA_Hash_Mode.h"
 
 // Library includes.
 #if THINGSBOARD_ENABLE_PROGMEM
@@ -29,10 +31,12 @@ constexpr char OTA_CB_IS_NULL[] = "OTA update callback is NULL";
 constexpr uint8_t CHUNK_RETRIES PROGMEM = 12U;
 constexpr uint16_t CHUNK_SIZE PROGMEM = (4U * 1024U);
 constexpr uint64_t REQUEST_TIMEOUT PROGMEM = (5U * 1000U * 1000U);
+constexpr uint64_t DOWNLOAD_WINDOW_POLL_INTERVAL PROGMEM = (60U * 1000U * 1000U);
 #else
 constexpr uint8_t CHUNK_RETRIES = 12U;
 constexpr uint16_t CHUNK_SIZE = (4U * 1024U);
 constexpr uint64_t REQUEST_TIMEOUT = (5U * 1000U * 1000U);
+constexpr uint64_t DOWNLOAD_WINDOW_POLL_INTERVAL = (60U * 1000U * 1000U);
 #endif // THINGSBOARD_ENABLE_PROGMEM
 
 
@@ -44,7 +48,8 @@ class OTA_Update_Callback : public Callback<void, const bool&> {
     /// @brief OTA firmware update callback signature
     using returnType = void;
     using progressArgumentType = const size_t&;
-    using progressFn = std::function<returnType(progressArgumentType current, progressArgumentType total)>;
+    using progressFn = Inplace_Function<returnType(progressArgumentType current, progressArgumentType total)>;
+    using downloadWindowFn = Inplace_Function<bool(void)>;
 
     /// @brief Constructs empty callback, will result in never being called
     OTA_Update_Callback();
@@ -164,14 +169,79 @@ class OTA_Update_Callback : public Callback<void, const bool&> {
     /// @param timeout_microseconds Timeout time until we expect a response from the server
     void Set_Timeout(const uint64_t &timeout_microseconds);
 
+    /// @brief Gets the point in the update at which the hash of the binary is calculated, to verify it against the checksum received from the server
+    /// @return Point in the update at which the binary is hashed
+    const OTA_Hash_Mode& Get_Hash_Mode() const;
+
+    /// @brief Sets the point in the update at which the hash of the binary is calculated, to verify it against the checksum received from the server.
+    /// Hashing the written data keeps the receive callback short and additionally detects corrupted writes, but requires an updater that supports read(),
+    /// otherwise the update fails as soon as it is started. Not supported by updaters that change the data before writing it, like the Heatshrink_Updater or Delta_Updater
+    /// @param hash_mode Point in the update at which the binary is hashed, default = OTA_Hash_Mode::RECEIVED_DATA
+    void Set_Hash_Mode(const OTA_Hash_Mode &hash_mode);
+
+    /// @brief Gets the expected CRC-32 of each chunk, which every received chunk is verified against before it is written
+    /// @return Expected CRC-32 of each chunk, nullptr if the chunks are not verified
+    const uint32_t* Get_Chunk_Checksums() const;
+
+    /// @brief Gets the amount of chunks an expected CRC-32 has been set for
+    /// @return Amount of chunks an expected CRC-32 has been set for
+    const size_t& Get_Chunk_Checksums_Amount() const;
+
+    /// @brief Sets the expected CRC-32 (IEEE 802.3, the same one used by zlib) of each chunk, which every received chunk is verified against before it is written.
+    /// A corrupted chunk is then requested again directly, instead of only noticing the corruption once the complete binary has been downloaded, which then requires to download the complete binary again.
+    /// The CRC-32 values have to be calculated for chunks of exactly the chunk size set in this callback, meaning the amount has to be the size of the binary divided by the chunk size rounded up.
+    /// Because that can only be checked once the size of the binary is known, a different amount is logged as an error when the update is started and the chunks are then not verified at all
+    /// @param chunkChecksums Expected CRC-32 of each chunk, in the order of the chunks, is not copied and therefore has to be kept alive as long as the update is running, nullptr disables the verification
+    /// @param amount Amount of CRC-32 values in the given array
+    void Set_Chunk_Checksums(const uint32_t *chunkChecksums, const size_t &amount);
+
+    /// @brief Gets the maximum random delay in microseconds, before the first chunk is requested
+    /// @return Maximum random delay before the first chunk is requested
+    const uint64_t& Get_Start_Jitter() const;
+
+    /// @brief Sets the maximum random delay in microseconds, before the first chunk is requested. Because ThingsBoard informs every device of a new firmware at the same time,
+    /// all devices would otherwise start downloading at exactly the same time, spreading the start out reduces the peak load on the shared network and the server
+    /// @param startJitter Maximum random delay before the first chunk is requested, 0 starts the download immediately, default = 0
+    void Set_Start_Jitter(const uint64_t &startJitter);
+
+    /// @brief Gets the minimum average time in microseconds between two chunk requests
+    /// @return Minimum average time between two chunk requests, 0 if the chunk requests are not limited
+    const uint64_t& Get_Request_Interval() const;
+
+    /// @brief Gets the amount of chunks that can be requested directly after each other, if no chunk has been requested for a while
+    /// @return Amount of chunks that can be requested directly after each other
+    const uint8_t& Get_Request_Burst() const;
+
+    /// @brief Sets the limit of chunk requests, implemented as a token bucket that receives one token every request interval, up to the given burst size, with every request consuming one token.
+    /// Requests, including requests that are repeated because of timeouts, are delayed until a token is available, which limits the average download rate to chunk size / request interval
+    /// @param requestInterval Minimum average time in microseconds between two chunk requests, 0 does not limit the chunk requests, default = 0
+    /// @param requestBurst Amount of chunks that can be requested directly after each other, if no chunk has been requested for a while, default = 1
+    void Set_Request_Rate_Limit(const uint64_t &requestInterval, const uint8_t &requestBurst = 1U);
+
+    /// @brief Gets the callback that decides whether chunks are allowed to be requested at the moment
+    /// @return Callback that decides whether chunks are allowed to be requested at the moment
+    const downloadWindowFn& Get_Download_Window_Callback() const;
+
+    /// @brief Sets the callback that decides whether chunks are allowed to be requested at the moment, which allows to restrict the download to a time window, for example during the night.
+    /// While the callback returns false, requesting the next chunk is postponed and the callback is called again after DOWNLOAD_WINDOW_POLL_INTERVAL, the already downloaded chunks are kept
+    /// @param downloadWindowCb Callback that returns whether chunks are allowed to be requested at the moment, an empty callback always allows requesting chunks
+    void Set_Download_Window_Callback(downloadWindowFn downloadWindowCb);
+
   private:
-    progressFn      m_progressCb;    // Progress callback to call
-    const char      *m_fwTitel;      // Current firmware title of device
-    const char      *m_fwVersion;    // Current firmware version of device
-    IUpdater        *m_updater;      // Updater implementation used to write firmware data
-    uint8_t         m_retries;       // Maximum amount of retries for a single chunk to be downloaded and flashes successfully
-    uint16_t        m_size;          // Size of chunks the firmware data will be split into
-    uint64_t        m_timeout;       // How long we wait for each chunck to arrive before declaring it as failed
+    progressFn       m_progressCb;              // Progress callback to call
+    const char       *m_fwTitel;                // Current firmware title of device
+    const char       *m_fwVersion;              // Current firmware version of device
+    IUpdater         *m_updater;                // Updater implementation used to write firmware data
+    uint8_t          m_retries;                 // Maximum amount of retries for a single chunk to be downloaded and flashes successfully
+    uint16_t         m_size;                    // Size of chunks the firmware data will be split into
+    uint64_t         m_timeout;                 // How long we wait for each chunck to arrive before declaring it as failed
+    OTA_Hash_Mode    m_hash_mode;               // Point in the update at which the binary is hashed
+    const uint32_t   *m_chunk_checksums;        // Expected CRC-32 of each chunk, nullptr if the chunks are not verified
+    size_t           m_chunk_checksums_amount;  // Amount of chunks an expected CRC-32 has been set for
+    uint64_t         m_start_jitter;            // Maximum random delay before the first chunk is requested
+    uint64_t         m_request_interval;        // Minimum average time between two chunk requests
+    uint8_t          m_request_burst;           // Amount of chunks that can be requested directly after each other
+    downloadWindowFn m_downloadWindowCb;        // Callback that decides whether chunks are allowed to be requested at the moment
 };
 
 #endif // THINGSBOARD_ENABLE_OTA
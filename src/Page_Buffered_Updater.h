@@ -0,0 +1,117 @@
+#ifndef Page_Buffered_Updater_h
+#define Page_Buffered_Updater_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_ENABLE_OTA
+
+// Local include.
+#include "IUpdater.h"
+
+// Library include.
+#include <string.h>
+
+
+/// @brief IUpdater decorator that coalesces the received chunks into blocks of exactly PageSize bytes, before they are passed to the given updater.
+/// Because the received chunks are seldom a multiple of the flash page size, writing them directly causes pages to be programmed multiple times,
+/// which is slower and causes additional wear. With this decorator every page is programmed exactly once, apart from the last one, which is written in read() or end().
+/// Chunks are passed through without copying them, as long as the buffered page is empty and the chunk contains at least one complete page
+/// @tparam PageSize Size of a flash page in bytes, the decorator contains a buffer of that size, default = 4096
+template <size_t PageSize = 4096U>
+class Page_Buffered_Updater : public IUpdater {
+  public:
+    /// @brief Constructor
+    /// @param updater Updater implementation the coalesced pages are written with, is not copied and therefore has to be kept alive as long as the decorator is used
+    inline Page_Buffered_Updater(IUpdater& updater) :
+        m_updater(updater),
+        m_page(),
+        m_page_size(0U)
+    {
+        // Nothing to do
+    }
+
+    bool begin(const size_t& data_size) override {
+        m_page_size = 0U;
+        return m_updater.begin(data_size);
+    }
+
+    size_t write(uint8_t* payload, const size_t& total_bytes) override {
+        size_t offset = 0U;
+
+        // Fill up the partially buffered page first, to ensure the next page starts at an aligned offset again
+        if (m_page_size != 0U) {
+            offset = Append_To_Page(payload, total_bytes);
+            if (m_page_size == PageSize && !Write_Page()) {
+                return 0U;
+            }
+        }
+
+        // Pass every complete page directly to the underlying updater, without copying it into the buffer first
+        while (m_page_size == 0U && total_bytes - offset >= PageSize) {
+            if (m_updater.write(payload + offset, PageSize) != PageSize) {
+                return 0U;
+            }
+            offset += PageSize;
+        }
+
+        // Buffer the remaining bytes, which do not fill up a complete page yet
+        (void)Append_To_Page(payload + offset, total_bytes - offset);
+        return total_bytes;
+    }
+
+    void reset() override {
+        m_page_size = 0U;
+        m_updater.reset();
+    }
+
+    bool supports_read() const override {
+        return m_updater.supports_read();
+    }
+
+    size_t read(const size_t& offset, uint8_t* buffer, const size_t& total_bytes) override {
+        // The written data is only read back once the complete binary has been received, therefore the last, partially filled page has to be written first,
+        // otherwise its bytes would be missing from the read back data. Writing it early does not cause an additional page write, because end() then has nothing left to write
+        if (m_page_size != 0U && !Write_Page()) {
+            return 0U;
+        }
+        return m_updater.read(offset, buffer, total_bytes);
+    }
+
+    bool end() override {
+        // Write the last page, which is most likely only partially filled
+        if (m_page_size != 0U && !Write_Page()) {
+            return false;
+        }
+        return m_updater.end();
+    }
+
+  private:
+    /// @brief Copies as many of the given bytes into the buffered page as still fit into it
+    /// @param payload Data that should be buffered
+    /// @param total_bytes Amount of bytes in the given data
+    /// @return Amount of bytes that have been copied into the buffered page
+    inline size_t Append_To_Page(const uint8_t *payload, const size_t& total_bytes) {
+        const size_t remaining = PageSize - m_page_size;
+        const size_t copied_bytes = total_bytes < remaining ? total_bytes : remaining;
+        memcpy(m_page + m_page_size, payload, copied_bytes);
+        m_page_size += copied_bytes;
+        return copied_bytes;
+    }
+
+    /// @brief Writes the buffered page with the underlying updater and empties the buffer afterwards
+    /// @return Whether the complete buffered page has been written successfully or not
+    inline bool Write_Page() {
+        const size_t page_size = m_page_size;
+        m_page_size = 0U;
+        return m_updater.write(m_page, page_size) == page_size;
+    }
+
+    IUpdater& m_updater;       // Updater implementation the coalesced pages are written with
+    uint8_t m_page[PageSize];  // Buffered page, that is not completely filled yet
+    size_t m_page_size;        // Amount of bytes in the buffered page
+};
+
+#endif // THINGSBOARD_ENABLE_OTA
+
+#endif // Page_Buffered_Updater_h
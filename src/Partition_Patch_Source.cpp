@@ -0,0 +1,27 @@
+// Header include.
+#include "Partition_Patch_Source.h"
+
+#if THINGSBOARD_ENABLE_OTA
+
+#if THINGSBOARD_USE_ESP_PARTITION
+
+// Library include.
+#include <esp_ota_ops.h>
+
+Partition_Patch_Source::Partition_Patch_Source() {
+    // Nothing to do
+}
+
+size_t Partition_Patch_Source::read(const size_t& offset, uint8_t* buffer, const size_t& total_bytes) {
+    const esp_partition_t *partition = esp_ota_get_running_partition();
+
+    if (partition == nullptr || offset > partition->size || total_bytes > partition->size - offset) {
+        return 0U;
+    }
+    const esp_err_t error = esp_partition_read(partition, offset, buffer, total_bytes);
+    return (error == ESP_OK) ? total_bytes : 0U;
+}
+
+#endif // THINGSBOARD_USE_ESP_PARTITION
+
+#endif // THINGSBOARD_ENABLE_OTA
@@ -0,0 +1,30 @@
+#ifndef Partition_Patch_Source_h
+#define Partition_Patch_Source_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_ENABLE_OTA
+
+#if THINGSBOARD_USE_ESP_PARTITION
+
+// Local include.
+#include "IPatch_Source.h"
+
+
+/// @brief IPatch_Source implementation that uses the Partition API from Espressif (https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/storage/partition.html)
+/// under the hood to read the currently installed image directly from the application partition the device is currently running from.
+/// Because the Espressif_Updater writes into the other application partition, the running image stays unchanged while the delta update is applied
+class Partition_Patch_Source : public IPatch_Source {
+  public:
+    /// @brief Constructor
+    Partition_Patch_Source();
+
+    size_t read(const size_t& offset, uint8_t* buffer, const size_t& total_bytes) override;
+};
+
+#endif // THINGSBOARD_USE_ESP_PARTITION
+
+#endif // THINGSBOARD_ENABLE_OTA
+
+#endif // Partition_Patch_Source_h
@@ -0,0 +1,78 @@
+// Header include.
+#include "Partition_Updater.h"
+
+#if THINGSBOARD_ENABLE_OTA
+
+#if THINGSBOARD_USE_ESP_PARTITION
+
+// Library include.
+#include <esp_partition.h>
+
+// Size of a single flash sector, the smallest area that can be erased at once.
+constexpr size_t FLASH_SECTOR_SIZE = 4096U;
+
+Partition_Updater::Partition_Updater(const char *label) :
+    m_label(label),
+    m_partition(nullptr),
+    m_size(0U),
+    m_written(0U)
+{
+    // Nothing to do
+}
+
+bool Partition_Updater::begin(const size_t& partition_size) {
+    reset();
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, m_label);
+
+    if (partition == nullptr || partition_size > partition->size) {
+        return false;
+    }
+
+    // Only erase the sectors that are actually needed, instead of the complete partition, which speeds up smaller updates on big partitions
+    const size_t erase_size = ((partition_size + FLASH_SECTOR_SIZE - 1U) / FLASH_SECTOR_SIZE) * FLASH_SECTOR_SIZE;
+    const esp_err_t error = esp_partition_erase_range(partition, 0U, erase_size);
+
+    if (error != ESP_OK) {
+        return false;
+    }
+
+    m_partition = partition;
+    m_size = partition_size;
+    return true;
+}
+
+size_t Partition_Updater::write(uint8_t* payload, const size_t& total_bytes) {
+    if (m_partition == nullptr || m_written + total_bytes > m_size) {
+        return 0U;
+    }
+    const esp_err_t error = esp_partition_write(static_cast<const esp_partition_t*>(m_partition), m_written, payload, total_bytes);
+    const size_t written_bytes = (error == ESP_OK) ? total_bytes : 0U;
+    m_written += written_bytes;
+    return written_bytes;
+}
+
+void Partition_Updater::reset() {
+    m_partition = nullptr;
+    m_size = 0U;
+    m_written = 0U;
+}
+
+bool Partition_Updater::supports_read() const {
+    return true;
+}
+
+size_t Partition_Updater::read(const size_t& offset, uint8_t* buffer, const size_t& total_bytes) {
+    if (m_partition == nullptr || offset > m_written || total_bytes > m_written - offset) {
+        return 0U;
+    }
+    const esp_err_t error = esp_partition_read(static_cast<const esp_partition_t*>(m_partition), offset, buffer, total_bytes);
+    return (error == ESP_OK) ? total_bytes : 0U;
+}
+
+bool Partition_Updater::end() {
+    return m_partition != nullptr && m_written == m_size;
+}
+
+#endif // THINGSBOARD_USE_ESP_PARTITION
+
+#endif // THINGSBOARD_ENABLE_OTA
@@ -0,0 +1,48 @@
+#ifndef Partition_Updater_h
+#define Partition_Updater_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_ENABLE_OTA
+
+#if THINGSBOARD_USE_ESP_PARTITION
+
+// Local include.
+#include "IUpdater.h"
+
+
+/// @brief IUpdater implementation that uses the Partition API from Espressif (https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/storage/partition.html)
+/// under the hood to write the given binary data directly into the data partition with the given label, without any file system in between.
+/// The needed sectors are erased in begin() and the partition is not marked as bootable, therefore it should be used for software or data artifacts and not for firmware
+class Partition_Updater : public IUpdater {
+  public:
+    /// @brief Constructor
+    /// @param label Label of the data partition the received binary data is written into, as configured in the partition table.
+    /// Is not copied and therefore has to be kept alive as long as the updater is used
+    Partition_Updater(const char *label);
+
+    bool begin(const size_t& partition_size) override;
+  
+    size_t write(uint8_t* payload, const size_t& total_bytes) override;
+
+    void reset() override;
+
+    bool supports_read() const override;
+
+    size_t read(const size_t& offset, uint8_t* buffer, const size_t& total_bytes) override;
+  
+    bool end() override;
+
+  private:
+    const char *m_label;      // Label of the data partition the received binary data is written into
+    const void *m_partition;  // Found partition with the given label, nullptr if no update is running
+    size_t     m_size;        // Total size of the data that should be written
+    size_t     m_written;     // Amount of bytes that have already been written, which is the offset the next data is written at
+};
+
+#endif // THINGSBOARD_USE_ESP_PARTITION
+
+#endif // THINGSBOARD_ENABLE_OTA
+
+#endif // Partition_Updater_h
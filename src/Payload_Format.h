@@ -0,0 +1,981 @@
+#ifndef Payload_Format_h
+#define Payload_Format_h
+
+// Local includes.
+#include "Configuration.h"
+#include "Constants.h"
+#include "Helper.h"
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <ArduinoJson.h>
+
+
+/// ---------------------------------
+/// Payload format policies.
+/// ---------------------------------
+// Every payload format policy has to implement the same methods, meaning size_t Measure(type, source, json_size), size_t Serialize(type, source, buffer, size),
+// size_t Serialize(type, source, print), size_t Get_Document_Size(type, payload, length), DeserializationError Deserialize(type, document, payload, length)
+// and bool Use_Json_Downlink(), as well as the static constexpr bool Is_Text, which decides whether the encoded payload can be printed for debugging purposes.
+// If a policy can not encode the given source, Measure() returns 0, which causes the message to be rejected with an error log instead of being sent.
+// The policy is only applied to the messages listed in Payload_Type, every other message exchanged with ThingsBoard,
+// like attribute requests, client-side RPC requests, provisioning, claiming or firmware updates are always encoded as json, because the server expects them in that format.
+// Messages received over the default downlink topics, meaning server-side RPC requests, shared attribute updates and the responses to attribute requests and client-side RPC requests,
+// are all decoded with the same format, which is json if Use_Json_Downlink() returns true and the format of the policy otherwise.
+// This mirrors the "Use JSON format for default downlink topics" setting of the device profile, which decides the format for all of those topics at once.
+// Those messages are passed to the Json_Payload_Format as Payload_Type::OTHER, which means the payload format policy of the ThingsBoard class never receives that type.
+// The type of the message is passed to every method, which allows formats that need a different schema for each kind of message.
+
+
+/// @brief Kinds of messages the payload format policy of the ThingsBoard class is applied to
+enum class Payload_Type : const uint8_t {
+    TELEMETRY,    // Telemetry sent to the server
+    ATTRIBUTES,   // Client-side attributes sent to the server
+    RPC_REQUEST,  // Server-side RPC request received from the server
+    RPC_RESPONSE, // Response to a server-side RPC request sent to the server
+    ATTRIBUTE_UPDATE,    // Shared attribute update received from the server
+    ATTRIBUTE_RESPONSE,  // Response to a client-side or shared attribute request received from the server
+    CLIENT_RPC_RESPONSE, // Response to a client-side RPC request received from the server
+    OTHER         // Every other message, which is always encoded as json and therefore only ever passed to the Json_Payload_Format
+};
+
+
+/// @brief Payload format policy that encodes and decodes messages as json text, which is the format ThingsBoard expects by default
+struct Json_Payload_Format {
+    static constexpr bool Is_Text = true;
+
+    /// @brief Returns whether messages received over the default downlink topics are decoded as json instead of with this format
+    /// @return Always true, because this format is json itself
+    inline bool Use_Json_Downlink() const {
+        return true;
+    }
+
+    /// @brief Returns the amount of bytes the given source needs once it has been encoded
+    /// @tparam TSource Source class that should be measured
+    /// @param type Kind of message the source is sent as
+    /// @param source Data source containing our json key value pairs we want to measure
+    /// @param json_size Size of the source serialized as json including the null terminator, as it has already been measured by the caller
+    /// @return Amount of bytes the encoded payload needs, without any null terminator
+    template <typename TSource>
+    inline size_t Measure(const Payload_Type& type, const TSource& source, const size_t& json_size) const {
+        (void)type;
+        (void)source;
+        return json_size == 0U ? 0U : json_size - 1U;
+    }
+
+    /// @brief Encodes the given source into the given buffer
+    /// @tparam TSource Source class that should be encoded
+    /// @param type Kind of message the source is sent as
+    /// @param source Data source containing our json key value pairs we want to encode
+    /// @param buffer Buffer the encoded payload is written into, has to be atleast one byte bigger than the measured size
+    /// @param size Size of the buffer
+    /// @return Amount of bytes written into the buffer, without any null terminator
+    template <typename TSource>
+    inline size_t Serialize(const Payload_Type& type, const TSource& source, uint8_t *buffer, const size_t& size) const {
+        (void)type;
+        return serializeJson(source, reinterpret_cast<char*>(buffer), size);
+    }
+
+    /// @brief Encodes the given source directly into the given print implementation
+    /// @tparam TSource Source class that should be encoded
+    /// @tparam TPrint Print implementation the payload is written into
+    /// @param type Kind of message the source is sent as
+    /// @param source Data source containing our json key value pairs we want to encode
+    /// @param destination Print implementation the encoded payload is written into
+    /// @return Amount of bytes written into the print implementation
+    template <typename TSource, typename TPrint>
+    inline size_t Serialize(const Payload_Type& type, const TSource& source, TPrint& destination) const {
+        (void)type;
+        return serializeJson(source, destination);
+    }
+
+    /// @brief Estimates the capacity the JsonDocument needs to decode the given payload, keys and strings are not copied and therefore not included
+    /// @param type Kind of message the payload has been received as
+    /// @param payload Received payload
+    /// @param length Length of the received payload
+    /// @return Capacity the JsonDocument needs
+    inline size_t Get_Document_Size(const Payload_Type& type, uint8_t *payload, const size_t& length) const {
+        (void)type;
+        (void)length;
+        return JSON_OBJECT_SIZE(Helper::getOccurences(reinterpret_cast<char*>(payload), COLON));
+    }
+
+    /// @brief Decodes the given payload into the given JsonDocument, the payload is modified to allow referencing the keys and strings instead of copying them
+    /// @tparam TDocument Type of the JsonDocument the payload is decoded into
+    /// @param type Kind of message the payload has been received as
+    /// @param document JsonDocument the payload is decoded into
+    /// @param payload Received payload
+    /// @param length Length of the received payload
+    /// @return Error that occured while decoding the payload
+    template <typename TDocument>
+    inline DeserializationError Deserialize(const Payload_Type& type, TDocument& document, uint8_t *payload, const size_t& length) const {
+        (void)type;
+        return deserializeJson(document, payload, length);
+    }
+};
+
+
+/// @brief Payload format policy that encodes and decodes messages as MessagePack (https://msgpack.org/), which is often only half as big as json for numeric telemetry
+/// and does not need to parse or print numbers as text. ThingsBoard itself does not decode MessagePack on the device transport,
+/// therefore the messages have to be converted on the way to the server, for example by an integration with an uplink converter or by a gateway
+struct MsgPack_Payload_Format {
+    static constexpr bool Is_Text = false;
+
+    /// @brief Constructor, decodes messages received over the default downlink topics as MessagePack
+    inline MsgPack_Payload_Format() :
+        m_json_downlink(false)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Returns whether messages received over the default downlink topics are decoded as json instead of as MessagePack
+    /// @return Whether the default downlink topics are decoded as json
+    inline bool Use_Json_Downlink() const {
+        return m_json_downlink;
+    }
+
+    /// @brief Sets whether messages received over the default downlink topics, meaning server-side RPC requests, shared attribute updates
+    /// and the responses to attribute requests and client-side RPC requests, are decoded as json instead of as MessagePack.
+    /// Should be enabled if the downlink converter of the integration or gateway forwards those messages as json
+    /// @param json_downlink Whether the default downlink topics are decoded as json
+    inline void Set_Json_Downlink(const bool& json_downlink) {
+        m_json_downlink = json_downlink;
+    }
+
+    /// @brief Returns the amount of bytes the given source needs once it has been encoded
+    /// @tparam TSource Source class that should be measured
+    /// @param type Kind of message the source is sent as
+    /// @param source Data source containing our json key value pairs we want to measure
+    /// @param json_size Size of the source serialized as json including the null terminator, ignored because it differs from the encoded size
+    /// @return Amount of bytes the encoded payload needs
+    template <typename TSource>
+    inline size_t Measure(const Payload_Type& type, const TSource& source, const size_t& json_size) const {
+        (void)type;
+        (void)json_size;
+        return measureMsgPack(source);
+    }
+
+    /// @brief Encodes the given source into the given buffer
+    /// @tparam TSource Source class that should be encoded
+    /// @param type Kind of message the source is sent as
+    /// @param source Data source containing our json key value pairs we want to encode
+    /// @param buffer Buffer the encoded payload is written into, has to be atleast as big as the measured size
+    /// @param size Size of the buffer
+    /// @return Amount of bytes written into the buffer
+    template <typename TSource>
+    inline size_t Serialize(const Payload_Type& type, const TSource& source, uint8_t *buffer, const size_t& size) const {
+        (void)type;
+        return serializeMsgPack(source, reinterpret_cast<char*>(buffer), size);
+    }
+
+    /// @brief Encodes the given source directly into the given print implementation
+    /// @tparam TSource Source class that should be encoded
+    /// @tparam TPrint Print implementation the payload is written into
+    /// @param type Kind of message the source is sent as
+    /// @param source Data source containing our json key value pairs we want to encode
+    /// @param destination Print implementation the encoded payload is written into
+    /// @return Amount of bytes written into the print implementation
+    template <typename TSource, typename TPrint>
+    inline size_t Serialize(const Payload_Type& type, const TSource& source, TPrint& destination) const {
+        (void)type;
+        return serializeMsgPack(source, destination);
+    }
+
+    /// @brief Estimates the capacity the JsonDocument needs to decode the given payload, keys and strings are not copied and therefore not included.
+    /// Every key-value pair needs atleast two bytes, one for the key and one for the value, which gives an upper bound for the amount of members
+    /// @param type Kind of message the payload has been received as
+    /// @param payload Received payload
+    /// @param length Length of the received payload
+    /// @return Capacity the JsonDocument needs
+    inline size_t Get_Document_Size(const Payload_Type& type, uint8_t *payload, const size_t& length) const {
+        (void)type;
+        (void)payload;
+        return JSON_OBJECT_SIZE((length / 2U) + 1U);
+    }
+
+    /// @brief Decodes the given payload into the given JsonDocument, the payload is modified to allow referencing the keys and strings instead of copying them
+    /// @tparam TDocument Type of the JsonDocument the payload is decoded into
+    /// @param type Kind of message the payload has been received as
+    /// @param document JsonDocument the payload is decoded into
+    /// @param payload Received payload
+    /// @param length Length of the received payload
+    /// @return Error that occured while decoding the payload
+    template <typename TDocument>
+    inline DeserializationError Deserialize(const Payload_Type& type, TDocument& document, uint8_t *payload, const size_t& length) const {
+        (void)type;
+        return deserializeMsgPack(document, payload, length);
+    }
+
+  private:
+    bool m_json_downlink; // Whether messages received over the default downlink topics are decoded as json instead of as MessagePack
+};
+
+/// @brief Field types of the protobuf schema the Protobuf_Payload_Format encodes and decodes the key-value pairs with,
+/// see https://protobuf.dev/programming-guides/proto3/#scalar for more information on the scalar value types
+enum class Protobuf_Field_Type : const uint8_t {
+    BOOL,   // bool, encoded as varint
+    INT32,  // int32, encoded as varint, negative values always need 10 bytes
+    INT64,  // int64, encoded as varint, negative values always need 10 bytes
+    UINT32, // uint32, encoded as varint
+    UINT64, // uint64, encoded as varint
+    SINT32, // sint32, encoded as zigzag varint, more efficient than int32 for negative values
+    SINT64, // sint64, encoded as zigzag varint, more efficient than int64 for negative values
+    FLOAT,  // float, encoded as fixed 4 bytes
+    DOUBLE, // double, encoded as fixed 8 bytes
+    STRING, // string, encoded as length-delimited bytes
+    JSON,   // string containing the value serialized as json, which is how ThingsBoard transports the params of RPC requests and the payload of RPC responses
+    KEY_VALUE_LIST // repeated TsKvProto, which is how ThingsBoard transports received attributes, every entry is decoded into one key-value pair of a nested object, can only be decoded
+};
+
+
+/// @brief Single field of the protobuf schema, mapping the key of a json key-value pair to the field number and type in the .proto file
+struct Protobuf_Field {
+    const char *key;          // Key of the json key-value pair, is not copied and therefore has to be kept alive, nullptr in combination with JSON encodes or decodes the complete message as json
+    uint32_t number;          // Field number of the field in the .proto file
+    Protobuf_Field_Type type; // Type of the field in the .proto file
+};
+
+
+// Default schema of server-side RPC requests, if the device profile does not change it.
+// message RpcRequestMsg { optional string method = 1; optional int32 requestId = 2; optional string params = 3; }
+constexpr Protobuf_Field PROTOBUF_RPC_REQUEST_SCHEMA[] = {
+    { "method", 1U, Protobuf_Field_Type::STRING },
+    { "requestId", 2U, Protobuf_Field_Type::INT32 },
+    { "params", 3U, Protobuf_Field_Type::JSON }
+};
+// Default schema of server-side RPC responses, if the device profile does not change it.
+// message RpcResponseMsg { optional string payload = 1; }
+constexpr Protobuf_Field PROTOBUF_RPC_RESPONSE_SCHEMA[] = {
+    { nullptr, 1U, Protobuf_Field_Type::JSON }
+};
+// Schema of shared attribute updates, as sent by ThingsBoard. The updated attributes are decoded into the nested "shared" object, deleted attributes are skipped.
+// message AttributeUpdateNotificationMsg { repeated TsKvProto sharedUpdated = 1; repeated string sharedDeleted = 2; }
+constexpr Protobuf_Field PROTOBUF_ATTRIBUTE_UPDATE_SCHEMA[] = {
+    { "shared", 1U, Protobuf_Field_Type::KEY_VALUE_LIST }
+};
+// Schema of the responses to attribute requests, as sent by ThingsBoard. The attributes are decoded into the nested "client" and "shared" objects, like in the json response.
+// message GetAttributeResponseMsg { int32 requestId = 1; repeated TsKvProto clientAttributeList = 2; repeated TsKvProto sharedAttributeList = 3; ... }
+constexpr Protobuf_Field PROTOBUF_ATTRIBUTE_RESPONSE_SCHEMA[] = {
+    { "client", 2U, Protobuf_Field_Type::KEY_VALUE_LIST },
+    { "shared", 3U, Protobuf_Field_Type::KEY_VALUE_LIST }
+};
+// Schema of the responses to client-side RPC requests, as sent by ThingsBoard. The payload replaces the complete message, like in the json response.
+// message ToServerRpcResponseMsg { int32 requestId = 1; string payload = 2; string error = 3; }
+constexpr Protobuf_Field PROTOBUF_CLIENT_RPC_RESPONSE_SCHEMA[] = {
+    { nullptr, 2U, Protobuf_Field_Type::JSON }
+};
+
+
+/// @brief Payload format policy that encodes and decodes messages with the protobuf wire format (https://protobuf.dev/programming-guides/encoding/),
+/// which is what ThingsBoard expects if the MQTT transport payload type of the device profile is set to Protobuf.
+/// Similar to nanopb the messages are never built as an intermediate object, instead the key-value pairs are directly written into the send buffer or read from the received payload,
+/// meaning the policy itself never allocates any memory. Received strings are null terminated in place inside of the received payload and therefore not copied either.
+/// The schema of each kind of message is given as an array of Protobuf_Field, which has to match the .proto schema configured in the device profile.
+/// Telemetry and attributes need a schema set with Set_Schema() before they can be sent, key-value pairs that are not part of the schema are silently skipped,
+/// while server-side RPC requests and responses use the default schema ThingsBoard uses as well. Received attributes and client-side RPC responses are decoded with the fixed schema ThingsBoard sends them with.
+/// Nested messages and repeated fields are not supported, except for the repeated TsKvProto the received attributes are transported in.
+/// A message that contains a value that is not a string for a string field, or that does not contain any field of the schema at all, is rejected instead of being sent
+class Protobuf_Payload_Format {
+  public:
+    static constexpr bool Is_Text = false;
+
+    /// @brief Constructor, uses the default ThingsBoard schema for server-side RPC requests and responses, received attributes and client-side RPC responses
+    /// and an empty schema for telemetry and attributes. Messages received over the default downlink topics are decoded as protobuf
+    inline Protobuf_Payload_Format() :
+        m_fields{ nullptr, nullptr, PROTOBUF_RPC_REQUEST_SCHEMA, PROTOBUF_RPC_RESPONSE_SCHEMA, PROTOBUF_ATTRIBUTE_UPDATE_SCHEMA, PROTOBUF_ATTRIBUTE_RESPONSE_SCHEMA, PROTOBUF_CLIENT_RPC_RESPONSE_SCHEMA, nullptr },
+        m_field_counts{ 0U, 0U, sizeof(PROTOBUF_RPC_REQUEST_SCHEMA) / sizeof(Protobuf_Field), sizeof(PROTOBUF_RPC_RESPONSE_SCHEMA) / sizeof(Protobuf_Field),
+          sizeof(PROTOBUF_ATTRIBUTE_UPDATE_SCHEMA) / sizeof(Protobuf_Field), sizeof(PROTOBUF_ATTRIBUTE_RESPONSE_SCHEMA) / sizeof(Protobuf_Field), sizeof(PROTOBUF_CLIENT_RPC_RESPONSE_SCHEMA) / sizeof(Protobuf_Field), 0U },
+        m_json_downlink(false)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Returns whether messages received over the default downlink topics are decoded as json instead of as protobuf
+    /// @return Whether the default downlink topics are decoded as json
+    inline bool Use_Json_Downlink() const {
+        return m_json_downlink;
+    }
+
+    /// @brief Sets whether messages received over the default downlink topics, meaning server-side RPC requests, shared attribute updates
+    /// and the responses to attribute requests and client-side RPC requests, are decoded as json instead of as protobuf.
+    /// Has to match the "Use JSON format for default downlink topics" setting of the device profile, which is disabled per default
+    /// @param json_downlink Whether the default downlink topics are decoded as json
+    inline void Set_Json_Downlink(const bool& json_downlink) {
+        m_json_downlink = json_downlink;
+    }
+
+    /// @brief Sets the schema the given kind of message is encoded and decoded with
+    /// @param type Kind of message the schema should be used for
+    /// @param fields Fields of the schema, are not copied and therefore have to be kept alive as long as the schema is used
+    /// @param count Amount of fields in the schema
+    inline void Set_Schema(const Payload_Type& type, const Protobuf_Field *fields, const size_t& count) {
+        const uint8_t index = static_cast<uint8_t>(type);
+        m_fields[index] = fields;
+        m_field_counts[index] = count;
+    }
+
+    /// @brief Sets the schema the given kind of message is encoded and decoded with
+    /// @tparam Count Amount of fields in the schema, deduced from the given array
+    /// @param type Kind of message the schema should be used for
+    /// @param fields Fields of the schema, are not copied and therefore have to be kept alive as long as the schema is used
+    template <size_t Count>
+    inline void Set_Schema(const Payload_Type& type, const Protobuf_Field (&fields)[Count]) {
+        Set_Schema(type, fields, Count);
+    }
+
+    /// @brief Returns the amount of bytes the given source needs once it has been encoded
+    /// @tparam TSource Source class that should be measured
+    /// @param type Kind of message the source is sent as
+    /// @param source Data source containing our json key value pairs we want to measure
+    /// @param json_size Size of the source serialized as json including the null terminator, ignored because it differs from the encoded size
+    /// @return Amount of bytes the encoded payload needs, 0 if the source is rejected
+    template <typename TSource>
+    inline size_t Measure(const Payload_Type& type, const TSource& source, const size_t& json_size) const {
+        (void)json_size;
+        Counting_Writer writer;
+        return Encode(type, source, writer);
+    }
+
+    /// @brief Encodes the given source into the given buffer
+    /// @tparam TSource Source class that should be encoded
+    /// @param type Kind of message the source is sent as
+    /// @param source Data source containing our json key value pairs we want to encode
+    /// @param buffer Buffer the encoded payload is written into, has to be atleast as big as the measured size
+    /// @param size Size of the buffer
+    /// @return Amount of bytes written into the buffer
+    template <typename TSource>
+    inline size_t Serialize(const Payload_Type& type, const TSource& source, uint8_t *buffer, const size_t& size) const {
+        Buffer_Writer writer(buffer, size);
+        return Encode(type, source, writer);
+    }
+
+    /// @brief Encodes the given source directly into the given print implementation
+    /// @tparam TSource Source class that should be encoded
+    /// @tparam TPrint Print implementation the payload is written into
+    /// @param type Kind of message the source is sent as
+    /// @param source Data source containing our json key value pairs we want to encode
+    /// @param destination Print implementation the encoded payload is written into
+    /// @return Amount of bytes written into the print implementation
+    template <typename TSource, typename TPrint>
+    inline size_t Serialize(const Payload_Type& type, const TSource& source, TPrint& destination) const {
+        return Encode(type, source, destination);
+    }
+
+    /// @brief Returns the capacity the JsonDocument needs to decode the given payload, strings are not copied and therefore not included.
+    /// Every field of the schema is decoded into one key-value pair, which gives an upper bound for the amount of members.
+    /// If the schema contains a json field its value is decoded into nested members as well, where every member needs atleast two bytes of the payload.
+    /// If the schema contains a key-value list every entry is decoded into a nested member, where every entry needs atleast seven bytes of the payload,
+    /// and its values can contain json as well
+    /// @param type Kind of message the payload has been received as
+    /// @param payload Received payload
+    /// @param length Length of the received payload
+    /// @return Capacity the JsonDocument needs
+    inline size_t Get_Document_Size(const Payload_Type& type, uint8_t *payload, const size_t& length) const {
+        (void)payload;
+        const uint8_t index = static_cast<uint8_t>(type);
+        size_t capacity = JSON_OBJECT_SIZE(m_field_counts[index]);
+        bool contains_json = false;
+        bool contains_list = false;
+        for (size_t i = 0U; i < m_field_counts[index]; i++) {
+            contains_json = contains_json || m_fields[index][i].type == Protobuf_Field_Type::JSON || m_fields[index][i].type == Protobuf_Field_Type::KEY_VALUE_LIST;
+            contains_list = contains_list || m_fields[index][i].type == Protobuf_Field_Type::KEY_VALUE_LIST;
+        }
+        if (contains_json) {
+            capacity += JSON_OBJECT_SIZE((length / 2U) + 1U);
+        }
+        if (contains_list) {
+            capacity += JSON_OBJECT_SIZE((length / MIN_KEY_VALUE_SIZE) + 1U);
+        }
+        return capacity;
+    }
+
+    /// @brief Decodes the given payload into the given JsonDocument, the payload is modified to null terminate received strings in place instead of copying them.
+    /// Fields that are not part of the schema or have a different wire type than expected are skipped, json fields are decoded into nested values,
+    /// which means the params of server-side RPC requests reach the callback the same way they would if they were received as json.
+    /// A json field without a key replaces the complete message and key-value lists are decoded into a nested object with the key of the field,
+    /// which means received attributes reach the callback the same way they would if they were received as json
+    /// @tparam TDocument Type of the JsonDocument the payload is decoded into
+    /// @param type Kind of message the payload has been received as
+    /// @param document JsonDocument the payload is decoded into
+    /// @param payload Received payload
+    /// @param length Length of the received payload
+    /// @return Error that occured while decoding the payload
+    template <typename TDocument>
+    inline DeserializationError Deserialize(const Payload_Type& type, TDocument& document, uint8_t *payload, const size_t& length) const {
+        JsonObject object = document.template to<JsonObject>();
+        size_t position = 0U;
+
+        while (position < length) {
+            uint32_t number = 0U;
+            uint8_t wire_type = 0U;
+            uint64_t value = 0U;
+            size_t start = 0U;
+            if (!Read_Field(payload, length, position, number, wire_type, value, start)) {
+                return DeserializationError::InvalidInput;
+            }
+
+            const Protobuf_Field *field = Find_Field(type, number);
+            if (field == nullptr || Get_Wire_Type(field->type) != wire_type) {
+                continue;
+            }
+
+            bool decoded = true;
+            if (field->type == Protobuf_Field_Type::KEY_VALUE_LIST) {
+                if (field->key == nullptr) {
+                    continue;
+                }
+                JsonObject list = object[field->key].template as<JsonObject>();
+                if (list.isNull()) {
+                    list = object.createNestedObject(field->key);
+                }
+                decoded = Decode_Key_Value(document, list, payload, start, start + value);
+            }
+            else if (field->key == nullptr) {
+                if (field->type != Protobuf_Field_Type::JSON) {
+                    continue;
+                }
+                decoded = Decode_Value(document, document.template as<JsonVariant>(), field->type, value, payload, start);
+            }
+            else {
+                decoded = Decode_Value(document, object[field->key], field->type, value, payload, start);
+            }
+
+            if (!decoded) {
+                return DeserializationError::NoMemory;
+            }
+        }
+        return DeserializationError::Ok;
+    }
+
+  private:
+    static constexpr uint8_t WIRE_TYPE_BITS = 3U;
+    static constexpr uint8_t WIRE_TYPE_MASK = 0x07U;
+    static constexpr uint8_t WIRE_TYPE_VARINT = 0U;
+    static constexpr uint8_t WIRE_TYPE_FIXED64 = 1U;
+    static constexpr uint8_t WIRE_TYPE_LENGTH_DELIMITED = 2U;
+    static constexpr uint8_t WIRE_TYPE_FIXED32 = 5U;
+    static constexpr uint8_t MAX_VARINT_SIZE = 10U;
+    static constexpr size_t PAYLOAD_TYPE_AMOUNT = 8U;
+    static constexpr uint8_t MIN_KEY_VALUE_SIZE = 7U;
+    // Fields of the nested messages the entries of a KEY_VALUE_LIST are transported in, as defined in the transport.proto of ThingsBoard.
+    // message TsKvProto { int64 ts = 1; KeyValueProto kv = 2; }
+    // message KeyValueProto { string key = 1; KeyValueType type = 2; bool bool_v = 3; int64 long_v = 4; double double_v = 5; string string_v = 6; string json_v = 7; }
+    static constexpr uint32_t TS_KV_FIELD = 2U;
+    static constexpr uint32_t KEY_FIELD = 1U;
+    static constexpr uint32_t TYPE_FIELD = 2U;
+    static constexpr uint32_t BOOL_FIELD = 3U;
+    static constexpr uint32_t LONG_FIELD = 4U;
+    static constexpr uint32_t DOUBLE_FIELD = 5U;
+    static constexpr uint32_t STRING_FIELD = 6U;
+    static constexpr uint32_t JSON_FIELD = 7U;
+    // Values of the KeyValueType enum { BOOLEAN_V = 0; LONG_V = 1; DOUBLE_V = 2; STRING_V = 3; JSON_V = 4; },
+    // which decides which of the value fields of the KeyValueProto is set, the field number is always BOOL_FIELD + type
+    static constexpr uint64_t BOOLEAN_V = 0U;
+    static constexpr uint64_t STRING_V = 3U;
+    static constexpr uint64_t JSON_V = 4U;
+
+#if ARDUINOJSON_USE_LONG_LONG
+    using Signed_Integer = int64_t;
+    using Unsigned_Integer = uint64_t;
+#else
+    using Signed_Integer = int32_t;
+    using Unsigned_Integer = uint32_t;
+#endif // ARDUINOJSON_USE_LONG_LONG
+
+    /// @brief Writer that only counts the written bytes, used to measure the encoded size without any buffer
+    class Counting_Writer {
+      public:
+        inline size_t write(uint8_t payload_byte) {
+            (void)payload_byte;
+            return 1U;
+        }
+
+        inline size_t write(const uint8_t *buffer, size_t size) {
+            (void)buffer;
+            return size;
+        }
+    };
+
+    /// @brief Writer that copies the written bytes into a fixed size buffer and refuses to write past its end
+    class Buffer_Writer {
+      public:
+        inline Buffer_Writer(uint8_t *buffer, const size_t& size) :
+            m_buffer(buffer),
+            m_size(size),
+            m_position(0U)
+        {
+            // Nothing to do
+        }
+
+        inline size_t write(uint8_t payload_byte) {
+            return write(&payload_byte, 1U);
+        }
+
+        inline size_t write(const uint8_t *buffer, size_t size) {
+            const size_t remaining = m_size - m_position;
+            const size_t count = size < remaining ? size : remaining;
+            memcpy(m_buffer + m_position, buffer, count);
+            m_position += count;
+            return count;
+        }
+
+      private:
+        uint8_t *m_buffer; // Buffer the bytes are copied into
+        size_t m_size;     // Size of the buffer
+        size_t m_position; // Amount of bytes that have been copied into the buffer
+    };
+
+    /// @brief Encodes every field of the schema of the given kind of message that is contained in the given source into the given writer
+    /// @tparam TSource Source class that should be encoded
+    /// @tparam TWriter Writer the encoded payload is written into, has to implement write(uint8_t) and write(const uint8_t*, size_t)
+    /// @param type Kind of message the source is sent as
+    /// @param source Data source containing our json key value pairs we want to encode
+    /// @param writer Writer the encoded payload is written into
+    /// @return Amount of bytes written into the writer
+    template <typename TSource, typename TWriter>
+    inline size_t Encode(const Payload_Type& type, const TSource& source, TWriter& writer) const {
+        const JsonVariantConst root = source;
+        const uint8_t index = static_cast<uint8_t>(type);
+        // Checked before anything is written, so that a rejected message is neither measured nor partially written into the given writer
+        for (size_t i = 0U; i < m_field_counts[index]; i++) {
+            if (!Is_Encodable(m_fields[index][i], root)) {
+                return 0U;
+            }
+        }
+        size_t bytes = 0U;
+        for (size_t i = 0U; i < m_field_counts[index]; i++) {
+            bytes += Encode_Field(m_fields[index][i], root, writer);
+        }
+        return bytes;
+    }
+
+    /// @brief Checks whether the value the given source contains for the given field can be encoded with the type of the field.
+    /// Numbers and booleans are converted between each other like ArduinoJson does, but a value that is not a string can not be encoded as a string field,
+    /// because it would otherwise be sent as an empty string, which the server can not tell apart from an actually empty value
+    /// @param field Field of the schema that should be checked
+    /// @param root Data source containing our json key value pairs we want to encode
+    /// @return Whether the field can be encoded or is not contained in the source, false if the message has to be rejected
+    static inline bool Is_Encodable(const Protobuf_Field& field, const JsonVariantConst& root) {
+        if (field.type != Protobuf_Field_Type::STRING || field.key == nullptr) {
+            return true;
+        }
+        const JsonVariantConst value = root[field.key];
+        return value.isNull() || value.is<const char*>();
+    }
+
+    /// @brief Encodes a single field of the schema, if the given source contains a value for it
+    /// @tparam TWriter Writer the encoded payload is written into
+    /// @param field Field of the schema that should be encoded
+    /// @param root Data source containing our json key value pairs we want to encode
+    /// @param writer Writer the encoded payload is written into
+    /// @return Amount of bytes written into the writer, 0 if the source does not contain a value for the field
+    template <typename TWriter>
+    static inline size_t Encode_Field(const Protobuf_Field& field, const JsonVariantConst& root, TWriter& writer) {
+        const JsonVariantConst value = field.key == nullptr ? root : root[field.key];
+        if (value.isNull() || (field.key == nullptr && field.type != Protobuf_Field_Type::JSON) || field.type == Protobuf_Field_Type::KEY_VALUE_LIST) {
+            return 0U;
+        }
+
+        size_t bytes = Write_Varint(writer, (static_cast<uint64_t>(field.number) << WIRE_TYPE_BITS) | Get_Wire_Type(field.type));
+        switch (field.type) {
+            case Protobuf_Field_Type::BOOL:
+                bytes += Write_Varint(writer, value.as<bool>() ? 1U : 0U);
+                break;
+            case Protobuf_Field_Type::INT32:
+                bytes += Write_Varint(writer, static_cast<uint64_t>(static_cast<int64_t>(value.as<int32_t>())));
+                break;
+            case Protobuf_Field_Type::INT64:
+                bytes += Write_Varint(writer, static_cast<uint64_t>(static_cast<int64_t>(value.as<Signed_Integer>())));
+                break;
+            case Protobuf_Field_Type::UINT32:
+                bytes += Write_Varint(writer, value.as<uint32_t>());
+                break;
+            case Protobuf_Field_Type::UINT64:
+                bytes += Write_Varint(writer, value.as<Unsigned_Integer>());
+                break;
+            case Protobuf_Field_Type::SINT32:
+            case Protobuf_Field_Type::SINT64: {
+                const int64_t number = field.type == Protobuf_Field_Type::SINT32 ? value.as<int32_t>() : value.as<Signed_Integer>();
+                // Zigzag encoding maps small negative numbers to small unsigned numbers, -1 to 1, 1 to 2, -2 to 3 and so on
+                bytes += Write_Varint(writer, (static_cast<uint64_t>(number) << 1U) ^ static_cast<uint64_t>(number >> 63U));
+                break;
+            }
+            case Protobuf_Field_Type::FLOAT: {
+                const float number = value.as<float>();
+                uint32_t bits = 0U;
+                memcpy(&bits, &number, sizeof(bits));
+                bytes += Write_Fixed(writer, bits, sizeof(bits));
+                break;
+            }
+            case Protobuf_Field_Type::DOUBLE: {
+                const double number = value.as<double>();
+                uint64_t bits = 0U;
+                memcpy(&bits, &number, sizeof(bits));
+                bytes += Write_Fixed(writer, bits, sizeof(bits));
+                break;
+            }
+            case Protobuf_Field_Type::STRING: {
+                const char *text = value.as<const char*>();
+                const size_t text_length = strlen(text);
+                bytes += Write_Varint(writer, text_length);
+                bytes += writer.write(reinterpret_cast<const uint8_t*>(text), text_length);
+                break;
+            }
+            case Protobuf_Field_Type::JSON:
+                bytes += Write_Varint(writer, measureJson(value));
+                bytes += serializeJson(value, writer);
+                break;
+            case Protobuf_Field_Type::KEY_VALUE_LIST:
+                // Already skipped above, because key-value lists can only be decoded
+                break;
+        }
+        return bytes;
+    }
+
+    /// @brief Decodes a single received value of the given type into the given JsonVariant
+    /// @tparam TDocument Type of the JsonDocument the payload is decoded into
+    /// @tparam TVariant Type of the JsonVariant or member of a JsonObject the value is decoded into
+    /// @param document JsonDocument the payload is decoded into, decides which kind of JsonDocument json fields are parsed with
+    /// @param variant JsonVariant the value is decoded into
+    /// @param type Type of the field in the schema
+    /// @param value Received varint or fixed value, or the length of a length-delimited value
+    /// @param payload Received payload
+    /// @param start Index of the first byte of a length-delimited value in the received payload
+    /// @return Whether the value could be stored in the JsonDocument or not
+    template <typename TDocument, typename TVariant>
+    static inline bool Decode_Value(const TDocument& document, TVariant variant, const Protobuf_Field_Type& type, const uint64_t& value, uint8_t *payload, const size_t& start) {
+        switch (type) {
+            case Protobuf_Field_Type::BOOL:
+                return variant.set(value != 0U);
+            case Protobuf_Field_Type::INT32:
+                return variant.set(static_cast<int32_t>(static_cast<uint32_t>(value)));
+            case Protobuf_Field_Type::INT64:
+                return variant.set(static_cast<Signed_Integer>(static_cast<int64_t>(value)));
+            case Protobuf_Field_Type::UINT32:
+                return variant.set(static_cast<uint32_t>(value));
+            case Protobuf_Field_Type::UINT64:
+                return variant.set(static_cast<Unsigned_Integer>(value));
+            case Protobuf_Field_Type::SINT32:
+            case Protobuf_Field_Type::SINT64: {
+                const int64_t number = static_cast<int64_t>(value >> 1U) ^ -static_cast<int64_t>(value & 1U);
+                return type == Protobuf_Field_Type::SINT32 ? variant.set(static_cast<int32_t>(number)) : variant.set(static_cast<Signed_Integer>(number));
+            }
+            case Protobuf_Field_Type::FLOAT: {
+                const uint32_t bits = static_cast<uint32_t>(value);
+                float number = 0.0f;
+                memcpy(&number, &bits, sizeof(number));
+                return variant.set(number);
+            }
+            case Protobuf_Field_Type::DOUBLE: {
+                double number = 0.0;
+                memcpy(&number, &value, sizeof(number));
+                return variant.set(number);
+            }
+            case Protobuf_Field_Type::STRING:
+            case Protobuf_Field_Type::JSON: {
+                // The string is moved one byte to the front, over the last byte of its length prefix, which has already been read,
+                // this frees the byte after the string for the null terminator without touching the following field
+                // and allows the JsonDocument to reference the string instead of copying it
+                char *text = reinterpret_cast<char*>(payload + start - 1U);
+                memmove(text, payload + start, value);
+                text[value] = '\0';
+                if (type == Protobuf_Field_Type::JSON) {
+                    return Decode_Json(document, variant, text, value);
+                }
+                return variant.set(const_cast<const char*>(text));
+            }
+            case Protobuf_Field_Type::KEY_VALUE_LIST:
+                // Decoded with Decode_Key_Value() instead, because every entry is a nested message
+                break;
+        }
+        return false;
+    }
+
+    /// @brief Decodes a single received TsKvProto entry of a key-value list into the given JsonObject, the key and string values are null terminated in place.
+    /// Proto3 does not send fields that contain their default value, therefore a missing type is a boolean and a missing value is false, 0 or an empty string
+    /// @tparam TDocument Type of the JsonDocument the payload is decoded into
+    /// @param document JsonDocument the payload is decoded into, decides which kind of JsonDocument json values are parsed with
+    /// @param list JsonObject the key-value pair is added to
+    /// @param payload Received payload
+    /// @param start Index of the first byte of the TsKvProto in the received payload
+    /// @param end Index of one-past-the-end byte of the TsKvProto in the received payload
+    /// @return Whether the entry was valid and could be stored in the JsonDocument or not
+    template <typename TDocument>
+    static inline bool Decode_Key_Value(const TDocument& document, JsonObject list, uint8_t *payload, const size_t& start, const size_t& end) {
+        size_t position = start;
+        size_t kv_start = 0U;
+        size_t kv_end = 0U;
+        while (position < end) {
+            uint32_t number = 0U;
+            uint8_t wire_type = 0U;
+            uint64_t value = 0U;
+            size_t value_start = 0U;
+            if (!Read_Field(payload, end, position, number, wire_type, value, value_start)) {
+                return false;
+            }
+            if (number == TS_KV_FIELD && wire_type == WIRE_TYPE_LENGTH_DELIMITED) {
+                kv_start = value_start;
+                kv_end = value_start + value;
+            }
+        }
+
+        uint64_t key_length = 0U;
+        size_t key_start = 0U;
+        uint64_t kv_type = BOOLEAN_V;
+        uint32_t kv_value_number = 0U;
+        uint64_t kv_value = 0U;
+        size_t kv_value_start = 0U;
+        position = kv_start;
+        while (position < kv_end) {
+            uint32_t number = 0U;
+            uint8_t wire_type = 0U;
+            uint64_t value = 0U;
+            size_t value_start = 0U;
+            if (!Read_Field(payload, kv_end, position, number, wire_type, value, value_start)) {
+                return false;
+            }
+            if (number == KEY_FIELD && wire_type == WIRE_TYPE_LENGTH_DELIMITED) {
+                key_length = value;
+                key_start = value_start;
+            }
+            else if (number == TYPE_FIELD && wire_type == WIRE_TYPE_VARINT) {
+                kv_type = value;
+            }
+            else if (number >= BOOL_FIELD && number <= JSON_FIELD && wire_type == Get_Wire_Type(Get_Value_Type(number))) {
+                kv_value_number = number;
+                kv_value = value;
+                kv_value_start = value_start;
+            }
+        }
+        if (key_start == 0U || kv_type > JSON_V) {
+            // Entries without a key or with an unknown type can not be added to the JsonObject and are skipped
+            return true;
+        }
+
+        // The key is moved one byte to the front the same way as a string value, see Decode_Value() for more information
+        char *key = reinterpret_cast<char*>(payload + key_start - 1U);
+        memmove(key, payload + key_start, key_length);
+        key[key_length] = '\0';
+        auto member = list[const_cast<const char*>(key)];
+
+        // The type decides which value field is set, a missing or different value field means the value is the default of that type
+        const uint32_t value_number = BOOL_FIELD + static_cast<uint32_t>(kv_type);
+        if (kv_value_number != value_number) {
+            kv_value = 0U;
+            if (kv_type == STRING_V || kv_type == JSON_V) {
+                return member.set("");
+            }
+        }
+        return Decode_Value(document, member, Get_Value_Type(value_number), kv_value, payload, kv_value_start);
+    }
+
+    /// @brief Gets the field type the given value field of the KeyValueProto is decoded with
+    /// @param number Field number of the value field
+    /// @return Field type of the value field
+    static inline Protobuf_Field_Type Get_Value_Type(const uint32_t& number) {
+        switch (number) {
+            case BOOL_FIELD:
+                return Protobuf_Field_Type::BOOL;
+            case LONG_FIELD:
+                return Protobuf_Field_Type::INT64;
+            case DOUBLE_FIELD:
+                return Protobuf_Field_Type::DOUBLE;
+            case STRING_FIELD:
+                return Protobuf_Field_Type::STRING;
+            default:
+                return Protobuf_Field_Type::JSON;
+        }
+    }
+
+    /// @brief Parses the received json text of a json field into the given JsonVariant. ArduinoJson can only parse into a complete JsonDocument,
+    /// therefore the text is parsed into a temporary JsonDocument first, which does not copy any strings because the text is writeable,
+    /// and the result is then copied into the given JsonVariant. Text that is not valid json is kept as a string instead, because ThingsBoard passes plain text that way
+    /// @tparam Capacity Capacity of the JsonDocument the payload is decoded into, the temporary JsonDocument uses the same capacity on the stack
+    /// @tparam TVariant Type of the JsonVariant or member of a JsonObject the value is decoded into
+    /// @param variant JsonVariant the value is decoded into
+    /// @param text Received json text, null terminated in place
+    /// @param length Length of the received json text
+    /// @return Whether the value could be stored in the JsonDocument or not
+    template <size_t Capacity, typename TVariant>
+    static inline bool Decode_Json(const StaticJsonDocument<Capacity>&, TVariant variant, char *text, const size_t& length) {
+        StaticJsonDocument<Capacity> parsed;
+        return Copy_Json(parsed, variant, text, length);
+    }
+
+    /// @brief Parses the received json text of a json field into the given JsonVariant, see the overload for StaticJsonDocument for more information
+    /// @tparam TAllocator Allocator of the JsonDocument the payload is decoded into, the temporary JsonDocument is allocated with the same allocator
+    /// @tparam TVariant Type of the JsonVariant or member of a JsonObject the value is decoded into
+    /// @param variant JsonVariant the value is decoded into
+    /// @param text Received json text, null terminated in place
+    /// @param length Length of the received json text
+    /// @return Whether the value could be stored in the JsonDocument or not
+    template <typename TAllocator, typename TVariant>
+    static inline bool Decode_Json(const BasicJsonDocument<TAllocator>&, TVariant variant, char *text, const size_t& length) {
+        BasicJsonDocument<TAllocator> parsed(JSON_OBJECT_SIZE((length / 2U) + 1U));
+        return Copy_Json(parsed, variant, text, length);
+    }
+
+    /// @brief Parses the received json text into the given temporary JsonDocument and copies the result into the given JsonVariant
+    /// @tparam TDocument Type of the temporary JsonDocument
+    /// @tparam TVariant Type of the JsonVariant or member of a JsonObject the value is decoded into
+    /// @param parsed Temporary JsonDocument the text is parsed into
+    /// @param variant JsonVariant the value is decoded into
+    /// @param text Received json text, null terminated in place
+    /// @param length Length of the received json text
+    /// @return Whether the value could be stored in the JsonDocument or not
+    template <typename TDocument, typename TVariant>
+    static inline bool Copy_Json(TDocument& parsed, TVariant variant, char *text, const size_t& length) {
+        const DeserializationError error = deserializeJson(parsed, text, length);
+        if (error == DeserializationError::InvalidInput) {
+            return variant.set(const_cast<const char*>(text));
+        }
+        return !error && variant.set(parsed.template as<JsonVariantConst>());
+    }
+
+    /// @brief Gets the field of the schema of the given kind of message with the given field number
+    /// @param type Kind of message the payload has been received as
+    /// @param number Field number of the received field
+    /// @return Field of the schema or nullptr if the schema does not contain the field number
+    inline const Protobuf_Field* Find_Field(const Payload_Type& type, const uint32_t& number) const {
+        const uint8_t index = static_cast<uint8_t>(type);
+        for (size_t i = 0U; i < m_field_counts[index]; i++) {
+            if (m_fields[index][i].number == number) {
+                return &m_fields[index][i];
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief Gets the wire type the given field type is encoded with
+    /// @param type Type of the field in the schema
+    /// @return Wire type of the field
+    static inline uint8_t Get_Wire_Type(const Protobuf_Field_Type& type) {
+        switch (type) {
+            case Protobuf_Field_Type::FLOAT:
+                return WIRE_TYPE_FIXED32;
+            case Protobuf_Field_Type::DOUBLE:
+                return WIRE_TYPE_FIXED64;
+            case Protobuf_Field_Type::STRING:
+            case Protobuf_Field_Type::JSON:
+            case Protobuf_Field_Type::KEY_VALUE_LIST:
+                return WIRE_TYPE_LENGTH_DELIMITED;
+            default:
+                return WIRE_TYPE_VARINT;
+        }
+    }
+
+    /// @brief Writes the given value as a varint, 7 bits per byte with the highest bit set if more bytes follow
+    /// @tparam TWriter Writer the value is written into
+    /// @param writer Writer the value is written into
+    /// @param value Value that should be written
+    /// @return Amount of bytes written into the writer
+    template <typename TWriter>
+    static inline size_t Write_Varint(TWriter& writer, uint64_t value) {
+        uint8_t encoded[MAX_VARINT_SIZE];
+        size_t size = 0U;
+        do {
+            encoded[size] = static_cast<uint8_t>(value & 0x7FU);
+            value >>= 7U;
+            if (value != 0U) {
+                encoded[size] |= 0x80U;
+            }
+            size++;
+        } while (value != 0U);
+        return writer.write(encoded, size);
+    }
+
+    /// @brief Writes the given value as a fixed amount of little endian bytes
+    /// @tparam TWriter Writer the value is written into
+    /// @param writer Writer the value is written into
+    /// @param value Value that should be written
+    /// @param size Amount of bytes that should be written, either 4 or 8
+    /// @return Amount of bytes written into the writer
+    template <typename TWriter>
+    static inline size_t Write_Fixed(TWriter& writer, const uint64_t& value, const size_t& size) {
+        uint8_t encoded[sizeof(uint64_t)];
+        for (size_t i = 0U; i < size; i++) {
+            encoded[i] = static_cast<uint8_t>(value >> (i * 8U));
+        }
+        return writer.write(encoded, size);
+    }
+
+    /// @brief Reads a varint from the given payload
+    /// @param payload Received payload
+    /// @param length Length of the received payload
+    /// @param position Index of the first byte of the varint, is moved past the varint
+    /// @param value Read value
+    /// @return Whether the varint was complete and not longer than 10 bytes or not
+    static inline bool Read_Varint(const uint8_t *payload, const size_t& length, size_t& position, uint64_t& value) {
+        value = 0U;
+        for (uint8_t shift = 0U; shift < MAX_VARINT_SIZE * 7U && position < length; shift += 7U) {
+            const uint8_t current = payload[position++];
+            value |= static_cast<uint64_t>(current & 0x7FU) << shift;
+            if ((current & 0x80U) == 0U) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Reads the tag and the value of the next field from the given payload, the content of length-delimited values is skipped
+    /// @param payload Received payload
+    /// @param length Length of the received payload, or index of one-past-the-end byte of the nested message that is read
+    /// @param position Index of the first byte of the field, is moved past the field
+    /// @param number Field number of the read field
+    /// @param wire_type Wire type of the read field
+    /// @param value Read varint or fixed value, or the length of a length-delimited value
+    /// @param start Index of the first byte of a length-delimited value
+    /// @return Whether the field was complete or not
+    static inline bool Read_Field(const uint8_t *payload, const size_t& length, size_t& position, uint32_t& number, uint8_t& wire_type, uint64_t& value, size_t& start) {
+        uint64_t tag = 0U;
+        if (!Read_Varint(payload, length, position, tag)) {
+            return false;
+        }
+        number = static_cast<uint32_t>(tag >> WIRE_TYPE_BITS);
+        wire_type = tag & WIRE_TYPE_MASK;
+        start = position;
+        switch (wire_type) {
+            case WIRE_TYPE_VARINT:
+                return Read_Varint(payload, length, position, value);
+            case WIRE_TYPE_FIXED64:
+                return Read_Fixed(payload, length, position, sizeof(uint64_t), value);
+            case WIRE_TYPE_LENGTH_DELIMITED:
+                if (!Read_Varint(payload, length, position, value) || value > length - position) {
+                    return false;
+                }
+                start = position;
+                position += value;
+                return true;
+            case WIRE_TYPE_FIXED32:
+                return Read_Fixed(payload, length, position, sizeof(uint32_t), value);
+            default:
+                return false;
+        }
+    }
+
+    /// @brief Reads a fixed amount of little endian bytes from the given payload
+    /// @param payload Received payload
+    /// @param length Length of the received payload
+    /// @param position Index of the first byte of the value, is moved past the value
+    /// @param size Amount of bytes that should be read, either 4 or 8
+    /// @param value Read value
+    /// @return Whether the payload contained enough bytes or not
+    static inline bool Read_Fixed(const uint8_t *payload, const size_t& length, size_t& position, const size_t& size, uint64_t& value) {
+        if (length - position < size) {
+            return false;
+        }
+        value = 0U;
+        for (size_t i = 0U; i < size; i++) {
+            value |= static_cast<uint64_t>(payload[position++]) << (i * 8U);
+        }
+        return true;
+    }
+
+    const Protobuf_Field *m_fields[PAYLOAD_TYPE_AMOUNT]; // Schema of each kind of message, indexed by Payload_Type
+    size_t m_field_counts[PAYLOAD_TYPE_AMOUNT];          // Amount of fields in the schema of each kind of message, indexed by Payload_Type
+    bool m_json_downlink;                                // Whether messages received over the default downlink topics are decoded as json instead of as protobuf
+};
+
+#endif // Payload_Format_h
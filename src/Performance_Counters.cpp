@@ -0,0 +1,201 @@
+// Header include.
+#include "Performance_Counters.h"
+
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+
+// Library includes.
+#include <string.h>
+
+
+// Upper bound of the first bucket in the latency histogram, each following bucket doubles the upper bound of the previous bucket.
+constexpr uint64_t FIRST_BUCKET_UPPER_BOUND_MICROSECONDS = 64U;
+
+
+Latency_Histogram::Latency_Histogram() :
+    m_buckets(),
+    m_count(0U),
+    m_sum(0U),
+    m_maximum(0U)
+{
+    // Nothing to do
+}
+
+void Latency_Histogram::Record(const uint64_t& microseconds) {
+    size_t index = 0U;
+    // Searching the bucket linearly is fine, because there are only a few buckets and most latencies fall into the first ones
+    while (index < BUCKET_AMOUNT - 1U && microseconds >= Get_Bucket_Upper_Bound(index)) {
+        index++;
+    }
+    m_buckets[index]++;
+    m_count++;
+    m_sum += microseconds;
+    if (microseconds > m_maximum) {
+        m_maximum = microseconds;
+    }
+}
+
+uint32_t Latency_Histogram::Get_Count() const {
+    return m_count;
+}
+
+uint64_t Latency_Histogram::Get_Average() const {
+    if (m_count == 0U) {
+        return 0U;
+    }
+    return m_sum / m_count;
+}
+
+uint64_t Latency_Histogram::Get_Maximum() const {
+    return m_maximum;
+}
+
+uint64_t Latency_Histogram::Get_Percentile(const uint8_t& percentile) const {
+    if (m_count == 0U) {
+        return 0U;
+    }
+    // Amount of recorded latencies that have to be smaller or equal to the returned value, rounded up
+    const uint64_t needed = (static_cast<uint64_t>(m_count) * (percentile > 100U ? 100U : percentile) + 99U) / 100U;
+    uint64_t current = 0U;
+    for (size_t index = 0U; index < BUCKET_AMOUNT - 1U; index++) {
+        current += m_buckets[index];
+        if (current >= needed) {
+            const uint64_t upper_bound = Get_Bucket_Upper_Bound(index);
+            // The maximum is more accurate than the upper bound if it falls into the same bucket
+            return m_maximum < upper_bound ? m_maximum : upper_bound;
+        }
+    }
+    return m_maximum;
+}
+
+uint32_t Latency_Histogram::Get_Bucket_Count(const size_t& index) const {
+    if (index >= BUCKET_AMOUNT) {
+        return 0U;
+    }
+    return m_buckets[index];
+}
+
+uint64_t Latency_Histogram::Get_Bucket_Upper_Bound(const size_t& index) {
+    return FIRST_BUCKET_UPPER_BOUND_MICROSECONDS << index;
+}
+
+void Latency_Histogram::Reset() {
+    memset(m_buckets, 0, sizeof(m_buckets));
+    m_count = 0U;
+    m_sum = 0U;
+    m_maximum = 0U;
+}
+
+Performance_Counters::Performance_Counters() :
+    m_sent(),
+    m_received(),
+    m_serialization_failures(0U),
+    m_deserialization_failures(0U),
+    m_oversize_drops(0U),
+    m_largest_heap_allocations(),
+    m_rpc_latency(),
+    m_ota_chunk_round_trip()
+{
+    // Nothing to do
+}
+
+void Performance_Counters::Record_Sent(const Topic_Class& topic_class, const size_t& bytes) {
+    Traffic_Counter& counter = m_sent[static_cast<size_t>(topic_class)];
+    counter.messages++;
+    counter.bytes += bytes;
+}
+
+void Performance_Counters::Record_Received(const Topic_Class& topic_class, const size_t& bytes) {
+    Traffic_Counter& counter = m_received[static_cast<size_t>(topic_class)];
+    counter.messages++;
+    counter.bytes += bytes;
+}
+
+void Performance_Counters::Record_Serialization_Failure() {
+    m_serialization_failures++;
+}
+
+void Performance_Counters::Record_Deserialization_Failure() {
+    m_deserialization_failures++;
+}
+
+void Performance_Counters::Record_Oversize_Drop() {
+    m_oversize_drops++;
+}
+
+void Performance_Counters::Record_Heap_Allocation(const Allocation_Path& path, const size_t& bytes) {
+    size_t& largest_allocation = m_largest_heap_allocations[static_cast<size_t>(path)];
+    if (bytes > largest_allocation) {
+        largest_allocation = bytes;
+    }
+}
+
+const Performance_Counters::Traffic_Counter& Performance_Counters::Get_Sent(const Topic_Class& topic_class) const {
+    return m_sent[static_cast<size_t>(topic_class)];
+}
+
+const Performance_Counters::Traffic_Counter& Performance_Counters::Get_Received(const Topic_Class& topic_class) const {
+    return m_received[static_cast<size_t>(topic_class)];
+}
+
+Performance_Counters::Traffic_Counter Performance_Counters::Get_Total_Sent() const {
+    Traffic_Counter total = {};
+    for (const Traffic_Counter& counter : m_sent) {
+        total.messages += counter.messages;
+        total.bytes += counter.bytes;
+    }
+    return total;
+}
+
+Performance_Counters::Traffic_Counter Performance_Counters::Get_Total_Received() const {
+    Traffic_Counter total = {};
+    for (const Traffic_Counter& counter : m_received) {
+        total.messages += counter.messages;
+        total.bytes += counter.bytes;
+    }
+    return total;
+}
+
+uint32_t Performance_Counters::Get_Serialization_Failures() const {
+    return m_serialization_failures;
+}
+
+uint32_t Performance_Counters::Get_Deserialization_Failures() const {
+    return m_deserialization_failures;
+}
+
+uint32_t Performance_Counters::Get_Oversize_Drops() const {
+    return m_oversize_drops;
+}
+
+size_t Performance_Counters::Get_Largest_Heap_Allocation(const Allocation_Path& path) const {
+    return m_largest_heap_allocations[static_cast<size_t>(path)];
+}
+
+Latency_Histogram& Performance_Counters::Get_RPC_Latency() {
+    return m_rpc_latency;
+}
+
+const Latency_Histogram& Performance_Counters::Get_RPC_Latency() const {
+    return m_rpc_latency;
+}
+
+Latency_Histogram& Performance_Counters::Get_OTA_Chunk_Round_Trip() {
+    return m_ota_chunk_round_trip;
+}
+
+const Latency_Histogram& Performance_Counters::Get_OTA_Chunk_Round_Trip() const {
+    return m_ota_chunk_round_trip;
+}
+
+void Performance_Counters::Reset() {
+    memset(m_sent, 0, sizeof(m_sent));
+    memset(m_received, 0, sizeof(m_received));
+    m_serialization_failures = 0U;
+    m_deserialization_failures = 0U;
+    m_oversize_drops = 0U;
+    memset(m_largest_heap_allocations, 0, sizeof(m_largest_heap_allocations));
+    m_rpc_latency.Reset();
+    m_ota_chunk_round_trip.Reset();
+}
+
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
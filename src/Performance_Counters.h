@@ -0,0 +1,201 @@
+#ifndef Performance_Counters_h
+#define Performance_Counters_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+
+// Library include.
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// @brief Classes of MQTT topics the sent and received messages are grouped into,
+/// allows to see which feature causes most of the traffic without having to keep counters for every possible topic
+enum class Topic_Class : const uint8_t {
+    TELEMETRY, // Telemetry data sent to the server
+    ATTRIBUTE, // Client-side attributes sent to the server or shared attribute updates received from the server
+    ATTRIBUTE_REQUEST, // Client-side or shared attribute requests and their responses
+    RPC, // Server-side RPC requests and their responses
+    RPC_REQUEST, // Client-side RPC requests and their responses
+    PROVISION, // Provisioning requests and their responses
+    CLAIM, // Claiming requests
+    FIRMWARE, // Firmware chunk requests and responses
+    SOFTWARE, // Software chunk requests and responses
+    OTHER, // Any other topic, mainly custom topics passed directly to Send_Json or Send_Json_String
+    AMOUNT // Amount of topic classes, has to stay the last entry
+};
+
+/// @brief Code paths the SDK allocates memory on the heap for, because the needed size would exceed the maximum stack size,
+/// allows to see which path would need to be given more memory if the device runs low on heap
+enum class Allocation_Path : const uint8_t {
+    SEND, // Serialized json payloads that are sent to the server
+    RECEIVE, // Json documents the received payloads are deserialized into
+    OTA, // Firmware or software chunks that are received from the server
+    AMOUNT // Amount of allocation paths, has to stay the last entry
+};
+
+/// @brief Fixed size histogram of latencies in microseconds, where each bucket covers twice the range of the previous bucket.
+/// Does not allocate any memory and recording a value only requires a few comparisons,
+/// meaning it can be used in hot paths like the handling of received MQTT messages
+class Latency_Histogram {
+  public:
+    /// @brief Amount of buckets in the histogram, the last bucket contains every latency bigger than the upper bound of the second to last bucket
+    static constexpr size_t BUCKET_AMOUNT = 16U;
+
+    /// @brief Constructor
+    Latency_Histogram();
+
+    /// @brief Records the given latency into the histogram
+    /// @param microseconds Latency that should be recorded
+    void Record(const uint64_t& microseconds);
+
+    /// @brief Gets the amount of latencies that have been recorded
+    /// @return Amount of recorded latencies
+    uint32_t Get_Count() const;
+
+    /// @brief Gets the average of all recorded latencies
+    /// @return Average latency in microseconds or 0 if nothing has been recorded yet
+    uint64_t Get_Average() const;
+
+    /// @brief Gets the biggest recorded latency
+    /// @return Maximum latency in microseconds
+    uint64_t Get_Maximum() const;
+
+    /// @brief Gets an approximation of the given percentile, by returning the upper bound of the bucket the given percentile falls into
+    /// @param percentile Percentile we want to receive, has to be between 0 and 100
+    /// @return Upper bound in microseconds of the bucket that contains the given percentile or the maximum if it falls into the last bucket
+    uint64_t Get_Percentile(const uint8_t& percentile) const;
+
+    /// @brief Gets the amount of latencies recorded into the bucket with the given index
+    /// @param index Index of the bucket, has to be smaller than BUCKET_AMOUNT
+    /// @return Amount of recorded latencies in the given bucket or 0 if the index is out of range
+    uint32_t Get_Bucket_Count(const size_t& index) const;
+
+    /// @brief Gets the upper bound of the bucket with the given index
+    /// @param index Index of the bucket, has to be smaller than BUCKET_AMOUNT
+    /// @return Exclusive upper bound in microseconds of the given bucket
+    static uint64_t Get_Bucket_Upper_Bound(const size_t& index);
+
+    /// @brief Resets all recorded latencies
+    void Reset();
+
+  private:
+    uint32_t m_buckets[BUCKET_AMOUNT]; // Amount of latencies recorded in each bucket
+    uint32_t m_count;                  // Total amount of recorded latencies
+    uint64_t m_sum;                    // Sum of all recorded latencies, used to calculate the average
+    uint64_t m_maximum;                // Biggest recorded latency
+};
+
+/// @brief Lightweight counters kept by the ThingsBoard class to diagnose the health of the connection and the device,
+/// without needing to wait for the device to disconnect. Counts the messages and bytes sent and received per topic class,
+/// failures when (de-)serializing json, messages dropped because they were too big for the internal buffer of the client,
+/// histograms of the time the subscribed server-side RPC callbacks take and the time between requesting a OTA chunk and receiving it,
+/// as well as the biggest amount of memory allocated on the heap at once per allocation path.
+/// Only exists if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS is set to 1, to ensure it does not cause any overhead if it is not needed
+class Performance_Counters {
+  public:
+    /// @brief Counter for the messages and bytes of one topic class
+    struct Traffic_Counter {
+        uint32_t messages; // Amount of messages
+        uint64_t bytes;    // Amount of payload bytes
+    };
+
+    /// @brief Constructor
+    Performance_Counters();
+
+    /// @brief Records a message that was successfully sent to the server
+    /// @param topic_class Class of the topic the message was sent over
+    /// @param bytes Size of the sent payload
+    void Record_Sent(const Topic_Class& topic_class, const size_t& bytes);
+
+    /// @brief Records a message that was received from the server
+    /// @param topic_class Class of the topic the message was received over
+    /// @param bytes Size of the received payload
+    void Record_Received(const Topic_Class& topic_class, const size_t& bytes);
+
+    /// @brief Records a failure to serialize json data that should have been sent to the server
+    void Record_Serialization_Failure();
+
+    /// @brief Records a failure to deserialize json data received from the server
+    void Record_Deserialization_Failure();
+
+    /// @brief Records a message that was not sent, because it was bigger than the internal buffer of the client
+    void Record_Oversize_Drop();
+
+    /// @brief Records the given heap allocation, updates the largest allocation of the given path if the allocation is bigger than any previous one.
+    /// Only the size of the single allocation is compared, the memory is freed again before the next one on the same path and therefore never adds up
+    /// @param path Code path the memory was allocated for
+    /// @param bytes Amount of bytes that were allocated
+    void Record_Heap_Allocation(const Allocation_Path& path, const size_t& bytes);
+
+    /// @brief Gets the counter of messages sent over the given topic class
+    /// @param topic_class Class of the topic we want to receive the counter for
+    /// @return Counter of the sent messages and bytes
+    const Traffic_Counter& Get_Sent(const Topic_Class& topic_class) const;
+
+    /// @brief Gets the counter of messages received over the given topic class
+    /// @param topic_class Class of the topic we want to receive the counter for
+    /// @return Counter of the received messages and bytes
+    const Traffic_Counter& Get_Received(const Topic_Class& topic_class) const;
+
+    /// @brief Gets the sum of the messages sent over all topic classes
+    /// @return Counter of all sent messages and bytes
+    Traffic_Counter Get_Total_Sent() const;
+
+    /// @brief Gets the sum of the messages received over all topic classes
+    /// @return Counter of all received messages and bytes
+    Traffic_Counter Get_Total_Received() const;
+
+    /// @brief Gets the amount of failures to serialize json data
+    /// @return Amount of serialization failures
+    uint32_t Get_Serialization_Failures() const;
+
+    /// @brief Gets the amount of failures to deserialize json data
+    /// @return Amount of deserialization failures
+    uint32_t Get_Deserialization_Failures() const;
+
+    /// @brief Gets the amount of messages that were not sent, because they were bigger than the internal buffer of the client
+    /// @return Amount of dropped messages
+    uint32_t Get_Oversize_Drops() const;
+
+    /// @brief Gets the biggest amount of memory that has been allocated on the heap at once for the given path, which is not the high-water mark of the whole heap,
+    /// because allocations of the user, the MQTT client or other paths are not included
+    /// @param path Code path we want to receive the largest allocation for
+    /// @return Largest allocation in bytes
+    size_t Get_Largest_Heap_Allocation(const Allocation_Path& path) const;
+
+    /// @brief Gets the histogram of the time the subscribed server-side RPC callbacks took to handle a request
+    /// @return Histogram of the RPC callback latencies
+    Latency_Histogram& Get_RPC_Latency();
+
+    /// @brief Gets the histogram of the time the subscribed server-side RPC callbacks took to handle a request
+    /// @return Histogram of the RPC callback latencies
+    const Latency_Histogram& Get_RPC_Latency() const;
+
+    /// @brief Gets the histogram of the time between requesting a firmware or software chunk and receiving it
+    /// @return Histogram of the OTA chunk round trip times
+    Latency_Histogram& Get_OTA_Chunk_Round_Trip();
+
+    /// @brief Gets the histogram of the time between requesting a firmware or software chunk and receiving it
+    /// @return Histogram of the OTA chunk round trip times
+    const Latency_Histogram& Get_OTA_Chunk_Round_Trip() const;
+
+    /// @brief Resets all counters, histograms and largest allocations
+    void Reset();
+
+  private:
+    Traffic_Counter m_sent[static_cast<size_t>(Topic_Class::AMOUNT)];                    // Sent messages per topic class
+    Traffic_Counter m_received[static_cast<size_t>(Topic_Class::AMOUNT)];                // Received messages per topic class
+    uint32_t m_serialization_failures;                                                   // Failures to serialize json data
+    uint32_t m_deserialization_failures;                                                 // Failures to deserialize json data
+    uint32_t m_oversize_drops;                                                           // Messages dropped because they were bigger than the internal buffer
+    size_t m_largest_heap_allocations[static_cast<size_t>(Allocation_Path::AMOUNT)];     // Biggest heap allocation per path
+    Latency_Histogram m_rpc_latency;                                                     // Time the server-side RPC callbacks took
+    Latency_Histogram m_ota_chunk_round_trip;                                            // Time between requesting and receiving an OTA chunk
+};
+
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+
+#endif // Performance_Counters_h
@@ -0,0 +1,24 @@
+// Header include.
+#include "RAM_Patch_Source.h"
+
+#if THINGSBOARD_ENABLE_OTA
+
+// Library include.
+#include <string.h>
+
+RAM_Patch_Source::RAM_Patch_Source(const uint8_t *buffer, const size_t& size) :
+    m_buffer(buffer),
+    m_size(size)
+{
+    // Nothing to do
+}
+
+size_t RAM_Patch_Source::read(const size_t& offset, uint8_t* buffer, const size_t& total_bytes) {
+    if (m_buffer == nullptr || offset > m_size || total_bytes > m_size - offset) {
+        return 0U;
+    }
+    memcpy(buffer, m_buffer + offset, total_bytes);
+    return total_bytes;
+}
+
+#endif // THINGSBOARD_ENABLE_OTA
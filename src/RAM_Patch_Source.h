@@ -0,0 +1,31 @@
+#ifndef RAM_Patch_Source_h
+#define RAM_Patch_Source_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_ENABLE_OTA
+
+// Local include.
+#include "IPatch_Source.h"
+
+
+/// @brief IPatch_Source implementation that reads the currently installed image from a buffer in memory,
+/// allows to apply delta updates to images that are kept in memory or to run the complete delta update without any flash memory, for example on Linux
+class RAM_Patch_Source : public IPatch_Source {
+  public:
+    /// @brief Constructor
+    /// @param buffer Buffer that contains the currently installed image, is not copied and therefore has to be kept alive as long as the source is used
+    /// @param size Size of the image in the given buffer in bytes
+    RAM_Patch_Source(const uint8_t *buffer, const size_t& size);
+
+    size_t read(const size_t& offset, uint8_t* buffer, const size_t& total_bytes) override;
+
+  private:
+    const uint8_t *m_buffer;  // Buffer that contains the currently installed image
+    size_t        m_size;     // Size of the image in the buffer in bytes
+};
+
+#endif // THINGSBOARD_ENABLE_OTA
+
+#endif // RAM_Patch_Source_h
@@ -0,0 +1,65 @@
+// Header include.
+#include "RAM_Updater.h"
+
+#if THINGSBOARD_ENABLE_OTA
+
+// Library include.
+#include <string.h>
+
+RAM_Updater::RAM_Updater(uint8_t *buffer, const size_t& capacity) :
+    m_buffer(buffer),
+    m_capacity(capacity),
+    m_size(0U),
+    m_written(0U)
+{
+    // Nothing to do
+}
+
+bool RAM_Updater::begin(const size_t& data_size) {
+    reset();
+    if (m_buffer == nullptr || data_size > m_capacity) {
+        return false;
+    }
+    m_size = data_size;
+    return true;
+}
+
+size_t RAM_Updater::write(uint8_t* payload, const size_t& total_bytes) {
+    // Never write more than the announced size, because the buffer might be exactly as big as the announced size
+    const size_t remaining = m_size - m_written;
+    const size_t written_bytes = total_bytes < remaining ? total_bytes : remaining;
+    memcpy(m_buffer + m_written, payload, written_bytes);
+    m_written += written_bytes;
+    return written_bytes;
+}
+
+void RAM_Updater::reset() {
+    m_size = 0U;
+    m_written = 0U;
+}
+
+bool RAM_Updater::supports_read() const {
+    return true;
+}
+
+size_t RAM_Updater::read(const size_t& offset, uint8_t* buffer, const size_t& total_bytes) {
+    if (offset > m_written || total_bytes > m_written - offset) {
+        return 0U;
+    }
+    memcpy(buffer, m_buffer + offset, total_bytes);
+    return total_bytes;
+}
+
+bool RAM_Updater::end() {
+    return m_written == m_size;
+}
+
+const uint8_t* RAM_Updater::Get_Data() const {
+    return m_buffer;
+}
+
+const size_t& RAM_Updater::Get_Size() const {
+    return m_written;
+}
+
+#endif // THINGSBOARD_ENABLE_OTA
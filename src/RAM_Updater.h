@@ -0,0 +1,51 @@
+#ifndef RAM_Updater_h
+#define RAM_Updater_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_ENABLE_OTA
+
+// Local include.
+#include "IUpdater.h"
+
+
+/// @brief IUpdater implementation that copies the given binary data into a buffer in memory, does not allocate the buffer itself, instead it writes into the given buffer.
+/// Allows to download small artifacts, like configuration files, directly into memory or to run the complete update without any flash memory, for example on Linux
+class RAM_Updater : public IUpdater {
+  public:
+    /// @brief Constructor
+    /// @param buffer Buffer the received binary data is written into, is not copied and therefore has to be kept alive as long as the updater is used
+    /// @param capacity Size of the given buffer in bytes, updates with a bigger binary fail in begin()
+    RAM_Updater(uint8_t *buffer, const size_t& capacity);
+
+    bool begin(const size_t& data_size) override;
+  
+    size_t write(uint8_t* payload, const size_t& total_bytes) override;
+
+    void reset() override;
+
+    bool supports_read() const override;
+
+    size_t read(const size_t& offset, uint8_t* buffer, const size_t& total_bytes) override;
+  
+    bool end() override;
+
+    /// @brief Gets the buffer the received binary data has been written into
+    /// @return Buffer given in the constructor
+    const uint8_t* Get_Data() const;
+
+    /// @brief Gets the amount of bytes that have been written into the buffer
+    /// @return Amount of written bytes
+    const size_t& Get_Size() const;
+
+  private:
+    uint8_t *m_buffer;   // Buffer the received binary data is written into
+    size_t  m_capacity;  // Size of the given buffer in bytes
+    size_t  m_size;      // Total size of the data that should be written
+    size_t  m_written;   // Amount of bytes that have already been written
+};
+
+#endif // THINGSBOARD_ENABLE_OTA
+
+#endif // RAM_Updater_h
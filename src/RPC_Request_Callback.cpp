@@ -26,6 +26,11 @@ RPC_Request_Callback::RPC_Request_Callback(const char *methodName, const JsonArr
     Callback(callback, RPC_REQUEST_CB_NULL),
     m_methodName(methodName),
     m_parameters(parameteres),
+#if THINGSBOARD_ENABLE_STL
+    m_timeout(0U),
+    m_timeout_callback(),
+    m_deadline(0U),
+#endif // THINGSBOARD_ENABLE_STL
     m_request_id(0U)
 {
     // Nothing to do
@@ -54,3 +59,31 @@ const JsonArray* RPC_Request_Callback::Get_Parameters() const {
 void RPC_Request_Callback::Set_Parameters(const JsonArray *parameteres) {
     m_parameters = parameteres;
 }
+
+#if THINGSBOARD_ENABLE_STL
+
+const uint64_t& RPC_Request_Callback::Get_Timeout() const {
+    return m_timeout;
+}
+
+void RPC_Request_Callback::Set_Timeout(const uint64_t& timeout_microseconds) {
+    m_timeout = timeout_microseconds;
+}
+
+const RPC_Request_Callback::timeoutFn& RPC_Request_Callback::Get_Timeout_Callback() const {
+    return m_timeout_callback;
+}
+
+void RPC_Request_Callback::Set_Timeout_Callback(timeoutFn timeoutCb) {
+    m_timeout_callback = timeoutCb;
+}
+
+const uint64_t& RPC_Request_Callback::Get_Deadline() const {
+    return m_deadline;
+}
+
+void RPC_Request_Callback::Set_Deadline(const uint64_t& deadline) {
+    m_deadline = deadline;
+}
+
+#endif // THINGSBOARD_ENABLE_STL
@@ -13,6 +13,11 @@
 /// Documentation about the specific use of client-side RPC in ThingsBoard can be found here https://thingsboard.io/docs/user-guide/rpc/#client-side-rpc
 class RPC_Request_Callback : public Callback<void, const JsonVariantConst&> {
   public:
+#if THINGSBOARD_ENABLE_STL
+    /// @brief Timeout callback signature, called if the response has not been received in time
+    using timeoutFn = Inplace_Function<void(void)>;
+#endif // THINGSBOARD_ENABLE_STL
+
     /// @brief Constructs empty callback, will result in never being called
     RPC_Request_Callback();
 
@@ -58,10 +63,47 @@ class RPC_Request_Callback : public Callback<void, const JsonVariantConst&> {
     /// @param parameteres Pointer to the passed parameters
     void Set_Parameters(const JsonArray *parameteres);
 
+#if THINGSBOARD_ENABLE_STL
+
+    /// @brief Gets the time in microseconds we wait for the response to the client-side RPC request, before it counts as a timeout
+    /// @return Time we wait for the response, 0 if we wait forever
+    const uint64_t& Get_Timeout() const;
+
+    /// @brief Sets the time in microseconds we wait for the response to the client-side RPC request, before it counts as a timeout.
+    /// Once the timeout has passed the timeout callback is called and the request is removed, meaning a late response is ignored,
+    /// which ensures requests the server never responds to do not keep their slot forever
+    /// @param timeout_microseconds Time we wait for the response, 0 waits forever
+    void Set_Timeout(const uint64_t& timeout_microseconds);
+
+    /// @brief Gets the callback that is called if the response to the client-side RPC request has not been received before the timeout has passed
+    /// @return Callback that is called if the request timed out
+    const timeoutFn& Get_Timeout_Callback() const;
+
+    /// @brief Sets the callback that is called if the response to the client-side RPC request has not been received before the timeout has passed
+    /// @param timeoutCb Callback that is called if the request timed out, an empty callback only removes the request
+    void Set_Timeout_Callback(timeoutFn timeoutCb);
+
+    /// @brief Gets the time the request times out at
+    /// @return Timestamp in microseconds the request times out at, 0 if the request never times out
+    const uint64_t& Get_Deadline() const;
+
+    /// @brief Sets the time the request times out at.
+    /// Not meant for external use, because the value is overwritten by the ThingsBoard class once the request has been sent anyway,
+    /// this is the case because only the ThingsBoard class knows when the request has actually been sent
+    /// @param deadline Timestamp in microseconds the request times out at, 0 if the request never times out
+    void Set_Deadline(const uint64_t& deadline);
+
+#endif // THINGSBOARD_ENABLE_STL
+
   private:
-    const char        *m_methodName;  // Method name
-    const JsonArray   *m_parameters;  // Parameter json
-    size_t            m_request_id;   // Id the request was called with
+    const char        *m_methodName;       // Method name
+    const JsonArray   *m_parameters;       // Parameter json
+#if THINGSBOARD_ENABLE_STL
+    uint64_t          m_timeout;           // Time we wait for the response, 0 if we wait forever
+    timeoutFn         m_timeout_callback;  // Callback that is called if the response has not been received in time
+    uint64_t          m_deadline;          // Timestamp the request times out at, 0 if it never times out
+#endif // THINGSBOARD_ENABLE_STL
+    size_t            m_request_id;        // Id the request was called with
 };
 
 #endif // RPC_Request_Callback_h
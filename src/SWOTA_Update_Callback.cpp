@@ -4,80 +4,37 @@
 #if THINGSBOARD_ENABLE_SWOTA
 
 SWOTA_Update_Callback::SWOTA_Update_Callback() :
-    SWOTA_Update_Callback(nullptr, nullptr, nullptr, nullptr, nullptr)
+    OTA_Update_Callback()
 {
     // Nothing to do
 }
 
-SWOTA_Update_Callback::SWOTA_Update_Callback(function endCb, const char *currSwTitle, const char *currSwVersion, SWOTA_Updater *updater, const uint8_t &chunkRetries, const uint16_t &chunkSize, const uint64_t &timeout) :
-    SWOTA_Update_Callback(nullptr, endCb, currSwTitle, currSwVersion, updater, chunkRetries, chunkSize, timeout)
+SWOTA_Update_Callback::SWOTA_Update_Callback(function endCb, const char *currSwTitle, const char *currSwVersion, IUpdater *updater, const uint8_t &chunkRetries, const uint16_t &chunkSize, const uint64_t &timeout) :
+    OTA_Update_Callback(endCb, currSwTitle, currSwVersion, updater, chunkRetries, chunkSize, timeout)
 {
     // Nothing to do
 }
 
-SWOTA_Update_Callback::SWOTA_Update_Callback(progressFn progressCb, function endCb, const char *currSwTitle, const char *currSwVersion, SWOTA_Updater *updater, const uint8_t &chunkRetries, const uint16_t &chunkSize, const uint64_t &timeout) :
-    Callback(endCb, SW_OTA_CB_IS_NULL),
-    m_progressCb(progressCb),
-    m_swTitel(currSwTitle),
-    m_swVersion(currSwVersion),
-    m_updater(updater),
-    m_retries(chunkRetries),
-    m_size(chunkSize),
-    m_timeout(timeout)
+SWOTA_Update_Callback::SWOTA_Update_Callback(progressFn progressCb, function endCb, const char *currSwTitle, const char *currSwVersion, IUpdater *updater, const uint8_t &chunkRetries, const uint16_t &chunkSize, const uint64_t &timeout) :
+    OTA_Update_Callback(progressCb, endCb, currSwTitle, currSwVersion, updater, chunkRetries, chunkSize, timeout)
 {
     // Nothing to do
 }
 
-void SWOTA_Update_Callback::Set_Progress_Callback(progressFn progressCb) {
-    m_progressCb = progressCb;
-}
-
 const char* SWOTA_Update_Callback::Get_Software_Title() const {
-    return m_swTitel;
+    return Get_Firmware_Title();
 }
 
 void SWOTA_Update_Callback::Set_Software_Title(const char *currSwTitle) {
-    m_swTitel = currSwTitle;
+    Set_Firmware_Title(currSwTitle);
 }
 
 const char* SWOTA_Update_Callback::Get_Software_Version() const {
-    return m_swVersion;
+    return Get_Firmware_Version();
 }
 
 void SWOTA_Update_Callback::Set_Software_Version(const char *currSwVersion) {
-    m_swVersion = currSwVersion;
-}
-
-SWOTA_Updater* SWOTA_Update_Callback::Get_Updater() const {
-    return m_updater;
-}
-
-void SWOTA_Update_Callback::Set_Updater(SWOTA_Updater* updater) {
-    m_updater = updater;
-}
-
-const uint8_t& SWOTA_Update_Callback::Get_Chunk_Retries() const {
-  return m_retries;
-}
-
-void SWOTA_Update_Callback::Set_Chunk_Retries(const uint8_t &chunkRetries) {
-    m_retries = chunkRetries;
-}
-
-const uint16_t& SWOTA_Update_Callback::Get_Chunk_Size() const {
-  return m_size;
-}
-
-void SWOTA_Update_Callback::Set_Chunk_Size(const uint16_t &chunkSize) {
-    m_size = chunkSize;
-}
-
-const uint64_t& SWOTA_Update_Callback::Get_Timeout() const {
-    return m_timeout;
-}
-
-void SWOTA_Update_Callback::Set_Timeout(const uint64_t &timeout_microseconds) {
-    m_timeout = timeout_microseconds;
+    Set_Firmware_Version(currSwVersion);
 }
 
-#endif // THINGSBOARD_ENABLE_SWOTA
\ No newline at end of file
+#endif // THINGSBOARD_ENABLE_SWOTA
@@ -16,7 +16,7 @@ Shared_Attribute_Callback::Shared_Attribute_Callback(function cb) :
 
 #if THINGSBOARD_ENABLE_STL
 
-const std::vector<const char *>& Shared_Attribute_Callback::Get_Attributes() const {
+const Shared_Attribute_Callback::Attribute_Keys& Shared_Attribute_Callback::Get_Attributes() const {
     return m_attributes;
 }
 
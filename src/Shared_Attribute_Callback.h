@@ -3,12 +3,12 @@
 
 // Local includes.
 #include "Callback.h"
+#if THINGSBOARD_ENABLE_STL
+#include "StaticVector.h"
+#endif // THINGSBOARD_ENABLE_STL
 
 // Library includes.
 #include <ArduinoJson.h>
-#if THINGSBOARD_ENABLE_STL
-#include <vector>
-#endif // THINGSBOARD_ENABLE_STL
 
 
 /// ---------------------------------
@@ -30,6 +30,11 @@ using Shared_Attribute_Data = const JsonObjectConst;
 /// Documentation about the specific use of shared attribute update  in ThingsBoard can be found here https://thingsboard.io/docs/reference/mqtt-api/#subscribe-to-attribute-updates-from-the-server
 class Shared_Attribute_Callback : public Callback<void, const Shared_Attribute_Data&>  {
   public:
+#if THINGSBOARD_ENABLE_STL
+    /// @brief Subscribed shared attribute keys, stored inline so creating or copying the callback never allocates memory on the heap
+    using Attribute_Keys = StaticVector<const char *, THINGSBOARD_MAX_ATTRIBUTE_KEYS>;
+#endif // THINGSBOARD_ENABLE_STL
+
     /// @brief Constructs empty callback, will result in never being called
     Shared_Attribute_Callback();
 
@@ -43,21 +48,16 @@ class Shared_Attribute_Callback : public Callback<void, const Shared_Attribute_D
     /// @brief Constructs callback, will be called upon shared attribute update arrival,
     /// where atleast one of the given multiple shared attributes passed was updated by the cloud.
     /// If the update does not include any of the given shared attributes the callback is not called.
-    /// Directly forwards the given arguments to the overloaded vector constructor,
-    /// meaning all combinatons of arguments that would initalize a vector can be used to call this constructor.
-    /// See possible vector constructors https://en.cppreference.com/w/cpp/container/vector/vector, for the possible passed parameters.
-    /// The possibilites mainly consist out of the fill constructor, where a value and a number n is given and then that many elements of the value will be copied into
-    /// or be created with their default value, or out of the range constructor where we can pass an interator the start of another data container
-    /// and to the end of the data container (last element + 1)
-    /// and then every element between those iteratos will be copied, in the same order as in the original data container.
-    /// The last option is a copy constructor where we pass a vector and the values of that vector will be copied into our buffer
-    /// @tparam ...Args Holds the multiple arguments that will simply be forwarded to the vector constructor and therefore allow to use every overloaded vector constructor without having to implement them
+    /// Copies the keys in the given range into the callback, meaning the data container they were read from does not have to outlive the callback,
+    /// but the strings the keys point to do. At most THINGSBOARD_MAX_ATTRIBUTE_KEYS keys are copied, further keys are ignored
+    /// @tparam InputIterator Class that points to the begin and end iterator of the given data container
     /// @param callback Callback method that will be called upon data arrival with the given data that was received serialized into a JsonDocument
-    /// @param ...args Arguments that will be forwarded into the overloaded vector constructor see https://en.cppreference.com/w/cpp/container/vector/vector for more information
-    template<typename... Args>
-    inline Shared_Attribute_Callback(function callback, Args... args)
+    /// @param first_itr Iterator pointing to the first key that should be copied
+    /// @param last_itr Iterator pointing to the end of the keys that should be copied (last element + 1)
+    template<typename InputIterator>
+    inline Shared_Attribute_Callback(function callback, InputIterator first_itr, const InputIterator& last_itr)
       : Callback(callback, ATT_CB_IS_NULL)
-      , m_attributes(std::forward<Args>(args)...)
+      , m_attributes(first_itr, last_itr)
     {
         // Nothing to do
     }
@@ -66,24 +66,18 @@ class Shared_Attribute_Callback : public Callback<void, const Shared_Attribute_D
     /// in the subscribed method being called if any of those attributes values is changed by the cloud,
     /// with their current value they have been changed to
     /// @return Subscribed shared attributes
-    const std::vector<const char *>& Get_Attributes() const;
+    const Attribute_Keys& Get_Attributes() const;
 
     /// @brief Sets all the subscribed shared attributes that will result,
     /// in the subscribed method being called if any of those attributes values is changed by the cloud,
     /// with their current value they have been changed to.
-    /// Directly forwards the given arguments to the overloaded vector assign method,
-    /// meaning all combinatons of arguments that can call the assign method on a vector can be used to call this method.
-    /// See possible overloaded vector assign methods https://en.cppreference.com/w/cpp/container/vector/assign, for the possible passed parameters.
-    /// The possibilites mainly consist out of the fill assign method, where a value and a number n is given and then that many elements of the value will be copied into
-    /// or be created with their default value, or out of the range assign method where we can pass an interator the start of another data container
-    /// and to the end of the data container (last element + 1)
-    /// and then every element between those iteratos will be copied, in the same order as in the original data container.
-    /// The last option is a copy assign method where we pass a vector and the values of that vector will be copied into our buffer
-    /// @tparam ...Args Holds the multiple arguments that will simply be forwarded to the vector assign method and therefore allow to use every overloaded vector assign without having to implement them
-    /// @param ...args Arguments that will be forwarded into the overloaded vector assign method see https://en.cppreference.com/w/cpp/container/vector/assign for more information
-    template<typename... Args>
-    inline void Set_Attributes(Args... args) {
-        m_attributes.assign(std::forward<Args>(args)...);
+    /// At most THINGSBOARD_MAX_ATTRIBUTE_KEYS keys are copied, further keys are ignored
+    /// @tparam InputIterator Class that points to the begin and end iterator of the given data container
+    /// @param first_itr Iterator pointing to the first key that should be copied
+    /// @param last_itr Iterator pointing to the end of the keys that should be copied (last element + 1)
+    template<typename InputIterator>
+    inline void Set_Attributes(InputIterator first_itr, const InputIterator& last_itr) {
+        m_attributes.assign(first_itr, last_itr);
     }
 
 #else
@@ -111,7 +105,7 @@ class Shared_Attribute_Callback : public Callback<void, const Shared_Attribute_D
 
   private:
 #if THINGSBOARD_ENABLE_STL
-    std::vector<const char *>      m_attributes;    // Shared attribute we want to subscribe to receive a message if they change
+    Attribute_Keys                 m_attributes;    // Shared attribute we want to subscribe to receive a message if they change
 #else
     const char                     *m_attributes;   // Shared attribute we want to subscribe to receive a message if they change
 #endif // THINGSBOARD_ENABLE_STL
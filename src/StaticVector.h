@@ -0,0 +1,370 @@
+#ifndef StaticVector_h
+#define StaticVector_h
+
+// Local include.
+#include "Configuration.h"
+
+// Library includes.
+#include <assert.h>
+#include <stddef.h>
+#include <new>
+
+
+/// @brief Data container with a fixed maximum capacity, that stores its elements inline instead of on the heap.
+/// Elements are only constructed once they are inserted and destroyed once they are removed, meaning the type does not need to be default constructible.
+/// Inserting an element into a full container does not insert it, therefore the caller has to ensure that size() is smaller than capacity() beforehand.
+/// Does not depend on the C++ STL, meaning it can be used on every board, and allows to subscribe callbacks without ever allocating memory on the heap.
+/// @tparam T Type of the underlying data the list should hold
+/// @tparam Capacity Maximum amount of elements that can be stored in the container
+template <typename T, size_t Capacity>
+class StaticVector {
+    static_assert(Capacity > 0U, "StaticVector has to be able to hold at least one element");
+
+  public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /// @brief Constructor
+    inline StaticVector() :
+        m_size(0U)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Range constructor, copies the elements in the given range,
+    /// elements that do not fit into the container anymore are not copied
+    /// @tparam InputIterator Class that points to the begin and end iterator of the given data container
+    /// @param first_itr Iterator pointing to the first element that should be copied
+    /// @param last_itr Iterator pointing to the end of the elements that should be copied (last element + 1)
+    template <typename InputIterator>
+    inline StaticVector(InputIterator first_itr, const InputIterator& last_itr) :
+        m_size(0U)
+    {
+        assign(first_itr, last_itr);
+    }
+
+    /// @brief Copy constructor
+    /// @param other Container the elements should be copied from
+    inline StaticVector(const StaticVector& other) :
+        m_size(0U)
+    {
+        for (const T& element : other) {
+            push_back(element);
+        }
+    }
+
+    /// @brief Move constructor, moves each element individually, because the elements are stored inline
+    /// @param other Container the elements should be moved from, is empty afterwards
+    inline StaticVector(StaticVector&& other) :
+        m_size(0U)
+    {
+        for (T& element : other) {
+            push_back(static_cast<T&&>(element));
+        }
+        other.clear();
+    }
+
+    /// @brief Destructor
+    inline ~StaticVector() {
+        clear();
+    }
+
+    /// @brief Copy assignment operator
+    /// @param other Container the elements should be copied from
+    /// @return Reference to this container
+    inline StaticVector& operator=(const StaticVector& other) {
+        if (this != &other) {
+            clear();
+            for (const T& element : other) {
+                push_back(element);
+            }
+        }
+        return *this;
+    }
+
+    /// @brief Move assignment operator, moves each element individually, because the elements are stored inline
+    /// @param other Container the elements should be moved from, is empty afterwards
+    /// @return Reference to this container
+    inline StaticVector& operator=(StaticVector&& other) {
+        if (this != &other) {
+            clear();
+            for (T& element : other) {
+                push_back(static_cast<T&&>(element));
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    /// @brief Returns whether there are still any element in the underlying data container
+    /// @return Whether the underlying data container is empty or not
+    inline bool empty() const {
+        return m_size == 0U;
+    }
+
+    /// @brief Returns whether the underlying data container can not hold any more elements
+    /// @return Whether the underlying data container is full or not
+    inline bool full() const {
+        return m_size == Capacity;
+    }
+
+    /// @brief Gets the current amount of elements in the underlying data container
+    /// @return The amount of items currently in the underlying data container
+    inline size_t size() const {
+        return m_size;
+    }
+
+    /// @brief Gets the maximum amount of elements that can be stored in the underlying data container
+    /// @return The maximum amount of items that can be stored in the underlying data container
+    inline constexpr size_t capacity() const {
+        return Capacity;
+    }
+
+    /// @brief Gets the maximum amount of elements that can be stored in the underlying data container
+    /// @return The maximum amount of items that can be stored in the underlying data container
+    inline constexpr size_t max_size() const {
+        return Capacity;
+    }
+
+    /// @brief Does nothing, because the memory for all elements is already reserved inline,
+    /// exists so the container can be used as a drop-in replacement for Vector or std::vector
+    inline void reserve(const size_t&) {
+        // Nothing to do
+    }
+
+    /// @brief Returns an iterator to the first element of the container
+    /// @return Iterator to the first element of the container
+    inline iterator begin() {
+        return data();
+    }
+
+    /// @brief Returns a constant iterator to the first element of the container
+    /// @return Constant iterator to the first element of the container
+    inline const_iterator begin() const {
+        return data();
+    }
+
+    /// @brief Returns an iterator to one-past-the-end element of the container
+    /// @return Iterator to one-past-the-end element of the container
+    inline iterator end() {
+        return data() + m_size;
+    }
+
+    /// @brief Returns a constant iterator to one-past-the-end element of the container
+    /// @return Constant iterator to one-past-the-end element of the container
+    inline const_iterator end() const {
+        return data() + m_size;
+    }
+
+    /// @brief Returns a constant iterator to the first element of the container
+    /// @return Constant iterator to the first element of the container
+    inline const_iterator cbegin() const {
+        return data();
+    }
+
+    /// @brief Returns a constant iterator to one-past-the-end element of the container
+    /// @return Constant iterator to one-past-the-end element of the container
+    inline const_iterator cend() const {
+        return data() + m_size;
+    }
+
+    /// @brief Returns the first element of the container
+    /// @return Reference to the first element of the container
+    inline T& front() {
+        assert(m_size != 0U);
+        return data()[0U];
+    }
+
+    /// @brief Returns the last element of the container
+    /// @return Reference to the last element of the container
+    inline T& back() {
+        assert(m_size != 0U);
+        return data()[m_size - 1U];
+    }
+
+    /// @brief Method to access an element at a given index,
+    /// ensures the device crashes if we attempted to access in an invalid location
+    /// @param index Index we want to get the corresponding element for
+    inline T& at(const size_t& index) {
+        assert(index < m_size);
+        return data()[index];
+    }
+
+    /// @brief Method to access an element at a given index,
+    /// ensures the device crashes if we attempted to access in an invalid location
+    /// @param index Index we want to get the corresponding element for
+    inline const T& at(const size_t& index) const {
+        assert(index < m_size);
+        return data()[index];
+    }
+
+    /// @brief Bracket operator to access an element at a given index
+    /// @param index Index we want to get the corresponding element for
+    inline T& operator[](const size_t& index) {
+        return data()[index];
+    }
+
+    /// @brief Bracket operator to access an element at a given index
+    /// @param index Index we want to get the corresponding element for
+    inline const T& operator[](const size_t& index) const {
+        return data()[index];
+    }
+
+    /// @brief Copies the given element to the end of the underlying data container, is not inserted if the container is already full
+    /// @param element Element that should be inserted at the end
+    inline void push_back(const T& element) {
+        if (full()) {
+            return;
+        }
+        new (data() + m_size) T(element);
+        m_size++;
+    }
+
+    /// @brief Moves the given element to the end of the underlying data container, is not inserted if the container is already full
+    /// @param element Element that should be inserted at the end
+    inline void push_back(T&& element) {
+        if (full()) {
+            return;
+        }
+        new (data() + m_size) T(static_cast<T&&>(element));
+        m_size++;
+    }
+
+    /// @brief Constructs an element in place at the end of the underlying data container, is not constructed if the container is already full
+    /// @tparam Args Types of the arguments passed to the constructor of the element
+    /// @param args Arguments passed to the constructor of the element
+    template <typename... Args>
+    inline void emplace_back(Args&&... args) {
+        if (full()) {
+            return;
+        }
+        new (data() + m_size) T(static_cast<Args&&>(args)...);
+        m_size++;
+    }
+
+    /// @brief Replaces the content of the container with the elements in the given range,
+    /// elements that do not fit into the container anymore are not copied
+    /// @tparam InputIterator Class that points to the begin and end iterator of the given data container
+    /// @param first_itr Iterator pointing to the first element that should be copied
+    /// @param last_itr Iterator pointing to the end of the elements that should be copied (last element + 1)
+    template <typename InputIterator>
+    inline void assign(InputIterator first_itr, const InputIterator& last_itr) {
+        clear();
+        for (; first_itr != last_itr && !full(); ++first_itr) {
+            push_back(*first_itr);
+        }
+    }
+
+    /// @brief Removes the last element of the underlying data container
+    inline void pop_back() {
+        assert(m_size != 0U);
+        m_size--;
+        data()[m_size].~T();
+    }
+
+    /// @brief Inserts the elements in the given range before the given position,
+    /// elements that do not fit into the container anymore are not inserted
+    /// @tparam InputIterator Class that points to the begin and end iterator of the given data container
+    /// @param position Iterator to the element the elements should be inserted before
+    /// @param first_itr Iterator pointing to the first element that should be inserted
+    /// @param last_itr Iterator pointing to the end of the elements that should be inserted (last element + 1)
+    /// @return Iterator pointing to the first inserted element
+    template <typename InputIterator>
+    inline iterator insert(const_iterator position, InputIterator first_itr, const InputIterator& last_itr) {
+        const size_t index = position - cbegin();
+        size_t current = index;
+        for (; first_itr != last_itr && !full(); ++first_itr) {
+            insert(cbegin() + current, *first_itr);
+            current++;
+        }
+        return begin() + index;
+    }
+
+    /// @brief Inserts the given element before the given position, all following elements are moved one to the right.
+    /// Is not inserted if the container is already full
+    /// @param position Iterator to the element the element should be inserted before
+    /// @param element Element that should be inserted
+    /// @return Iterator pointing to the inserted element
+    inline iterator insert(const_iterator position, const T& element) {
+        const size_t index = position - cbegin();
+        if (full()) {
+            return end();
+        }
+        if (index == m_size) {
+            push_back(element);
+            return begin() + index;
+        }
+        // Move the last element into the uninitialized memory after it and then move all other elements one to the right
+        new (data() + m_size) T(static_cast<T&&>(data()[m_size - 1U]));
+        for (size_t i = m_size - 1U; i > index; i--) {
+            data()[i] = static_cast<T&&>(data()[i - 1U]);
+        }
+        data()[index] = element;
+        m_size++;
+        return begin() + index;
+    }
+
+    /// @brief Removes the element at the given position, has to move all following elements one to the left to keep their order
+    /// @param position Iterator to the element that should be removed
+    /// @return Iterator pointing to the element that followed the removed element
+    inline iterator erase(const_iterator position) {
+        const size_t index = position - cbegin();
+        erase(index);
+        return begin() + index;
+    }
+
+    /// @brief Removes the element at the given index, has to move all following elements one to the left to keep their order
+    /// @param index Index the element should be removed at from the underlying data container
+    inline void erase(const size_t& index) {
+        // Check if the given index is bigger or equal than the actual amount of elements if it is we can not erase that element because it does not exist
+        if (index >= m_size) {
+            return;
+        }
+        for (size_t i = index; i < m_size - 1U; i++) {
+            data()[i] = static_cast<T&&>(data()[i + 1U]);
+        }
+        pop_back();
+    }
+
+    /// @brief Removes the element at the given index in constant time, by moving the last element into its place.
+    /// Changes the order of the remaining elements, therefore it should only be used if the order does not matter
+    /// @param index Index the element should be removed at from the underlying data container
+    inline void erase_unordered(const size_t& index) {
+        if (index >= m_size) {
+            return;
+        }
+        if (index != m_size - 1U) {
+            data()[index] = static_cast<T&&>(back());
+        }
+        pop_back();
+    }
+
+    /// @brief Destroys all elements in the underlying data container
+    inline void clear() {
+        while (m_size != 0U) {
+            pop_back();
+        }
+    }
+
+  private:
+    /// @brief Returns a pointer to the inline storage interpreted as the given type
+    /// @return Pointer to the first element of the inline storage
+    inline T* data() {
+        return reinterpret_cast<T*>(m_storage);
+    }
+
+    /// @brief Returns a constant pointer to the inline storage interpreted as the given type
+    /// @return Constant pointer to the first element of the inline storage
+    inline const T* data() const {
+        return reinterpret_cast<const T*>(m_storage);
+    }
+
+    alignas(T) unsigned char m_storage[Capacity * sizeof(T)]; // Inline storage the elements are constructed in
+    size_t m_size;                                            // Used size that shows how many elements we entered
+};
+
+#endif // StaticVector_h
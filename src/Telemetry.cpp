@@ -73,3 +73,33 @@ bool Telemetry::SerializeKeyValue(const JsonVariant &jsonObj) const {
     }
     return false;
 }
+
+const char* Telemetry::Get_Key() const {
+    return m_key;
+}
+
+bool Telemetry::Get_Number(double& value) const {
+    switch (m_type) {
+        case DataType::TYPE_BOOL:
+            value = m_value.boolean ? 1.0 : 0.0;
+            return true;
+        case DataType::TYPE_INT:
+            value = static_cast<double>(m_value.integer);
+            return true;
+        case DataType::TYPE_REAL:
+            value = m_value.real;
+            return true;
+        default:
+            // Nothing to do
+            break;
+    }
+    return false;
+}
+
+bool Telemetry::Is_Boolean() const {
+    return m_type == DataType::TYPE_BOOL;
+}
+
+const char* Telemetry::Get_String() const {
+    return m_type == DataType::TYPE_STR ? m_value.str : nullptr;
+}
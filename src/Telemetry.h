@@ -79,6 +79,23 @@ class Telemetry {
     /// @return Whether serializing was successful or not
     bool SerializeKeyValue(const JsonVariant &jsonObj) const;
 
+    /// @brief Gets the key of the key-value pair
+    /// @return Key of the key-value pair or nullptr if the record has no key
+    const char* Get_Key() const;
+
+    /// @brief Gets the value of the key-value pair as a number, booleans are converted to 0 or 1
+    /// @param value Variable the value is copied into, if it is numeric
+    /// @return Whether the value is numeric or not, false for strings and empty records
+    bool Get_Number(double& value) const;
+
+    /// @brief Gets whether the value of the key-value pair is a boolean, which allows to distinguish it from the 0 or 1 returned by Get_Number()
+    /// @return Whether the value is a boolean or not
+    bool Is_Boolean() const;
+
+    /// @brief Gets the value of the key-value pair as a string
+    /// @return String value or nullptr if the value is not a string
+    const char* Get_String() const;
+
   private:
     // Data container
     union Data {
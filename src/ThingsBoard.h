@@ -4,6 +4,7 @@
 // Local includes.
 #include "Constants.h"
 #include "Vector.h"
+#include "StaticVector.h"
 #include "Helper.h"
 #include "ThingsBoardDefaultLogger.h"
 #include "Shared_Attribute_Callback.h"
@@ -11,11 +12,22 @@
 #include "RPC_Callback.h"
 #include "RPC_Request_Callback.h"
 #include "Provision_Callback.h"
+#include "Callback_Watchdog.h"
+#include "Critical_Section.h"
 #include "OTA_Handler.h"
 #include "IMQTT_Client.h"
-#include "SWOTA_Handler.h"
+#include "SWOTA_Update_Callback.h"
+#include "Performance_Counters.h"
+#include "Allocator.h"
+#include "Payload_Format.h"
+#include "ITelemetry_Filter.h"
+#include "Attribute_Store.h"
 
 // Library includes.
+#if THINGSBOARD_ENABLE_STL
+#include <string>
+#include <vector>
+#endif // THINGSBOARD_ENABLE_STL
 #if THINGSBOARD_ENABLE_STREAM_UTILS
 #include <StreamUtils.h>
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
@@ -87,10 +99,8 @@ constexpr char DEFAULT_CLIENT_ID[] = "TbDev";
 // Shared attribute request keys.
 #if THINGSBOARD_ENABLE_PROGMEM
 constexpr char SHARED_REQUEST_KEY[] PROGMEM = "sharedKeys";
-constexpr char SHARED_RESPONSE_KEY[] PROGMEM = "shared";
 #else
 constexpr char SHARED_REQUEST_KEY[] = "sharedKeys";
-constexpr char SHARED_RESPONSE_KEY[] = "shared";
 #endif // THINGSBOARD_ENABLE_PROGMEM
 
 // Client side attribute request keys.
@@ -115,23 +125,18 @@ constexpr char RPC_EMPTY_PARAMS_VALUE[] = "{}";
 
 // Log messages.
 #if THINGSBOARD_ENABLE_PROGMEM
-constexpr char UNABLE_TO_DE_SERIALIZE_JSON[] PROGMEM = "Unable to de-serialize received json data with error (DeserializationError::%s)";
 constexpr char INVALID_BUFFER_SIZE[] PROGMEM = "Buffer size (%u) to small for the given payloads size (%u), increase with setBufferSize accordingly or set THINGSBOARD_ENABLE_STREAM_UTILS to 1 before including ThingsBoard";
-#if THINGSBOARD_ENABLE_OTA
-constexpr char NUMBER_PRINTF[] PROGMEM = "%u";
-#endif // THINGSBOARD_ENABLE_OTA
 #if !THINGSBOARD_ENABLE_DYNAMIC
 constexpr char MAX_RPC_EXCEEDED[] PROGMEM = "Too many server-side RPC subscriptions, increase MaxFieldsAmt or unsubscribe";
 constexpr char MAX_RPC_REQUEST_EXCEEDED[] PROGMEM = "Too many client-side RPC subscriptions, increase MaxFieldsAmt or unsubscribe";
 constexpr char MAX_SHARED_ATT_UPDATE_EXCEEDED[] PROGMEM = "Too many shared attribute update callback subscriptions, increase MaxFieldsAmt or unsubscribe";
 constexpr char MAX_SHARED_ATT_REQUEST_EXCEEDED[] PROGMEM = "Too many shared attribute request callback subscriptions, increase MaxFieldsAmt";
-#else
-constexpr char COLON PROGMEM = ':';
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
 constexpr char COMMA PROGMEM = ',';
 constexpr char NO_KEYS_TO_REQUEST[] PROGMEM = "No keys to request were given";
 constexpr char RPC_METHOD_NULL[] PROGMEM = "RPC methodName is NULL";
 constexpr char SUBSCRIBE_TOPIC_FAILED[] PROGMEM = "Subscribing the given topic failed";
+constexpr char REQUEST_TIMED_OUT[] PROGMEM = "Response for request with id (%u) not received in time, removing the request";
 #if THINGSBOARD_ENABLE_DEBUG
 constexpr char NO_RPC_PARAMS_PASSED[] PROGMEM = "No parameters passed with RPC, passing null JSON";
 constexpr char NOT_FOUND_ATT_UPDATE[] PROGMEM = "Shared attribute update key not found";
@@ -147,23 +152,18 @@ constexpr char SEND_MESSAGE[] PROGMEM = "Sending data to server over topic (%s)
 constexpr char SEND_SERIALIZED[] PROGMEM = "Hidden, because json data is bigger than buffer, therefore showing in console is skipped";
 #endif // THINGSBOARD_ENABLE_DEBUG
 #else
-constexpr char UNABLE_TO_DE_SERIALIZE_JSON[] = "Unable to de-serialize received json data with error (DeserializationError::%s)";
 constexpr char INVALID_BUFFER_SIZE[] = "Buffer size (%u) to small for the given payloads size (%u), increase with setBufferSize accordingly or set THINGSBOARD_ENABLE_STREAM_UTILS to 1 before including ThingsBoard";
-#if THINGSBOARD_ENABLE_OTA
-constexpr char NUMBER_PRINTF[] = "%u";
-#endif // THINGSBOARD_ENABLE_OTA
 #if !THINGSBOARD_ENABLE_DYNAMIC
 constexpr char MAX_RPC_EXCEEDED[] = "Too many server-side RPC subscriptions, increase MaxFieldsAmt or unsubscribe";
 constexpr char MAX_RPC_REQUEST_EXCEEDED[] = "Too many client-side RPC subscriptions, increase MaxFieldsAmt or unsubscribe";
 constexpr char MAX_SHARED_ATT_UPDATE_EXCEEDED[] = "Too many shared attribute update callback subscriptions, increase MaxFieldsAmt or unsubscribe";
 constexpr char MAX_SHARED_ATT_REQUEST_EXCEEDED[] = "Too many shared attribute request callback subscriptions, increase MaxFieldsAmt";
-#else
-constexpr char COLON = ':';
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
 constexpr char COMMA = ',';
 constexpr char NO_KEYS_TO_REQUEST[] = "No keys to request were given";
 constexpr char RPC_METHOD_NULL[] = "RPC methodName is NULL";
 constexpr char SUBSCRIBE_TOPIC_FAILED[] = "Subscribing the given topic failed";
+constexpr char REQUEST_TIMED_OUT[] = "Response for request with id (%u) not received in time, removing the request";
 #if THINGSBOARD_ENABLE_DEBUG
 constexpr char NO_RPC_PARAMS_PASSED[] = "No parameters passed with RPC, passing null JSON";
 constexpr char NOT_FOUND_ATT_UPDATE[] = "Shared attribute update key not found";
@@ -232,76 +232,102 @@ constexpr char FIRMWARE_RESPONSE_SUBSCRIBE_TOPIC[] = "v2/fw/response/#";
 constexpr char FIRMWARE_REQUEST_TOPIC[] = "v2/fw/request/0/chunk/%u";
 #endif // THINGSBOARD_ENABLE_PROGMEM
 
-// Firmware data keys.
-#if THINGSBOARD_ENABLE_PROGMEM
-constexpr char CURR_FW_TITLE_KEY[] PROGMEM = "current_fw_title";
-constexpr char CURR_FW_VER_KEY[] PROGMEM = "current_fw_version";
-constexpr char FW_ERROR_KEY[] PROGMEM = "fw_error";
-constexpr char FW_STATE_KEY[] PROGMEM = "fw_state";
-constexpr char FW_VER_KEY[] PROGMEM = "fw_version";
-constexpr char FW_TITLE_KEY[] PROGMEM = "fw_title";
-constexpr char FW_CHKS_KEY[] PROGMEM = "fw_checksum";
-constexpr char FW_CHKS_ALGO_KEY[] PROGMEM = "fw_checksum_algorithm";
-constexpr char FW_SIZE_KEY[] PROGMEM = "fw_size";
-constexpr char CHECKSUM_AGORITM_MD5[] PROGMEM = "MD5";
-constexpr char CHECKSUM_AGORITM_SHA256[] PROGMEM = "SHA256";
-constexpr char CHECKSUM_AGORITM_SHA384[] PROGMEM = "SHA384";
-constexpr char CHECKSUM_AGORITM_SHA512[] PROGMEM = "SHA512";
-#else
-constexpr char CURR_FW_TITLE_KEY[] = "current_fw_title";
-constexpr char CURR_FW_VER_KEY[] = "current_fw_version";
-constexpr char FW_ERROR_KEY[] = "fw_error";
-constexpr char FW_STATE_KEY[] = "fw_state";
-constexpr char FW_VER_KEY[] = "fw_version";
-constexpr char FW_TITLE_KEY[] = "fw_title";
-constexpr char FW_CHKS_KEY[] = "fw_checksum";
-constexpr char FW_CHKS_ALGO_KEY[] = "fw_checksum_algorithm";
-constexpr char FW_SIZE_KEY[] = "fw_size";
-constexpr char CHECKSUM_AGORITM_MD5[] = "MD5";
-constexpr char CHECKSUM_AGORITM_SHA256[] = "SHA256";
-constexpr char CHECKSUM_AGORITM_SHA384[] = "SHA384";
-constexpr char CHECKSUM_AGORITM_SHA512[] = "SHA512";
-#endif // THINGSBOARD_ENABLE_PROGMEM
-
 // Log messages.
 #if THINGSBOARD_ENABLE_PROGMEM
-constexpr char NO_FW[] PROGMEM = "No new firmware assigned on the given device";
-constexpr char EMPTY_FW[] PROGMEM = "Given firmware was NULL";
-constexpr char FW_UP_TO_DATE[] PROGMEM = "Firmware is already up to date";
-constexpr char FW_NOT_FOR_US[] PROGMEM = "Firmware is not for us (title is different)";
-constexpr char FW_CHKS_ALGO_NOT_SUPPORTED[] PROGMEM = "Checksum algorithm (%s) is not supported";
 constexpr char NOT_ENOUGH_RAM[] PROGMEM = "Temporary allocating more internal client buffer failed, decrease OTA chunk size or decrease overall heap usage";
-constexpr char RESETTING_FAILED[] PROGMEM = "Preparing for OTA firmware updates failed, attributes might be NULL";
 #if THINGSBOARD_ENABLE_DEBUG
 constexpr char PAGE_BREAK[] PROGMEM = "=================================";
 constexpr char NEW_FW[] PROGMEM = "A new Firmware is available:";
+constexpr char NEW_SW[] PROGMEM = "A new Software is available:";
 constexpr char FROM_TOO[] PROGMEM = "(%s) => (%s)";
 constexpr char DOWNLOADING_FW[] PROGMEM = "Attempting to download over MQTT...";
 #endif // THINGSBOARD_ENABLE_DEBUG
 #else
-constexpr char NO_FW[] = "No new firmware assigned on the given device";
-constexpr char EMPTY_FW[] = "Given firmware was NULL";
-constexpr char FW_UP_TO_DATE[] = "Firmware is already up to date";
-constexpr char FW_NOT_FOR_US[] = "Firmware is not for us (title is different)";
-constexpr char FW_CHKS_ALGO_NOT_SUPPORTED[] = "Checksum algorithm (%s) is not supported";
 constexpr char NOT_ENOUGH_RAM[] = "Temporary allocating more internal client buffer failed, decrease OTA chunk size or decrease overall heap usage";
-constexpr char RESETTING_FAILED[] = "Preparing for OTA firmware updates failed, attributes might be NULL";
 #if THINGSBOARD_ENABLE_DEBUG
 constexpr char PAGE_BREAK[] = "=================================";
 constexpr char NEW_FW[] = "A new Firmware is available:";
 constexpr char NEW_SW[] = "A new Software is available:";
 constexpr char FROM_TOO[] = "(%s) => (%s)";
 constexpr char DOWNLOADING_FW[] = "Attempting to download over MQTT...";
-constexpr char DOWNLOADING_SW[] = "Attempting to download over MQTT...";
 #endif // THINGSBOARD_ENABLE_DEBUG
 #endif // THINGSBOARD_ENABLE_PROGMEM
 
 #endif // THINGSBOARD_ENABLE_OTA
 
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+
+// Performance counter telemetry keys.
+#if THINGSBOARD_ENABLE_PROGMEM
+constexpr char PERF_SENT_MESSAGES_KEY[] PROGMEM = "tb_sent_messages";
+constexpr char PERF_SENT_BYTES_KEY[] PROGMEM = "tb_sent_bytes";
+constexpr char PERF_RECEIVED_MESSAGES_KEY[] PROGMEM = "tb_received_messages";
+constexpr char PERF_RECEIVED_BYTES_KEY[] PROGMEM = "tb_received_bytes";
+constexpr char PERF_SERIALIZATION_FAILURES_KEY[] PROGMEM = "tb_serialization_failures";
+constexpr char PERF_DESERIALIZATION_FAILURES_KEY[] PROGMEM = "tb_deserialization_failures";
+constexpr char PERF_OVERSIZE_DROPS_KEY[] PROGMEM = "tb_oversize_drops";
+constexpr char PERF_RPC_COUNT_KEY[] PROGMEM = "tb_rpc_count";
+constexpr char PERF_RPC_AVERAGE_KEY[] PROGMEM = "tb_rpc_avg_us";
+constexpr char PERF_RPC_P95_KEY[] PROGMEM = "tb_rpc_p95_us";
+constexpr char PERF_RPC_MAX_KEY[] PROGMEM = "tb_rpc_max_us";
+constexpr char PERF_OTA_CHUNK_AVERAGE_KEY[] PROGMEM = "tb_ota_chunk_rtt_avg_us";
+constexpr char PERF_OTA_CHUNK_P95_KEY[] PROGMEM = "tb_ota_chunk_rtt_p95_us";
+constexpr char PERF_OTA_CHUNK_MAX_KEY[] PROGMEM = "tb_ota_chunk_rtt_max_us";
+constexpr char PERF_HEAP_SEND_KEY[] PROGMEM = "tb_heap_largest_send";
+constexpr char PERF_HEAP_RECEIVE_KEY[] PROGMEM = "tb_heap_largest_receive";
+constexpr char PERF_HEAP_OTA_KEY[] PROGMEM = "tb_heap_largest_ota";
+#else
+constexpr char PERF_SENT_MESSAGES_KEY[] = "tb_sent_messages";
+constexpr char PERF_SENT_BYTES_KEY[] = "tb_sent_bytes";
+constexpr char PERF_RECEIVED_MESSAGES_KEY[] = "tb_received_messages";
+constexpr char PERF_RECEIVED_BYTES_KEY[] = "tb_received_bytes";
+constexpr char PERF_SERIALIZATION_FAILURES_KEY[] = "tb_serialization_failures";
+constexpr char PERF_DESERIALIZATION_FAILURES_KEY[] = "tb_deserialization_failures";
+constexpr char PERF_OVERSIZE_DROPS_KEY[] = "tb_oversize_drops";
+constexpr char PERF_RPC_COUNT_KEY[] = "tb_rpc_count";
+constexpr char PERF_RPC_AVERAGE_KEY[] = "tb_rpc_avg_us";
+constexpr char PERF_RPC_P95_KEY[] = "tb_rpc_p95_us";
+constexpr char PERF_RPC_MAX_KEY[] = "tb_rpc_max_us";
+constexpr char PERF_OTA_CHUNK_AVERAGE_KEY[] = "tb_ota_chunk_rtt_avg_us";
+constexpr char PERF_OTA_CHUNK_P95_KEY[] = "tb_ota_chunk_rtt_p95_us";
+constexpr char PERF_OTA_CHUNK_MAX_KEY[] = "tb_ota_chunk_rtt_max_us";
+constexpr char PERF_HEAP_SEND_KEY[] = "tb_heap_largest_send";
+constexpr char PERF_HEAP_RECEIVE_KEY[] = "tb_heap_largest_receive";
+constexpr char PERF_HEAP_OTA_KEY[] = "tb_heap_largest_ota";
+#endif // THINGSBOARD_ENABLE_PROGMEM
+
+// Amount of key-value pairs sent by sendPerformanceCounters(), has to be adjusted if keys are added or removed.
+constexpr size_t PERF_FIELDS_AMOUNT = 17U;
+// Percentile of the latency histograms that is sent by sendPerformanceCounters().
+constexpr uint8_t PERF_PERCENTILE = 95U;
+
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+
 #if THINGSBOARD_ENABLE_SWOTA
+
+// Software topics.
+#if THINGSBOARD_ENABLE_PROGMEM
+constexpr char SOFTWARE_RESPONSE_TOPIC[] PROGMEM = "v2/sw/response/0/chunk";
+constexpr char SOFTWARE_RESPONSE_SUBSCRIBE_TOPIC[] PROGMEM = "v2/sw/response/#";
+constexpr char SOFTWARE_REQUEST_TOPIC[] PROGMEM = "v2/sw/request/0/chunk/%u";
+#else
 constexpr char SOFTWARE_RESPONSE_TOPIC[] = "v2/sw/response/0/chunk";
 constexpr char SOFTWARE_RESPONSE_SUBSCRIBE_TOPIC[] = "v2/sw/response/#";
 constexpr char SOFTWARE_REQUEST_TOPIC[] = "v2/sw/request/0/chunk/%u";
+#endif // THINGSBOARD_ENABLE_PROGMEM
+
+// Software data keys.
+#if THINGSBOARD_ENABLE_PROGMEM
+constexpr char CURR_SW_TITLE_KEY[] PROGMEM = "current_sw_title";
+constexpr char CURR_SW_VER_KEY[] PROGMEM = "current_sw_version";
+constexpr char SW_ERROR_KEY[] PROGMEM = "sw_error";
+constexpr char SW_STATE_KEY[] PROGMEM = "sw_state";
+constexpr char SW_VER_KEY[] PROGMEM = "sw_version";
+constexpr char SW_TITLE_KEY[] PROGMEM = "sw_title";
+constexpr char SW_CHKS_KEY[] PROGMEM = "sw_checksum";
+constexpr char SW_CHKS_ALGO_KEY[] PROGMEM = "sw_checksum_algorithm";
+constexpr char SW_SIZE_KEY[] PROGMEM = "sw_size";
+#else
 constexpr char CURR_SW_TITLE_KEY[] = "current_sw_title";
 constexpr char CURR_SW_VER_KEY[] = "current_sw_version";
 constexpr char SW_ERROR_KEY[] = "sw_error";
@@ -311,11 +337,80 @@ constexpr char SW_TITLE_KEY[] = "sw_title";
 constexpr char SW_CHKS_KEY[] = "sw_checksum";
 constexpr char SW_CHKS_ALGO_KEY[] = "sw_checksum_algorithm";
 constexpr char SW_SIZE_KEY[] = "sw_size";
+#endif // THINGSBOARD_ENABLE_PROGMEM
+
+// Log messages.
+#if THINGSBOARD_ENABLE_PROGMEM
+constexpr char NO_SW[] PROGMEM = "No new software assigned on the given device";
+constexpr char EMPTY_SW[] PROGMEM = "Given software was NULL";
+constexpr char SW_UP_TO_DATE[] PROGMEM = "Software is already up to date";
+constexpr char SW_NOT_FOR_US[] PROGMEM = "Software is not for us (title is different)";
+#else
 constexpr char NO_SW[] = "No new software assigned on the given device";
 constexpr char EMPTY_SW[] = "Given software was NULL";
 constexpr char SW_UP_TO_DATE[] = "Software is already up to date";
 constexpr char SW_NOT_FOR_US[] = "Software is not for us (title is different)";
-constexpr char SW_CHKS_ALGO_NOT_SUPPORTED[] = "Checksum algorithm (%s) is not supported";
+#endif // THINGSBOARD_ENABLE_PROGMEM
+
+#endif // THINGSBOARD_ENABLE_SWOTA
+
+#if THINGSBOARD_ENABLE_OTA
+
+/// @brief Topics, attribute keys and messages of one artifact type that can be downloaded over MQTT,
+/// allows to handle the firmware and the software update with the same methods, because they only differ in the used topics and keys
+struct OTA_Artifact {
+  const char *request_topic;            // Topic format string the chunk with the given index is requested over
+  const char *response_topic;           // Topic the requested chunks are received over, followed by the index of the chunk
+  const char *response_subscribe_topic; // Topic that has to be subscribed to receive the requested chunks
+  const char *title_key;                // Shared attribute key of the assigned title
+  const char *version_key;              // Shared attribute key of the assigned version
+  const char *size_key;                 // Shared attribute key of the size of the assigned binary
+  const char *checksum_key;             // Shared attribute key of the checksum of the assigned binary
+  const char *checksum_algorithm_key;   // Shared attribute key of the algorithm the checksum was created with
+  const char *current_title_key;        // Telemetry key the current title of the device is sent with
+  const char *current_version_key;      // Telemetry key the current version of the device is sent with
+  const char *state_key;                // Telemetry key the current state of the update is sent with
+  const char *error_key;                // Telemetry key the error message of a failed update is sent with
+  const char *no_artifact;              // Message if nothing has been assigned to the device
+  const char *empty_artifact;           // Message if the assigned title, version or checksum is empty
+  const char *up_to_date;               // Message if the assigned version is already installed
+  const char *not_for_us;               // Message if the assigned title is different from the title of the device
+#if THINGSBOARD_ENABLE_DEBUG
+  const char *new_artifact;             // Message if a new version has been assigned and is going to be downloaded
+#endif // THINGSBOARD_ENABLE_DEBUG
+};
+
+// Amount of shared attribute keys that are requested or subscribed to receive the information of the assigned artifact.
+// The keys are copied into the inline key storage of the callbacks, which therefore has to be able to hold all of them.
+constexpr size_t OTA_SHARED_KEYS_AMOUNT = 5U;
+static_assert(OTA_SHARED_KEYS_AMOUNT <= THINGSBOARD_MAX_ATTRIBUTE_KEYS, "OTA requests more shared attributes than a callback can hold, increase THINGSBOARD_MAX_ATTRIBUTE_KEYS accordingly");
+
+// Topics, attribute keys and messages of the firmware.
+constexpr OTA_Artifact FIRMWARE_ARTIFACT = {
+  FIRMWARE_REQUEST_TOPIC, FIRMWARE_RESPONSE_TOPIC, FIRMWARE_RESPONSE_SUBSCRIBE_TOPIC,
+  FW_TITLE_KEY, FW_VER_KEY, FW_SIZE_KEY, FW_CHKS_KEY, FW_CHKS_ALGO_KEY,
+  CURR_FW_TITLE_KEY, CURR_FW_VER_KEY, FW_STATE_KEY, FW_ERROR_KEY,
+  NO_FW, EMPTY_FW, FW_UP_TO_DATE, FW_NOT_FOR_US,
+#if THINGSBOARD_ENABLE_DEBUG
+  NEW_FW,
+#endif // THINGSBOARD_ENABLE_DEBUG
+};
+
+#endif // THINGSBOARD_ENABLE_OTA
+
+#if THINGSBOARD_ENABLE_SWOTA
+
+// Topics, attribute keys and messages of the software.
+constexpr OTA_Artifact SOFTWARE_ARTIFACT = {
+  SOFTWARE_REQUEST_TOPIC, SOFTWARE_RESPONSE_TOPIC, SOFTWARE_RESPONSE_SUBSCRIBE_TOPIC,
+  SW_TITLE_KEY, SW_VER_KEY, SW_SIZE_KEY, SW_CHKS_KEY, SW_CHKS_ALGO_KEY,
+  CURR_SW_TITLE_KEY, CURR_SW_VER_KEY, SW_STATE_KEY, SW_ERROR_KEY,
+  NO_SW, EMPTY_SW, SW_UP_TO_DATE, SW_NOT_FOR_US,
+#if THINGSBOARD_ENABLE_DEBUG
+  NEW_SW,
+#endif // THINGSBOARD_ENABLE_DEBUG
+};
+
 #endif // THINGSBOARD_ENABLE_SWOTA
 
 
@@ -325,7 +420,11 @@ constexpr char SW_CHKS_ALGO_NOT_SUPPORTED[] = "Checksum algorithm (%s) is not su
 /// If this feature of automatic deduction, is not needed, or not wanted because it allocates memory on the heap, then the values can be set once as template arguements.
 /// Simply set THINGSBOARD_ENABLE_DYNAMIC to 0, before including ThingsBoard.h
 /// @tparam Logger Logging class that should be used to print messages generated by internal processes, default = ThingsBoardDefaultLogger
-template<typename Logger = ThingsBoardDefaultLogger>
+/// @tparam Allocator Allocator policy every internal heap allocation is done with, allows to pin the library to a fixed memory budget or to psram. See Allocator.h for the available policies, default = Default_Allocator
+/// @tparam PayloadFormat Payload format policy telemetry, attributes, server-side RPC and the messages received over the default downlink topics are encoded with, allows to use a binary encoding instead of json. See Payload_Format.h for the available policies, default = Json_Payload_Format
+template<typename Logger = ThingsBoardDefaultLogger,
+         typename Allocator = Default_Allocator,
+         typename PayloadFormat = Json_Payload_Format>
 #else
 /// @brief Wrapper around any arbitrary MQTT Client implementing the IMQTT_Client interface, to allow connecting and sending / retrieving data from ThingsBoard over the MQTT or MQTT with TLS/SSL protocol.
 /// BufferSize of the underlying data buffer can be changed during the runtime and the maximum amount of data points that can ever be can be set once as template arguements.
@@ -333,8 +432,12 @@ template<typename Logger = ThingsBoardDefaultLogger>
 /// simply set THINGSBOARD_ENABLE_DYNAMIC to 1, before including ThingsBoard.h
 /// @tparam MaxFieldsAmt Maximum amount of key value pair that we will be able to sent or received by ThingsBoard in one call, default = 8
 /// @tparam Logger Logging class that should be used to print messages generated by internal processes, default = ThingsBoardDefaultLogger
+/// @tparam Allocator Allocator policy every internal heap allocation is done with, allows to pin the library to a fixed memory budget or to psram. See Allocator.h for the available policies, default = Default_Allocator
+/// @tparam PayloadFormat Payload format policy telemetry, attributes, server-side RPC and the messages received over the default downlink topics are encoded with, allows to use a binary encoding instead of json. See Payload_Format.h for the available policies, default = Json_Payload_Format
 template<size_t MaxFieldsAmt = Default_Fields_Amt,
-         typename Logger = ThingsBoardDefaultLogger>
+         typename Logger = ThingsBoardDefaultLogger,
+         typename Allocator = Default_Allocator,
+         typename PayloadFormat = Json_Payload_Format>
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 class ThingsBoardSized {
   public:
@@ -358,24 +461,36 @@ class ThingsBoardSized {
       : m_client(client)
       , m_max_stack(maxStackSize)
       , m_buffering_size(bufferingSize)
+      , m_allocator()
+      , m_payload_format()
+      , m_telemetry_filter(nullptr)
+      , m_attribute_filter(nullptr)
       , m_rpc_callbacks()
       , m_rpc_request_callbacks()
       , m_shared_attribute_update_callbacks()
       , m_attribute_request_callbacks()
       , m_provision_callback()
       , m_request_id(0U)
+      , m_request_section()
+#if THINGSBOARD_ENABLE_STL || THINGSBOARD_ENABLE_OTA
+      , m_timer_wheel()
+#endif // THINGSBOARD_ENABLE_STL || THINGSBOARD_ENABLE_OTA
+#if THINGSBOARD_ENABLE_STL
+      , m_request_watchdog(m_timer_wheel, [this]() { Handle_Request_Timeout(); })
+#endif // THINGSBOARD_ENABLE_STL
 #if THINGSBOARD_ENABLE_OTA
-      , m_fw_callback(nullptr)
       , m_previous_buffer_size(0U)
       , m_change_buffer_size(false)
-      , m_ota(std::bind(&ThingsBoardSized::Publish_Chunk_Request, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Firmware_Send_State, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Firmware_OTA_Unsubscribe, this))
+      , m_fw_download(m_timer_wheel, FIRMWARE_ARTIFACT, [this](const size_t& request_chunck) { return Publish_Chunk_Request(m_fw_download, request_chunck); }, [this](const char *current_state, const char *error) { return Send_Update_State(FIRMWARE_ARTIFACT, current_state, error); }, [this]() { return OTA_Unsubscribe(m_fw_download); })
 #endif // THINGSBOARD_ENABLE_OTA
 #if THINGSBOARD_ENABLE_SWOTA
-      , m_sw_callback(nullptr) // edit by DD
-      //, m_previous_buffer_size(0U)
-      //, m_change_buffer_size(false)
-      , m_swOta(std::bind(&ThingsBoardSized::SwPublish_Chunk_Request, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Software_Send_State, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::Software_OTA_Unsubscribe, this)) // edit by DD
+      , m_sw_download(m_timer_wheel, SOFTWARE_ARTIFACT, [this](const size_t& request_chunck) { return Publish_Chunk_Request(m_sw_download, request_chunck); }, [this](const char *current_state, const char *error) { return Send_Update_State(SOFTWARE_ARTIFACT, current_state, error); }, [this]() { return OTA_Unsubscribe(m_sw_download); })
 #endif // THINGSBOARD_ENABLE_SWOTA
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+      , m_performance_counters()
+      , m_performance_counters_interval(0U)
+      , m_performance_counters_last_sent(0U)
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
     {
       setBufferSize(bufferSize);
 
@@ -383,13 +498,8 @@ class ThingsBoardSized {
 #if THINGSBOARD_ENABLE_STL
       m_client.set_callback(std::bind(&ThingsBoardSized::onMQTTMessage, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
 #else
-      m_client.set_callback(ThingsBoardSized::onStaticMQTTMessage);
-      m_subscribedInstance = this;
+      m_client.set_callback(ThingsBoardSized::onStaticMQTTMessage, this);
 #endif // THINGSBOARD_ENABLE_STL
-
-#if !THINGSBOARD_ENABLE_DYNAMIC
-      reserve_callback_size(MaxFieldsAmt);
-#endif // !THINGSBOARD_ENABLE_DYNAMIC
     }
 
     /// @brief Destructor
@@ -406,6 +516,14 @@ class ThingsBoardSized {
       return m_client;
     }
 
+    /// @brief Gets the payload format policy telemetry, attributes, server-side RPC and the default downlink topics are encoded with,
+    /// allows to configure the policy after the instance has been created, for example to set the schema of the Protobuf_Payload_Format
+    /// or to decode the default downlink topics as json, if the device profile is configured to send them as json
+    /// @return Reference to the payload format policy
+    inline PayloadFormat& getPayloadFormat() {
+      return m_payload_format;
+    }
+
     /// @brief Sets the maximum amount of bytes that we want to allocate on the stack, before the memory is allocated on the heap instead
     /// @param maxStackSize Maximum amount of bytes we want to allocate on the stack
     inline void setMaximumStackSize(const size_t& maxStackSize) {
@@ -496,13 +614,83 @@ class ThingsBoardSized {
       return m_client.connected();
     }
 
-    /// @brief Receives / sends any outstanding messages from and to the MQTT broker
+    /// @brief Receives / sends any outstanding messages from and to the MQTT broker and handles every timeout that has passed,
+    /// like missing OTA chunks or responses to client-side RPC and attribute requests, therefore it has to be called periodically for them to ever time out
     /// @return Whether sending or receiving the oustanding the messages was successful or not
     inline bool loop() {
-      return m_client.loop();
+      const bool result = m_client.loop();
+#if THINGSBOARD_ENABLE_STL || THINGSBOARD_ENABLE_OTA
+      m_timer_wheel.Process();
+#endif // THINGSBOARD_ENABLE_STL || THINGSBOARD_ENABLE_OTA
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+      if (m_performance_counters_interval != 0U && Helper::getMicroseconds() - m_performance_counters_last_sent >= m_performance_counters_interval) {
+        sendPerformanceCounters();
+      }
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+      return result;
+    }
+
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+
+    /// @brief Gets the performance counters, that are kept about the sent and received messages, failures, latencies and heap usage,
+    /// allows to diagnose if the device is struggling without having to wait for it to disconnect
+    /// @return Reference to the internal performance counters, can be used to read or reset them
+    inline Performance_Counters& getPerformanceCounters() {
+      return m_performance_counters;
     }
 
-    /// @brief Attempts to send key value pairs from custom source over the given topic to the server
+    /// @brief Sets the interval in which the performance counters are automatically sent as telemetry data in the loop() method.
+    /// Ensure the internal buffer of the client is big enough to send all the key-value pairs at once, see sendPerformanceCounters() for more information
+    /// @param interval_microseconds Interval in microseconds, 0 disables automatically sending the performance counters
+    inline void setPerformanceCountersInterval(const uint64_t& interval_microseconds) {
+      m_performance_counters_interval = interval_microseconds;
+      m_performance_counters_last_sent = Helper::getMicroseconds();
+    }
+
+    /// @brief Attempts to send the performance counters as telemetry data. Sends the total amount of sent and received messages and bytes,
+    /// the amount of (de-)serialization failures and oversize drops, the count, average, 95th percentile and maximum of the RPC callback latency,
+    /// the average, 95th percentile and maximum of the OTA chunk round trip time and the largest heap allocation per allocation path.
+    /// The counters per topic class are not sent, to keep the message small, but can be read with getPerformanceCounters().
+    /// The counters are always encoded as json, independent of the payload format policy, because their keys are not part of any user defined schema
+    /// @return Whether sending the data was successful or not
+    inline bool sendPerformanceCounters() {
+      m_performance_counters_last_sent = Helper::getMicroseconds();
+
+      StaticJsonDocument<JSON_OBJECT_SIZE(PERF_FIELDS_AMOUNT)> jsonBuffer;
+      const JsonObject object = jsonBuffer.to<JsonObject>();
+
+      const Performance_Counters::Traffic_Counter sent = m_performance_counters.Get_Total_Sent();
+      const Performance_Counters::Traffic_Counter received = m_performance_counters.Get_Total_Received();
+      const Latency_Histogram& rpc_latency = m_performance_counters.Get_RPC_Latency();
+      const Latency_Histogram& ota_chunk_round_trip = m_performance_counters.Get_OTA_Chunk_Round_Trip();
+
+      object[PERF_SENT_MESSAGES_KEY] = sent.messages;
+      object[PERF_SENT_BYTES_KEY] = sent.bytes;
+      object[PERF_RECEIVED_MESSAGES_KEY] = received.messages;
+      object[PERF_RECEIVED_BYTES_KEY] = received.bytes;
+      object[PERF_SERIALIZATION_FAILURES_KEY] = m_performance_counters.Get_Serialization_Failures();
+      object[PERF_DESERIALIZATION_FAILURES_KEY] = m_performance_counters.Get_Deserialization_Failures();
+      object[PERF_OVERSIZE_DROPS_KEY] = m_performance_counters.Get_Oversize_Drops();
+      object[PERF_RPC_COUNT_KEY] = rpc_latency.Get_Count();
+      object[PERF_RPC_AVERAGE_KEY] = rpc_latency.Get_Average();
+      object[PERF_RPC_P95_KEY] = rpc_latency.Get_Percentile(PERF_PERCENTILE);
+      object[PERF_RPC_MAX_KEY] = rpc_latency.Get_Maximum();
+      object[PERF_OTA_CHUNK_AVERAGE_KEY] = ota_chunk_round_trip.Get_Average();
+      object[PERF_OTA_CHUNK_P95_KEY] = ota_chunk_round_trip.Get_Percentile(PERF_PERCENTILE);
+      object[PERF_OTA_CHUNK_MAX_KEY] = ota_chunk_round_trip.Get_Maximum();
+      object[PERF_HEAP_SEND_KEY] = m_performance_counters.Get_Largest_Heap_Allocation(Allocation_Path::SEND);
+      object[PERF_HEAP_RECEIVE_KEY] = m_performance_counters.Get_Largest_Heap_Allocation(Allocation_Path::RECEIVE);
+      object[PERF_HEAP_OTA_KEY] = m_performance_counters.Get_Largest_Heap_Allocation(Allocation_Path::OTA);
+
+      // Send_Json is not used, because it would reject the message if MaxFieldsAmt is smaller than the amount of sent performance counters,
+      // that check is only needed for user created data though, because we ensured our JsonDocument is big enough to hold all values
+      const Json_Payload_Format json_format;
+      return Serialize_And_Send_Json(TELEMETRY_TOPIC, object, Helper::Measure_Json(object), json_format, Payload_Type::OTHER);
+    }
+
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+
+    /// @brief Attempts to send key value pairs from custom source over the given topic to the server, always encoded as json
     /// @tparam TSource Source class that should be used to serialize the json that is sent to the server
     /// @param topic Topic we want to send the data over
     /// @param source Data source containing our json key value pairs we want to send
@@ -510,61 +698,21 @@ class ThingsBoardSized {
     /// @return Whether sending the data was successful or not
     template <typename TSource>
     inline bool Send_Json(const char* topic, const TSource& source, const size_t& jsonSize) {
-      // Check if allocating needed memory failed when trying to create the JsonObject,
-      // if it did the isNull() method will return true. See https://arduinojson.org/v6/api/jsonvariant/isnull/ for more information
-      if (source.isNull()) {
-        Logger::log(UNABLE_TO_ALLOCATE_MEMORY);
-        return false;
-      }
-#if !THINGSBOARD_ENABLE_DYNAMIC
-      const size_t amount = source.size();
-      if (MaxFieldsAmt < amount) {
-        char message[Helper::detectSize(TOO_MANY_JSON_FIELDS, amount, MaxFieldsAmt)];
-        snprintf_P(message, sizeof(message), TOO_MANY_JSON_FIELDS, amount, MaxFieldsAmt);
-        Logger::log(message);
-        return false;
-      }
-#endif // !THINGSBOARD_ENABLE_DYNAMIC
-      bool result = false;
-
-#if THINGSBOARD_ENABLE_STREAM_UTILS
-      // Check if the size of the given message would be too big for the actual client,
-      // if it is utilize the serialize json work around, so that the internal client buffer can be circumvented
-      if (m_client.get_buffer_size() < jsonSize)  {
-#if THINGSBOARD_ENABLE_DEBUG
-        char message[JSON_STRING_SIZE(strlen(SEND_MESSAGE)) + JSON_STRING_SIZE(strlen(topic)) + JSON_STRING_SIZE(strlen(SEND_SERIALIZED))];
-        snprintf_P(message, sizeof(message), SEND_MESSAGE, topic, SEND_SERIALIZED);
-        Logger::log(message);
-#endif // THINGSBOARD_ENABLE_DEBUG
-        result = Serialize_Json(topic, source, jsonSize);
-      }
-      // Check if the remaining stack size of the current task would overflow the stack,
-      // if it would allocate the memory on the heap instead to ensure no stack overflow occurs
-      else
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
-      if (getMaximumStackSize() < jsonSize) {
-        char* json = new char[jsonSize];
-        if (serializeJson(source, json, jsonSize) < jsonSize - 1) {
-          Logger::log(UNABLE_TO_SERIALIZE_JSON);
-        }
-        else {
-          result = Send_Json_String(topic, json);
-        }
-        // Ensure to actually delete the memory placed onto the heap, to make sure we do not create a memory leak
-        // and set the pointer to null so we do not have a dangling reference.
-        delete[] json;
-        json = nullptr;
-      }
-      else {
-        char json[jsonSize];
-        if (serializeJson(source, json, jsonSize) < jsonSize - 1) {
-          Logger::log(UNABLE_TO_SERIALIZE_JSON);
-          return result;
-        }
-        result = Send_Json_String(topic, json);
-      }
+      const Json_Payload_Format json_format;
+      return Send_Json(topic, source, jsonSize, json_format, Payload_Type::OTHER);
+    }
 
-      return result;
+    /// @brief Attempts to send key value pairs from custom source over the given topic to the server,
+    /// encoded with the payload format policy of this instance as the given kind of message
+    /// @tparam TSource Source class that should be used to serialize the json that is sent to the server
+    /// @param topic Topic we want to send the data over
+    /// @param source Data source containing our json key value pairs we want to send
+    /// @param jsonSize Size of the data inside the source
+    /// @param type Kind of message the source is sent as, decides which schema the payload format policy uses
+    /// @return Whether sending the data was successful or not
+    template <typename TSource>
+    inline bool Send_Json(const char* topic, const TSource& source, const size_t& jsonSize, const Payload_Type& type) {
+      return Send_Json(topic, source, jsonSize, m_payload_format, type);
     }
 
     /// @brief Attempts to send custom json string over the given topic to the server
@@ -576,23 +724,15 @@ class ThingsBoardSized {
         return false;
       }
 
-      const uint16_t& currentBufferSize = m_client.get_buffer_size();
       const size_t jsonSize = strlen(json);
 
-      if (currentBufferSize < jsonSize) {
-        char message[Helper::detectSize(INVALID_BUFFER_SIZE, currentBufferSize, jsonSize)];
-        snprintf_P(message, sizeof(message), INVALID_BUFFER_SIZE, currentBufferSize, jsonSize);
-        Logger::log(message);
-        return false;
-      }
-
 #if THINGSBOARD_ENABLE_DEBUG
       char message[JSON_STRING_SIZE(strlen(SEND_MESSAGE)) + JSON_STRING_SIZE(strlen(topic)) + jsonSize];
       snprintf_P(message, sizeof(message), SEND_MESSAGE, topic, json);
       Logger::log(message);
 #endif // THINGSBOARD_ENABLE_DEBUG
 
-      return m_client.publish(topic, reinterpret_cast<const uint8_t*>(json), jsonSize);
+      return Send_Payload(topic, reinterpret_cast<const uint8_t*>(json), jsonSize);
     }
 
     //----------------------------------------------------------------------------
@@ -688,6 +828,22 @@ class ThingsBoardSized {
       return Send_Json(PROV_REQUEST_TOPIC, requestObject, objectSize);
     }
 
+    /// @brief Sets the filter that decides which key-value pairs passed to sendTelemetry() or sendTelemetryData() are actually sent,
+    /// allows to suppress sending values that have not changed enough since they were sent last, for example with the Deadband_Filter.
+    /// Suppressed key-value pairs are treated as successfully sent, custom json passed to sendTelemetryJson() is never filtered
+    /// @param filter Filter that should be used, is not copied and therefore has to be kept alive as long as it is set, nullptr disables filtering
+    inline void setTelemetryFilter(ITelemetry_Filter *filter) {
+      m_telemetry_filter = filter;
+    }
+
+    /// @brief Sets the filter that decides which key-value pairs passed to sendAttributes() or sendAttributeData() are actually sent,
+    /// allows to suppress sending values that have not changed enough since they were sent last, for example with the Deadband_Filter.
+    /// Suppressed key-value pairs are treated as successfully sent, custom json passed to sendAttributeJSON() is never filtered
+    /// @param filter Filter that should be used, is not copied and therefore has to be kept alive as long as it is set, nullptr disables filtering
+    inline void setAttributeFilter(ITelemetry_Filter *filter) {
+      m_attribute_filter = filter;
+    }
+
     //----------------------------------------------------------------------------
     // Telemetry API
 
@@ -727,7 +883,7 @@ class ThingsBoardSized {
     /// @return Whether sending the data was successful or not
     template <typename TSource>
     inline bool sendTelemetryJson(const TSource& source, const size_t& jsonSize) {
-      return Send_Json(TELEMETRY_TOPIC, source, jsonSize);
+      return Send_Json(TELEMETRY_TOPIC, source, jsonSize, Payload_Type::TELEMETRY);
     }
 
     //----------------------------------------------------------------------------
@@ -769,7 +925,48 @@ class ThingsBoardSized {
     /// @return Whether sending the data was successful or not
     template <typename TSource>
     inline bool sendAttributeJSON(const TSource& source, const size_t& jsonSize) {
-      return Send_Json(ATTRIBUTE_TOPIC, source, jsonSize);
+      return Send_Json(ATTRIBUTE_TOPIC, source, jsonSize, Payload_Type::ATTRIBUTES);
+    }
+
+    /// @brief Attempts to send every attribute of the given store that has changed since it was published last in one single message,
+    /// once the message has been sent successfully the attributes are marked as unchanged. Does not send anything if no attribute has changed.
+    /// If more attributes have changed than MaxFieldsAmt allows in one message, they are sent in multiple messages of at most MaxFieldsAmt attributes instead,
+    /// where only the attributes of the messages that have been sent successfully are marked as unchanged
+    /// See https://thingsboard.io/docs/user-guide/attributes/ for more information
+    /// @tparam MaxKeys Maximum amount of attributes that can be stored
+    /// @tparam MaxKeyLength Maximum length of the key of an attribute
+    /// @tparam MaxStringLength Maximum length of a string value
+    /// @param store Store containing the current value of each client-side attribute
+    /// @return Whether sending the changed attributes was successful or not
+    template <size_t MaxKeys, size_t MaxKeyLength, size_t MaxStringLength>
+    inline bool sendChangedAttributes(Attribute_Store<MaxKeys, MaxKeyLength, MaxStringLength>& store) {
+      size_t changed_count = store.Get_Changed_Count();
+
+      while (changed_count > 0U) {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        const size_t count = changed_count;
+        // String are const char* and therefore stored as a pointer --> zero copy, meaning the size for the strings is 0 bytes,
+        // Data structure size depends on the amount of key value pairs passed.
+        // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
+        Json_Document jsonBuffer(JSON_OBJECT_SIZE(count), m_allocator);
+#else
+        // Messages with more than MaxFieldsAmt key-value pairs are rejected by Send_Json, therefore bigger changes are split into multiple messages
+        const size_t count = changed_count < MaxFieldsAmt ? changed_count : MaxFieldsAmt;
+        StaticJsonDocument<JSON_OBJECT_SIZE(MaxKeys < MaxFieldsAmt ? MaxKeys : MaxFieldsAmt)> jsonBuffer;
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+
+        const JsonVariant object = jsonBuffer.template to<JsonVariant>();
+        if (!store.Serialize_Changed(object, count)) {
+          Logger::log(UNABLE_TO_SERIALIZE);
+          return false;
+        }
+        if (!sendAttributeJSON(object, Helper::Measure_Json(object))) {
+          return false;
+        }
+        store.Clear_Changed(count);
+        changed_count -= count;
+      }
+      return true;
     }
 
     /// @brief Requests one client-side attribute calllback,
@@ -889,12 +1086,9 @@ class ThingsBoardSized {
         Logger::log(RPC_METHOD_NULL);
         return false;
       }
-      RPC_Request_Callback* registeredCallback = nullptr;
-      // Ensure the response topic has been subscribed
-      if (!RPC_Request_Subscribe(callback, registeredCallback)) {
-        return false;
-      }
-      else if (registeredCallback == nullptr) {
+      // Ensure the response topic has been subscribed, the local copy is assigned the request id once it has been registered
+      RPC_Request_Callback request = callback;
+      if (!RPC_Request_Subscribe(request)) {
         return false;
       }
 
@@ -905,7 +1099,7 @@ class ThingsBoardSized {
       // Data structure size depends on the amount of key value pairs passed + the default methodName and params key needed for the request.
       // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
       const size_t dataStructureMemoryUsage = JSON_OBJECT_SIZE(parameters != nullptr ? parameters->size() + 2U : 2U);
-      TBJsonDocument requestBuffer(dataStructureMemoryUsage);
+      Json_Document requestBuffer(dataStructureMemoryUsage, m_allocator);
 #else
       // Ensure to have enough size for the infinite amount of possible parameters that could be sent to the cloud,
       // therefore we set the size to the MaxFieldsAmt instead of JSON_OBJECT_SIZE(1), which will result in a JsonDocument with a size of 16 bytes
@@ -927,11 +1121,9 @@ class ThingsBoardSized {
         requestVariant[RPC_PARAMS_KEY] = RPC_EMPTY_PARAMS_VALUE;
       }
 
-      m_request_id++;
-      registeredCallback->Set_Request_ID(m_request_id);
-
-      char topic[Helper::detectSize(RPC_SEND_REQUEST_TOPIC, m_request_id)];
-      snprintf_P(topic, sizeof(topic), RPC_SEND_REQUEST_TOPIC, m_request_id);
+      const size_t& request_id = request.Get_Request_ID();
+      char topic[Helper::detectSize(RPC_SEND_REQUEST_TOPIC, request_id)];
+      snprintf_P(topic, sizeof(topic), RPC_SEND_REQUEST_TOPIC, request_id);
 
       const size_t objectSize = Helper::Measure_Json(requestBuffer);
       return Send_Json(topic, requestBuffer, objectSize);
@@ -947,21 +1139,13 @@ class ThingsBoardSized {
     /// @param callback Callback method that will be called
     /// @return Whether subscribing the given callback was successful or not
     inline bool Start_Firmware_Update(const OTA_Update_Callback& callback) {
-      if (!Prepare_Firmware_Settings(callback))  {
-        Logger::log(RESETTING_FAILED);
-        return false;
-      }
-
-      // Request the firmware information
-      const std::vector<const char *> fw_shared_keys{FW_CHKS_KEY, FW_CHKS_ALGO_KEY, FW_SIZE_KEY, FW_TITLE_KEY, FW_VER_KEY};
-      const Attribute_Request_Callback fw_request_callback(std::bind(&ThingsBoardSized::Firmware_Shared_Attribute_Received, this, std::placeholders::_1), fw_shared_keys.cbegin(), fw_shared_keys.cend());
-      return Shared_Attributes_Request(fw_request_callback);
+      return Start_Update(m_fw_download, callback);
     }
 
     /// @brief Stops the currently running firmware update, calls the finish callback with a failure if the update is running.
     /// See https://thingsboard.io/docs/user-guide/ota-updates/ for more information
     inline void Stop_Firmware_Update() {
-      m_ota.Stop_Firmware_Update();
+      m_fw_download.handler.Stop_Update();
     }
 
     /// @brief Subscribes for any assignment of firmware to the given device device,
@@ -970,15 +1154,7 @@ class ThingsBoardSized {
     /// @param callback Callback method that will be called
     /// @return Whether subscribing the given callback was successful or not
     inline bool Subscribe_Firmware_Update(const OTA_Update_Callback& callback) {
-      if (!Prepare_Firmware_Settings(callback))  {
-        Logger::log(RESETTING_FAILED);
-        return false;
-      }
-
-      // Subscribes to changes of the firmware information
-      const std::vector<const char *> fw_shared_keys{FW_CHKS_KEY, FW_CHKS_ALGO_KEY, FW_SIZE_KEY, FW_TITLE_KEY, FW_VER_KEY};
-      const Shared_Attribute_Callback fw_update_callback(std::bind(&ThingsBoardSized::Firmware_Shared_Attribute_Received, this, std::placeholders::_1), fw_shared_keys.cbegin(), fw_shared_keys.cend());
-      return Shared_Attributes_Subscribe(fw_update_callback);
+      return Subscribe_Update(m_fw_download, callback);
     }
 
     /// @brief Sends the given firmware title and firmware version to the cloud.
@@ -987,12 +1163,7 @@ class ThingsBoardSized {
     /// @param currFwVersion Current device firmware version
     /// @return Whether sending the current device firmware information was successful or not
     inline bool Firmware_Send_Info(const char *currFwTitle, const char *currFwVersion) {
-      StaticJsonDocument<JSON_OBJECT_SIZE(2)> currentFirmwareInfo;
-      const JsonObject currentFirmwareInfoObject = currentFirmwareInfo.to<JsonObject>();
-
-      currentFirmwareInfoObject[CURR_FW_TITLE_KEY] = currFwTitle;
-      currentFirmwareInfoObject[CURR_FW_VER_KEY] = currFwVersion;
-      return sendTelemetryJson(currentFirmwareInfoObject, Helper::Measure_Json(currentFirmwareInfoObject));
+      return Send_Update_Info(FIRMWARE_ARTIFACT, currFwTitle, currFwVersion);
     }
 
     /// @brief Sends the given firmware state to the cloud.
@@ -1003,16 +1174,7 @@ class ThingsBoardSized {
     /// and therefore does not require any firmware error messsages
     /// @return Whether sending the current firmware download state was successful or not
     inline bool Firmware_Send_State(const char *currFwState, const char* fwError = nullptr) {
-      StaticJsonDocument<JSON_OBJECT_SIZE(2)> currentFirmwareState;
-      const JsonObject currentFirmwareStateObject = currentFirmwareState.to<JsonObject>();
-
-      // Make the fw error optional,
-      // meaning if it is an empty string or null instead we don't send it at all.
-      if (fwError != nullptr && fwError[0] != '\0') {
-        currentFirmwareStateObject[FW_ERROR_KEY] = fwError;
-      }
-      currentFirmwareStateObject[FW_STATE_KEY] = currFwState;
-      return sendTelemetryJson(currentFirmwareStateObject, Helper::Measure_Json(currentFirmwareStateObject));
+      return Send_Update_State(FIRMWARE_ARTIFACT, currFwState, fwError);
     }
 
 #endif // THINGSBOARD_ENABLE_OTA
@@ -1120,31 +1282,24 @@ class ThingsBoardSized {
     }
 
 
-   //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
     // Software OTA API
 
 #if THINGSBOARD_ENABLE_SWOTA
 
     /// @brief Immediately starts a software update if software is assigned to the given device.
+    /// Is downloaded with its own instance of the same engine as the firmware, therefore both updates can run at the same time.
     /// See https://thingsboard.io/docs/user-guide/ota-updates/ for more information
     /// @param callback Callback method that will be called
     /// @return Whether subscribing the given callback was successful or not
-    inline bool Start_Software_Update(const SWOTA_Update_Callback& callback) { //edit by DD
-      if (!Prepare_Software_Settings(callback))  {
-        Logger::log(RESETTING_FAILED);
-        return false;
-      }
-
-      // Request the software information
-      const std::vector<const char *> sw_shared_keys{SW_CHKS_KEY, SW_CHKS_ALGO_KEY, SW_SIZE_KEY, SW_TITLE_KEY, SW_VER_KEY};
-      const Attribute_Request_Callback sw_request_callback(std::bind(&ThingsBoardSized::Software_Shared_Attribute_Received, this, std::placeholders::_1), sw_shared_keys.cbegin(), sw_shared_keys.cend());
-      return Shared_Attributes_Request(sw_request_callback);
+    inline bool Start_Software_Update(const SWOTA_Update_Callback& callback) {
+      return Start_Update(m_sw_download, callback);
     }
 
     /// @brief Stops the currently running software update, calls the finish callback with a failure if the update is running.
     /// See https://thingsboard.io/docs/user-guide/ota-updates/ for more information
     inline void Stop_Software_Update() {
-      m_swOta.Stop_Software_Update();
+      m_sw_download.handler.Stop_Update();
     }
 
     /// @brief Subscribes for any assignment of software to the given device device,
@@ -1153,15 +1308,7 @@ class ThingsBoardSized {
     /// @param callback Callback method that will be called
     /// @return Whether subscribing the given callback was successful or not
     inline bool Subscribe_Software_Update(const SWOTA_Update_Callback& callback) {
-      if (!Prepare_Software_Settings(callback))  {
-        Logger::log(RESETTING_FAILED);
-        return false;
-      }
-
-      // Subscribes to changes of the software information
-      const std::vector<const char *> sw_shared_keys{SW_CHKS_KEY, SW_CHKS_ALGO_KEY, SW_SIZE_KEY, SW_TITLE_KEY, SW_VER_KEY};
-      const Shared_Attribute_Callback sw_update_callback(std::bind(&ThingsBoardSized::Software_Shared_Attribute_Received, this, std::placeholders::_1), sw_shared_keys.cbegin(), sw_shared_keys.cend());
-      return Shared_Attributes_Subscribe(sw_update_callback);
+      return Subscribe_Update(m_sw_download, callback);
     }
 
     /// @brief Sends the given software title and software version to the cloud.
@@ -1170,12 +1317,7 @@ class ThingsBoardSized {
     /// @param currSwVersion Current device software version
     /// @return Whether sending the current device software information was successful or not
     inline bool Software_Send_Info(const char *currSwTitle, const char *currSwVersion) {
-      StaticJsonDocument<JSON_OBJECT_SIZE(2)> currentSoftwareInfo;
-      const JsonObject currentSoftwareInfoObject = currentSoftwareInfo.to<JsonObject>();
-
-      currentSoftwareInfoObject[CURR_SW_TITLE_KEY] = currSwTitle;
-      currentSoftwareInfoObject[CURR_SW_VER_KEY] = currSwVersion;
-      return sendTelemetryJson(currentSoftwareInfoObject, Helper::Measure_Json(currentSoftwareInfoObject));
+      return Send_Update_Info(SOFTWARE_ARTIFACT, currSwTitle, currSwVersion);
     }
 
     /// @brief Sends the given software state to the cloud.
@@ -1186,99 +1328,355 @@ class ThingsBoardSized {
     /// and therefore does not require any software error messsages
     /// @return Whether sending the current software download state was successful or not
     inline bool Software_Send_State(const char *currSwState, const char* swError = nullptr) {
-      StaticJsonDocument<JSON_OBJECT_SIZE(2)> currentSoftwareState;
-      const JsonObject currentSoftwareStateObject = currentSoftwareState.to<JsonObject>();
-
-      // Make the sw error optional,
-      // meaning if it is an empty string or null instead we don't send it at all.
-      if (swError != nullptr && swError[0] != '\0') {
-        currentSoftwareStateObject[SW_ERROR_KEY] = swError;
-      }
-      currentSoftwareStateObject[SW_STATE_KEY] = currSwState;
-      return sendTelemetryJson(currentSoftwareStateObject, Helper::Measure_Json(currentSoftwareStateObject));
+      return Send_Update_State(SOFTWARE_ARTIFACT, currSwState, swError);
     }
 
 #endif // THINGSBOARD_ENABLE_SWOTA
   
   private:
+#if THINGSBOARD_ENABLE_OTA
+    /// @brief State of the download of one artifact type, every artifact type has its own instance of the download engine,
+    /// which allows to download the firmware and the software at the same time
+    struct OTA_Download {
+      /// @brief Constructor
+      /// @param timer_wheel Timer wheel the chunk request timeouts are scheduled on, has to be kept alive as long as the download is used
+      /// @param artifact Topics, attribute keys and messages of the downloaded artifact type, has to be kept alive as long as the download is used
+      /// @param publish_callback Callback that is used to request the chunk with the given chunk number
+      /// @param send_state_callback Callback that is used to send information about the current state of the update
+      /// @param finish_callback Callback that is called once the update has been finished
+      inline OTA_Download(Timer_Wheel& timer_wheel, const OTA_Artifact& artifact, Inplace_Function<bool(const size_t&)> publish_callback, Inplace_Function<bool(const char *, const char *)> send_state_callback, Inplace_Function<bool(void)> finish_callback)
+        : artifact(artifact)
+        , callback(nullptr)
+        , handler(timer_wheel, publish_callback, send_state_callback, finish_callback)
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+        , chunk_request_time(0U)
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+      {
+        // Nothing to do
+      }
+
+      const OTA_Artifact& artifact;        // Topics, attribute keys and messages of the downloaded artifact type
+      const OTA_Update_Callback *callback; // Update callback of the prepared or running update, nullptr if no update has been prepared
+      OTA_Handler<Logger> handler;         // Engine that requests, writes and verifies the chunks of the binary
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+      uint64_t chunk_request_time;         // Timestamp in microseconds the last chunk was requested at, used to measure the round trip time, 0 if no request is outstanding
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+    };
+#endif // THINGSBOARD_ENABLE_OTA
 
 #if THINGSBOARD_ENABLE_STREAM_UTILS
 
     /// @brief Serialize the custom attribute source into the underlying client.
     /// Sends the given bytes to the client without requiring any temporary buffer at the cost of hugely increased send times
+    /// @tparam Format Payload format policy the source is encoded with
     /// @tparam TSource Source class that should be used to serialize the json that is sent to the server
     /// @param topic Topic we want to send the data over
     /// @param source Data source containing our json key value pairs we want to send
-    /// @param jsonSize Size of the data inside the source
+    /// @param format Payload format policy the source is encoded with
+    /// @param type Kind of message the source is sent as
+    /// @param payloadSize Size of the encoded payload
     /// @return Whether sending the data was successful or not
-    template <typename TSource>
-    inline bool Serialize_Json(const char* topic, const TSource& source, const size_t& jsonSize) {
-      if (!m_client.begin_publish(topic, jsonSize)) {
+    template <typename Format, typename TSource>
+    inline bool Serialize_Json(const char* topic, const TSource& source, const Format& format, const Payload_Type& type, const size_t& payloadSize) {
+      if (!m_client.begin_publish(topic, payloadSize)) {
         Logger::log(UNABLE_TO_SERIALIZE_JSON);
         return false;
       }
       BufferingPrint buffered_print(m_client, getBufferingSize());
-      const size_t bytes_serialized = serializeJson(source, buffered_print);
-      if (bytes_serialized < jsonSize) {
+      const size_t bytes_serialized = format.Serialize(type, source, buffered_print);
+      if (bytes_serialized < payloadSize) {
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+        m_performance_counters.Record_Serialization_Failure();
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
         Logger::log(UNABLE_TO_SERIALIZE_JSON);
         return false;
       }
       buffered_print.flush();
-      return m_client.end_publish();
+      const bool result = m_client.end_publish();
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+      if (result) {
+        m_performance_counters.Record_Sent(Get_Topic_Class(topic, false), bytes_serialized);
+      }
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+      return result;
     }
 
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
 
-#if THINGSBOARD_ENABLE_OTA
-
-    /// @brief Publishes a request via MQTT to request the given firmware chunk
-    /// @param request_chunck Chunk index that should be requested from the server
-    /// @return Whether publishing the message was successful or not
-    inline bool Publish_Chunk_Request(const size_t& request_chunck) {
-      // Calculate the number of chuncks we need to request,
-      // in order to download the complete firmware binary
-      const uint16_t& chunk_size = m_fw_callback->Get_Chunk_Size();
-
-      // Convert the interger size into a readable string
-      char size[Helper::detectSize(NUMBER_PRINTF, chunk_size)];
-      snprintf_P(size, sizeof(size), NUMBER_PRINTF, chunk_size);
-      const size_t jsonSize = strlen(size);
-
-      // Size adjuts dynamically to the current length of the currChunk number to ensure we don't cut it out of the topic string.
-      char topic[Helper::detectSize(FIRMWARE_REQUEST_TOPIC, request_chunck)];
-      snprintf_P(topic, sizeof(topic), FIRMWARE_REQUEST_TOPIC, request_chunck);
-
-      return m_client.publish(topic, reinterpret_cast<uint8_t*>(size), jsonSize);
+    /// @brief Attempts to send key value pairs from custom source over the given topic to the server, encoded with the given payload format policy
+    /// @tparam Format Payload format policy the source is encoded with
+    /// @tparam TSource Source class that should be used to serialize the json that is sent to the server
+    /// @param topic Topic we want to send the data over
+    /// @param source Data source containing our json key value pairs we want to send
+    /// @param jsonSize Size of the data inside the source
+    /// @param format Payload format policy the source is encoded with
+    /// @param type Kind of message the source is sent as
+    /// @return Whether sending the data was successful or not
+    template <typename Format, typename TSource>
+    inline bool Send_Json(const char* topic, const TSource& source, const size_t& jsonSize, const Format& format, const Payload_Type& type) {
+      // Check if allocating needed memory failed when trying to create the JsonObject,
+      // if it did the isNull() method will return true. See https://arduinojson.org/v6/api/jsonvariant/isnull/ for more information
+      if (source.isNull()) {
+        Logger::log(UNABLE_TO_ALLOCATE_MEMORY);
+        return false;
+      }
+#if !THINGSBOARD_ENABLE_DYNAMIC
+      const size_t amount = source.size();
+      if (MaxFieldsAmt < amount) {
+        char message[Helper::detectSize(TOO_MANY_JSON_FIELDS, amount, MaxFieldsAmt)];
+        snprintf_P(message, sizeof(message), TOO_MANY_JSON_FIELDS, amount, MaxFieldsAmt);
+        Logger::log(message);
+        return false;
+      }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+      return Serialize_And_Send_Json(topic, source, jsonSize, format, type);
     }
 
-#endif // THINGSBOARD_ENABLE_OTA
-
-    /// @brief Returns the maximum amount of bytes that we want to allocate on the stack, before the memory is allocated on the heap instead
-    /// @return Maximum amount of bytes we want to allocate on the stack
-    inline const size_t& getMaximumStackSize() const {
-      return m_max_stack;
+    /// @brief Serializes the given source with the given payload format policy into a temporary buffer and sends it over the given topic to the server,
+    /// does not check if the amount of key-value pairs in the source is bigger than MaxFieldsAmt, that has to be done by the caller if needed
+    /// @tparam Format Payload format policy the source is encoded with
+    /// @tparam TSource Source class that should be used to serialize the json that is sent to the server
+    /// @param topic Topic we want to send the data over
+    /// @param source Data source containing our json key value pairs we want to send
+    /// @param jsonSize Size of the data inside the source
+    /// @param format Payload format policy the source is encoded with
+    /// @param type Kind of message the source is sent as
+    /// @return Whether sending the data was successful or not
+    template <typename Format, typename TSource>
+    inline bool Serialize_And_Send_Json(const char* topic, const TSource& source, const size_t& jsonSize, const Format& format, const Payload_Type& type) {
+      return Serialize_And_Send(topic, source, format, type, format.Measure(type, source, jsonSize));
     }
 
+    /// @brief Encodes the given source with the given payload format policy into a temporary buffer and sends it over the given topic to the server
+    /// @tparam Format Payload format policy the source is encoded with
+    /// @tparam TSource Source class that should be used to serialize the json that is sent to the server
+    /// @param topic Topic we want to send the data over
+    /// @param source Data source containing our json key value pairs we want to send
+    /// @param format Payload format policy the source is encoded with
+    /// @param type Kind of message the source is sent as
+    /// @param payloadSize Size of the encoded payload
+    /// @return Whether sending the data was successful or not
+    template <typename Format, typename TSource>
+    inline bool Serialize_And_Send(const char* topic, const TSource& source, const Format& format, const Payload_Type& type, const size_t& payloadSize) {
+      bool result = false;
+      // Payload format policies measure 0 bytes if they reject the given source, because it can not be encoded without losing values
+      if (payloadSize == 0U) {
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+        m_performance_counters.Record_Serialization_Failure();
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+        Logger::log(UNABLE_TO_SERIALIZE_JSON);
+        return result;
+      }
+      // Json is null terminated, which needs one additional byte in the buffer
+      const size_t bufferSize = payloadSize + 1U;
+
 #if THINGSBOARD_ENABLE_STREAM_UTILS
+      // Check if the size of the given message would be too big for the actual client,
+      // if it is utilize the serialize json work around, so that the internal client buffer can be circumvented
+      if (m_client.get_buffer_size() < payloadSize)  {
+#if THINGSBOARD_ENABLE_DEBUG
+        char message[JSON_STRING_SIZE(strlen(SEND_MESSAGE)) + JSON_STRING_SIZE(strlen(topic)) + JSON_STRING_SIZE(strlen(SEND_SERIALIZED))];
+        snprintf_P(message, sizeof(message), SEND_MESSAGE, topic, SEND_SERIALIZED);
+        Logger::log(message);
+#endif // THINGSBOARD_ENABLE_DEBUG
+        result = Serialize_Json(topic, source, format, type, payloadSize);
+      }
+      // Check if the remaining stack size of the current task would overflow the stack,
+      // if it would allocate the memory on the heap instead to ensure no stack overflow occurs
+      else
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+      if (getMaximumStackSize() < bufferSize) {
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+        m_performance_counters.Record_Heap_Allocation(Allocation_Path::SEND, bufferSize);
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+        uint8_t* payload = static_cast<uint8_t*>(m_allocator.allocate(bufferSize));
+        if (payload == nullptr) {
+          char message[Helper::detectSize(UNABLE_TO_ALLOCATE_BUFFER, static_cast<unsigned int>(bufferSize))];
+          snprintf_P(message, sizeof(message), UNABLE_TO_ALLOCATE_BUFFER, static_cast<unsigned int>(bufferSize));
+          Logger::log(message);
+          return result;
+        }
+        result = Encode_And_Send(topic, source, format, type, payload, bufferSize);
+        // Ensure to actually free the memory placed onto the heap, to make sure we do not create a memory leak
+        // and set the pointer to null so we do not have a dangling reference.
+        m_allocator.deallocate(payload);
+        payload = nullptr;
+      }
+      else {
+        uint8_t payload[bufferSize];
+        result = Encode_And_Send(topic, source, format, type, payload, bufferSize);
+      }
 
-    /// @brief Returns the amount of bytes that can be allocated to speed up fall back serialization with the StreamUtils class
-    /// See https://github.com/bblanchon/ArduinoStreamUtils for more information on the underlying class used
-    /// @return Amount of bytes allocated to speed up serialization
-    inline const size_t& getBufferingSize() const {
-      return m_buffering_size;
+      return result;
     }
 
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
-
-    /// @brief Requests one client-side or shared attribute calllback,
-    /// that will be called if the key-value pair from the server for the given client-side or shared attributes is received
-    /// @param callback Callback method that will be called
-    /// @param attributeRequestKey Key of the key-value pair that will contain the attributes we want to request
-    /// @param attributeResponseKey Key of the key-value pair that will contain the attributes we got as a response
+    /// @brief Encodes the given source with the given payload format policy into the given buffer and sends it over the given topic to the server
+    /// @tparam Format Payload format policy the source is encoded with
+    /// @tparam TSource Source class that should be used to serialize the json that is sent to the server
+    /// @param topic Topic we want to send the data over
+    /// @param source Data source containing our json key value pairs we want to send
+    /// @param format Payload format policy the source is encoded with
+    /// @param type Kind of message the source is sent as
+    /// @param payload Buffer the source is encoded into
+    /// @param bufferSize Size of the buffer, one byte bigger than the encoded payload
+    /// @return Whether sending the data was successful or not
+    template <typename Format, typename TSource>
+    inline bool Encode_And_Send(const char* topic, const TSource& source, const Format& format, const Payload_Type& type, uint8_t *payload, const size_t& bufferSize) {
+      const size_t payloadSize = format.Serialize(type, source, payload, bufferSize);
+      if (payloadSize < bufferSize - 1U) {
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+        m_performance_counters.Record_Serialization_Failure();
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+        Logger::log(UNABLE_TO_SERIALIZE_JSON);
+        return false;
+      }
+#if THINGSBOARD_ENABLE_DEBUG
+      // Binary payloads can not be printed and are therefore not logged
+      if (Format::Is_Text) {
+        char message[JSON_STRING_SIZE(strlen(SEND_MESSAGE)) + JSON_STRING_SIZE(strlen(topic)) + bufferSize];
+        snprintf_P(message, sizeof(message), SEND_MESSAGE, topic, reinterpret_cast<const char*>(payload));
+        Logger::log(message);
+      }
+#endif // THINGSBOARD_ENABLE_DEBUG
+      return Send_Payload(topic, payload, payloadSize);
+    }
+
+    /// @brief Publishes the given already encoded payload over the given topic to the server, if it fits into the buffer of the client
+    /// @param topic Topic we want to send the data over
+    /// @param payload Encoded payload we want to send
+    /// @param length Length of the encoded payload
+    /// @return Whether sending the data was successful or not
+    inline bool Send_Payload(const char* topic, const uint8_t *payload, const size_t& length) {
+      const uint16_t& currentBufferSize = m_client.get_buffer_size();
+
+      if (currentBufferSize < length) {
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+        m_performance_counters.Record_Oversize_Drop();
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+        char message[Helper::detectSize(INVALID_BUFFER_SIZE, currentBufferSize, length)];
+        snprintf_P(message, sizeof(message), INVALID_BUFFER_SIZE, currentBufferSize, length);
+        Logger::log(message);
+        return false;
+      }
+
+      const bool result = m_client.publish(topic, payload, length);
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+      if (result) {
+        m_performance_counters.Record_Sent(Get_Topic_Class(topic, false), length);
+      }
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+      return result;
+    }
+
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+
+    /// @brief Gets the class of the given topic, that the sent or received messages are counted in by the performance counters.
+    /// The direction is needed, because the same topic can be used to send requests or to receive responses depending on the feature
+    /// @param topic Topic the message was sent or received over
+    /// @param received Whether the message was received from the server or sent to the server
+    /// @return Class of the given topic or Topic_Class::OTHER if it does not belong to any of the ThingsBoard topics
+    inline Topic_Class Get_Topic_Class(const char *topic, const bool& received) const {
+      if (topic == nullptr) {
+        return Topic_Class::OTHER;
+      }
+      // Same ordering as in onMQTTMessage has to be kept, because more specific topics contain the text of the less specific ones.
+      // The request topics contain a number format argument (%u) at the end, which is removed from the compared length
+      else if (strncmp_P(TELEMETRY_TOPIC, topic, strlen(TELEMETRY_TOPIC)) == 0) {
+        return Topic_Class::TELEMETRY;
+      }
+      else if (strncmp_P(RPC_RESPONSE_TOPIC, topic, strlen(RPC_RESPONSE_TOPIC)) == 0) {
+        return received ? Topic_Class::RPC_REQUEST : Topic_Class::RPC;
+      }
+      else if (strncmp_P(RPC_REQUEST_TOPIC, topic, strlen(RPC_REQUEST_TOPIC)) == 0) {
+        return received ? Topic_Class::RPC : Topic_Class::RPC_REQUEST;
+      }
+      else if (strncmp_P(ATTRIBUTE_RESPONSE_TOPIC, topic, strlen(ATTRIBUTE_RESPONSE_TOPIC)) == 0 || strncmp_P(ATTRIBUTE_REQUEST_TOPIC, topic, strlen(ATTRIBUTE_REQUEST_TOPIC) - 2U) == 0) {
+        return Topic_Class::ATTRIBUTE_REQUEST;
+      }
+      else if (strncmp_P(ATTRIBUTE_TOPIC, topic, strlen(ATTRIBUTE_TOPIC)) == 0) {
+        return Topic_Class::ATTRIBUTE;
+      }
+      else if (strncmp_P(PROV_RESPONSE_TOPIC, topic, strlen(PROV_RESPONSE_TOPIC)) == 0 || strncmp_P(PROV_REQUEST_TOPIC, topic, strlen(PROV_REQUEST_TOPIC)) == 0) {
+        return Topic_Class::PROVISION;
+      }
+      else if (strncmp_P(CLAIM_TOPIC, topic, strlen(CLAIM_TOPIC)) == 0) {
+        return Topic_Class::CLAIM;
+      }
+#if THINGSBOARD_ENABLE_OTA
+      else if (strncmp_P(FIRMWARE_RESPONSE_TOPIC, topic, strlen(FIRMWARE_RESPONSE_TOPIC)) == 0) {
+        return Topic_Class::FIRMWARE;
+      }
+#endif // THINGSBOARD_ENABLE_OTA
+#if THINGSBOARD_ENABLE_SWOTA
+      else if (strncmp_P(SOFTWARE_RESPONSE_TOPIC, topic, strlen(SOFTWARE_RESPONSE_TOPIC)) == 0) {
+        return Topic_Class::SOFTWARE;
+      }
+#endif // THINGSBOARD_ENABLE_SWOTA
+      return Topic_Class::OTHER;
+    }
+
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+
+#if THINGSBOARD_ENABLE_OTA
+
+    /// @brief Publishes a request via MQTT to request the given chunk of the given download
+    /// @param download Download the chunk is requested for
+    /// @param request_chunck Chunk index that should be requested from the server
+    /// @return Whether publishing the message was successful or not
+    inline bool Publish_Chunk_Request(OTA_Download& download, const size_t& request_chunck) {
+      // Calculate the number of chuncks we need to request,
+      // in order to download the complete binary
+      const uint16_t& chunk_size = download.callback->Get_Chunk_Size();
+
+      // Convert the interger size into a readable string
+      char size[Helper::detectSize(NUMBER_PRINTF, chunk_size)];
+      snprintf_P(size, sizeof(size), NUMBER_PRINTF, chunk_size);
+      const size_t jsonSize = strlen(size);
+
+      // Size adjuts dynamically to the current length of the currChunk number to ensure we don't cut it out of the topic string.
+      char topic[Helper::detectSize(download.artifact.request_topic, request_chunck)];
+      snprintf_P(topic, sizeof(topic), download.artifact.request_topic, request_chunck);
+
+      const bool result = m_client.publish(topic, reinterpret_cast<uint8_t*>(size), jsonSize);
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+      // Every request, including the retries of a chunk, restarts the round trip measurement. A request that could not be published clears it instead,
+      // because otherwise a late response to an earlier request would be measured from that earlier request
+      download.chunk_request_time = result ? Helper::getMicroseconds() : 0U;
+      if (result) {
+        m_performance_counters.Record_Sent(Get_Topic_Class(download.artifact.response_topic, true), jsonSize);
+      }
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+      return result;
+    }
+
+#endif // THINGSBOARD_ENABLE_OTA
+
+    /// @brief Returns the maximum amount of bytes that we want to allocate on the stack, before the memory is allocated on the heap instead
+    /// @return Maximum amount of bytes we want to allocate on the stack
+    inline const size_t& getMaximumStackSize() const {
+      return m_max_stack;
+    }
+
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+
+    /// @brief Returns the amount of bytes that can be allocated to speed up fall back serialization with the StreamUtils class
+    /// See https://github.com/bblanchon/ArduinoStreamUtils for more information on the underlying class used
+    /// @return Amount of bytes allocated to speed up serialization
+    inline const size_t& getBufferingSize() const {
+      return m_buffering_size;
+    }
+
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+
+    /// @brief Requests one client-side or shared attribute calllback,
+    /// that will be called if the key-value pair from the server for the given client-side or shared attributes is received
+    /// @param callback Callback method that will be called
+    /// @param attributeRequestKey Key of the key-value pair that will contain the attributes we want to request
+    /// @param attributeResponseKey Key of the key-value pair that will contain the attributes we got as a response
     /// @return Whether requesting the given callback was successful or not
     inline bool Attributes_Request(const Attribute_Request_Callback& callback, const char* attributeRequestKey, const char* attributeResponseKey) {
 #if THINGSBOARD_ENABLE_STL
-      const std::vector<const char *>& attributes = callback.Get_Attributes();
+      const Attribute_Request_Callback::Attribute_Keys& attributes = callback.Get_Attributes();
 
       // Check if any sharedKeys were requested
       if (attributes.empty()) {
@@ -1300,12 +1698,10 @@ class ThingsBoardSized {
       }
 #endif // THINGSBOARD_ENABLE_STL
 
-      // Ensure the response topic has been subscribed
-      Attribute_Request_Callback* registeredCallback = nullptr;
-      if (!Attributes_Request_Subscribe(callback, registeredCallback)) {
-        return false;
-      }
-      else if (registeredCallback == nullptr) {
+      // Ensure the response topic has been subscribed, the local copy is assigned the request id once it has been registered
+      Attribute_Request_Callback request_callback = callback;
+      request_callback.Set_Attribute_Key(attributeResponseKey);
+      if (!Attributes_Request_Subscribe(request_callback)) {
         return false;
       }
 
@@ -1320,7 +1716,7 @@ class ThingsBoardSized {
       const JsonVariant requestVariant = requestBuffer.template as<JsonVariant>();
 
 #if THINGSBOARD_ENABLE_STL
-      std::string request;
+      String_Type request;
 
       for (const char *att : attributes) {
         // Check if the given attribute is null, if it is skip it
@@ -1343,12 +1739,9 @@ class ThingsBoardSized {
       requestVariant[attributeRequestKey] = request;
 #endif // THINGSBOARD_ENABLE_STL
 
-      m_request_id++;
-      registeredCallback->Set_Request_ID(m_request_id);
-      registeredCallback->Set_Attribute_Key(attributeResponseKey);
-
-      char topic[Helper::detectSize(ATTRIBUTE_REQUEST_TOPIC, m_request_id)];
-      snprintf_P(topic, sizeof(topic), ATTRIBUTE_REQUEST_TOPIC, m_request_id);
+      const size_t& request_id = request_callback.Get_Request_ID();
+      char topic[Helper::detectSize(ATTRIBUTE_REQUEST_TOPIC, request_id)];
+      snprintf_P(topic, sizeof(topic), ATTRIBUTE_REQUEST_TOPIC, request_id);
 
       const size_t objectSize = Helper::Measure_Json(requestBuffer);
       return Send_Json(topic, requestBuffer, objectSize);
@@ -1377,151 +1770,246 @@ class ThingsBoardSized {
 
 #if THINGSBOARD_ENABLE_OTA
 
+    /// @brief Requests the shared attributes of the given download and starts the download if a new version has been assigned to the device
+    /// @param download Download that should be started
+    /// @param callback Callback method that will be called
+    /// @return Whether requesting the shared attributes was successful or not
+    inline bool Start_Update(OTA_Download& download, const OTA_Update_Callback& callback) {
+      if (!Prepare_Update_Settings(download, callback))  {
+        Logger::log(RESETTING_FAILED);
+        return false;
+      }
+
+      // Request the artifact information
+      const OTA_Artifact& artifact = download.artifact;
+      const char *const shared_keys[OTA_SHARED_KEYS_AMOUNT] = {artifact.checksum_key, artifact.checksum_algorithm_key, artifact.size_key, artifact.title_key, artifact.version_key};
+      const Attribute_Request_Callback request_callback([this, &download](const Shared_Attribute_Data& data) { Update_Shared_Attribute_Received(download, data); }, shared_keys, shared_keys + OTA_SHARED_KEYS_AMOUNT);
+      return Shared_Attributes_Request(request_callback);
+    }
+
+    /// @brief Subscribes to changes of the shared attributes of the given download and starts the download every time a new version is assigned to the device
+    /// @param download Download that should be started
+    /// @param callback Callback method that will be called
+    /// @return Whether subscribing to the shared attributes was successful or not
+    inline bool Subscribe_Update(OTA_Download& download, const OTA_Update_Callback& callback) {
+      if (!Prepare_Update_Settings(download, callback))  {
+        Logger::log(RESETTING_FAILED);
+        return false;
+      }
+
+      // Subscribes to changes of the artifact information
+      const OTA_Artifact& artifact = download.artifact;
+      const char *const shared_keys[OTA_SHARED_KEYS_AMOUNT] = {artifact.checksum_key, artifact.checksum_algorithm_key, artifact.size_key, artifact.title_key, artifact.version_key};
+      const Shared_Attribute_Callback update_callback([this, &download](const Shared_Attribute_Data& data) { Update_Shared_Attribute_Received(download, data); }, shared_keys, shared_keys + OTA_SHARED_KEYS_AMOUNT);
+      return Shared_Attributes_Subscribe(update_callback);
+    }
+
+    /// @brief Sends the given title and version of the given artifact type to the cloud
+    /// @param artifact Artifact type the title and version belong to
+    /// @param current_title Current title of the artifact on the device
+    /// @param current_version Current version of the artifact on the device
+    /// @return Whether sending the current information was successful or not
+    inline bool Send_Update_Info(const OTA_Artifact& artifact, const char *current_title, const char *current_version) {
+      StaticJsonDocument<JSON_OBJECT_SIZE(2)> currentInfo;
+      const JsonObject currentInfoObject = currentInfo.to<JsonObject>();
+
+      currentInfoObject[artifact.current_title_key] = current_title;
+      currentInfoObject[artifact.current_version_key] = current_version;
+      return sendTelemetryJson(currentInfoObject, Helper::Measure_Json(currentInfoObject));
+    }
+
+    /// @brief Sends the given update state of the given artifact type to the cloud
+    /// @param artifact Artifact type the state belongs to
+    /// @param current_state Current download state
+    /// @param error Error message that describes the current state,
+    /// pass nullptr or an empty string if the current state is not a failure state
+    /// @return Whether sending the current download state was successful or not
+    inline bool Send_Update_State(const OTA_Artifact& artifact, const char *current_state, const char *error) {
+      StaticJsonDocument<JSON_OBJECT_SIZE(2)> currentState;
+      const JsonObject currentStateObject = currentState.to<JsonObject>();
+
+      // Make the error optional,
+      // meaning if it is an empty string or null instead we don't send it at all.
+      if (error != nullptr && error[0] != '\0') {
+        currentStateObject[artifact.error_key] = error;
+      }
+      currentStateObject[artifact.state_key] = current_state;
+      return sendTelemetryJson(currentStateObject, Helper::Measure_Json(currentStateObject));
+    }
+
     /// @brief Checks the included information in the callback,
-    /// and attempts to sends the current device firmware information to the cloud
+    /// and attempts to sends the current device information of the given download to the cloud
+    /// @param download Download the callback is used for
     /// @param callback Callback method that will be called
-    /// @return Whether checking and sending the current device firmware information was successful or not
-    inline bool Prepare_Firmware_Settings(const OTA_Update_Callback& callback) {
-      const char *currFwTitle = callback.Get_Firmware_Title();
-      const char *currFwVersion = callback.Get_Firmware_Version();
+    /// @return Whether checking and sending the current device information was successful or not
+    inline bool Prepare_Update_Settings(OTA_Download& download, const OTA_Update_Callback& callback) {
+      const char *current_title = callback.Get_Firmware_Title();
+      const char *current_version = callback.Get_Firmware_Version();
 
-      // Send current firmware version
-      if (currFwTitle == nullptr || currFwVersion == nullptr) {
+      // Send current version
+      if (current_title == nullptr || current_version == nullptr) {
         return false;
       }
-      else if (!Firmware_Send_Info(currFwTitle, currFwVersion)) {
+      else if (!Send_Update_Info(download.artifact, current_title, current_version)) {
         return false;
       }
 
       // Set private members needed for update
-      m_fw_callback = &callback;
+      download.callback = &callback;
       return true;
     }
 
-    /// @brief Subscribes to the firmware response topic
-    /// @return Whether subscribing to the firmware response topic was successful or not
-    inline bool Firmware_OTA_Subscribe() {
-      if (!m_client.subscribe(FIRMWARE_RESPONSE_SUBSCRIBE_TOPIC)) {
+    /// @brief Subscribes to the response topic of the given download
+    /// @param download Download whose chunks should be received
+    /// @return Whether subscribing to the response topic was successful or not
+    inline bool OTA_Subscribe(OTA_Download& download) {
+      if (!m_client.subscribe(download.artifact.response_subscribe_topic)) {
         Logger::log(SUBSCRIBE_TOPIC_FAILED);
-        Firmware_Send_State(FW_STATE_FAILED, SUBSCRIBE_TOPIC_FAILED);
+        Send_Update_State(download.artifact, FW_STATE_FAILED, SUBSCRIBE_TOPIC_FAILED);
         return false;
       }
       return true;
     }
 
-    /// @brief Unsubscribes from the firmware response topic and clears any memory associated with the firmware update,
-    /// should not be called before actually fully completing the firmware update.
-    /// @return Whether unsubscribing from the firmware response topic was successful or not
-    inline bool Firmware_OTA_Unsubscribe() {
-      // Buffer size has been set to another value before the update,
-      // to allow to receive ota chunck packets that might be much bigger than the normal
-      // buffer size would allow, therefore we return to the previous value to decrease overall memory usage
-      if (m_change_buffer_size) {
-          m_client.set_buffer_size(m_previous_buffer_size);
-      }
+    /// @brief Unsubscribes from the response topic of the given download and clears any memory associated with it,
+    /// should not be called before actually fully completing the update.
+    /// @param download Download that has been finished
+    /// @return Whether unsubscribing from the response topic was successful or not
+    inline bool OTA_Unsubscribe(OTA_Download& download) {
       // Reset now not needed private member variables
-      m_fw_callback = nullptr;
+      download.callback = nullptr;
+      Restore_Buffer_Size();
       // Unsubscribe from the topic
-      return m_client.unsubscribe(FIRMWARE_RESPONSE_SUBSCRIBE_TOPIC);
+      return m_client.unsubscribe(download.artifact.response_subscribe_topic);
+    }
+
+    /// @brief Increases the internal buffer of the client, so that it can receive chunks of the given size.
+    /// The buffer is shared by all running downloads, therefore it is only ever increased to the biggest chunk size of all running downloads
+    /// and the size it had before the first download is kept, so it can be restored once no download is running anymore
+    /// @param chunk_size Size of the chunks that should be received
+    /// @return Whether the buffer is big enough to receive the chunks or not
+    inline bool Increase_Buffer_Size(const uint16_t& chunk_size) {
+      const uint16_t required_size = chunk_size + 50U;
+      const uint16_t current_size = m_client.get_buffer_size();
+      if (current_size >= required_size) {
+        return true;
+      }
+      else if (!m_client.set_buffer_size(required_size)) {
+        return false;
+      }
+      // Only the size before the first increase has to be restored, because later increases are all done by downloads
+      if (!m_change_buffer_size) {
+        m_previous_buffer_size = current_size;
+        m_change_buffer_size = true;
+      }
+      return true;
     }
 
-    /// @brief Callback that will be called upon firmware shared attribute arrival
-    /// @param data Json data containing key-value pairs for the needed firmware information,
-    /// to ensure we have a firmware assigned and can start the update over MQTT
-    inline void Firmware_Shared_Attribute_Received(const Shared_Attribute_Data& data) {
-      // Check if firmware is available for our device
-      if (!data.containsKey(FW_VER_KEY) || !data.containsKey(FW_TITLE_KEY)) {
-        Logger::log(NO_FW);
-        Firmware_Send_State(FW_STATE_FAILED, NO_FW);
+    /// @brief Restores the internal buffer of the client to the size it had before it was temporarily increased to receive the chunks,
+    /// to decrease overall memory usage. Does nothing as long as any download is still running, because it still needs the increased buffer
+    inline void Restore_Buffer_Size() {
+      if (!m_change_buffer_size || m_fw_download.handler.Is_Running()) {
         return;
       }
-      else if (m_fw_callback == nullptr) {
+#if THINGSBOARD_ENABLE_SWOTA
+      else if (m_sw_download.handler.Is_Running()) {
+        return;
+      }
+#endif // THINGSBOARD_ENABLE_SWOTA
+      m_client.set_buffer_size(m_previous_buffer_size);
+      m_change_buffer_size = false;
+    }
+
+    /// @brief Callback that will be called upon arrival of the shared attributes of the given download
+    /// @param download Download the shared attributes have been requested for
+    /// @param data Json data containing key-value pairs for the needed artifact information,
+    /// to ensure we have a new version assigned and can start the update over MQTT
+    inline void Update_Shared_Attribute_Received(OTA_Download& download, const Shared_Attribute_Data& data) {
+      const OTA_Artifact& artifact = download.artifact;
+
+      // Check if a new version is available for our device
+      if (!data.containsKey(artifact.version_key) || !data.containsKey(artifact.title_key)) {
+        Logger::log(artifact.no_artifact);
+        Send_Update_State(artifact, FW_STATE_FAILED, artifact.no_artifact);
+        return;
+      }
+      else if (download.callback == nullptr) {
         Logger::log(OTA_CB_IS_NULL);
-        Firmware_Send_State(FW_STATE_FAILED, OTA_CB_IS_NULL);
+        Send_Update_State(artifact, FW_STATE_FAILED, OTA_CB_IS_NULL);
         return;
       }
 
-      const char *fw_title = data[FW_TITLE_KEY].as<const char *>();
-      const char *fw_version = data[FW_VER_KEY].as<const char *>();
-      const std::string fw_checksum = data[FW_CHKS_KEY].as<std::string>();
-      const std::string fw_algorithm = data[FW_CHKS_ALGO_KEY].as<std::string>();
-      const size_t fw_size = data[FW_SIZE_KEY].as<const size_t>();
+      const char *title = data[artifact.title_key].as<const char *>();
+      const char *version = data[artifact.version_key].as<const char *>();
+      const char *checksum = data[artifact.checksum_key].as<const char *>();
+      const char *algorithm = data[artifact.checksum_algorithm_key].as<const char *>();
+      const size_t size = data[artifact.size_key].as<const size_t>();
 
-      const char *curr_fw_title = m_fw_callback->Get_Firmware_Title();
-      const char *curr_fw_version = m_fw_callback->Get_Firmware_Version();
+      const char *curr_title = download.callback->Get_Firmware_Title();
+      const char *curr_version = download.callback->Get_Firmware_Version();
 
-      if (fw_title == nullptr || fw_version == nullptr || curr_fw_title == nullptr || curr_fw_version == nullptr || fw_algorithm.empty() || fw_checksum.empty()) {
-        Logger::log(EMPTY_FW);
-        Firmware_Send_State(FW_STATE_FAILED, EMPTY_FW);
+      if (title == nullptr || version == nullptr || curr_title == nullptr || curr_version == nullptr || algorithm == nullptr || checksum == nullptr || algorithm[0] == '\0' || checksum[0] == '\0') {
+        Logger::log(artifact.empty_artifact);
+        Send_Update_State(artifact, FW_STATE_FAILED, artifact.empty_artifact);
         return;
       }
-      // If firmware version and title is the same, we do not initiate an update, because we expect the binary to be the same one we are currently using
-      else if (strncmp_P(curr_fw_title, fw_title, JSON_STRING_SIZE(strlen(curr_fw_title))) == 0 && strncmp_P(curr_fw_version, fw_version, JSON_STRING_SIZE(strlen(curr_fw_version))) == 0) {
-        Logger::log(FW_UP_TO_DATE);
-        Firmware_Send_State(FW_STATE_UPDATED, FW_UP_TO_DATE);
+      // If version and title is the same, we do not initiate an update, because we expect the binary to be the same one we are currently using
+      else if (strncmp_P(curr_title, title, JSON_STRING_SIZE(strlen(curr_title))) == 0 && strncmp_P(curr_version, version, JSON_STRING_SIZE(strlen(curr_version))) == 0) {
+        Logger::log(artifact.up_to_date);
+        Send_Update_State(artifact, FW_STATE_UPDATED, artifact.up_to_date);
         return;
       }
-      // If firmware title is not the same, we do not initiate an update, because we expect the binary to be for another device type 
-      else if (strncmp_P(curr_fw_title, fw_title, JSON_STRING_SIZE(strlen(curr_fw_title))) != 0) {
-        Logger::log(FW_NOT_FOR_US);
-        ESP_LOGI("extra", "%s (%d)", curr_fw_title, strlen(curr_fw_title)); 
-        ESP_LOGI("extra", "%s (%d)", fw_title, strlen(fw_title)); 
-        Firmware_Send_State(FW_STATE_FAILED, FW_NOT_FOR_US);
+      // If title is not the same, we do not initiate an update, because we expect the binary to be for another device type
+      else if (strncmp_P(curr_title, title, JSON_STRING_SIZE(strlen(curr_title))) != 0) {
+        Logger::log(artifact.not_for_us);
+        Send_Update_State(artifact, FW_STATE_FAILED, artifact.not_for_us);
         return;
       }
 
-      mbedtls_md_type_t fw_checksum_algorithm = mbedtls_md_type_t();
+      mbedtls_md_type_t checksum_algorithm = mbedtls_md_type_t();
 
-      // Change the used firmware algorithm, depending on which type is set for the given firmware information
-      if (fw_algorithm.compare(CHECKSUM_AGORITM_MD5) == 0) {
-        fw_checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_MD5;
+      // Change the used algorithm, depending on which type is set for the given artifact information
+      if (strncmp_P(algorithm, CHECKSUM_AGORITM_MD5, sizeof(CHECKSUM_AGORITM_MD5)) == 0) {
+        checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_MD5;
       }
-      else if (fw_algorithm.compare(CHECKSUM_AGORITM_SHA256) == 0) {
-        fw_checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_SHA256;
+      else if (strncmp_P(algorithm, CHECKSUM_AGORITM_SHA256, sizeof(CHECKSUM_AGORITM_SHA256)) == 0) {
+        checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_SHA256;
       }
-      else if (fw_algorithm.compare(CHECKSUM_AGORITM_SHA384) == 0) {
-        fw_checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_SHA384;
+      else if (strncmp_P(algorithm, CHECKSUM_AGORITM_SHA384, sizeof(CHECKSUM_AGORITM_SHA384)) == 0) {
+        checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_SHA384;
       }
-      else if (fw_algorithm.compare(CHECKSUM_AGORITM_SHA512) == 0) {
-        fw_checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_SHA512;
+      else if (strncmp_P(algorithm, CHECKSUM_AGORITM_SHA512, sizeof(CHECKSUM_AGORITM_SHA512)) == 0) {
+        checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_SHA512;
       }
       else {
-        char message[JSON_STRING_SIZE(strlen(FW_CHKS_ALGO_NOT_SUPPORTED)) + JSON_STRING_SIZE(fw_algorithm.size())];
-        snprintf_P(message, sizeof(message), FW_CHKS_ALGO_NOT_SUPPORTED, fw_algorithm.c_str());
+        char message[JSON_STRING_SIZE(strlen(FW_CHKS_ALGO_NOT_SUPPORTED)) + JSON_STRING_SIZE(strlen(algorithm))];
+        snprintf_P(message, sizeof(message), FW_CHKS_ALGO_NOT_SUPPORTED, algorithm);
         Logger::log(message);
-        Firmware_Send_State(FW_STATE_FAILED, message);
+        Send_Update_State(artifact, FW_STATE_FAILED, message);
         return;
       }
 
-      if (!Firmware_OTA_Subscribe()) {
+      if (!OTA_Subscribe(download)) {
         return;
       }
 
 #if THINGSBOARD_ENABLE_DEBUG
       Logger::log(PAGE_BREAK);
-      Logger::log(NEW_FW);
-      char firmware[JSON_STRING_SIZE(strlen(FROM_TOO)) + JSON_STRING_SIZE(strlen(curr_fw_version)) + JSON_STRING_SIZE(strlen(fw_version))];
-      snprintf_P(firmware, sizeof(firmware), FROM_TOO, curr_fw_version, fw_version);
-      Logger::log(firmware);
+      Logger::log(artifact.new_artifact);
+      char new_version[JSON_STRING_SIZE(strlen(FROM_TOO)) + JSON_STRING_SIZE(strlen(curr_version)) + JSON_STRING_SIZE(strlen(version))];
+      snprintf_P(new_version, sizeof(new_version), FROM_TOO, curr_version, version);
+      Logger::log(new_version);
       Logger::log(DOWNLOADING_FW);
 #endif // THINGSBOARD_ENABLE_DEBUG
 
-      // Calculate the number of chuncks we need to request,
-      // in order to download the complete firmware binary
-      const uint16_t& chunk_size = m_fw_callback->Get_Chunk_Size();
-
-      // Get the previous buffer size and cache it so the previous settings can be restored.
-      m_previous_buffer_size = m_client.get_buffer_size();
-      m_change_buffer_size = m_previous_buffer_size < (chunk_size + 50U);
-
-      // Increase size of receive buffer
-      if (m_change_buffer_size && !m_client.set_buffer_size(chunk_size + 50U)) {
+      // Increase size of receive buffer, so the chunks of the binary fit into it
+      if (!Increase_Buffer_Size(download.callback->Get_Chunk_Size())) {
         Logger::log(NOT_ENOUGH_RAM);
-        Firmware_Send_State(FW_STATE_FAILED, NOT_ENOUGH_RAM);
+        Send_Update_State(artifact, FW_STATE_FAILED, NOT_ENOUGH_RAM);
         return;
       }
 
-      m_ota.Start_Firmware_Update(m_fw_callback, fw_size, fw_algorithm, fw_checksum, fw_checksum_algorithm);
+      download.handler.Start_Update(download.callback, size, algorithm, checksum, checksum_algorithm);
     }
 
 #endif // THINGSBOARD_ENABLE_OTA
@@ -1558,39 +2046,21 @@ class ThingsBoardSized {
       }
     }
 
-#if !THINGSBOARD_ENABLE_DYNAMIC
-    /// @brief Reserves size for the given amount of items in our internal callback vectors beforehand for performance reasons,
-    /// this ensures the internal memory blocks do not have to move if new data is inserted,
-    /// because the current memory block is too small to hold the data for all the values
-    /// @param reservedSize Size we want to reserve and should not use more if we do,
-    /// the internal memory blocks might need to be moved to a new location
-    inline void reserve_callback_size(const size_t& reservedSize) {
-      m_rpc_callbacks.reserve(reservedSize);
-      m_rpc_request_callbacks.reserve(reservedSize);
-      m_shared_attribute_update_callbacks.reserve(reservedSize);
-      m_attribute_request_callbacks.reserve(reservedSize);
-    }
-#endif // !THINGSBOARD_ENABLE_DYNAMIC
-
     /// @brief Subscribes to the client-side RPC response topic
-    /// @param callback Callback method that will be called
-    /// @param registeredCallback Editable pointer to a reference of the local version that was copied from the passed callback
+    /// @param callback Local version that was copied from the passed callback, is assigned the request id once it has been registered
     /// @return Whether requesting the given callback was successful or not
-    inline bool RPC_Request_Subscribe(const RPC_Request_Callback& callback, RPC_Request_Callback*& registeredCallback = nullptr) {
-#if !THINGSBOARD_ENABLE_DYNAMIC
-      if (m_rpc_request_callbacks.size() + 1 > m_rpc_request_callbacks.capacity()) {
-        Logger::log(MAX_RPC_REQUEST_EXCEEDED);
+    inline bool RPC_Request_Subscribe(RPC_Request_Callback& callback) {
+      // Subscribing before the capacity is checked does not subscribe needlessly, because the topic is still subscribed if any request is pending
+      if (!m_client.subscribe(RPC_RESPONSE_SUBSCRIBE_TOPIC)) {
+        Logger::log(SUBSCRIBE_TOPIC_FAILED);
         return false;
       }
+      else if (!Register_Request(m_rpc_request_callbacks, callback)) {
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        Logger::log(MAX_RPC_REQUEST_EXCEEDED);
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
-      if (!m_client.subscribe(RPC_RESPONSE_SUBSCRIBE_TOPIC)) {
-        Logger::log(SUBSCRIBE_TOPIC_FAILED);
         return false;
       }
-
-      // Push back given callback into our local vector
-      m_rpc_request_callbacks.push_back(callback);
-      registeredCallback = &m_rpc_request_callbacks.back();
       return true;
     }
 
@@ -1599,29 +2069,28 @@ class ThingsBoardSized {
     /// and from the client-side RPC response topic, was successful or not
     inline bool RPC_Request_Unsubscribe() {
       // Empty all callbacks
-      m_rpc_request_callbacks.clear();
+      {
+        const Critical_Section_Lock lock(m_request_section);
+        m_rpc_request_callbacks.clear();
+      }
       return m_client.unsubscribe(RPC_RESPONSE_SUBSCRIBE_TOPIC);
     }
 
     /// @brief Subscribes to attribute response topic
-    /// @param callback Callback method that will be called
-    /// @param registeredCallback Editable pointer to a reference of the local version that was copied from the passed callback
+    /// @param callback Local version that was copied from the passed callback, is assigned the request id once it has been registered
     /// @return Whether requesting the given callback was successful or not
-    inline bool Attributes_Request_Subscribe(const Attribute_Request_Callback& callback, Attribute_Request_Callback*& registeredCallback = nullptr) {
-#if !THINGSBOARD_ENABLE_DYNAMIC
-      if (m_attribute_request_callbacks.size() + 1 > m_attribute_request_callbacks.capacity()) {
-        Logger::log(MAX_SHARED_ATT_REQUEST_EXCEEDED);
+    inline bool Attributes_Request_Subscribe(Attribute_Request_Callback& callback) {
+      // Subscribing before the capacity is checked does not subscribe needlessly, because the topic is still subscribed if any request is pending
+      if (!m_client.subscribe(ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC)) {
+        Logger::log(SUBSCRIBE_TOPIC_FAILED);
         return false;
       }
+      else if (!Register_Request(m_attribute_request_callbacks, callback)) {
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        Logger::log(MAX_SHARED_ATT_REQUEST_EXCEEDED);
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
-      if (!m_client.subscribe(ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC)) {
-        Logger::log(SUBSCRIBE_TOPIC_FAILED);
         return false;
       }
-
-      // Push back given callback into our local vector
-      m_attribute_request_callbacks.push_back(callback);
-      registeredCallback = &m_attribute_request_callbacks.back();
       return true;
     }
 
@@ -1630,10 +2099,188 @@ class ThingsBoardSized {
     /// and from the  attribute response topic, was successful or not
     inline bool Attributes_Request_Unsubscribe() {
       // Empty all callbacks
-      m_attribute_request_callbacks.clear();
+      {
+        const Critical_Section_Lock lock(m_request_section);
+        m_attribute_request_callbacks.clear();
+      }
       return m_client.unsubscribe(ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC);
     }
 
+    /// @brief Assigns the next request id to the given request and adds it to the given pending requests.
+    /// Additionally sets its deadline and reschedules the request watchdog, if it has a timeout
+    /// @tparam Container Type of the container holding the requests
+    /// @tparam Request_Callback Type of the request, either RPC_Request_Callback or Attribute_Request_Callback
+    /// @param requests Pending requests
+    /// @param request Local version of the request that was copied from the passed callback
+    /// @return Whether the request was added, false if the maximum amount of pending requests has been reached
+    template<typename Container, typename Request_Callback>
+    inline bool Register_Request(Container& requests, Request_Callback& request) {
+      // The request is completely set up before it is added, because a response or timeout handled by another task might remove it again right away
+      const Critical_Section_Lock lock(m_request_section);
+#if !THINGSBOARD_ENABLE_DYNAMIC
+      if (requests.size() + 1 > requests.capacity()) {
+        return false;
+      }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+      m_request_id++;
+      request.Set_Request_ID(m_request_id);
+#if THINGSBOARD_ENABLE_STL
+      const uint64_t& timeout = request.Get_Timeout();
+      if (timeout != 0U) {
+        request.Set_Deadline(Helper::getMicroseconds() + timeout);
+      }
+#endif // THINGSBOARD_ENABLE_STL
+      // Push back given callback into our local vector
+      requests.push_back(request);
+#if THINGSBOARD_ENABLE_STL
+      if (timeout != 0U) {
+        Schedule_Request_Timeout();
+      }
+#endif // THINGSBOARD_ENABLE_STL
+      return true;
+    }
+
+    /// @brief Removes the pending request with the given id and copies it into the given request, so its callback can be called once the critical section has been left
+    /// @tparam Container Type of the container holding the requests
+    /// @tparam Request_Callback Type of the request, either RPC_Request_Callback or Attribute_Request_Callback
+    /// @param requests Pending requests
+    /// @param request_id Id of the request a response has been received for
+    /// @param request Copy of the removed request
+    /// @return Whether a request with the given id was pending
+    template<typename Container, typename Request_Callback>
+    inline bool Take_Request(Container& requests, const size_t& request_id, Request_Callback& request) {
+      const Critical_Section_Lock lock(m_request_section);
+      for (size_t i = 0; i < requests.size(); i++) {
+        if (requests.at(i).Get_Request_ID() != request_id) {
+          continue;
+        }
+        request = requests.at(i);
+        // Delete callback because the changes have been requested and the callback is no longer needed,
+        // the order of the pending requests does not matter, because they are matched by their id
+        Helper::remove_unordered(requests, i);
+        return true;
+      }
+      return false;
+    }
+
+    /// @brief Unsubscribes from the given response topic, if we are not waiting for any further responses to the given requests.
+    /// Will be resubscribed if another request is sent anyway
+    /// @tparam Container Type of the container holding the requests
+    /// @param requests Pending requests
+    /// @param topic Topic the responses to the given requests are received on
+    template<typename Container>
+    inline void Unsubscribe_Without_Requests(const Container& requests, const char *topic) {
+      if (!Has_Requests(requests)) {
+        (void)m_client.unsubscribe(topic);
+        // Another task might have registered a request while we unsubscribed, its response would then never be received
+        if (Has_Requests(requests)) {
+          (void)m_client.subscribe(topic);
+        }
+      }
+    }
+
+    /// @brief Whether any of the given requests is still pending
+    /// @tparam Container Type of the container holding the requests
+    /// @param requests Pending requests
+    /// @return Whether the given requests are not empty
+    template<typename Container>
+    inline bool Has_Requests(const Container& requests) {
+      const Critical_Section_Lock lock(m_request_section);
+      return !requests.empty();
+    }
+
+#if THINGSBOARD_ENABLE_STL
+
+    /// @brief Schedules the request watchdog to the earliest deadline of all pending client-side RPC and attribute requests,
+    /// a single watchdog is enough, because it is simply scheduled to the next deadline again once it expired.
+    /// Has to be called while the request section is held, to ensure another task does not reschedule it to an outdated deadline in the meantime
+    inline void Schedule_Request_Timeout() {
+      uint64_t deadline = 0U;
+      Get_Earliest_Deadline(m_rpc_request_callbacks, deadline);
+      Get_Earliest_Deadline(m_attribute_request_callbacks, deadline);
+      if (deadline == 0U) {
+        m_request_watchdog.detach();
+        return;
+      }
+      const uint64_t now = Helper::getMicroseconds();
+      m_request_watchdog.once(deadline > now ? deadline - now : 0U);
+    }
+
+    /// @brief Gets the earliest deadline of the given pending requests
+    /// @tparam Container Type of the container holding the requests
+    /// @param requests Pending requests
+    /// @param deadline Earliest deadline found so far, is overwritten if one of the given requests has an earlier deadline, 0 if none has been found yet
+    template<typename Container>
+    static inline void Get_Earliest_Deadline(const Container& requests, uint64_t& deadline) {
+      for (size_t i = 0; i < requests.size(); i++) {
+        const uint64_t& request_deadline = requests.at(i).Get_Deadline();
+        if (request_deadline != 0U && (deadline == 0U || request_deadline < deadline)) {
+          deadline = request_deadline;
+        }
+      }
+    }
+
+    /// @brief Callback that will be called by the request watchdog, once the earliest deadline of the pending requests has passed.
+    /// Removes every request whose deadline has passed, calls their timeout callback and schedules the watchdog to the next deadline
+    inline void Handle_Request_Timeout() {
+      const uint64_t now = Helper::getMicroseconds();
+      // Unsubscribe the response topics the same way receiving the last response does, if we are not waiting for any further responses
+      if (Expire_Requests<RPC_Request_Callback>(m_rpc_request_callbacks, now)) {
+        Unsubscribe_Without_Requests(m_rpc_request_callbacks, RPC_RESPONSE_SUBSCRIBE_TOPIC);
+      }
+      if (Expire_Requests<Attribute_Request_Callback>(m_attribute_request_callbacks, now)) {
+        Unsubscribe_Without_Requests(m_attribute_request_callbacks, ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC);
+      }
+      const Critical_Section_Lock lock(m_request_section);
+      Schedule_Request_Timeout();
+    }
+
+    /// @brief Removes every given request whose deadline has passed and calls their timeout callback
+    /// @tparam Request_Callback Type of the request, either RPC_Request_Callback or Attribute_Request_Callback
+    /// @tparam Container Type of the container holding the requests
+    /// @param requests Pending requests
+    /// @param now Current timestamp in microseconds
+    /// @return Whether any request has been removed
+    template<typename Request_Callback, typename Container>
+    inline bool Expire_Requests(Container& requests, const uint64_t& now) {
+      bool expired = false;
+      while (true) {
+        // The request is removed and copied before the timeout callback is called, because the callback might send another request
+        // and because the critical section may not be held while calling it
+        Request_Callback request;
+        bool found = false;
+        {
+          const Critical_Section_Lock lock(m_request_section);
+          for (size_t i = 0U; i < requests.size(); i++) {
+            const uint64_t& deadline = requests.at(i).Get_Deadline();
+            if (deadline == 0U || deadline > now) {
+              continue;
+            }
+            request = requests.at(i);
+            Helper::remove_unordered(requests, i);
+            found = true;
+            break;
+          }
+        }
+        if (!found) {
+          return expired;
+        }
+        expired = true;
+
+        const size_t& request_id = request.Get_Request_ID();
+        char message[Helper::detectSize(REQUEST_TIMED_OUT, static_cast<unsigned int>(request_id))];
+        snprintf_P(message, sizeof(message), REQUEST_TIMED_OUT, static_cast<unsigned int>(request_id));
+        Logger::log(message);
+
+        const Inplace_Function<void(void)>& timeout_callback = request.Get_Timeout_Callback();
+        if (timeout_callback) {
+          timeout_callback();
+        }
+      }
+    }
+
+#endif // THINGSBOARD_ENABLE_STL
+
     /// @brief Attempts to send a single key-value pair with the given key and value of the given type
     /// @tparam T Type of the passed value
     /// @param key Key of the key value pair we want to send
@@ -1648,6 +2295,12 @@ class ThingsBoardSized {
         return false;
       }
 
+      ITelemetry_Filter *filter = telemetry ? m_telemetry_filter : m_attribute_filter;
+      const uint64_t now = filter != nullptr ? Helper::getMicroseconds() : 0U;
+      if (filter != nullptr && !filter->Should_Send(t, now)) {
+        return true;
+      }
+
       StaticJsonDocument<JSON_OBJECT_SIZE(1)>jsonBuffer;
 
       const JsonVariant object = jsonBuffer.to<JsonVariant>();
@@ -1655,7 +2308,11 @@ class ThingsBoardSized {
         Logger::log(UNABLE_TO_SERIALIZE);
         return false;
       }
-      return telemetry ? sendTelemetryJson(object, Helper::Measure_Json(object)) : sendAttributeJSON(object, Helper::Measure_Json(object));
+      const bool result = telemetry ? sendTelemetryJson(object, Helper::Measure_Json(object)) : sendAttributeJSON(object, Helper::Measure_Json(object));
+      if (result && filter != nullptr) {
+        filter->Mark_Sent(t, now);
+      }
+      return result;
     }
 
     /// @brief Process callback that will be called upon client-side RPC response arrival
@@ -1667,24 +2324,13 @@ class ThingsBoardSized {
       // therefore we remove the section before that which is the topic + an additional "/" character, that seperates the topic from the response id.
       // Meaning the index we want to get the substring from is the length of the topic + 1 for the additonal "/" character
       const size_t index = strlen(RPC_RESPONSE_TOPIC) + 1U;
-#if THINGSBOARD_ENABLE_STL
-      std::string response = topic;
-      response = response.substr(index, response.length() - index);
-#else
-      String response = topic;
-      response = response.substring(index);
-#endif // THINGSBOARD_ENABLE_STL
-
-      // Convert the remaining text after the topic to an integer, because it should now contain only the response id
-      const size_t response_id = atoi(response.c_str());
-
-      for (size_t i = 0; i < m_rpc_request_callbacks.size(); i++) {
-        const RPC_Request_Callback& rpc_request = m_rpc_request_callbacks.at(i);
-
-        if (rpc_request.Get_Request_ID() != response_id) {
-          continue;
-        }
+      // Convert the remaining text after the topic to an integer, because it should only contain the response id.
+      // Parsing directly from the topic instead of copying the remaining text into a string first, removes the need for any allocation
+      const size_t response_id = atoi(topic + index);
 
+      // The request is removed before its callback is called, because the timeout of the request might be handled by another task in the meantime
+      RPC_Request_Callback rpc_request;
+      if (Take_Request(m_rpc_request_callbacks, response_id, rpc_request)) {
 #if THINGSBOARD_ENABLE_DEBUG
         char message[Helper::detectSize(CALLING_REQUEST_CB, response_id)];
         snprintf_P(message, sizeof(message), CALLING_REQUEST_CB, response_id);
@@ -1694,18 +2340,11 @@ class ThingsBoardSized {
         // Getting non-existing field from JSON should automatically
         // set JSONVariant to null
         rpc_request.Call_Callback<Logger>(data);
-
-        // Delete callback because the changes have been requested and the callback is no longer needed
-        Helper::remove(m_rpc_request_callbacks, i);
-        break;
       }
 
-      // Attempt to unsubscribe from the shared attribute request topic,
-      // if we are not waiting for any further responses with shared attributes from the server.
-      // Will be resubscribed if another request is sent anyway
-      if (m_rpc_request_callbacks.empty()) {
-        RPC_Request_Unsubscribe();
-      }
+      // Attempt to unsubscribe from the client-side RPC response topic,
+      // if we are not waiting for any further responses from the server
+      Unsubscribe_Without_Requests(m_rpc_request_callbacks, RPC_RESPONSE_SUBSCRIBE_TOPIC);
     }
 
     /// @brief Process callback that will be called upon server-side RPC request arrival
@@ -1748,7 +2387,13 @@ class ThingsBoardSized {
 #endif // THINGSBOARD_ENABLE_DEBUG
 
         const JsonVariantConst param = data[RPC_PARAMS_KEY].as<JsonVariantConst>();
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+        const uint64_t start = Helper::getMicroseconds();
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
         response = rpc.Call_Callback<Logger>(param);
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+        m_performance_counters.Get_RPC_Latency().Record(Helper::getMicroseconds() - start);
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
         break;
       }
 
@@ -1761,62 +2406,81 @@ class ThingsBoardSized {
       // therefore we remove the section before that which is the topic + an additional "/" character, that seperates the topic from the request id.
       // Meaning the index we want to get the substring from is the length of the topic + 1 for the additonal "/" character
       const size_t index = strlen(RPC_REQUEST_TOPIC) + 1U;
-#if THINGSBOARD_ENABLE_STL
-      std::string request = topic;
-      request = request.substr(index, request.length() - index);
-#else
-      String request = topic;
-      request = request.substring(index);
-#endif // THINGSBOARD_ENABLE_STL
-
-      // Convert the remaining text after the topic to an integer, because it should now contain only the request id
-      const size_t request_id = atoi(request.c_str());
+      // Convert the remaining text after the topic to an integer, because it should only contain the request id.
+      // Parsing directly from the topic instead of copying the remaining text into a string first, removes the need for any allocation
+      const size_t request_id = atoi(topic + index);
 
       char responseTopic[Helper::detectSize(RPC_SEND_RESPONSE_TOPIC, request_id)];
       snprintf_P(responseTopic, sizeof(responseTopic), RPC_SEND_RESPONSE_TOPIC, request_id);
 
       const size_t jsonSize = Helper::Measure_Json(response);
-      Send_Json(responseTopic, response, jsonSize);
+      Send_Json(responseTopic, response, jsonSize, Payload_Type::RPC_RESPONSE);
     }
 
 #if THINGSBOARD_ENABLE_OTA
 
-    /// @brief Process callback that will be called upon firmware response arrival
-    /// and is responsible for handling the payload and calling the appropriate previously subscribed callback
+    /// @brief Gets the download whose chunks are received over the given topic
+    /// @param topic Topic we got the response over
+    /// @return Download the chunk was requested for or nullptr if the topic is not the response topic of any download
+    inline OTA_Download* Get_OTA_Download(const char *topic) {
+      if (strncmp_P(FIRMWARE_RESPONSE_TOPIC, topic, strlen(FIRMWARE_RESPONSE_TOPIC)) == 0) {
+        return &m_fw_download;
+      }
+#if THINGSBOARD_ENABLE_SWOTA
+      else if (strncmp_P(SOFTWARE_RESPONSE_TOPIC, topic, strlen(SOFTWARE_RESPONSE_TOPIC)) == 0) {
+        return &m_sw_download;
+      }
+#endif // THINGSBOARD_ENABLE_SWOTA
+      return nullptr;
+    }
+
+    /// @brief Process callback that will be called upon chunk response arrival
+    /// and is responsible for handling the payload and passing it to the engine of the given download
+    /// @param download Download the received chunk was requested for
     /// @param topic Previously subscribed topic, we got the response over
     /// @param payload Payload that was sent over the cloud and received over the given topic
     /// @param length Total length of the received payload
-    inline void process_firmware_response(char *topic, uint8_t *payload, const size_t& length) {
+    inline void process_ota_response(OTA_Download& download, char *topic, uint8_t *payload, const size_t& length) {
       // Remove the not needed part of the received topic string, which is everything before the request id,
       // therefore we remove the section before that which is the topic + an additional "/" character, that seperates the topic from the request id.
       // Meaning the index we want to get the substring from is the length of the topic + 1 for the additonal "/" character
-      const size_t index = strlen(FIRMWARE_RESPONSE_TOPIC) + 1U;
-#if THINGSBOARD_ENABLE_STL
-      std::string request = topic;
-      request = request.substr(index, request.length() - index);
-#else
-      String request = topic;
-      request = request.substring(index);
-#endif // THINGSBOARD_ENABLE_STL
+      const size_t index = strlen(download.artifact.response_topic) + 1U;
+      // Convert the remaining text after the topic to an integer, because it should only contain the request id.
+      // Parsing directly from the topic instead of copying the remaining text into a string first, removes the need for any allocation
+      const size_t request_id = atoi(topic + index);
 
-      // Convert the remaining text after the topic to an integer, because it should now contain only the request id
-      const size_t request_id = atoi(request.c_str());
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+      // Only the first response to the last request is measured, duplicated responses or responses without an outstanding request would otherwise be measured from the wrong request
+      if (download.chunk_request_time != 0U) {
+        m_performance_counters.Get_OTA_Chunk_Round_Trip().Record(Helper::getMicroseconds() - download.chunk_request_time);
+        download.chunk_request_time = 0U;
+      }
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
 
       // Check if the remaining stack size of the current task would overflow the stack,
       // if it would allocate the memory on the heap instead to ensure no stack overflow occurs.
       if (getMaximumStackSize() < length) {
-        uint8_t* binary = new uint8_t[length];
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+        m_performance_counters.Record_Heap_Allocation(Allocation_Path::OTA, length);
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+        uint8_t* binary = static_cast<uint8_t*>(m_allocator.allocate(length));
+        if (binary == nullptr) {
+          char message[Helper::detectSize(UNABLE_TO_ALLOCATE_BUFFER, static_cast<unsigned int>(length))];
+          snprintf_P(message, sizeof(message), UNABLE_TO_ALLOCATE_BUFFER, static_cast<unsigned int>(length));
+          Logger::log(message);
+          return;
+        }
         memcpy(binary, payload, length);
-        m_ota.Process_Firmware_Packet(request_id, binary, length);
-        // Ensure to actually delete the memory placed onto the heap, to make sure we do not create a memory leak
+        download.handler.Process_Packet(request_id, binary, length);
+        // Ensure to actually free the memory placed onto the heap, to make sure we do not create a memory leak
         // and set the pointer to null so we do not have a dangling reference.
-        delete[] binary;
+        m_allocator.deallocate(binary);
         binary = nullptr;
       }
       else {
         uint8_t binary[length];
         memcpy(binary, payload, length);
-        m_ota.Process_Firmware_Packet(request_id, binary, length);
+        download.handler.Process_Packet(request_id, binary, length);
       }
     }
 
@@ -1924,65 +2588,45 @@ class ThingsBoardSized {
       // therefore we remove the section before that which is the topic + an additional "/" character, that seperates the topic from the response id.
       // Meaning the index we want to get the substring from is the length of the topic + 1 for the additonal "/" character
       const size_t index = strlen(ATTRIBUTE_RESPONSE_TOPIC) + 1U;
-#if THINGSBOARD_ENABLE_STL
-      std::string response = topic;
-      response = response.substr(index, response.length() - index);
-#else
-      String response = topic;
-      response = response.substring(index);
-#endif // THINGSBOARD_ENABLE_STL
-
-      // Convert the remaining text after the topic to an integer, because it should now contain only the response id
-      const size_t response_id = atoi(response.c_str());
+      // Convert the remaining text after the topic to an integer, because it should only contain the response id.
+      // Parsing directly from the topic instead of copying the remaining text into a string first, removes the need for any allocation
+      const size_t response_id = atoi(topic + index);
 
-#if THINGSBOARD_ENABLE_DEBUG
-      char message[Helper::detectSize(CALLING_REQUEST_CB, response_id)];
-#endif // THINGSBOARD_ENABLE_DEBUG
-      for (size_t i = 0; i < m_attribute_request_callbacks.size(); i++) {
-        const Attribute_Request_Callback& attribute_request = m_attribute_request_callbacks.at(i);
-
-        if (attribute_request.Get_Request_ID() != response_id) {
-          continue;
-        }
+      // The request is removed before its callback is called, because the timeout of the request might be handled by another task in the meantime
+      Attribute_Request_Callback attribute_request;
+      if (Take_Request(m_attribute_request_callbacks, response_id, attribute_request)) {
         const char *attributeResponseKey = attribute_request.Get_Attribute_Key();
         if (attributeResponseKey == nullptr) {
 #if THINGSBOARD_ENABLE_DEBUG
           Logger::log(ATT_KEY_NOT_FOUND);
 #endif // THINGSBOARD_ENABLE_DEBUG
-          goto delete_callback;
         }
         else if (!data) {
 #if THINGSBOARD_ENABLE_DEBUG
           Logger::log(ATT_KEY_NOT_FOUND);
 #endif // THINGSBOARD_ENABLE_DEBUG
-          goto delete_callback;
-        }
-
-        if (data.containsKey(attributeResponseKey)) {
-          data = data[attributeResponseKey];
         }
+        else {
+          if (data.containsKey(attributeResponseKey)) {
+            data = data[attributeResponseKey];
+          }
 
 #if THINGSBOARD_ENABLE_DEBUG
-        snprintf_P(message, sizeof(message), CALLING_REQUEST_CB, response_id);
-        Logger::log(message);
+          char message[Helper::detectSize(CALLING_REQUEST_CB, response_id)];
+          snprintf_P(message, sizeof(message), CALLING_REQUEST_CB, response_id);
+          Logger::log(message);
 #endif // THINGSBOARD_ENABLE_DEBUG
 
-        // Getting non-existing field from JSON should automatically
-        // set JSONVariant to null
-        attribute_request.Call_Callback<Logger>(data);
-
-        delete_callback:
-        // Delete callback because the changes have been requested and the callback is no longer needed
-        Helper::remove(m_attribute_request_callbacks, i);
-        break;
+          // Getting non-existing field from JSON should automatically
+          // set JSONVariant to null
+          attribute_request.Call_Callback<Logger>(data);
+        }
       }
 
       // Unsubscribe from the shared attribute request topic,
       // if we are not waiting for any further responses with shared attributes from the server.
       // Will be resubscribed if another request is sent anyway
-      if (m_attribute_request_callbacks.empty()) {
-        Attributes_Request_Unsubscribe();
-      }
+      Unsubscribe_Without_Requests(m_attribute_request_callbacks, ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC);
     }
 
     /// @brief Process callback that will be called upon provision response arrival
@@ -2007,242 +2651,108 @@ class ThingsBoardSized {
       // Data structure size depends on the amount of key value pairs passed.
       // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
       const size_t dataStructureMemoryUsage = JSON_OBJECT_SIZE(data_count);
-      TBJsonDocument jsonBuffer(dataStructureMemoryUsage);
+      Json_Document jsonBuffer(dataStructureMemoryUsage, m_allocator);
 #else
       StaticJsonDocument<JSON_OBJECT_SIZE(MaxFieldsAmt)> jsonBuffer;
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
 
       const JsonVariant object = jsonBuffer.template to<JsonVariant>();
 
-      for (size_t i = 0; i < data_count; i++) {
-        if (!data[i].SerializeKeyValue(object)) {
-          Logger::log(UNABLE_TO_SERIALIZE);
+      ITelemetry_Filter *filter = telemetry ? m_telemetry_filter : m_attribute_filter;
+      const uint64_t now = filter != nullptr ? Helper::getMicroseconds() : 0U;
+      size_t serialized_count = 0U;
+
+      // Indices of the serialized key-value pairs, so that exactly those are marked as sent once sending succeeded. Asking the filter again instead would give a different answer
+      // for a key that is contained multiple times, because marking its first key-value pair as sent already changes the state of the filter
+#if THINGSBOARD_ENABLE_DYNAMIC
+      size_t *serialized_indices = nullptr;
+      if (filter != nullptr && data_count != 0U) {
+        serialized_indices = static_cast<size_t*>(m_allocator.allocate(data_count * sizeof(size_t)));
+        if (serialized_indices == nullptr) {
+          char message[Helper::detectSize(UNABLE_TO_ALLOCATE_BUFFER, static_cast<unsigned int>(data_count * sizeof(size_t)))];
+          snprintf_P(message, sizeof(message), UNABLE_TO_ALLOCATE_BUFFER, static_cast<unsigned int>(data_count * sizeof(size_t)));
+          Logger::log(message);
           return false;
         }
       }
+#else
+      size_t serialized_indices[MaxFieldsAmt];
+#endif // THINGSBOARD_ENABLE_DYNAMIC
 
-      return telemetry ? sendTelemetryJson(object, Helper::Measure_Json(object)) : sendAttributeJSON(object, Helper::Measure_Json(object));
-    }
-
-#if THINGSBOARD_ENABLE_SWOTA
-
-    /// @brief Publishes a request via MQTT to request the given software chunk
-    /// @param request_chunck Chunk index that should be requested from the server
-    /// @return Whether publishing the message was successful or not
-    inline bool SwPublish_Chunk_Request(const size_t& request_chunck) {
-      // Calculate the number of chuncks we need to request,
-      // in order to download the complete software binary
-      const uint16_t& chunk_size = m_sw_callback->Get_Chunk_Size();
-
-      // Convert the interger size into a readable string
-      char size[Helper::detectSize(NUMBER_PRINTF, chunk_size)];
-      snprintf_P(size, sizeof(size), NUMBER_PRINTF, chunk_size);
-      const size_t jsonSize = strlen(size);
-
-      // Size adjuts dynamically to the current length of the currChunk number to ensure we don't cut it out of the topic string.
-      char topic[Helper::detectSize(SOFTWARE_REQUEST_TOPIC, request_chunck)];
-      snprintf_P(topic, sizeof(topic), SOFTWARE_REQUEST_TOPIC, request_chunck);
-
-      return m_client.publish(topic, reinterpret_cast<uint8_t*>(size), jsonSize);
-    }
-
-    /// @brief Checks the included information in the callback,
-    /// and attempts to sends the current device software information to the cloud
-    /// @param callback Callback method that will be called
-    /// @return Whether checking and sending the current device software information was successful or not
-    inline bool Prepare_Software_Settings(const SWOTA_Update_Callback& callback) {
-      const char *currSwTitle = callback.Get_Software_Title();
-      const char *currSwVersion = callback.Get_Software_Version();
-
-      // Send current software version
-      if (currSwTitle == nullptr || currSwVersion == nullptr) {
-        return false;
-      }
-      else if (!Software_Send_Info(currSwTitle, currSwVersion)) {
-        return false;
-      }
-
-      // Set private members needed for update
-      m_sw_callback = &callback;
-      return true;
-    }
-
-    /// @brief Subscribes to the software response topic
-    /// @return Whether subscribing to the software response topic was successful or not
-    inline bool Software_OTA_Subscribe() {
-      if (!m_client.subscribe(SOFTWARE_RESPONSE_SUBSCRIBE_TOPIC)) {
-        Logger::log(SUBSCRIBE_TOPIC_FAILED);
-        Software_Send_State(SW_STATE_FAILED, SUBSCRIBE_TOPIC_FAILED);
-        return false;
-      }
-      return true;
-    }
-
-    /// @brief Unsubscribes from the software response topic and clears any memory associated with the software update,
-    /// should not be called before actually fully completing the software update.
-    /// @return Whether unsubscribing from the software response topic was successful or not
-    inline bool Software_OTA_Unsubscribe() {
-      // Buffer size has been set to another value before the update,
-      // to allow to receive ota chunck packets that might be much bigger than the normal
-      // buffer size would allow, therefore we return to the previous value to decrease overall memory usage
-      if (m_change_buffer_size) {
-          m_client.set_buffer_size(m_previous_buffer_size);
-      }
-      // Reset now not needed private member variables
-      m_sw_callback = nullptr;
-      // Unsubscribe from the topic
-      return m_client.unsubscribe(SOFTWARE_RESPONSE_SUBSCRIBE_TOPIC);
-    }
-
-    /// @brief Callback that will be called upon software shared attribute arrival
-    /// @param data Json data containing key-value pairs for the needed software information,
-    /// to ensure we have a software assigned and can start the update over MQTT
-    inline void Software_Shared_Attribute_Received(const Shared_Attribute_Data& data) {
-      // Check if software is available for our device
-      if (!data.containsKey(SW_VER_KEY) || !data.containsKey(SW_TITLE_KEY)) {
-        Logger::log(NO_SW);
-        Software_Send_State(SW_STATE_FAILED, NO_SW);
-        return;
-      }
-      else if (m_sw_callback == nullptr) {
-        Logger::log(OTA_CB_IS_NULL);
-        Software_Send_State(SW_STATE_FAILED, OTA_CB_IS_NULL);
-        return;
-      }
-
-      const char *sw_title = data[SW_TITLE_KEY].as<const char *>();
-      const char *sw_version = data[SW_VER_KEY].as<const char *>();
-      const std::string sw_checksum = data[SW_CHKS_KEY].as<std::string>();
-      const std::string sw_algorithm = data[SW_CHKS_ALGO_KEY].as<std::string>();
-      const size_t sw_size = data[SW_SIZE_KEY].as<const size_t>();
-
-      const char *curr_sw_title = m_sw_callback->Get_Software_Title();
-      const char *curr_sw_version = m_sw_callback->Get_Software_Version();
-
-      if (sw_title == nullptr || sw_version == nullptr || curr_sw_title == nullptr || curr_sw_version == nullptr || sw_algorithm.empty() || sw_checksum.empty()) {
-        Logger::log(EMPTY_SW);
-        Software_Send_State(SW_STATE_FAILED, EMPTY_SW);
-        return;
-      }
-      // If software version and title is the same, we do not initiate an update, because we expect the binary to be the same one we are currently using
-      else if (strncmp_P(curr_sw_title, sw_title, JSON_STRING_SIZE(strlen(curr_sw_title))) == 0 && strncmp_P(curr_sw_version, sw_version, JSON_STRING_SIZE(strlen(curr_sw_version))) == 0) {
-        Logger::log(SW_UP_TO_DATE);
-        Software_Send_State(SW_STATE_UPDATED, SW_UP_TO_DATE);
-        return;
-      }
-      // If software title is not the same, we do not initiate an update, because we expect the binary to be for another device type 
-      else if (strncmp_P(curr_sw_title, sw_title, JSON_STRING_SIZE(strlen(curr_sw_title))) != 0) {
-        Logger::log(SW_NOT_FOR_US);
-        ESP_LOGI("extra", "%s (%d)", curr_sw_title, strlen(curr_sw_title)); 
-        ESP_LOGI("extra", "%s (%d)", sw_title, strlen(sw_title)); 
-        Software_Send_State(SW_STATE_FAILED, SW_NOT_FOR_US);
-        return;
-      }
-
-      mbedtls_md_type_t sw_checksum_algorithm = mbedtls_md_type_t();
-
-      // Change the used software algorithm, depending on which type is set for the given software information
-      if (sw_algorithm.compare(CHECKSUM_AGORITM_MD5) == 0) {
-        sw_checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_MD5;
-      }
-      else if (sw_algorithm.compare(CHECKSUM_AGORITM_SHA256) == 0) {
-        sw_checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_SHA256;
-      }
-      else if (sw_algorithm.compare(CHECKSUM_AGORITM_SHA384) == 0) {
-        sw_checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_SHA384;
-      }
-      else if (sw_algorithm.compare(CHECKSUM_AGORITM_SHA512) == 0) {
-        sw_checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_SHA512;
-      }
-      else {
-        char message[JSON_STRING_SIZE(strlen(SW_CHKS_ALGO_NOT_SUPPORTED)) + JSON_STRING_SIZE(sw_algorithm.size())];
-        snprintf_P(message, sizeof(message), SW_CHKS_ALGO_NOT_SUPPORTED, sw_algorithm.c_str());
-        Logger::log(message);
-        Software_Send_State(SW_STATE_FAILED, message);
-        return;
-      }
-
-      if (!Software_OTA_Subscribe()) {
-        return;
+      bool result = true;
+      for (size_t i = 0; i < data_count; i++) {
+        if (filter != nullptr && !filter->Should_Send(data[i], now)) {
+          continue;
+        }
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        // The document can not hold more key-value pairs than that either
+        if (serialized_count >= MaxFieldsAmt) {
+          Logger::log(UNABLE_TO_SERIALIZE);
+          result = false;
+          break;
+        }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+        if (!data[i].SerializeKeyValue(object)) {
+          Logger::log(UNABLE_TO_SERIALIZE);
+          result = false;
+          break;
+        }
+        if (filter != nullptr) {
+          serialized_indices[serialized_count] = i;
+        }
+        serialized_count++;
       }
 
-#if THINGSBOARD_ENABLE_DEBUG
-      Logger::log(PAGE_BREAK);
-      Logger::log(NEW_SW);
-      char software[JSON_STRING_SIZE(strlen(FROM_TOO)) + JSON_STRING_SIZE(strlen(curr_sw_version)) + JSON_STRING_SIZE(strlen(sw_version))];
-      snprintf_P(software, sizeof(software), FROM_TOO, curr_sw_version, sw_version);
-      Logger::log(software);
-      Logger::log(DOWNLOADING_SW);
-#endif // THINGSBOARD_ENABLE_DEBUG
-
-      // Calculate the number of chuncks we need to request,
-      // in order to download the complete software binary
-      const uint16_t& chunk_size = m_sw_callback->Get_Chunk_Size();
-
-      // Get the previous buffer size and cache it so the previous settings can be restored.
-      m_previous_buffer_size = m_client.get_buffer_size();
-      m_change_buffer_size = m_previous_buffer_size < (chunk_size + 50U);
-
-      // Increase size of receive buffer
-      if (m_change_buffer_size && !m_client.set_buffer_size(chunk_size + 50U)) {
-        Logger::log(NOT_ENOUGH_RAM);
-        Software_Send_State(SW_STATE_FAILED, NOT_ENOUGH_RAM);
-        return;
+      // Every key-value pair has been suppressed by the filter, therefore there is nothing left that would need to be sent
+      if (result && (data_count == 0U || serialized_count != 0U)) {
+        result = telemetry ? sendTelemetryJson(object, Helper::Measure_Json(object)) : sendAttributeJSON(object, Helper::Measure_Json(object));
+        if (result && filter != nullptr) {
+          for (size_t i = 0; i < serialized_count; i++) {
+            filter->Mark_Sent(data[serialized_indices[i]], now);
+          }
+        }
       }
 
-      m_swOta.Start_Software_Update(m_sw_callback, sw_size, sw_algorithm, sw_checksum, sw_checksum_algorithm);
+#if THINGSBOARD_ENABLE_DYNAMIC
+      // Ensure to actually free the memory placed onto the heap, to make sure we do not create a memory leak
+      m_allocator.deallocate(serialized_indices);
+      serialized_indices = nullptr;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+      return result;
     }
 
-    /// @brief Process callback that will be called upon software response arrival
-    /// and is responsible for handling the payload and calling the appropriate previously subscribed callback
-    /// @param topic Previously subscribed topic, we got the response over
-    /// @param payload Payload that was sent over the cloud and received over the given topic
-    /// @param length Total length of the received payload
-    inline void process_software_response(char *topic, uint8_t *payload, const size_t& length) {
-      // Remove the not needed part of the received topic string, which is everything before the request id,
-      // therefore we remove the section before that which is the topic + an additional "/" character, that seperates the topic from the request id.
-      // Meaning the index we want to get the substring from is the length of the topic + 1 for the additonal "/" character
-      const size_t index = strlen(SOFTWARE_RESPONSE_TOPIC) + 1U;
+#if THINGSBOARD_ENABLE_DYNAMIC
+    /// @brief Vector signature, allocates its elements with the given allocator policy
 #if THINGSBOARD_ENABLE_STL
-      std::string request = topic;
-      request = request.substr(index, request.length() - index);
+    template<typename T>
+    using Vector = std::vector<T, Allocator_Adapter<T, Allocator>>;
 #else
-      String request = topic;
-      request = request.substring(index);
+    template<typename T>
+    using Vector = ::Vector<T, Allocator>;
 #endif // THINGSBOARD_ENABLE_STL
+#else
+    /// @brief Vector signature, stores up to MaxFieldsAmt elements inline, so subscribing callbacks never allocates memory on the heap
+    template<typename T>
+    using Vector = StaticVector<T, MaxFieldsAmt>;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
 
-      // Convert the remaining text after the topic to an integer, because it should now contain only the request id
-      const size_t request_id = atoi(request.c_str());
-
-      // Check if the remaining stack size of the current task would overflow the stack,
-      // if it would allocate the memory on the heap instead to ensure no stack overflow occurs.
-      if (getMaximumStackSize() < length) {
-        uint8_t* binary = new uint8_t[length];
-        memcpy(binary, payload, length);
-        m_swOta.Process_Software_Packet(request_id, binary, length);
-        // Ensure to actually delete the memory placed onto the heap, to make sure we do not create a memory leak
-        // and set the pointer to null so we do not have a dangling reference.
-        delete[] binary;
-        binary = nullptr;
-      }
-      else {
-        uint8_t binary[length];
-        memcpy(binary, payload, length);
-        m_swOta.Process_Software_Packet(request_id, binary, length);
-      }
-    }
-
-#endif // THINGSBOARD_ENABLE_SWOTA
-
-    /// @brief Vector signature
 #if THINGSBOARD_ENABLE_STL
-    template<typename T>
-    using Vector = std::vector<T>;
+    /// @brief String signature, allocates its characters with the given allocator policy
+    using String_Type = std::basic_string<char, std::char_traits<char>, Allocator_Adapter<char, Allocator>>;
 #endif // THINGSBOARD_ENABLE_STL
 
+#if THINGSBOARD_ENABLE_DYNAMIC
+    /// @brief JsonDocument signature, allocates its memory pool with the given allocator policy
+    using Json_Document = BasicJsonDocument<Allocator>;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
     IMQTT_Client& m_client; // MQTT client instance.
     size_t m_max_stack; // Maximum stack size we allocate at once.
     size_t m_buffering_size; // Buffering size used to serialize directly into client.
+    Allocator m_allocator; // Allocator policy every internal heap allocation is done with
+    PayloadFormat m_payload_format; // Payload format policy telemetry, attributes, server-side RPC and the default downlink topics are encoded with
+    ITelemetry_Filter *m_telemetry_filter; // Filter deciding which telemetry key-value pairs are sent, nullptr sends every key-value pair
+    ITelemetry_Filter *m_attribute_filter; // Filter deciding which attribute key-value pairs are sent, nullptr sends every key-value pair
 
     // Vectors hold copy of the actual passed data, this is to ensure they stay valid,
     // even if the user only temporarily created the object before the method was called.
@@ -2259,21 +2769,30 @@ class ThingsBoardSized {
 
     Provision_Callback m_provision_callback; // Provision response callback
     size_t m_request_id; // Allows nearly 4.3 million requests before wrapping back to 0
+    Critical_Section m_request_section; // Guards the pending client-side RPC and attribute requests and the request id, because responses might be received by the task of the MQTT client
+#if THINGSBOARD_ENABLE_STL || THINGSBOARD_ENABLE_OTA
+    Timer_Wheel m_timer_wheel; // Drives every timeout of this instance from loop(), has to be declared before any watchdog scheduled on it, to ensure it is destroyed after them
+#endif // THINGSBOARD_ENABLE_STL || THINGSBOARD_ENABLE_OTA
+#if THINGSBOARD_ENABLE_STL
+    Callback_Watchdog m_request_watchdog; // Expires at the earliest deadline of the pending client-side RPC and attribute requests
+#endif // THINGSBOARD_ENABLE_STL
 
 #if THINGSBOARD_ENABLE_OTA
-    const OTA_Update_Callback *m_fw_callback; // Ota update response callback
-    uint16_t m_previous_buffer_size; // Previous buffer size of the underlying client, used to revert to the previously configured buffer size if it was temporarily increased by the OTA update
-    bool m_change_buffer_size; // Whether the buffer size had to be changed, because the previous internal buffer size was to small to hold the firmware chunks
-    OTA_Handler<Logger> m_ota; // Class instance that handles the flashing and creating a hash from the given received binary firmware data
+    uint16_t m_previous_buffer_size; // Previous buffer size of the underlying client, used to revert to the previously configured buffer size once no download needs the temporarily increased buffer anymore
+    bool m_change_buffer_size; // Whether the buffer size had to be changed, because the previous internal buffer size was to small to hold the chunks of a running download
+    OTA_Download m_fw_download; // Download of the firmware, handles the flashing and creating a hash from the given received binary firmware data
 #endif // THINGSBOARD_ENABLE_OTA
 
 #if THINGSBOARD_ENABLE_SWOTA
-    const SWOTA_Update_Callback *m_sw_callback; // Ota update response callback
-    //uint16_t m_previous_buffer_size; // Previous buffer size of the underlying client, used to revert to the previously configured buffer size if it was temporarily increased by the OTA update
-    //bool m_change_buffer_size; // Whether the buffer size had to be changed, because the previous internal buffer size was to small to hold the software chunks
-    SWOTA_Handler<Logger> m_swOta; // Class instance that handles the flashing and creating a hash from the given received binary software data
+    OTA_Download m_sw_download; // Download of the software, handles the writing and creating a hash from the given received binary software data
 #endif // THINGSBOARD_ENABLE_SWOTA
 
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+    Performance_Counters m_performance_counters; // Counters about the sent and received messages, failures, latencies and heap usage
+    uint64_t m_performance_counters_interval; // Interval in microseconds the performance counters are sent in, 0 if they should not be sent automatically
+    uint64_t m_performance_counters_last_sent; // Timestamp in microseconds the performance counters were last sent at
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+
     /// @brief MQTT callback that will be called if a publish message is received from the server
     /// @param topic Previously subscribed topic, we got the response over 
     /// @param payload Payload that was sent over the cloud and received over the given topic
@@ -2285,42 +2804,84 @@ class ThingsBoardSized {
       Logger::log(message);
 #endif // THINGSBOARD_ENABLE_DEBUG
 
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+      m_performance_counters.Record_Received(Get_Topic_Class(topic, true), length);
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+
 #if THINGSBOARD_ENABLE_OTA
       // When receiving the ota binary payload we do not want to deserialize it into json, because it only contains
-      // firmware bytes that should be directly writtin into flash, therefore we can skip that step and directly process those bytes
-      if (strncmp_P(FIRMWARE_RESPONSE_TOPIC, topic, strlen(FIRMWARE_RESPONSE_TOPIC)) == 0) {
-        process_firmware_response(topic, payload, length);
+      // firmware or software bytes that should be directly written, therefore we can skip that step and directly process those bytes
+      OTA_Download *download = Get_OTA_Download(topic);
+      if (download != nullptr) {
+        process_ota_response(*download, topic, payload, length);
         return;
       }
 #endif // THINGSBOARD_ENABLE_OTA
 
-#if THINGSBOARD_ENABLE_SWOTA
-      // When receiving the ota binary payload we do not want to deserialize it into json, because it only contains
-      // software bytes that should be directly writtin into flash, therefore we can skip that step and directly process those bytes
-      if (strncmp_P(SOFTWARE_RESPONSE_TOPIC, topic, strlen(SOFTWARE_RESPONSE_TOPIC)) == 0) {
-        process_software_response(topic, payload, length);
+      // Every message received over the default downlink topics is encoded with the same format, decided by the device profile,
+      // which is either json or the format of the payload format policy. Every other received message, like the provisioning response, is always encoded as json
+      const Payload_Type type = Get_Downlink_Type(topic);
+      if (type != Payload_Type::OTHER && !m_payload_format.Use_Json_Downlink()) {
+        Deserialize_And_Process(topic, payload, length, m_payload_format, type);
         return;
       }
-#endif // THINGSBOARD_ENABLE_SWOTA
+      const Json_Payload_Format json_format;
+      Deserialize_And_Process(topic, payload, length, json_format, type);
+    }
+
+    /// @brief Gets the kind of message received over the given topic, if it is one of the default downlink topics
+    /// @param topic Previously subscribed topic, we got the response over
+    /// @return Kind of message received over the given topic, Payload_Type::OTHER if the topic is not one of the default downlink topics
+    inline Payload_Type Get_Downlink_Type(const char *topic) const {
+      // Same ordering as in Deserialize_And_Process has to be kept, because more specific topics contain the text of the less specific ones
+      if (strncmp_P(RPC_RESPONSE_TOPIC, topic, strlen(RPC_RESPONSE_TOPIC)) == 0) {
+        return Payload_Type::CLIENT_RPC_RESPONSE;
+      }
+      else if (strncmp_P(RPC_REQUEST_TOPIC, topic, strlen(RPC_REQUEST_TOPIC)) == 0) {
+        return Payload_Type::RPC_REQUEST;
+      }
+      else if (strncmp_P(ATTRIBUTE_RESPONSE_TOPIC, topic, strlen(ATTRIBUTE_RESPONSE_TOPIC)) == 0) {
+        return Payload_Type::ATTRIBUTE_RESPONSE;
+      }
+      else if (strncmp_P(ATTRIBUTE_TOPIC, topic, strlen(ATTRIBUTE_TOPIC)) == 0) {
+        return Payload_Type::ATTRIBUTE_UPDATE;
+      }
+      return Payload_Type::OTHER;
+    }
 
+    /// @brief Decodes the received payload with the given payload format policy and forwards it to the process method of the topic it was received over
+    /// @tparam Format Payload format policy the payload is decoded with
+    /// @param topic Previously subscribed topic, we got the response over
+    /// @param payload Payload that was sent over the cloud and received over the given topic
+    /// @param length Total length of the received payload
+    /// @param format Payload format policy the payload is decoded with
+    /// @param type Kind of message the payload has been received as
+    template <typename Format>
+    inline void Deserialize_And_Process(char *topic, uint8_t *payload, const size_t& length, const Format& format, const Payload_Type& type) {
 #if THINGSBOARD_ENABLE_DYNAMIC
       // Buffer that we deserialize is writeable and not read only --> zero copy, meaning the size for the data is 0 bytes,
       // Data structure size depends on the amount of key value pairs received.
       // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
-      const size_t dataStructureMemoryUsage = JSON_OBJECT_SIZE(Helper::getOccurences(reinterpret_cast<char*>(payload), COLON));
+      const size_t dataStructureMemoryUsage = format.Get_Document_Size(type, payload, length);
       ESP_LOGI("Thingsb", "size %d", dataStructureMemoryUsage);
       ESP_LOGI("Thingsb", "free heap: %d",(int)esp_get_free_heap_size());
       //ESP_LOGI("Thingsb", "Payload %s", payload);
-      TBJsonDocument jsonBuffer(dataStructureMemoryUsage);
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+      m_performance_counters.Record_Heap_Allocation(Allocation_Path::RECEIVE, dataStructureMemoryUsage);
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+      Json_Document jsonBuffer(dataStructureMemoryUsage, m_allocator);
 #else
       StaticJsonDocument<JSON_OBJECT_SIZE(MaxFieldsAmt)> jsonBuffer;
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
 
-      // The deserializeJson method we use, can use the zero copy mode because a writeable input was passed,
+      // The deserialize method we use, can use the zero copy mode because a writeable input was passed,
       // if that were not the case the needed allocated memory would drastically increase, because the keys would need to be copied as well.
       // See https://arduinojson.org/v6/doc/deserialization/ for more info on ArduinoJson deserialization
-      const DeserializationError error = deserializeJson(jsonBuffer, payload, length);
+      const DeserializationError error = format.Deserialize(type, jsonBuffer, payload, length);
       if (error) {
+#if THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
+        m_performance_counters.Record_Deserialization_Failure();
+#endif // THINGSBOARD_ENABLE_PERFORMANCE_COUNTERS
         char message[Helper::detectSize(UNABLE_TO_DE_SERIALIZE_JSON, error.c_str())];
         snprintf_P(message, sizeof(message), UNABLE_TO_DE_SERIALIZE_JSON, error.c_str());
         Logger::log(message);
@@ -2356,34 +2917,23 @@ class ThingsBoardSized {
 
 #if !THINGSBOARD_ENABLE_STL
 
-    // PubSub client cannot call a method when message arrives on subscribed topic.
-    // Only free-standing function is allowed.
-    // To be able to forward event to an instance, rather than to a function, this pointer exists.
-    static ThingsBoardSized *m_subscribedInstance;
-
-    static void onStaticMQTTMessage(char *topic, uint8_t *payload, unsigned int length) {
-      if (m_subscribedInstance == nullptr) {
+    /// @brief Without the C++ STL the MQTT client can only call a free-standing function when a message arrives on a subscribed topic.
+    /// To be able to forward the event to the instance that subscribed, rather than to a function, the instance is passed as the context
+    /// @param context Instance that subscribed the callback, passed back by the MQTT client
+    /// @param topic Topic the message was received over
+    /// @param payload Payload of the received message
+    /// @param length Length of the payload in bytes
+    static void onStaticMQTTMessage(void *context, char *topic, uint8_t *payload, unsigned int length) {
+      if (context == nullptr) {
         return;
       }
-      m_subscribedInstance->onMQTTMessage(topic, payload, length);
+      static_cast<ThingsBoardSized *>(context)->onMQTTMessage(topic, payload, length);
     }
 
 #endif // !THINGSBOARD_ENABLE_STL
 
 };
 
-#if !THINGSBOARD_ENABLE_STL && !THINGSBOARD_ENABLE_DYNAMIC
-
-template<size_t MaxFieldsAmt, typename Logger>
-ThingsBoardSized<MaxFieldsAmt, Logger> *ThingsBoardSized<MaxFieldsAmt, Logger>::m_subscribedInstance = nullptr;
-
-#elif !THINGSBOARD_ENABLE_STL && THINGSBOARD_ENABLE_DYNAMIC
-
-template<typename Logger>
-ThingsBoardSized<Logger> *ThingsBoardSized<Logger>::m_subscribedInstance = nullptr;
-
-#endif
-
 using ThingsBoard = ThingsBoardSized<>;
 
 #endif // ThingsBoard_h
@@ -13,6 +13,16 @@
 #include "Telemetry.h"
 #include "Helper.h"
 #include "IHTTP_Client.h"
+#include "Allocator.h"
+#include "HTTP_Response_Reader.h"
+#include "OTA_Handler.h"
+
+// Library includes.
+#include <string.h>
+#if THINGSBOARD_ENABLE_OTA
+#include <ctype.h>
+#include <string>
+#endif // THINGSBOARD_ENABLE_OTA
 
 /// ---------------------------------
 /// Constant strings in flash memory.
@@ -21,12 +31,18 @@
 #if THINGSBOARD_ENABLE_PROGMEM
 constexpr char HTTP_TELEMETRY_TOPIC[] PROGMEM = "/api/v1/%s/telemetry";
 constexpr char HTTP_ATTRIBUTES_TOPIC[] PROGMEM = "/api/v1/%s/attributes";
+constexpr char HTTP_API_PREFIX[] PROGMEM = "/api/v1/";
+constexpr char HTTP_TELEMETRY_SUFFIX[] PROGMEM = "/telemetry";
+constexpr char HTTP_ATTRIBUTES_SUFFIX[] PROGMEM = "/attributes";
 constexpr char HTTP_POST_PATH[] PROGMEM = "application/json";
 constexpr int HTTP_RESPONSE_SUCCESS_RANGE_START PROGMEM = 200;
 constexpr int HTTP_RESPONSE_SUCCESS_RANGE_END PROGMEM = 299;
 #else
 constexpr char HTTP_TELEMETRY_TOPIC[] = "/api/v1/%s/telemetry";
 constexpr char HTTP_ATTRIBUTES_TOPIC[] = "/api/v1/%s/attributes";
+constexpr char HTTP_API_PREFIX[] = "/api/v1/";
+constexpr char HTTP_TELEMETRY_SUFFIX[] = "/telemetry";
+constexpr char HTTP_ATTRIBUTES_SUFFIX[] = "/attributes";
 constexpr char HTTP_POST_PATH[] = "application/json";
 constexpr int HTTP_RESPONSE_SUCCESS_RANGE_START = 200;
 constexpr int HTTP_RESPONSE_SUCCESS_RANGE_END = 299;
@@ -39,21 +55,59 @@ constexpr char GET[] PROGMEM = "GET";
 constexpr char SLASH[] PROGMEM = "/";
 constexpr char CONTENT_TYPE[] PROGMEM = "Content-Type";
 constexpr char HTTP_FAILED[] PROGMEM = "(%s) failed HTTP response (%d)";
+constexpr char BATCH_SAMPLE_TOO_BIG[] PROGMEM = "Telemetry sample (%u) bytes does not fit into the batch buffer (%u) bytes, increase the batch buffer size accordingly";
+constexpr char TS_KEY[] PROGMEM = "ts";
+constexpr char VALUES_KEY[] PROGMEM = "values";
 #else
 constexpr char POST[] = "POST";
 constexpr char GET[] = "GET";
 constexpr char SLASH[] = "/";
 constexpr char CONTENT_TYPE[] = "Content-Type";
 constexpr char HTTP_FAILED[] = "(%s) failed HTTP response (%d)";
+constexpr char BATCH_SAMPLE_TOO_BIG[] = "Telemetry sample (%u) bytes does not fit into the batch buffer (%u) bytes, increase the batch buffer size accordingly";
+constexpr char TS_KEY[] = "ts";
+constexpr char VALUES_KEY[] = "values";
+#endif // THINGSBOARD_ENABLE_PROGMEM
+
+#if THINGSBOARD_ENABLE_OTA
+
+// Firmware paths.
+#if THINGSBOARD_ENABLE_PROGMEM
+constexpr char HTTP_FIRMWARE_ATTRIBUTES_PARAMETER[] PROGMEM = "?sharedKeys=fw_checksum,fw_checksum_algorithm,fw_size,fw_title,fw_version";
+constexpr char HTTP_FIRMWARE_SUFFIX[] PROGMEM = "/firmware?title=";
+constexpr char HTTP_FIRMWARE_VERSION_PARAMETER[] PROGMEM = "&version=";
+constexpr char HTTP_FIRMWARE_SIZE_PARAMETER[] PROGMEM = "&size=";
+constexpr char HTTP_FIRMWARE_CHUNK_PARAMETER[] PROGMEM = "&chunk=";
+#else
+constexpr char HTTP_FIRMWARE_ATTRIBUTES_PARAMETER[] = "?sharedKeys=fw_checksum,fw_checksum_algorithm,fw_size,fw_title,fw_version";
+constexpr char HTTP_FIRMWARE_SUFFIX[] = "/firmware?title=";
+constexpr char HTTP_FIRMWARE_VERSION_PARAMETER[] = "&version=";
+constexpr char HTTP_FIRMWARE_SIZE_PARAMETER[] = "&size=";
+constexpr char HTTP_FIRMWARE_CHUNK_PARAMETER[] = "&chunk=";
 #endif // THINGSBOARD_ENABLE_PROGMEM
 
+// Log messages.
+#if THINGSBOARD_ENABLE_PROGMEM
+constexpr char FW_CHUNK_DOWNLOAD_FAILED[] PROGMEM = "Downloading firmware chunk (%u) failed, retrying once the chunk timeout has passed";
+#else
+constexpr char FW_CHUNK_DOWNLOAD_FAILED[] = "Downloading firmware chunk (%u) failed, retrying once the chunk timeout has passed";
+#endif // THINGSBOARD_ENABLE_PROGMEM
+
+// Keys and values of the firmware shared attributes response are copied into the JsonDocument, because they are read from the client instead of a mutable buffer.
+// Enough to hold the key names, a SHA512 checksum and the title and version with up to 64 characters each
+constexpr size_t FIRMWARE_ATTRIBUTES_STRING_SIZE = 384U;
+
+#endif // THINGSBOARD_ENABLE_OTA
+
 #if THINGSBOARD_ENABLE_DYNAMIC
 /// @brief Wrapper around the ArduinoHttpClient or HTTPClient to allow connecting and sending / retrieving data from ThingsBoard over the HTTP orHTTPS protocol.
 /// BufferSize of the underlying data buffer as well as the maximum amount of data points that can ever be sent are either dynamic or can be changed during runtime.
 /// If this feature is not needed and the values can be sent once as template arguements it is recommended to use the static ThingsBoard instance instead.
 /// Simply set THINGSBOARD_ENABLE_DYNAMIC to 0, before including ThingsBoardHttp.h
 /// @tparam Logger Logging class that should be used to print messages generated by internal processes, default = ThingsBoardDefaultLogger
-template<typename Logger = ThingsBoardDefaultLogger>
+/// @tparam Allocator Allocator policy every internal heap allocation is done with, allows to pin the library to a fixed memory budget or to psram. See Allocator.h for the available policies, default = Default_Allocator
+template<typename Logger = ThingsBoardDefaultLogger,
+         typename Allocator = Default_Allocator>
 #else
 /// @brief Wrapper around the ArduinoHttpClient or HTTPClient to allow connecting and sending / retrieving data from ThingsBoard over the HTTP orHTTPS protocol.
 /// BufferSize of the underlying data buffer as well as the maximum amount of data points that can ever be sent have to defined as template arguments.
@@ -61,8 +115,10 @@ template<typename Logger = ThingsBoardDefaultLogger>
 /// Simply set THINGSBOARD_ENABLE_DYNAMIC to 1, before including ThingsBoardHttp.h.
 /// @tparam MaxFieldsAmt Maximum amount of key value pair that we will be able to sent to ThingsBoard in one call, default = 8
 /// @tparam Logger Logging class that should be used to print messages generated by internal processes, default = ThingsBoardDefaultLogger
+/// @tparam Allocator Allocator policy every internal heap allocation is done with, allows to pin the library to a fixed memory budget or to psram. See Allocator.h for the available policies, default = Default_Allocator
 template<size_t MaxFieldsAmt = Default_Fields_Amt,
-         typename Logger = ThingsBoardDefaultLogger>
+         typename Logger = ThingsBoardDefaultLogger,
+         typename Allocator = Default_Allocator>
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 class ThingsBoardHttpSized {
   public:
@@ -72,16 +128,97 @@ class ThingsBoardHttpSized {
     /// @param access_token Token used to verify the devices identity with the ThingsBoard server
     /// @param host Host server we want to establish a connection to (example: "demo.thingsboard.io")
     /// @param port Port we want to establish a connection over (80 for HTTP, 443 for HTTPS)
-    /// @param keepAlive Attempts to keep the establishes TCP connection alive to make sending data faster
+    /// @param keepAlive Attempts to keep the establishes TCP connection alive and reuses it for all following requests to make sending data faster,
+    /// if the connection has been closed in the meantime it is re-established automatically. If disabled the connection is closed after every request instead
     /// @param maxStackSize Maximum amount of bytes we want to allocate on the stack, default = Default_Max_Stack_Size
     inline ThingsBoardHttpSized(IHTTP_Client& client, const char *access_token,
                                 const char *host, const uint16_t& port = 80U, const bool& keepAlive = true, const size_t& maxStackSize = Default_Max_Stack_Size)
       : m_client(client)
       , m_max_stack(maxStackSize)
-      , m_token(access_token)
+      , m_token(nullptr)
+      , m_telemetry_path(nullptr)
+      , m_attributes_path(nullptr)
+      , m_host(host)
+      , m_port(port)
+      , m_keep_alive(keepAlive)
+      , m_connections_opened(0U)
+      , m_requests_sent(0U)
+      , m_batch(nullptr)
+      , m_batch_size(0U)
+      , m_batch_length(0U)
+      , m_batch_samples(0U)
+      , m_batch_max_samples(0U)
+      , m_batch_max_age(0U)
+      , m_batch_started(0U)
+#if THINGSBOARD_ENABLE_OTA
+      , m_timer_wheel()
+      , m_fw_callback(nullptr)
+      , m_fw_path(nullptr)
+      , m_fw_path_length(0U)
+      , m_fw_chunk(nullptr)
+      , m_fw_requested_chunk(0U)
+      , m_fw_chunk_pending(false)
+      , m_ota(m_timer_wheel, [this](const size_t& request_chunk) { return Request_Chunk(request_chunk); }, [this](const char *current_fw_state, const char *fw_error) { return Firmware_Send_State(current_fw_state, fw_error); }, [this]() { return Firmware_OTA_Finish(); })
+#endif // THINGSBOARD_ENABLE_OTA
+      , m_allocator()
     {
+      (void)setAccessToken(access_token);
       m_client.set_keep_alive(keepAlive);
-      m_client.connect(host, port);
+      (void)connectToHost();
+    }
+
+    /// @brief Destructor, frees the precomputed paths and the telemetry batch buffer without sending the samples it still contains
+    inline ~ThingsBoardHttpSized() {
+#if THINGSBOARD_ENABLE_OTA
+      m_allocator.deallocate(m_fw_chunk);
+      m_fw_chunk = nullptr;
+      m_allocator.deallocate(m_fw_path);
+      m_fw_path = nullptr;
+#endif // THINGSBOARD_ENABLE_OTA
+      m_allocator.deallocate(m_batch);
+      m_batch = nullptr;
+      m_allocator.deallocate(m_telemetry_path);
+      m_telemetry_path = nullptr;
+      m_attributes_path = nullptr;
+    }
+
+    /// @brief Copy constructor, deleted because the copy would free the same precomputed paths and telemetry batch buffer again in its destructor
+    ThingsBoardHttpSized(const ThingsBoardHttpSized&) = delete;
+
+    /// @brief Copy assignment operator, deleted because the copy would free the same precomputed paths and telemetry batch buffer again in its destructor
+    ThingsBoardHttpSized& operator=(const ThingsBoardHttpSized&) = delete;
+
+    /// @brief Changes the access token used to verify the devices identity with the ThingsBoard server.
+    /// The telemetry and attributes paths containing the token are built once here instead of being formatted again for every sent request
+    /// @param access_token Token used to verify the devices identity with the ThingsBoard server, is not copied and therefore has to be kept alive by the user
+    /// @return Whether allocating the memory for the precomputed paths was successful or not
+    inline bool setAccessToken(const char *access_token) {
+      m_token = access_token;
+      // Both paths are placed into a single allocation, therefore only the telemetry path has to be freed
+      m_allocator.deallocate(m_telemetry_path);
+      m_telemetry_path = nullptr;
+      m_attributes_path = nullptr;
+      if (m_token == nullptr) {
+        return false;
+      }
+
+      constexpr size_t prefix_length = sizeof(HTTP_API_PREFIX) - 1U;
+      constexpr size_t telemetry_suffix_size = sizeof(HTTP_TELEMETRY_SUFFIX);
+      constexpr size_t attributes_suffix_size = sizeof(HTTP_ATTRIBUTES_SUFFIX);
+      const size_t token_length = strlen(m_token);
+      const size_t telemetry_size = prefix_length + token_length + telemetry_suffix_size;
+      const size_t attributes_size = prefix_length + token_length + attributes_suffix_size;
+      m_telemetry_path = static_cast<char*>(m_allocator.allocate(telemetry_size + attributes_size));
+      if (m_telemetry_path == nullptr) {
+        char message[Helper::detectSize(UNABLE_TO_ALLOCATE_BUFFER, telemetry_size + attributes_size)];
+        snprintf_P(message, sizeof(message), UNABLE_TO_ALLOCATE_BUFFER, telemetry_size + attributes_size);
+        Logger::log(message);
+        return false;
+      }
+      m_attributes_path = m_telemetry_path + telemetry_size;
+      Build_Path(m_telemetry_path, token_length, HTTP_TELEMETRY_SUFFIX, telemetry_suffix_size);
+      Build_Path(m_attributes_path, token_length, HTTP_ATTRIBUTES_SUFFIX, attributes_suffix_size);
+      return true;
     }
 
     /// @brief Sets the maximum amount of bytes that we want to allocate on the stack, before the memory is allocated on the heap instead
@@ -90,6 +227,25 @@ class ThingsBoardHttpSized {
       m_max_stack = maxStackSize;
     }
 
+    /// @brief Gets the amount of TCP connections that have been opened to the host, compared with getRequestsSent() it shows how well the connection is reused.
+    /// Ideally only a single connection is opened if keep alive is enabled, every additional connection means the host closed the idle connection in the meantime
+    /// @return Amount of connections that have been opened since the construction or the last call to resetConnectionStatistics()
+    inline const uint32_t& getConnectionsOpened() const {
+      return m_connections_opened;
+    }
+
+    /// @brief Gets the amount of POST and GET requests that have been sent to the host, including requests that were resent on a newly opened connection
+    /// @return Amount of requests that have been sent since the construction or the last call to resetConnectionStatistics()
+    inline const uint32_t& getRequestsSent() const {
+      return m_requests_sent;
+    }
+
+    /// @brief Resets the amount of opened connections and sent requests back to 0
+    inline void resetConnectionStatistics() {
+      m_connections_opened = 0U;
+      m_requests_sent = 0U;
+    }
+
     /// @brief Attempts to send key value pairs from custom source over the given topic to the server
     /// @tparam TSource Source class that should be used to serialize the json that is sent to the server
     /// @param topic Topic we want to send the data over
@@ -116,16 +272,22 @@ class ThingsBoardHttpSized {
       bool result = false;
 
       if (getMaximumStackSize() < jsonSize) {
-        char* json = new char[jsonSize];
+        char* json = static_cast<char*>(m_allocator.allocate(jsonSize));
+        if (json == nullptr) {
+          char message[Helper::detectSize(UNABLE_TO_ALLOCATE_BUFFER, jsonSize)];
+          snprintf_P(message, sizeof(message), UNABLE_TO_ALLOCATE_BUFFER, jsonSize);
+          Logger::log(message);
+          return result;
+        }
         if (serializeJson(source, json, jsonSize) < jsonSize - 1) {
           Logger::log(UNABLE_TO_SERIALIZE_JSON);
         }
         else {
           result = Send_Json_String(topic, json);
         }
-        // Ensure to actually delete the memory placed onto the heap, to make sure we do not create a memory leak
+        // Ensure to actually free the memory placed onto the heap, to make sure we do not create a memory leak
         // and set the pointer to null so we do not have a dangling reference.
-        delete[] json;
+        m_allocator.deallocate(json);
         json = nullptr;
       }
       else {
@@ -149,6 +311,13 @@ class ThingsBoardHttpSized {
         return false;
       }
 
+      // Telemetry and attributes are sent over the paths precomputed in setAccessToken(), only custom topics have to be formatted with the token for every request
+      if (topic == HTTP_TELEMETRY_TOPIC && m_telemetry_path != nullptr) {
+        return postMessage(m_telemetry_path, json);
+      }
+      else if (topic == HTTP_ATTRIBUTES_TOPIC && m_attributes_path != nullptr) {
+        return postMessage(m_attributes_path, json);
+      }
       char path[Helper::detectSize(topic, m_token)];
       snprintf_P(path, sizeof(path), topic, m_token);
       return postMessage(path, json);
@@ -172,7 +341,7 @@ class ThingsBoardHttpSized {
     /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
     /// @param data Array containing all the data we want to send
     /// @param data_count Amount of data entries in the array that we want to send
-    /// @return Whetherr sending the data was successful or not
+    /// @return Whether sending the data was successful or not
     inline bool sendTelemetry(const Telemetry *data, size_t data_count) {
       return sendDataArray(data, data_count);
     }
@@ -180,7 +349,7 @@ class ThingsBoardHttpSized {
     /// @brief Attempts to send custom json telemetry string.
     /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
     /// @param json String containing our json key value pairs we want to attempt to send
-    /// @return Whetherr sending the data was successful or not
+    /// @return Whether sending the data was successful or not
     inline bool sendTelemetryJson(const char *json) {
       return Send_Json_String(HTTP_TELEMETRY_TOPIC, json);
     }
@@ -196,11 +365,135 @@ class ThingsBoardHttpSized {
       return Send_Json(HTTP_TELEMETRY_TOPIC, source, jsonSize);
     }
 
+    //----------------------------------------------------------------------------
+    // Telemetry batch API
+
+    /// @brief Enables batching of telemetry samples, each added sample is serialized into an internal buffer and all samples are sent together in a single request
+    /// as a json array of {"ts":...,"values":{...}} objects, which removes the overhead of a separate request for every sample.
+    /// The batch is sent once the next sample would not fit into the buffer anymore, once it contains the given amount of samples or once the oldest sample is older than the given age,
+    /// where the age is only checked when adding a sample or when calling loop(). Pending samples are sent before the buffer is changed.
+    /// See https://thingsboard.io/docs/reference/http-api/#telemetry-upload-api for more information
+    /// @param bufferSize Size of the buffer the samples are serialized into, has to fit atleast a single sample, 0 disables batching and frees the buffer
+    /// @param maxSamples Amount of samples after which the batch is sent, 0 means the batch is only sent once the buffer is full or the age is exceeded
+    /// @param maxAgeMicroseconds Age of the oldest sample after which the batch is sent, 0 means the age is not checked
+    /// @return Whether allocating the buffer was successful or not
+    inline bool setTelemetryBatching(const size_t& bufferSize, const size_t& maxSamples = 0U, const uint64_t& maxAgeMicroseconds = 0U) {
+      (void)flushTelemetry();
+      m_allocator.deallocate(m_batch);
+      m_batch = nullptr;
+      m_batch_size = 0U;
+      m_batch_max_samples = maxSamples;
+      m_batch_max_age = maxAgeMicroseconds;
+      if (bufferSize == 0U) {
+        return true;
+      }
+
+      m_batch = static_cast<char*>(m_allocator.allocate(bufferSize));
+      if (m_batch == nullptr) {
+        char message[Helper::detectSize(UNABLE_TO_ALLOCATE_BUFFER, bufferSize)];
+        snprintf_P(message, sizeof(message), UNABLE_TO_ALLOCATE_BUFFER, bufferSize);
+        Logger::log(message);
+        return false;
+      }
+      m_batch_size = bufferSize;
+      return true;
+    }
+
+    /// @brief Adds a telemetry sample with the given timestamp to the batch, the keys and values are serialized directly,
+    /// meaning they do not have to be kept alive until the batch is sent. Requires batching to be enabled with setTelemetryBatching()
+    /// @param data Array containing all the key value pairs of the sample
+    /// @param data_count Amount of data entries in the array
+    /// @param timestamp Unix timestamp in milliseconds the sample was measured at
+    /// @return Whether adding the sample and sending the batch, if it was due, was successful or not
+    inline bool addTelemetry(const Telemetry *data, size_t data_count, const uint64_t& timestamp) {
+      if (m_batch == nullptr) {
+        return false;
+      }
+#if THINGSBOARD_ENABLE_DYNAMIC
+      // String are const char* and therefore stored as a pointer --> zero copy, meaning the size for the strings is 0 bytes,
+      // Data structure size depends on the amount of key value pairs passed.
+      // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
+      const size_t dataStructureMemoryUsage = JSON_OBJECT_SIZE(2U) + JSON_OBJECT_SIZE(data_count);
+      BasicJsonDocument<Allocator> jsonBuffer(dataStructureMemoryUsage, m_allocator);
+#else
+      if (MaxFieldsAmt < data_count) {
+        char message[Helper::detectSize(TOO_MANY_JSON_FIELDS, data_count, MaxFieldsAmt)];
+        snprintf_P(message, sizeof(message), TOO_MANY_JSON_FIELDS, data_count, MaxFieldsAmt);
+        Logger::log(message);
+        return false;
+      }
+      StaticJsonDocument<JSON_OBJECT_SIZE(2U) + JSON_OBJECT_SIZE(MaxFieldsAmt)> jsonBuffer;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+      JsonObject sample = jsonBuffer.template to<JsonObject>();
+      sample[TS_KEY] = timestamp;
+      JsonVariant values = sample.createNestedObject(VALUES_KEY);
+      for (size_t i = 0; i < data_count; ++i) {
+        if (!data[i].SerializeKeyValue(values)) {
+          Logger::log(UNABLE_TO_SERIALIZE);
+          return false;
+        }
+      }
+
+      // Each sample needs an additional byte for the leading '[' or ',' and the batch always needs to keep two bytes for the closing ']' and the null terminator
+      const size_t sampleSize = measureJson(sample) + 1U;
+      if (sampleSize + 2U > m_batch_size) {
+        char message[Helper::detectSize(BATCH_SAMPLE_TOO_BIG, sampleSize, m_batch_size)];
+        snprintf_P(message, sizeof(message), BATCH_SAMPLE_TOO_BIG, sampleSize, m_batch_size);
+        Logger::log(message);
+        return false;
+      }
+      bool result = true;
+      if (m_batch_length + sampleSize + 2U > m_batch_size) {
+        result = flushTelemetry();
+      }
+
+      if (m_batch_samples == 0U) {
+        m_batch_started = Helper::getMicroseconds();
+      }
+      m_batch[m_batch_length] = m_batch_samples == 0U ? '[' : ',';
+      m_batch_length += 1U + serializeJson(sample, m_batch + m_batch_length + 1U, m_batch_size - m_batch_length - 1U);
+      m_batch_samples++;
+
+      if (m_batch_max_samples != 0U && m_batch_samples >= m_batch_max_samples) {
+        return flushTelemetry() && result;
+      }
+      return loop() && result;
+    }
+
+    /// @brief Sends all samples currently contained in the batch in a single request, the samples are removed from the batch even if sending them failed,
+    /// to ensure a connection that is down for a longer time does not block newer samples from being added
+    /// @return Whether sending the batch was successful or not, true if the batch was empty
+    inline bool flushTelemetry() {
+      if (m_batch == nullptr || m_batch_samples == 0U) {
+        return true;
+      }
+      m_batch[m_batch_length] = ']';
+      m_batch[m_batch_length + 1U] = '\0';
+      const bool result = Send_Json_String(HTTP_TELEMETRY_TOPIC, m_batch);
+      m_batch_length = 0U;
+      m_batch_samples = 0U;
+      return result;
+    }
+
+    /// @brief Sends the telemetry batch if its oldest sample is older than the configured maximum age and downloads the next firmware chunk if an update is running,
+    /// which includes requesting chunks again whose timeout has passed, should be called periodically if batching with a maximum age is enabled or a firmware update has been started, because neither progresses otherwise
+    /// @return Whether sending the batch was successful or not, true if it was not due yet
+    inline bool loop() {
+#if THINGSBOARD_ENABLE_OTA
+      m_timer_wheel.Process();
+      Download_Pending_Chunk();
+#endif // THINGSBOARD_ENABLE_OTA
+      if (m_batch_max_age == 0U || m_batch_samples == 0U || Helper::getMicroseconds() - m_batch_started < m_batch_max_age) {
+        return true;
+      }
+      return flushTelemetry();
+    }
+
     /// @brief Attempts to send a GET request over HTTP or HTTPS
     /// @param path API path we want to get data from (example: /api/v1/$TOKEN/rpc)
     /// @param response String the GET response will be copied into,
     /// will not be changed if the GET request wasn't successful
-    /// @return Whetherr sending the GET request was successful or not
+    /// @return Whether sending the GET request was successful or not
 #if THINGSBOARD_ENABLE_STL
     inline bool sendGetRequest(const char* path, std::string& response) {
 #else
@@ -209,10 +502,74 @@ class ThingsBoardHttpSized {
       return getMessage(path, response);
     }
 
+    /// @brief Attempts to send a GET request over HTTP or HTTPS and passes the response body in multiple parts to the given callback,
+    /// instead of copying the complete body into a string, meaning arbitrarily large responses can be processed in constant memory
+    /// @tparam Chunk_Callback Callable object with the signature bool(const uint8_t *chunk, const size_t& size), returning false aborts reading the rest of the body
+    /// @param path API path we want to get data from (example: /api/v1/$TOKEN/rpc)
+    /// @param callback Callback that is called with each part of the response body
+    /// @param chunkSize Maximum size of each part passed to the callback, the part is allocated once with the allocator policy and reused for every part, default = Default_Payload
+    /// @return Whether sending the GET request and reading the complete body was successful or not
+    template <typename Chunk_Callback>
+    inline bool streamGetRequest(const char* path, const Chunk_Callback& callback, const size_t& chunkSize = Default_Payload) {
+      // Allocated before the request is sent, because the response would otherwise have to be discarded if allocating fails
+      uint8_t* chunk = static_cast<uint8_t*>(m_allocator.allocate(chunkSize));
+      if (chunk == nullptr) {
+        char message[Helper::detectSize(UNABLE_TO_ALLOCATE_BUFFER, chunkSize)];
+        snprintf_P(message, sizeof(message), UNABLE_TO_ALLOCATE_BUFFER, chunkSize);
+        Logger::log(message);
+        return false;
+      }
+      if (!startGetRequest(path)) {
+        m_allocator.deallocate(chunk);
+        return false;
+      }
+
+      int read = 0;
+      bool aborted = false;
+      while (!aborted && (read = m_client.read_response_body(chunk, chunkSize)) > 0) {
+        aborted = !callback(chunk, static_cast<size_t>(read));
+      }
+      m_allocator.deallocate(chunk);
+      chunk = nullptr;
+
+      // Remaining body has not been read if the callback aborted, therefore the connection can not be reused for the next request
+      if (aborted || read < 0 || !m_keep_alive) {
+        clearConnection();
+      }
+      return !aborted && read == 0;
+    }
+
+    /// @brief Attempts to send a GET request over HTTP or HTTPS and deserializes the response body directly from the client into the given JsonDocument,
+    /// without copying the complete body into a string beforehand
+    /// @tparam TDocument Type of the JsonDocument the response body is deserialized into
+    /// @param path API path we want to get data from (example: /api/v1/$TOKEN/attributes?sharedKeys=fw_title)
+    /// @param document JsonDocument the response body is deserialized into, has to be big enough to hold the deserialized response
+    /// @return Whether sending the GET request and deserializing the response body was successful or not
+    template <typename TDocument>
+    inline bool sendGetRequestJson(const char* path, TDocument& document) {
+      if (!startGetRequest(path)) {
+        return false;
+      }
+
+      HTTP_Response_Reader<> reader(m_client);
+      const DeserializationError error = deserializeJson(document, reader);
+      if (error || reader.Get_Error() != 0) {
+        char message[Helper::detectSize(UNABLE_TO_DE_SERIALIZE_JSON, error.c_str())];
+        snprintf_P(message, sizeof(message), UNABLE_TO_DE_SERIALIZE_JSON, error.c_str());
+        Logger::log(message);
+        clearConnection();
+        return false;
+      }
+
+      // Deserialization stops after the json data, any trailing bytes have to be consumed before the connection can be reused
+      finishRequest(0);
+      return true;
+    }
+
     /// @brief Attempts to send a POST request over HTTP or HTTPS
     /// @param path API path we want to send data to (example: /api/v1/$TOKEN/attributes)
     /// @param json String containing our json key value pairs we want to attempt to send
-    /// @return Whetherr sending the POST request was successful or not
+    /// @return Whether sending the POST request was successful or not
     inline bool sendPostRequest(const char* path, const char* json) {
       return postMessage(path, json);
     }
@@ -235,7 +592,7 @@ class ThingsBoardHttpSized {
     /// See https://thingsboard.io/docs/user-guide/attributes/ for more information
     /// @param data Array containing all the data we want to send
     /// @param data_count Amount of data entries in the array that we want to send
-    /// @return Whetherr sending the data was successful or not
+    /// @return Whether sending the data was successful or not
     inline bool sendAttributes(const Attribute *data, size_t data_count) {
       return sendDataArray(data, data_count, false);
     }
@@ -243,7 +600,7 @@ class ThingsBoardHttpSized {
     /// @brief Attempts to send custom json attribute string.
     /// See https://thingsboard.io/docs/user-guide/attributes/ for more information
     /// @param json String containing our json key value pairs we want to attempt to send
-    /// @return Whetherr sending the data was successful or not
+    /// @return Whether sending the data was successful or not
     inline bool sendAttributeJSON(const char *json) {
       return Send_Json_String(HTTP_ATTRIBUTES_TOPIC, json);
     }
@@ -259,6 +616,82 @@ class ThingsBoardHttpSized {
       return Send_Json(HTTP_ATTRIBUTES_TOPIC, source, jsonSize);
     }
 
+#if THINGSBOARD_ENABLE_OTA
+
+    //----------------------------------------------------------------------------
+    // Firmware OTA API
+
+    /// @brief Requests the firmware shared attributes and if a new firmware is assigned to the device starts downloading it over HTTP or HTTPS.
+    /// Instead of the chunk requests and responses over MQTT, each chunk is downloaded with a GET request from the firmware endpoint over the kept alive connection
+    /// and then passed to the same updater and hash verification, which allows to use much bigger chunk sizes than the MQTT buffer would allow.
+    /// The download progresses in loop(), which downloads one chunk per call, therefore it has to be called until the end callback has been called.
+    /// See https://thingsboard.io/docs/reference/http-api/#firmware-api for more information
+    /// @param callback Callback method that will be called, is not copied and therefore has to be kept alive until the update has finished
+    /// @return Whether a new firmware has been found and its download has been started or not
+    inline bool Start_Firmware_Update(const OTA_Update_Callback& callback) {
+      if (!Prepare_Firmware_Settings(callback))  {
+        Logger::log(RESETTING_FAILED);
+        return false;
+      }
+
+      const size_t attributes_length = strlen(m_attributes_path);
+      char path[attributes_length + sizeof(HTTP_FIRMWARE_ATTRIBUTES_PARAMETER)];
+      memcpy(path, m_attributes_path, attributes_length);
+      memcpy_P(path + attributes_length, HTTP_FIRMWARE_ATTRIBUTES_PARAMETER, sizeof(HTTP_FIRMWARE_ATTRIBUTES_PARAMETER));
+
+      StaticJsonDocument<JSON_OBJECT_SIZE(1U) + JSON_OBJECT_SIZE(5U) + FIRMWARE_ATTRIBUTES_STRING_SIZE> response;
+      if (!sendGetRequestJson(path, response)) {
+        m_fw_callback = nullptr;
+        return false;
+      }
+      return Firmware_Shared_Attribute_Received(response[SHARED_RESPONSE_KEY]);
+    }
+
+    /// @brief Stops the currently running firmware update, calls the finish callback with a failure if the update is running.
+    /// The chunk that is currently being downloaded, if loop() is called from another task, is still completed but discarded
+    inline void Stop_Firmware_Update() {
+      if (m_fw_callback == nullptr) {
+        return;
+      }
+      m_ota.Stop_Update();
+    }
+
+    /// @brief Sends the given firmware title and firmware version to the cloud.
+    /// See https://thingsboard.io/docs/user-guide/ota-updates/ for more information
+    /// @param currFwTitle Current device firmware title
+    /// @param currFwVersion Current device firmware version
+    /// @return Whether sending the current device firmware information was successful or not
+    inline bool Firmware_Send_Info(const char *currFwTitle, const char *currFwVersion) {
+      StaticJsonDocument<JSON_OBJECT_SIZE(2)> currentFirmwareInfo;
+      const JsonObject currentFirmwareInfoObject = currentFirmwareInfo.to<JsonObject>();
+
+      currentFirmwareInfoObject[CURR_FW_TITLE_KEY] = currFwTitle;
+      currentFirmwareInfoObject[CURR_FW_VER_KEY] = currFwVersion;
+      return sendTelemetryJson(currentFirmwareInfoObject, Helper::Measure_Json(currentFirmwareInfoObject));
+    }
+
+    /// @brief Sends the given firmware state to the cloud.
+    /// See https://thingsboard.io/docs/user-guide/ota-updates/ for more information
+    /// @param currFwState Current firmware download state
+    /// @param fwError Firmware error message that describes the current firmware state,
+    /// pass nullptr or an empty string if the current state is not a failure state
+    /// and therefore does not require any firmware error messsages
+    /// @return Whether sending the current firmware download state was successful or not
+    inline bool Firmware_Send_State(const char *currFwState, const char* fwError = nullptr) {
+      StaticJsonDocument<JSON_OBJECT_SIZE(2)> currentFirmwareState;
+      const JsonObject currentFirmwareStateObject = currentFirmwareState.to<JsonObject>();
+
+      // Make the fw error optional,
+      // meaning if it is an empty string or null instead we don't send it at all.
+      if (fwError != nullptr && fwError[0] != '\0') {
+        currentFirmwareStateObject[FW_ERROR_KEY] = fwError;
+      }
+      currentFirmwareStateObject[FW_STATE_KEY] = currFwState;
+      return sendTelemetryJson(currentFirmwareStateObject, Helper::Measure_Json(currentFirmwareStateObject));
+    }
+
+#endif // THINGSBOARD_ENABLE_OTA
+
   private:
 
     /// @brief Returns the maximum amount of bytes that we want to allocate on the stack, before the memory is allocated on the heap instead
@@ -267,30 +700,114 @@ class ThingsBoardHttpSized {
       return m_max_stack;
     }
 
+    /// @brief Writes the api prefix, the token and the given suffix into the given buffer, only uses memcpy instead of formatting the path with snprintf
+    /// @param path Buffer the path is written into, has to be big enough to fit the prefix, the token and the suffix including its null terminator
+    /// @param token_length Length of the token without the null terminator
+    /// @param suffix Suffix that is appended after the token
+    /// @param suffix_size Size of the suffix including its null terminator
+    inline void Build_Path(char *path, const size_t& token_length, const char *suffix, const size_t& suffix_size) const {
+      constexpr size_t prefix_length = sizeof(HTTP_API_PREFIX) - 1U;
+      memcpy_P(path, HTTP_API_PREFIX, prefix_length);
+      memcpy(path + prefix_length, m_token, token_length);
+      memcpy_P(path + prefix_length + token_length, suffix, suffix_size);
+    }
+
     /// @brief Clears any remaining memory of the previous conenction,
     /// and resets the TCP as well, if data is resend the TCP connection has to be re-established
     inline void clearConnection() {
       m_client.stop();
     }
 
+    /// @brief Clears any remaining state of the previous connection and opens a new connection to the host
+    /// @return Whether the connection could be established or not
+    inline bool connectToHost() {
+      clearConnection();
+      m_connections_opened++;
+      return m_client.connect(m_host, m_port) > 0;
+    }
+
+    /// @brief Sends a request over the kept alive connection if it is still open or over a newly opened connection otherwise.
+    /// The host might close an idle connection at any time, which is often only noticed once we attempt to send over it,
+    /// therefore if sending over a reused connection fails, the request is sent once more over a newly opened connection
+    /// @tparam Request Type of the callable that sends the request
+    /// @param request Callable that sends the request and returns 0 if successful or the internal error code otherwise
+    /// @return 0 if the request was sent successfully or the internal error code of the last attempt
+    template <typename Request>
+    inline int sendRequest(const Request& request) {
+      const bool reused = m_client.connected();
+      if (!reused) {
+        (void)connectToHost();
+      }
+      m_requests_sent++;
+      int error = request();
+      if (error != 0 && reused) {
+        (void)connectToHost();
+        m_requests_sent++;
+        error = request();
+      }
+      return error;
+    }
+
+    /// @brief Finishes the previously sent request, if keep alive is enabled the remaining response body is consumed so the connection can be reused for the next request,
+    /// otherwise or if sending the request failed, the connection is closed
+    /// @param error Internal error code returned when sending the request
+    inline void finishRequest(const int& error) {
+      if (!m_keep_alive || error != 0) {
+        clearConnection();
+        return;
+      }
+
+      // Consume the remaining response body in small parts, instead of copying it completely into a string that is discarded anyway
+      uint8_t discarded[Default_Payload];
+      int read = 0;
+      while ((read = m_client.read_response_body(discarded, sizeof(discarded))) > 0) {
+        // Nothing to do
+      }
+      if (read < 0) {
+        clearConnection();
+      }
+    }
+
+    /// @brief Sends a GET request over HTTP or HTTPS and checks the status code of the response, the response body can then be read from the client
+    /// @param path API path we want to get data from (example: /api/v1/$TOKEN/rpc)
+    /// @return Whether sending the GET request was successful and the response contains a success status code or not
+    inline bool startGetRequest(const char* path) {
+      const int error = sendRequest([&]() {
+        return m_client.get(path);
+      });
+      const int status = error == 0 ? m_client.get_response_status_code() : error;
+
+      if (status < HTTP_RESPONSE_SUCCESS_RANGE_START || status > HTTP_RESPONSE_SUCCESS_RANGE_END) {
+        char message[Helper::detectSize(HTTP_FAILED, GET, status)];
+        snprintf_P(message, sizeof(message), HTTP_FAILED, GET, status);
+        Logger::log(message);
+        finishRequest(error);
+        return false;
+      }
+      return true;
+    }
+
     /// @brief Attempts to send a POST request over HTTP or HTTPS
     /// @param path API path we want to send data to (example: /api/v1/$TOKEN/attributes)
     /// @param json String containing our json key value pairs we want to attempt to send
-    /// @return Whetherr sending the POST request was successful or not
+    /// @return Whether sending the POST request was successful or not
     inline bool postMessage(const char* path, const char* json) {
       bool result = true;
 
-      const int success = m_client.post(path, HTTP_POST_PATH, json);
-      const int status = m_client.get_response_status_code();
+      const int error = sendRequest([&]() {
+        return m_client.post(path, HTTP_POST_PATH, json);
+      });
+      // Reading the status code of a request that could not be sent would only block until the response timeout, therefore the error code is logged instead
+      const int status = error == 0 ? m_client.get_response_status_code() : error;
 
-      if (!success || status < HTTP_RESPONSE_SUCCESS_RANGE_START || status > HTTP_RESPONSE_SUCCESS_RANGE_END) {
+      if (status < HTTP_RESPONSE_SUCCESS_RANGE_START || status > HTTP_RESPONSE_SUCCESS_RANGE_END) {
         char message[Helper::detectSize(HTTP_FAILED, POST, status)];
         snprintf_P(message, sizeof(message), HTTP_FAILED, POST, status);
         Logger::log(message);
         result = false;
       }
 
-      clearConnection();
+      finishRequest(error);
       return result;
     }
 
@@ -298,44 +815,36 @@ class ThingsBoardHttpSized {
     /// @param path API path we want to get data from (example: /api/v1/$TOKEN/rpc)
     /// @param response String the GET response will be copied into,
     /// will not be changed if the GET request wasn't successful
-    /// @return Whetherr sending the GET request was successful or not
+    /// @return Whether sending the GET request was successful or not
 #if THINGSBOARD_ENABLE_STL
     inline bool getMessage(const char* path, std::string& response) {
 #else
     inline bool getMessage(const char* path, String& response) {
 #endif // THINGSBOARD_ENABLE_STL
-      bool result = true;
-
-      const bool success = m_client.get(path);
-      const int status = m_client.get_response_status_code();
-
-      if (!success || status < HTTP_RESPONSE_SUCCESS_RANGE_START || status > HTTP_RESPONSE_SUCCESS_RANGE_END) {
-        char message[Helper::detectSize(HTTP_FAILED, GET, status)];
-        snprintf_P(message, sizeof(message), HTTP_FAILED, GET, status);
-        Logger::log(message);
-        result = false;
-        goto cleanup;
+      if (!startGetRequest(path)) {
+        return false;
       }
 
+      // Reading the body consumes the response completly, meaning the connection can directly be reused without calling finishRequest()
       response = m_client.get_response_body();
-
-      cleanup:
-      clearConnection();
-      return result;
+      if (!m_keep_alive) {
+        clearConnection();
+      }
+      return true;
     }
 
     /// @brief Attempts to send aggregated attribute or telemetry data
     /// @param data Array containing all the data we want to send
     /// @param data_count Amount of data entries in the array that we want to send
-    /// @param telemetry Whetherr the aggregated data is telemetry (true) or attribut (false)
-    /// @return Whetherr sending the data was successful or not
+    /// @param telemetry Whether the aggregated data is telemetry (true) or attribut (false)
+    /// @return Whether sending the data was successful or not
     inline bool sendDataArray(const Telemetry *data, size_t data_count, bool telemetry = true) {
 #if THINGSBOARD_ENABLE_DYNAMIC
       // String are const char* and therefore stored as a pointer --> zero copy, meaning the size for the strings is 0 bytes,
       // Data structure size depends on the amount of key value pairs passed.
       // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
       const size_t dataStructureMemoryUsage = JSON_OBJECT_SIZE(data_count);
-      TBJsonDocument jsonBuffer(dataStructureMemoryUsage);
+      BasicJsonDocument<Allocator> jsonBuffer(dataStructureMemoryUsage, m_allocator);
 #else
       StaticJsonDocument<JSON_OBJECT_SIZE(MaxFieldsAmt)> jsonBuffer;
 #endif // THINGSBOARD_ENABLE_DYNAMIC
@@ -350,7 +859,7 @@ class ThingsBoardHttpSized {
 
 #if THINGSBOARD_ENABLE_DYNAMIC
       // Resize internal JsonDocument buffer to only use the actually needed amount of memory.
-      requestBuffer.shrinkToFit();
+      jsonBuffer.shrinkToFit();
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
 
       return telemetry ? sendTelemetryJson(object, Helper::Measure_Json(object)) : sendAttributeJSON(object, Helper::Measure_Json(object));
@@ -360,8 +869,8 @@ class ThingsBoardHttpSized {
     /// @tparam T Type of the passed value
     /// @param key Key of the key value pair we want to send
     /// @param val Value of the key value pair we want to send
-    /// @param telemetry Whetherr the aggregated data is telemetry (true) or attribut (false)
-    /// @return Whetherr sending the data was successful or not
+    /// @param telemetry Whether the aggregated data is telemetry (true) or attribut (false)
+    /// @return Whether sending the data was successful or not
     template<typename T>
     inline bool sendKeyValue(const char *key, T value, bool telemetry = true) {
       const Telemetry t(key, value);
@@ -380,9 +889,276 @@ class ThingsBoardHttpSized {
       return telemetry ? sendTelemetryJson(object, Helper::Measure_Json(object)) : sendAttributeJSON(object, Helper::Measure_Json(object));
     }
 
-    IHTTP_Client& m_client; // HttpClient instance
-    size_t m_max_stack;     // Maximum stack size we allocate at once on the stack.
-    const char *m_token;    // Access token used to connect with
+#if THINGSBOARD_ENABLE_OTA
+
+    /// @brief Checks the included information in the callback,
+    /// and attempts to sends the current device firmware information to the cloud
+    /// @param callback Callback method that will be called
+    /// @return Whether checking and sending the current device firmware information was successful or not
+    inline bool Prepare_Firmware_Settings(const OTA_Update_Callback& callback) {
+      const char *currFwTitle = callback.Get_Firmware_Title();
+      const char *currFwVersion = callback.Get_Firmware_Version();
+
+      // Send current firmware version
+      if (currFwTitle == nullptr || currFwVersion == nullptr || m_attributes_path == nullptr) {
+        return false;
+      }
+      else if (!Firmware_Send_Info(currFwTitle, currFwVersion)) {
+        return false;
+      }
+
+      // Set private members needed for update
+      m_fw_callback = &callback;
+      return true;
+    }
+
+    /// @brief Checks the received firmware shared attributes and if they describe a new firmware for this device,
+    /// builds the path the chunks are downloaded from, allocates the chunk buffer and starts the update
+    /// @param data Json data containing key-value pairs for the needed firmware information
+    /// @return Whether the update has been started or not
+    inline bool Firmware_Shared_Attribute_Received(const JsonObjectConst& data) {
+      // Check if firmware is available for our device
+      if (!data.containsKey(FW_VER_KEY) || !data.containsKey(FW_TITLE_KEY)) {
+        Logger::log(NO_FW);
+        Firmware_Send_State(FW_STATE_FAILED, NO_FW);
+        m_fw_callback = nullptr;
+        return false;
+      }
+
+      const char *fw_title = data[FW_TITLE_KEY].as<const char *>();
+      const char *fw_version = data[FW_VER_KEY].as<const char *>();
+      const char *fw_checksum = data[FW_CHKS_KEY].as<const char *>();
+      const char *fw_algorithm = data[FW_CHKS_ALGO_KEY].as<const char *>();
+      const size_t fw_size = data[FW_SIZE_KEY].as<const size_t>();
+
+      const char *curr_fw_title = m_fw_callback->Get_Firmware_Title();
+      const char *curr_fw_version = m_fw_callback->Get_Firmware_Version();
+
+      if (fw_title == nullptr || fw_version == nullptr || fw_algorithm == nullptr || fw_checksum == nullptr || fw_algorithm[0] == '\0' || fw_checksum[0] == '\0') {
+        Logger::log(EMPTY_FW);
+        Firmware_Send_State(FW_STATE_FAILED, EMPTY_FW);
+        m_fw_callback = nullptr;
+        return false;
+      }
+      // If firmware version and title is the same, we do not initiate an update, because we expect the binary to be the same one we are currently using
+      else if (strncmp_P(curr_fw_title, fw_title, JSON_STRING_SIZE(strlen(curr_fw_title))) == 0 && strncmp_P(curr_fw_version, fw_version, JSON_STRING_SIZE(strlen(curr_fw_version))) == 0) {
+        Logger::log(FW_UP_TO_DATE);
+        Firmware_Send_State(FW_STATE_UPDATED, FW_UP_TO_DATE);
+        m_fw_callback = nullptr;
+        return false;
+      }
+      // If firmware title is not the same, we do not initiate an update, because we expect the binary to be for another device type
+      else if (strncmp_P(curr_fw_title, fw_title, JSON_STRING_SIZE(strlen(curr_fw_title))) != 0) {
+        Logger::log(FW_NOT_FOR_US);
+        Firmware_Send_State(FW_STATE_FAILED, FW_NOT_FOR_US);
+        m_fw_callback = nullptr;
+        return false;
+      }
+
+      mbedtls_md_type_t fw_checksum_algorithm = mbedtls_md_type_t();
+
+      // Change the used firmware algorithm, depending on which type is set for the given firmware information
+      if (strncmp_P(fw_algorithm, CHECKSUM_AGORITM_MD5, sizeof(CHECKSUM_AGORITM_MD5)) == 0) {
+        fw_checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_MD5;
+      }
+      else if (strncmp_P(fw_algorithm, CHECKSUM_AGORITM_SHA256, sizeof(CHECKSUM_AGORITM_SHA256)) == 0) {
+        fw_checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_SHA256;
+      }
+      else if (strncmp_P(fw_algorithm, CHECKSUM_AGORITM_SHA384, sizeof(CHECKSUM_AGORITM_SHA384)) == 0) {
+        fw_checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_SHA384;
+      }
+      else if (strncmp_P(fw_algorithm, CHECKSUM_AGORITM_SHA512, sizeof(CHECKSUM_AGORITM_SHA512)) == 0) {
+        fw_checksum_algorithm = mbedtls_md_type_t::MBEDTLS_MD_SHA512;
+      }
+      else {
+        char message[JSON_STRING_SIZE(strlen(FW_CHKS_ALGO_NOT_SUPPORTED)) + JSON_STRING_SIZE(strlen(fw_algorithm))];
+        snprintf_P(message, sizeof(message), FW_CHKS_ALGO_NOT_SUPPORTED, fw_algorithm);
+        Logger::log(message);
+        Firmware_Send_State(FW_STATE_FAILED, message);
+        m_fw_callback = nullptr;
+        return false;
+      }
+
+      const uint16_t& chunk_size = m_fw_callback->Get_Chunk_Size();
+      m_allocator.deallocate(m_fw_chunk);
+      m_fw_chunk = static_cast<uint8_t*>(m_allocator.allocate(chunk_size));
+      if (m_fw_chunk == nullptr) {
+        char message[Helper::detectSize(UNABLE_TO_ALLOCATE_BUFFER, chunk_size)];
+        snprintf_P(message, sizeof(message), UNABLE_TO_ALLOCATE_BUFFER, chunk_size);
+        Logger::log(message);
+        Firmware_Send_State(FW_STATE_FAILED, message);
+        m_fw_callback = nullptr;
+        return false;
+      }
+
+      // Everything except the chunk index stays the same for every chunk, therefore the path is only built once
+      char size[Helper::detectSize(NUMBER_PRINTF, chunk_size)];
+      const size_t size_length = snprintf_P(size, sizeof(size), NUMBER_PRINTF, chunk_size);
+      const size_t path_length = (sizeof(HTTP_API_PREFIX) - 1U) + strlen(m_token) + (sizeof(HTTP_FIRMWARE_SUFFIX) - 1U) + Url_Encoded_Length(fw_title)
+        + (sizeof(HTTP_FIRMWARE_VERSION_PARAMETER) - 1U) + Url_Encoded_Length(fw_version) + (sizeof(HTTP_FIRMWARE_SIZE_PARAMETER) - 1U) + size_length + (sizeof(HTTP_FIRMWARE_CHUNK_PARAMETER) - 1U);
+      m_allocator.deallocate(m_fw_path);
+      m_fw_path = static_cast<char*>(m_allocator.allocate(path_length));
+      if (m_fw_path == nullptr) {
+        char message[Helper::detectSize(UNABLE_TO_ALLOCATE_BUFFER, path_length)];
+        snprintf_P(message, sizeof(message), UNABLE_TO_ALLOCATE_BUFFER, path_length);
+        Logger::log(message);
+        Firmware_Send_State(FW_STATE_FAILED, message);
+        Firmware_OTA_Finish();
+        return false;
+      }
+      char *path = m_fw_path;
+      path = Append_Progmem(path, HTTP_API_PREFIX, sizeof(HTTP_API_PREFIX) - 1U);
+      memcpy(path, m_token, strlen(m_token));
+      path += strlen(m_token);
+      path = Append_Progmem(path, HTTP_FIRMWARE_SUFFIX, sizeof(HTTP_FIRMWARE_SUFFIX) - 1U);
+      path = Append_Url_Encoded(path, fw_title);
+      path = Append_Progmem(path, HTTP_FIRMWARE_VERSION_PARAMETER, sizeof(HTTP_FIRMWARE_VERSION_PARAMETER) - 1U);
+      path = Append_Url_Encoded(path, fw_version);
+      path = Append_Progmem(path, HTTP_FIRMWARE_SIZE_PARAMETER, sizeof(HTTP_FIRMWARE_SIZE_PARAMETER) - 1U);
+      memcpy(path, size, size_length);
+      path += size_length;
+      (void)Append_Progmem(path, HTTP_FIRMWARE_CHUNK_PARAMETER, sizeof(HTTP_FIRMWARE_CHUNK_PARAMETER) - 1U);
+      m_fw_path_length = path_length;
+
+      m_ota.Start_Update(m_fw_callback, fw_size, fw_algorithm, fw_checksum, fw_checksum_algorithm);
+      return true;
+    }
+
+    /// @brief Marks the given firmware chunk to be downloaded in the next call to loop(), instead of downloading it directly,
+    /// because the chunk is requested again from inside the processing of the previous chunk or from the timeout callback of the watchdog
+    /// @param request_chunk Chunk index that should be downloaded from the server
+    /// @return Always true, because marking the chunk can not fail
+    inline bool Request_Chunk(const size_t& request_chunk) {
+      m_fw_requested_chunk = request_chunk;
+      m_fw_chunk_pending = true;
+      return true;
+    }
+
+    /// @brief Downloads the firmware chunk that has been requested last with a GET request and passes it to the firmware update handler.
+    /// If the download fails the chunk is not requested again directly, but only once the watchdog of the handler times out, to ensure failed downloads count towards the chunk retries
+    inline void Download_Pending_Chunk() {
+      if (!m_fw_chunk_pending || m_fw_chunk == nullptr) {
+        return;
+      }
+      m_fw_chunk_pending = false;
+      const size_t chunk = m_fw_requested_chunk;
+      const uint16_t& chunk_size = m_fw_callback->Get_Chunk_Size();
+
+      char path[m_fw_path_length + Helper::detectSize(NUMBER_PRINTF, chunk)];
+      memcpy(path, m_fw_path, m_fw_path_length);
+      snprintf_P(path + m_fw_path_length, sizeof(path) - m_fw_path_length, NUMBER_PRINTF, chunk);
+
+      size_t received = 0U;
+      int read = 0;
+      if (startGetRequest(path)) {
+        while (received < chunk_size && (read = m_client.read_response_body(m_fw_chunk + received, chunk_size - received)) > 0) {
+          received += read;
+        }
+        finishRequest(read < 0 ? read : 0);
+      }
+      else {
+        read = -1;
+      }
+
+      if (read < 0) {
+        char message[Helper::detectSize(FW_CHUNK_DOWNLOAD_FAILED, chunk)];
+        snprintf_P(message, sizeof(message), FW_CHUNK_DOWNLOAD_FAILED, chunk);
+        Logger::log(message);
+        return;
+      }
+      m_ota.Process_Packet(chunk, m_fw_chunk, received);
+    }
+
+    /// @brief Clears any memory associated with the firmware update, called by the firmware update handler once the update has either failed or succeeded
+    /// @return Always true, because releasing the memory can not fail
+    inline bool Firmware_OTA_Finish() {
+      m_allocator.deallocate(m_fw_chunk);
+      m_fw_chunk = nullptr;
+      m_fw_chunk_pending = false;
+      m_allocator.deallocate(m_fw_path);
+      m_fw_path = nullptr;
+      m_fw_path_length = 0U;
+      m_fw_callback = nullptr;
+      return true;
+    }
+
+    /// @brief Whether the given character is allowed inside of a query parameter without being percent-encoded
+    /// @param character Character that should be checked
+    /// @return Whether the character is unreserved or not
+    inline static bool Is_Url_Unreserved(const unsigned char& character) {
+      return isalnum(character) || character == '-' || character == '_' || character == '.' || character == '~';
+    }
+
+    /// @brief Calculates the length of the given value, once every character that is not allowed inside of a query parameter has been percent-encoded
+    /// @param value Value that should be encoded, for example the firmware title or version
+    /// @return Length of the encoded value without the null terminator
+    inline static size_t Url_Encoded_Length(const char *value) {
+      size_t length = 0U;
+      for (; *value != '\0'; ++value) {
+        length += Is_Url_Unreserved(*value) ? 1U : 3U;
+      }
+      return length;
+    }
+
+    /// @brief Appends the given value to the given path, with every character that is not allowed inside of a query parameter being percent-encoded
+    /// @param path Position in the path the encoded value should be written to, has to have space for at least Url_Encoded_Length() characters
+    /// @param value Value that should be encoded, for example the firmware title or version
+    /// @return Position in the path directly after the encoded value
+    inline static char* Append_Url_Encoded(char *path, const char *value) {
+      constexpr char hex[] = "0123456789ABCDEF";
+      for (; *value != '\0'; ++value) {
+        const unsigned char character = *value;
+        if (Is_Url_Unreserved(character)) {
+          *path++ = character;
+          continue;
+        }
+        *path++ = '%';
+        *path++ = hex[character >> 4U];
+        *path++ = hex[character & 0x0FU];
+      }
+      return path;
+    }
+
+    /// @brief Appends the given constant string, that might be placed in flash memory, to the given path
+    /// @param path Position in the path the string should be written to
+    /// @param value String that should be appended
+    /// @param length Length of the string without the null terminator
+    /// @return Position in the path directly after the appended string
+    inline static char* Append_Progmem(char *path, const char *value, const size_t& length) {
+      memcpy_P(path, value, length);
+      return path + length;
+    }
+
+#endif // THINGSBOARD_ENABLE_OTA
+
+    IHTTP_Client& m_client;         // HttpClient instance
+    size_t m_max_stack;             // Maximum stack size we allocate at once on the stack.
+    const char *m_token;            // Access token used to connect with
+    char *m_telemetry_path;         // Precomputed path telemetry is sent over, contains the access token
+    char *m_attributes_path;        // Precomputed path attributes are sent over, contains the access token, placed directly after the telemetry path in the same allocation
+    const char *m_host;             // Host server the connection is re-established to, if it has been closed
+    uint16_t m_port;                // Port the connection is re-established over, if it has been closed
+    bool m_keep_alive;              // Whether the connection is kept alive and reused for the following requests or closed after every request
+    uint32_t m_connections_opened;  // Amount of connections that have been opened to the host
+    uint32_t m_requests_sent;       // Amount of requests that have been sent to the host, including resent requests
+    char *m_batch;                  // Buffer the telemetry samples are serialized into, until they are sent as a single json array
+    size_t m_batch_size;            // Size of the telemetry batch buffer
+    size_t m_batch_length;          // Amount of bytes currently written into the telemetry batch buffer
+    size_t m_batch_samples;         // Amount of samples currently contained in the telemetry batch buffer
+    size_t m_batch_max_samples;     // Amount of samples after which the telemetry batch is sent, 0 if unlimited
+    uint64_t m_batch_max_age;       // Age in microseconds of the oldest sample after which the telemetry batch is sent, 0 if unlimited
+    uint64_t m_batch_started;       // Time in microseconds the oldest sample in the telemetry batch was added
+#if THINGSBOARD_ENABLE_OTA
+    Timer_Wheel m_timer_wheel;                // Drives the chunk timeouts of the firmware update from loop(), has to be declared before the handler to ensure it is destroyed after it
+    const OTA_Update_Callback *m_fw_callback; // Callback of the currently running firmware update, nullptr if no update is running
+    char *m_fw_path;                          // Path the firmware chunks are downloaded from without a null terminator, only the chunk index has to be appended, allocated for the duration of the update
+    size_t m_fw_path_length;                  // Length of the firmware chunk path
+    uint8_t *m_fw_chunk;                      // Buffer the currently downloaded firmware chunk is read into, allocated with the chunk size for the duration of the update
+    size_t m_fw_requested_chunk;              // Index of the firmware chunk that should be downloaded next
+    bool m_fw_chunk_pending;                  // Whether the requested firmware chunk still has to be downloaded in loop()
+    OTA_Handler<Logger> m_ota;                // Class instance that handles the writing and verification of the downloaded firmware chunks
+#endif // THINGSBOARD_ENABLE_OTA
+    Allocator m_allocator;          // Allocator policy every internal heap allocation is done with
 };
 
 using ThingsBoardHttp = ThingsBoardHttpSized<>;
@@ -0,0 +1,116 @@
+// Header include.
+#include "Timer_Wheel.h"
+
+#if THINGSBOARD_ENABLE_STL || THINGSBOARD_ENABLE_OTA
+
+// Local includes.
+#include "Callback_Watchdog.h"
+#include "Helper.h"
+
+Timer_Wheel::Timer_Wheel() :
+    m_slots(),
+    m_expired(nullptr),
+    m_current_tick(0U),
+    m_section()
+{
+    // Nothing to do
+}
+
+Timer_Wheel::~Timer_Wheel() {
+    for (size_t i = 0U; i < TIMER_WHEEL_SLOTS; i++) {
+        while (m_slots[i] != nullptr) {
+            Unlink(*m_slots[i]);
+        }
+    }
+    while (m_expired != nullptr) {
+        Unlink(*m_expired);
+    }
+}
+
+void Timer_Wheel::Schedule(Callback_Watchdog& watchdog, const uint64_t& timeout_microseconds) {
+    const Critical_Section_Lock lock(m_section);
+    Unlink(watchdog);
+    // Round up to the next tick, to ensure the watchdog never expires before the given timeout has passed
+    const uint64_t expiry = Helper::getMicroseconds() + timeout_microseconds;
+    uint64_t tick = (expiry + TIMER_WHEEL_RESOLUTION - 1U) / TIMER_WHEEL_RESOLUTION;
+    if (tick <= m_current_tick) {
+        tick = m_current_tick + 1U;
+    }
+    watchdog.m_expiry_tick = tick;
+    Link(m_slots[tick % TIMER_WHEEL_SLOTS], watchdog);
+}
+
+void Timer_Wheel::Cancel(Callback_Watchdog& watchdog) {
+    const Critical_Section_Lock lock(m_section);
+    Unlink(watchdog);
+}
+
+void Timer_Wheel::Process() {
+    {
+        const Critical_Section_Lock lock(m_section);
+        const uint64_t target_tick = Helper::getMicroseconds() / TIMER_WHEEL_RESOLUTION;
+        if (target_tick <= m_current_tick) {
+            return;
+        }
+
+        // Only the slots of the ticks that passed need to be checked, but if more than one rotation passed every slot has to be checked once
+        size_t checked_slots = TIMER_WHEEL_SLOTS;
+        if (target_tick - m_current_tick < TIMER_WHEEL_SLOTS) {
+            checked_slots = target_tick - m_current_tick;
+        }
+
+        // Expired watchdogs are collected first and only called afterwards, because the callbacks may schedule or cancel watchdogs,
+        // which would otherwise change the slots while they are still being iterated
+        for (size_t i = 1U; i <= checked_slots; i++) {
+            Callback_Watchdog *watchdog = m_slots[(m_current_tick + i) % TIMER_WHEEL_SLOTS];
+            while (watchdog != nullptr) {
+                Callback_Watchdog *next = watchdog->m_next;
+                if (watchdog->m_expiry_tick <= target_tick) {
+                    Unlink(*watchdog);
+                    Link(m_expired, *watchdog);
+                }
+                watchdog = next;
+            }
+        }
+        m_current_tick = target_tick;
+    }
+
+    // The section is left before each callback is called, because the callbacks may publish with the MQTT client or schedule watchdogs themselves
+    while (true) {
+        Callback_Watchdog *watchdog = nullptr;
+        {
+            const Critical_Section_Lock lock(m_section);
+            watchdog = m_expired;
+            if (watchdog != nullptr) {
+                Unlink(*watchdog);
+            }
+        }
+        if (watchdog == nullptr) {
+            break;
+        }
+        watchdog->m_callback();
+    }
+}
+
+void Timer_Wheel::Link(Callback_Watchdog*& head, Callback_Watchdog& watchdog) {
+    watchdog.m_next = head;
+    if (head != nullptr) {
+        head->m_prev = &watchdog.m_next;
+    }
+    watchdog.m_prev = &head;
+    head = &watchdog;
+}
+
+void Timer_Wheel::Unlink(Callback_Watchdog& watchdog) {
+    if (watchdog.m_prev == nullptr) {
+        return;
+    }
+    *watchdog.m_prev = watchdog.m_next;
+    if (watchdog.m_next != nullptr) {
+        watchdog.m_next->m_prev = watchdog.m_prev;
+    }
+    watchdog.m_next = nullptr;
+    watchdog.m_prev = nullptr;
+}
+
+#endif // THINGSBOARD_ENABLE_STL || THINGSBOARD_ENABLE_OTA
@@ -0,0 +1,73 @@
+#ifndef Timer_Wheel_h
+#define Timer_Wheel_h
+
+// Local includes.
+#include "Configuration.h"
+#include "Critical_Section.h"
+
+// Watchdogs store their callback in an Inplace_Function, therefore the wheel is available under the same condition,
+// which is needed by the client-side request timeouts if the C++ STL is enabled and by the OTA chunk timeouts
+#if THINGSBOARD_ENABLE_STL || THINGSBOARD_ENABLE_OTA
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+
+
+// Forward declaration, because the watchdogs are the entries of the wheel and therefore need to know the wheel they are scheduled on as well
+class Callback_Watchdog;
+
+
+/// @brief Coarse-grained hashed timer wheel, that drives every timeout of a ThingsBoard instance from a single scheduling point, instead of every timeout owning its own system timer.
+/// Scheduled watchdogs are sorted into one of TIMER_WHEEL_SLOTS slots by the tick they expire in, where one tick is TIMER_WHEEL_RESOLUTION microseconds long.
+/// Process() then only has to look at the slots of the ticks that passed since it was last called, which keeps it cheap even if it is called very often.
+/// Watchdogs that expire further in the future than one rotation of the wheel simply remain in their slot until their tick has actually been reached.
+/// The watchdogs are linked into the slots directly, therefore scheduling and cancelling never allocates memory and takes constant time.
+/// Expired watchdogs call their callback from inside of Process(), meaning from the same task that calls it, instead of from a separate timer task,
+/// therefore timeouts are only handled while Process() is called periodically, which is done by the loop() method of the ThingsBoard instances.
+/// Watchdogs may be scheduled or cancelled from another task while Process() is running, for example by the task of the Espressif_MQTT_Client once an OTA chunk has been received,
+/// therefore the slots are guarded by a Critical_Section, which is left before any callback is called. A watchdog cancelled before its callback has been called does not expire anymore
+class Timer_Wheel {
+  public:
+    /// @brief Constructs an empty timer wheel
+    Timer_Wheel();
+
+    /// @brief Destructor, removes every still scheduled watchdog from the wheel without calling their callback
+    ~Timer_Wheel();
+
+    /// @brief Schedules the given watchdog to expire once the given timeout has passed, if it is already scheduled it is rescheduled with the new timeout instead.
+    /// The timeout is rounded up to the next tick, meaning the watchdog expires at most TIMER_WHEEL_RESOLUTION microseconds late, but never early
+    /// @param watchdog Watchdog that should be scheduled, is not copied and therefore has to stay alive until it has expired or has been cancelled
+    /// @param timeout_microseconds Amount of microseconds until the watchdog expires
+    void Schedule(Callback_Watchdog& watchdog, const uint64_t& timeout_microseconds);
+
+    /// @brief Removes the given watchdog from the wheel, without calling its callback. Does nothing if the watchdog is not currently scheduled
+    /// @param watchdog Watchdog that should not expire anymore
+    void Cancel(Callback_Watchdog& watchdog);
+
+    /// @brief Calls the callback of every scheduled watchdog whose timeout has passed and removes them from the wheel,
+    /// callbacks are allowed to schedule or cancel any watchdog, including themselves. Has to be called periodically for any watchdog to ever expire
+    void Process();
+
+  private:
+    static constexpr size_t TIMER_WHEEL_SLOTS = 64U;             // Amount of slots, one rotation of the wheel is the amount of slots multiplied with the resolution
+    static constexpr uint64_t TIMER_WHEEL_RESOLUTION = 10000U;  // Length of one tick in microseconds, watchdogs can expire at most this late
+
+    /// @brief Appends the given watchdog to the front of the given list
+    /// @param head First watchdog of the list, nullptr if the list is empty
+    /// @param watchdog Watchdog that should be linked into the list, may not be in any list yet
+    static void Link(Callback_Watchdog*& head, Callback_Watchdog& watchdog);
+
+    /// @brief Removes the given watchdog from the list it is currently in, does nothing if it is not in any list
+    /// @param watchdog Watchdog that should be unlinked
+    static void Unlink(Callback_Watchdog& watchdog);
+
+    Callback_Watchdog *m_slots[TIMER_WHEEL_SLOTS]; // First scheduled watchdog of each slot, nullptr if the slot is empty
+    Callback_Watchdog *m_expired;                  // Expired watchdogs whose callback has not been called yet, kept as a member so they can still be cancelled until then
+    uint64_t m_current_tick;                       // Last tick that has been processed, watchdogs are always scheduled into a later tick
+    Critical_Section m_section;                    // Guards the slots and the expired watchdogs against being changed by multiple tasks at once
+};
+
+#endif // THINGSBOARD_ENABLE_STL || THINGSBOARD_ENABLE_OTA
+
+#endif // Timer_Wheel_h
@@ -6,17 +6,28 @@
 
 #if !THINGSBOARD_ENABLE_STL
 
+// Local include.
+#include "Allocator.h"
+
 // Library includes.
 #include <assert.h>
+#include <new>
+#include <stdlib.h>
 
 
 /// @brief Replacement data container for boards that do not support the C++ STL.
+/// Elements are relocated with memcpy when the underlying memory grows, therefore the type has to be trivially relocatable,
+/// which is the case for all internally used callback classes, because they only consist of pointers and numbers if the C++ STL is not used.
+/// If growing the underlying memory fails the device aborts, which is the same failure policy the std::vector used with the C++ STL has through the Allocator_Adapter,
+/// see Allocator.h for more information. This ensures an element is never silently dropped and both builds behave the same.
 /// @tparam T Type of the underlying data the list should point too.
-template <typename T>
+/// @tparam Allocator Allocator policy used to allocate the underlying memory, see Allocator.h for more information, default = Default_Allocator
+template <typename T, typename Allocator = Default_Allocator>
 class Vector {
   public:
     /// @brief Constructor
     inline Vector(void) :
+        m_allocator(),
         m_elements(nullptr),
         m_capacity(0U),
         m_size(0U)
@@ -26,7 +37,8 @@ class Vector {
 
     /// @brief Destructor
     inline ~Vector() {
-        delete[] m_elements;
+        clear();
+        m_allocator.deallocate(m_elements);
         m_elements = nullptr;
     }
 
@@ -79,32 +91,22 @@ class Vector {
         return m_elements + m_size;
     }
 
-    /// @brief Reserves the given capacity for the underlying data container
+    /// @brief Reserves the given capacity for the underlying data container, aborts if allocating the memory fails
     /// @param capacity Capacity that should be reserved in the underlying data container
     inline void reserve(const size_t& capacity) {
         if (capacity > m_capacity) {
-            T* newElements = new T[m_capacity];
-            if (m_elements != nullptr) {
-                memcpy(newElements, m_elements, m_size * sizeof(T));
-                delete[] m_elements;
-            }
-            m_elements = newElements;
+            grow(capacity);
         }
     }
 
-    /// @brief Inserts the given element at the end of the underlying data container
+    /// @brief Inserts the given element at the end of the underlying data container,
+    /// if the underlying memory is full and allocating more memory fails the device aborts
     /// @param element Element that should be inserted at the end
     inline void push_back(const T& element) {
         if (m_size == m_capacity) {
-            m_capacity = (m_capacity == 0) ? 1 : 2 * m_capacity;
-            T* newElements = new T[m_capacity];
-            if (m_elements != nullptr) {
-                memcpy(newElements, m_elements, m_size * sizeof(T));
-                delete[] m_elements;
-            }
-            m_elements = newElements;
+            grow((m_capacity == 0U) ? 1U : 2U * m_capacity);
         }
-        m_elements[m_size] = element;
+        new (&m_elements[m_size]) T(element);
         m_size++;
     }
 
@@ -119,6 +121,7 @@ class Vector {
             }
             // Decrease the size of the vector to remove the last element, because either it was moved one index to the left or was the element we wanted to delete
             m_size--;
+            m_elements[m_size].~T();
         }
     }
 
@@ -143,12 +146,31 @@ class Vector {
     }
 
     /// @brief Clears the given underlying data container.
-    /// Simply sets the underlying size to 0, data will only be cleared in the destructor
+    /// Destroys all elements, but the underlying memory will only be freed in the destructor
     inline void clear() {
+        for (size_t i = 0; i < m_size; i++) {
+            m_elements[i].~T();
+        }
         m_size = 0;
     }
 
   private:
+    /// @brief Moves the elements into newly allocated memory with the given capacity, aborts if allocating the new memory fails
+    /// @param capacity Capacity the underlying memory should have afterwards
+    inline void grow(const size_t& capacity) {
+        T* newElements = static_cast<T*>(m_allocator.allocate(capacity * sizeof(T)));
+        if (newElements == nullptr) {
+            abort();
+        }
+        if (m_elements != nullptr) {
+            memcpy(newElements, m_elements, m_size * sizeof(T));
+            m_allocator.deallocate(m_elements);
+        }
+        m_elements = newElements;
+        m_capacity = capacity;
+    }
+
+    Allocator m_allocator; // Allocator policy used to allocate the underlying memory
     T* m_elements;      // Pointer to the start of our elements
     size_t m_capacity;  // Allocated capacity that shows how many elements we could hold
     size_t m_size;      // Used size that shows how many elements we entered
@@ -0,0 +1,66 @@
+// Local includes.
+#include "Deadband_Filter.h"
+
+// Library includes.
+#include <gtest/gtest.h>
+#include <math.h>
+
+constexpr char FILTER_KEY[] = "value";
+
+/// @brief Whether the filter allows sending the given value and if it does, marks it as sent like a successful send would
+template <typename T>
+static bool Send(Deadband_Filter<1U>& filter, const T& value, const uint64_t& now = 0U) {
+    const Telemetry data(FILTER_KEY, value);
+    if (!filter.Should_Send(data, now)) {
+        return false;
+    }
+    filter.Mark_Sent(data, now);
+    return true;
+}
+
+TEST(Deadband_Filter_Test, Suppresses_Values_Inside_Of_Deadband) {
+    Deadband_Filter<1U> filter;
+    ASSERT_TRUE(filter.Add_Key(FILTER_KEY, 0.5, 0.0));
+    EXPECT_TRUE(Send(filter, 20.0));
+    EXPECT_FALSE(Send(filter, 20.4));
+    EXPECT_TRUE(Send(filter, 20.6));
+}
+
+TEST(Deadband_Filter_Test, Sends_Transitions_From_And_To_NaN) {
+    Deadband_Filter<1U> filter;
+    ASSERT_TRUE(filter.Add_Key(FILTER_KEY, 0.5, 0.1));
+    EXPECT_TRUE(Send(filter, 20.0));
+    EXPECT_TRUE(Send(filter, NAN));
+    EXPECT_FALSE(Send(filter, NAN));
+    // A value following NaN has no distance to it and therefore has to be sent, instead of being suppressed forever
+    EXPECT_TRUE(Send(filter, 20.0));
+    EXPECT_FALSE(Send(filter, 20.1));
+}
+
+TEST(Deadband_Filter_Test, Sends_Transitions_From_And_To_Infinity) {
+    Deadband_Filter<1U> filter;
+    ASSERT_TRUE(filter.Add_Key(FILTER_KEY, 0.5, 0.1));
+    EXPECT_TRUE(Send(filter, 20.0));
+    EXPECT_TRUE(Send(filter, INFINITY));
+    EXPECT_FALSE(Send(filter, INFINITY));
+    EXPECT_TRUE(Send(filter, -INFINITY));
+    EXPECT_TRUE(Send(filter, 20.0));
+}
+
+TEST(Deadband_Filter_Test, Sends_Every_Boolean_Toggle) {
+    Deadband_Filter<1U> filter;
+    ASSERT_TRUE(filter.Add_Key(FILTER_KEY, 1.0, 0.0));
+    EXPECT_TRUE(Send(filter, false));
+    EXPECT_FALSE(Send(filter, false));
+    EXPECT_TRUE(Send(filter, true));
+    EXPECT_FALSE(Send(filter, true));
+    EXPECT_TRUE(Send(filter, false));
+}
+
+TEST(Deadband_Filter_Test, Sends_Unchanged_Value_After_Heartbeat) {
+    Deadband_Filter<1U> filter;
+    ASSERT_TRUE(filter.Add_Key(FILTER_KEY, 0.5, 0.0, 1000U));
+    EXPECT_TRUE(Send(filter, 20.0, 0U));
+    EXPECT_FALSE(Send(filter, 20.0, 999U));
+    EXPECT_TRUE(Send(filter, 20.0, 1000U));
+}
@@ -0,0 +1,279 @@
+// Local includes.
+#include "Delta_Updater.h"
+#include "HashGenerator.h"
+#include "RAM_Patch_Source.h"
+#include "RAM_Updater.h"
+
+// Library includes.
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+constexpr size_t INSTALLED_IMAGE_SIZE = 1024U;
+constexpr size_t DELTA_RECORD_SIZE = 12U;
+
+/// @brief Builds a patch in the format of the Delta_Updater, the diff and extra bytes of each record are taken from the target image,
+/// while the diff bytes are additionally calculated against the installed image at the current read position
+class Delta_Patch {
+  public:
+    /// @brief Constructor, writes the header of the patch
+    /// @param installed Currently installed image the patch is applied to
+    /// @param target Image the patch should reconstruct
+    Delta_Patch(const std::vector<uint8_t>& installed, const std::vector<uint8_t>& target)
+      : m_installed(installed)
+      , m_target(target)
+      , m_data(DELTA_PATCH_MAGIC, DELTA_PATCH_MAGIC + DELTA_PATCH_MAGIC_SIZE)
+      , m_source_offset(0U)
+      , m_target_offset(0U)
+    {
+        Append_Integer(static_cast<uint32_t>(m_target.size()));
+    }
+
+    /// @brief Appends a record with the given lengths, that continues reconstructing the target image where the previous record ended
+    /// @param diff_length Amount of bytes that are added to the bytes read from the installed image
+    /// @param extra_length Amount of bytes that are copied as is
+    /// @param seek Offset the read position in the installed image is moved by afterwards
+    void Add_Record(const uint32_t& diff_length, const uint32_t& extra_length, const int32_t& seek) {
+        Append_Integer(diff_length);
+        Append_Integer(extra_length);
+        Append_Integer(static_cast<uint32_t>(seek));
+        for (size_t i = 0U; i < diff_length; i++) {
+            m_data.push_back(static_cast<uint8_t>(m_target.at(m_target_offset + i) - m_installed.at(m_source_offset + i)));
+        }
+        m_source_offset += diff_length;
+        m_target_offset += diff_length;
+        m_data.insert(m_data.end(), m_target.begin() + m_target_offset, m_target.begin() + m_target_offset + extra_length);
+        m_target_offset += extra_length;
+        m_source_offset += seek;
+    }
+
+    /// @brief Gets the built patch
+    /// @return Header and every record that has been added
+    std::vector<uint8_t>& Get_Data() {
+        return m_data;
+    }
+
+  private:
+    /// @brief Appends the given integer as 32-bit little endian
+    /// @param value Integer that should be appended
+    void Append_Integer(const uint32_t& value) {
+        for (size_t i = 0U; i < sizeof(value); i++) {
+            m_data.push_back(static_cast<uint8_t>(value >> (i * 8U)));
+        }
+    }
+
+    const std::vector<uint8_t>& m_installed; // Currently installed image the patch is applied to
+    const std::vector<uint8_t>& m_target;    // Image the patch should reconstruct
+    std::vector<uint8_t> m_data;             // Patch that has been built so far
+    size_t m_source_offset;                  // Read position in the installed image after the last record
+    size_t m_target_offset;                  // Amount of bytes of the target image the added records reconstruct
+};
+
+/// @brief Currently installed image every patch of the tests is applied to
+static std::vector<uint8_t> Installed_Image() {
+    std::vector<uint8_t> installed(INSTALLED_IMAGE_SIZE);
+    for (size_t i = 0U; i < installed.size(); i++) {
+        installed[i] = static_cast<uint8_t>((i * 13U) + (i >> 8U));
+    }
+    return installed;
+}
+
+/// @brief Hex checksum of the given image, as it would be set on the server
+static std::string Checksum(const std::vector<uint8_t>& image) {
+    HashGenerator hash;
+    hash.start(MBEDTLS_MD_SHA256);
+    (void)hash.update(image.data(), image.size());
+    uint8_t digest[MBEDTLS_MD_MAX_SIZE] = {};
+    const size_t digest_size = hash.get_hash(digest);
+    char hex[(MBEDTLS_MD_MAX_SIZE * 2U) + 1U] = {};
+    HashGenerator::encode_hex(digest, digest_size, hex);
+    return hex;
+}
+
+/// @brief Replays the given patch into the given updater in chunks of the given size, the same way the OTA_Handler passes received chunks
+/// @return Amount of bytes the updater has accepted, is smaller than the patch if the updater rejected it in write()
+template <size_t BufferSize>
+static size_t Write_Patch(Delta_Updater<BufferSize>& updater, std::vector<uint8_t> patch, const size_t& chunk_size) {
+    if (!updater.begin(patch.size())) {
+        return 0U;
+    }
+    size_t written = 0U;
+    while (written < patch.size()) {
+        const size_t size = std::min(chunk_size, patch.size() - written);
+        const size_t accepted = updater.write(patch.data() + written, size);
+        written += accepted;
+        if (accepted != size) {
+            break;
+        }
+    }
+    return written;
+}
+
+/// @brief Replays the given patch and ends the update
+/// @return Whether the patch was accepted completely and ending the update was successful
+template <size_t BufferSize>
+static bool Apply_Patch(Delta_Updater<BufferSize>& updater, const std::vector<uint8_t>& patch, const size_t& chunk_size) {
+    return Write_Patch(updater, patch, chunk_size) == patch.size() && updater.end();
+}
+
+TEST(Delta_Updater_Test, Header_And_Control_Records_Split_Across_Chunks) {
+    const std::vector<uint8_t> installed = Installed_Image();
+    std::vector<uint8_t> target;
+    for (size_t i = 0U; i < 600U; i++) {
+        target.push_back(static_cast<uint8_t>(installed[i] + (i % 3U)));
+    }
+    for (size_t i = 0U; i < 50U; i++) {
+        target.push_back(static_cast<uint8_t>(0xA5U ^ i));
+    }
+    for (size_t i = 600U; i < 900U; i++) {
+        target.push_back(static_cast<uint8_t>(installed[i] + 1U));
+    }
+    for (size_t i = 0U; i < 10U; i++) {
+        target.push_back(static_cast<uint8_t>(i));
+    }
+    Delta_Patch patch(installed, target);
+    patch.Add_Record(600U, 50U, 0);
+    patch.Add_Record(300U, 10U, 0);
+
+    // Chunk sizes that are not a multiple of the record size split the header and the control records at every possible position
+    const size_t chunk_sizes[] = { 1U, 5U, 7U, DELTA_RECORD_SIZE - 1U, DELTA_RECORD_SIZE + 1U, 4096U };
+    for (const size_t& chunk_size : chunk_sizes) {
+        RAM_Patch_Source source(installed.data(), installed.size());
+        std::vector<uint8_t> output(target.size());
+        RAM_Updater output_updater(output.data(), output.size());
+        Delta_Updater<> updater(source, output_updater);
+        EXPECT_TRUE(Apply_Patch(updater, patch.Get_Data(), chunk_size)) << "chunk size " << chunk_size;
+        EXPECT_EQ(output, target) << "chunk size " << chunk_size;
+    }
+}
+
+TEST(Delta_Updater_Test, Negative_Seek_Reads_Earlier_Part_Of_Installed_Image) {
+    const std::vector<uint8_t> installed = Installed_Image();
+    std::vector<uint8_t> target(installed.begin() + 512U, installed.begin() + 768U);
+    for (size_t i = 0U; i < 256U; i++) {
+        target.push_back(static_cast<uint8_t>(installed[i] ^ 0x0FU));
+    }
+    Delta_Patch patch(installed, target);
+    // Skip forward to the middle of the installed image, then jump back to its start once that part has been copied
+    patch.Add_Record(0U, 0U, 512);
+    patch.Add_Record(256U, 0U, -768);
+    patch.Add_Record(256U, 0U, 0);
+
+    RAM_Patch_Source source(installed.data(), installed.size());
+    std::vector<uint8_t> output(target.size());
+    RAM_Updater output_updater(output.data(), output.size());
+    Delta_Updater<> updater(source, output_updater);
+    EXPECT_TRUE(Apply_Patch(updater, patch.Get_Data(), 100U));
+    EXPECT_EQ(output, target);
+}
+
+TEST(Delta_Updater_Test, Diff_Longer_Than_Buffer_Is_Applied_In_Parts) {
+    constexpr size_t buffer_size = 16U;
+    const std::vector<uint8_t> installed = Installed_Image();
+    std::vector<uint8_t> target(installed);
+    for (size_t i = 0U; i < target.size(); i += 5U) {
+        target[i]++;
+    }
+    Delta_Patch patch(installed, target);
+    patch.Add_Record(static_cast<uint32_t>(target.size()), 0U, 0);
+
+    const size_t chunk_sizes[] = { 7U, buffer_size, 4096U };
+    for (const size_t& chunk_size : chunk_sizes) {
+        RAM_Patch_Source source(installed.data(), installed.size());
+        std::vector<uint8_t> output(target.size());
+        RAM_Updater output_updater(output.data(), output.size());
+        Delta_Updater<buffer_size> updater(source, output_updater);
+        EXPECT_TRUE(Apply_Patch(updater, patch.Get_Data(), chunk_size)) << "chunk size " << chunk_size;
+        EXPECT_EQ(output, target) << "chunk size " << chunk_size;
+    }
+}
+
+TEST(Delta_Updater_Test, Truncated_Patch_Is_Rejected) {
+    const std::vector<uint8_t> installed = Installed_Image();
+    std::vector<uint8_t> target(installed.begin(), installed.begin() + 200U);
+    target.push_back(0x42U);
+    Delta_Patch patch(installed, target);
+    patch.Add_Record(200U, 1U, 0);
+    const std::vector<uint8_t>& complete = patch.Get_Data();
+
+    // Ends inside of the header, inside of the control record, inside of the diff bytes and before the last extra byte
+    const size_t lengths[] = { 5U, DELTA_RECORD_SIZE + 6U, (2U * DELTA_RECORD_SIZE) + 100U, complete.size() - 1U };
+    for (const size_t& length : lengths) {
+        const std::vector<uint8_t> truncated(complete.begin(), complete.begin() + length);
+        RAM_Patch_Source source(installed.data(), installed.size());
+        std::vector<uint8_t> output(target.size());
+        RAM_Updater output_updater(output.data(), output.size());
+        Delta_Updater<> updater(source, output_updater);
+        EXPECT_EQ(Write_Patch(updater, truncated, 64U), truncated.size()) << "length " << length;
+        EXPECT_FALSE(updater.end()) << "length " << length;
+    }
+}
+
+TEST(Delta_Updater_Test, Oversized_Patch_Is_Rejected) {
+    const std::vector<uint8_t> installed = Installed_Image();
+    const std::vector<uint8_t> target(installed.begin(), installed.begin() + 200U);
+    Delta_Patch patch(installed, target);
+    patch.Add_Record(200U, 0U, 0);
+    const std::vector<uint8_t>& complete = patch.Get_Data();
+
+    // A record that would reconstruct more bytes than the header announced is rejected as soon as its control record has been received
+    std::vector<uint8_t> additional_record(complete);
+    const uint8_t record[DELTA_RECORD_SIZE + 1U] = { 0U, 0U, 0U, 0U, 1U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0xFFU };
+    additional_record.insert(additional_record.end(), record, record + sizeof(record));
+    {
+        RAM_Patch_Source source(installed.data(), installed.size());
+        std::vector<uint8_t> output(target.size());
+        RAM_Updater output_updater(output.data(), output.size());
+        Delta_Updater<> updater(source, output_updater);
+        EXPECT_EQ(Write_Patch(updater, additional_record, 4096U), complete.size());
+    }
+
+    // Trailing bytes that do not form a complete record are accepted while they are received, but fail the update once it ends
+    std::vector<uint8_t> trailing_bytes(complete);
+    trailing_bytes.insert(trailing_bytes.end(), 3U, 0U);
+    {
+        RAM_Patch_Source source(installed.data(), installed.size());
+        std::vector<uint8_t> output(target.size());
+        RAM_Updater output_updater(output.data(), output.size());
+        Delta_Updater<> updater(source, output_updater);
+        EXPECT_EQ(Write_Patch(updater, trailing_bytes, 4096U), trailing_bytes.size());
+        EXPECT_FALSE(updater.end());
+    }
+}
+
+TEST(Delta_Updater_Test, Target_Checksum_Is_Verified) {
+    const std::vector<uint8_t> installed = Installed_Image();
+    std::vector<uint8_t> target(installed.begin(), installed.begin() + 300U);
+    target[150U] ^= 0xFFU;
+    Delta_Patch patch(installed, target);
+    patch.Add_Record(300U, 0U, 0);
+
+    std::string mismatching = Checksum(target);
+    mismatching[0U] = mismatching[0U] == '0' ? '1' : '0';
+    const std::string checksums[] = { Checksum(target), mismatching };
+    for (const std::string& checksum : checksums) {
+        RAM_Patch_Source source(installed.data(), installed.size());
+        std::vector<uint8_t> output(target.size());
+        RAM_Updater output_updater(output.data(), output.size());
+        Delta_Updater<> updater(source, output_updater);
+        ASSERT_TRUE(updater.Set_Target_Checksum(MBEDTLS_MD_SHA256, checksum.c_str()));
+        EXPECT_EQ(Apply_Patch(updater, patch.Get_Data(), 128U), checksum != mismatching);
+        // The reconstructed image is written either way, only ending the update decides whether it is used
+        EXPECT_EQ(output, target);
+    }
+}
+
+TEST(Delta_Updater_Test, Invalid_Target_Checksum_Disables_Check) {
+    const std::vector<uint8_t> installed = Installed_Image();
+    const std::vector<uint8_t> target(installed.begin(), installed.begin() + 100U);
+    Delta_Patch patch(installed, target);
+    patch.Add_Record(100U, 0U, 0);
+
+    RAM_Patch_Source source(installed.data(), installed.size());
+    std::vector<uint8_t> output(target.size());
+    RAM_Updater output_updater(output.data(), output.size());
+    Delta_Updater<> updater(source, output_updater);
+    EXPECT_FALSE(updater.Set_Target_Checksum(MBEDTLS_MD_SHA256, "not a checksum"));
+    EXPECT_TRUE(Apply_Patch(updater, patch.Get_Data(), 128U));
+}
@@ -0,0 +1,47 @@
+// Local includes.
+#include "Inplace_Function.h"
+
+// Library includes.
+#include <gtest/gtest.h>
+#include <string>
+
+/// @brief Type that can not be called at all
+struct Not_Callable {};
+
+// The constructor is only viable for callable objects matching the signature, any other type has to be rejected by overload resolution
+static_assert(std::is_constructible<Inplace_Function<bool(int)>, bool(*)(int)>::value, "Function pointer with the same signature has to be accepted");
+static_assert(std::is_constructible<Inplace_Function<void(int)>, int(*)(int)>::value, "Result of a function that returns void has to be discarded");
+static_assert(std::is_constructible<Inplace_Function<long(int)>, int(*)(int)>::value, "Result convertible into the return type has to be accepted");
+static_assert(!std::is_constructible<Inplace_Function<bool(int)>, Not_Callable>::value, "Type that is not callable has to be rejected");
+static_assert(!std::is_constructible<Inplace_Function<bool(int)>, int>::value, "Type that is not callable has to be rejected");
+static_assert(!std::is_constructible<Inplace_Function<bool(int)>, void(*)(std::string)>::value, "Callable object with different argument types has to be rejected");
+static_assert(!std::is_constructible<Inplace_Function<std::string(int)>, int(*)(int)>::value, "Callable object with a result that is not convertible has to be rejected");
+
+static int Increment(int value) {
+    return value + 1;
+}
+
+TEST(Inplace_Function_Test, Calls_Stored_Lambda) {
+    int offset = 2;
+    const Inplace_Function<int(int)> function([&offset](int value) { return value + offset; });
+    ASSERT_TRUE(static_cast<bool>(function));
+    EXPECT_EQ(function(1), 3);
+}
+
+TEST(Inplace_Function_Test, Null_Function_Pointer_Is_Empty) {
+    int (*pointer)(int) = nullptr;
+    const Inplace_Function<int(int)> empty(pointer);
+    EXPECT_FALSE(static_cast<bool>(empty));
+    const Inplace_Function<int(int)> function(&Increment);
+    EXPECT_EQ(function(1), 2);
+}
+
+TEST(Inplace_Function_Test, Copies_And_Moves_Stored_Object) {
+    const std::string suffix = "!";
+    Inplace_Function<std::string(const std::string&)> function([suffix](const std::string& text) { return text + suffix; });
+    const Inplace_Function<std::string(const std::string&)> copy(function);
+    const Inplace_Function<std::string(const std::string&)> moved(std::move(function));
+    EXPECT_FALSE(static_cast<bool>(function));
+    EXPECT_EQ(copy("a"), "a!");
+    EXPECT_EQ(moved("b"), "b!");
+}
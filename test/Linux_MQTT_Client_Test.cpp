@@ -0,0 +1,352 @@
+// Local includes.
+#include "Fake_Clock.h"
+#include "Linux_MQTT_Client.h"
+
+// Library includes.
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <netinet/in.h>
+#include <string.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+constexpr char BROKER_ADDRESS[] = "127.0.0.1";
+constexpr char CLIENT_ID[] = "loopback";
+constexpr char ACCESS_TOKEN[] = "token";
+constexpr char TELEMETRY_TOPIC[] = "v1/devices/me/telemetry";
+constexpr char ATTRIBUTE_TOPIC[] = "v1/devices/me/attributes";
+constexpr char TELEMETRY_PAYLOAD[] = "{\"temperature\":23}";
+constexpr std::chrono::milliseconds EXPECTATION_TIMEOUT(2000);
+
+/// @brief Message received by the Loopback_Broker or by the Linux_MQTT_Client
+struct Received_Message {
+    std::string topic;
+    std::string payload;
+};
+
+/// @brief Minimal MQTT 3.1.1 broker listening on the loopback interface, that accepts a single connection on a background thread.
+/// Answers CONNECT, SUBSCRIBE and PINGREQ like a real broker, records every received PUBLISH and sends it back if the client has subscribed the exact same topic.
+/// Allows testing the Linux_MQTT_Client against real sockets without requiring an installed broker like mosquitto
+class Loopback_Broker {
+  public:
+    /// @brief Constructor, starts listening on a free port of the loopback interface
+    /// @param connack_return_code Return code of the CONNACK the broker answers the CONNECT with, 0 accepts the connection
+    explicit Loopback_Broker(const uint8_t& connack_return_code = 0U)
+      : m_connack_return_code(connack_return_code)
+      , m_listener(socket(AF_INET, SOCK_STREAM, 0))
+      , m_connection(-1)
+      , m_port(0U)
+      , m_mutex()
+      , m_client_id()
+      , m_user_name()
+      , m_published()
+      , m_subscribed()
+      , m_pings(0U)
+      , m_thread()
+    {
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if (bind(m_listener, reinterpret_cast<sockaddr *>(&address), length) != 0 || listen(m_listener, 1) != 0 ||
+            getsockname(m_listener, reinterpret_cast<sockaddr *>(&address), &length) != 0) {
+            return;
+        }
+        m_port = ntohs(address.sin_port);
+        m_thread = std::thread(&Loopback_Broker::Run, this);
+    }
+
+    /// @brief Destructor, closes the connection and waits for the background thread to finish
+    ~Loopback_Broker() {
+        shutdown(m_listener, SHUT_RDWR);
+        Close_Connection();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        close(m_listener);
+        if (m_connection >= 0) {
+            close(m_connection);
+        }
+    }
+
+    /// @brief Gets the port the broker listens on
+    /// @return Port on the loopback interface, 0 if listening failed
+    uint16_t Get_Port() const {
+        return m_port;
+    }
+
+    /// @brief Closes the connection from the side of the broker, without sending any control packet beforehand
+    void Close_Connection() {
+        const int connection = m_connection;
+        if (connection >= 0) {
+            shutdown(connection, SHUT_RDWR);
+        }
+    }
+
+    /// @brief Gets the client id of the received CONNECT
+    std::string Get_Client_Id() {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        return m_client_id;
+    }
+
+    /// @brief Gets the user name of the received CONNECT, which ThingsBoard expects the access token in
+    std::string Get_User_Name() {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        return m_user_name;
+    }
+
+    /// @brief Gets every PUBLISH received so far
+    std::vector<Received_Message> Get_Published() {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        return m_published;
+    }
+
+    /// @brief Gets the amount of PINGREQ answered so far
+    size_t Get_Ping_Count() const {
+        return m_pings;
+    }
+
+  private:
+    /// @brief Accepts a single connection and handles its control packets until it has been closed
+    void Run() {
+        m_connection = accept(m_listener, nullptr, nullptr);
+        if (m_connection < 0) {
+            return;
+        }
+        uint8_t header = 0U;
+        std::vector<uint8_t> body;
+        while (Read_Packet(header, body)) {
+            Handle_Packet(header, body);
+        }
+    }
+
+    /// @brief Reads exactly the given amount of bytes from the connection
+    bool Read_Exactly(uint8_t *buffer, const size_t& size) {
+        size_t received = 0U;
+        while (received < size) {
+            const ssize_t result = recv(m_connection, buffer + received, size - received, 0);
+            if (result <= 0) {
+                return false;
+            }
+            received += static_cast<size_t>(result);
+        }
+        return true;
+    }
+
+    /// @brief Reads the fixed header and the remaining length of the next control packet, followed by its variable header and payload
+    bool Read_Packet(uint8_t& header, std::vector<uint8_t>& body) {
+        if (!Read_Exactly(&header, 1U)) {
+            return false;
+        }
+        size_t remaining_length = 0U;
+        uint8_t encoded = 0U;
+        size_t multiplier = 1U;
+        do {
+            if (!Read_Exactly(&encoded, 1U)) {
+                return false;
+            }
+            remaining_length += (encoded & 0x7FU) * multiplier;
+            multiplier *= 128U;
+        } while ((encoded & 0x80U) != 0U);
+        body.resize(remaining_length);
+        return remaining_length == 0U || Read_Exactly(body.data(), remaining_length);
+    }
+
+    /// @brief Sends the given control packet, the remaining length is always encoded in a single byte, which is enough for the test messages
+    void Send_Packet(const uint8_t& header, const std::vector<uint8_t>& body) {
+        std::vector<uint8_t> packet = { header, static_cast<uint8_t>(body.size()) };
+        packet.insert(packet.end(), body.begin(), body.end());
+        (void)send(m_connection, packet.data(), packet.size(), MSG_NOSIGNAL);
+    }
+
+    /// @brief Reads a string with a two byte length prefix from the given position of the body
+    static std::string Read_String(const std::vector<uint8_t>& body, size_t& position) {
+        if (position + 2U > body.size()) {
+            return std::string();
+        }
+        const size_t length = (body[position] << 8U) | body[position + 1U];
+        position += 2U;
+        const size_t end = std::min(body.size(), position + length);
+        std::string text(body.begin() + position, body.begin() + end);
+        position = end;
+        return text;
+    }
+
+    /// @brief Answers and records the given control packet
+    void Handle_Packet(const uint8_t& header, const std::vector<uint8_t>& body) {
+        switch (header & 0xF0U) {
+            case 0x10U: {
+                // The variable header of CONNECT is always 10 bytes, the connect flags are the 8th byte
+                if (body.size() < 10U) {
+                    break;
+                }
+                size_t position = 10U;
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                m_client_id = Read_String(body, position);
+                if ((body[7U] & 0x80U) != 0U) {
+                    m_user_name = Read_String(body, position);
+                }
+                Send_Packet(0x20U, { 0U, m_connack_return_code });
+                break;
+            }
+            case 0x30U: {
+                size_t position = 0U;
+                Received_Message message;
+                message.topic = Read_String(body, position);
+                message.payload.assign(body.begin() + position, body.end());
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                m_published.push_back(message);
+                if (std::find(m_subscribed.begin(), m_subscribed.end(), message.topic) != m_subscribed.end()) {
+                    Send_Packet(header, body);
+                }
+                break;
+            }
+            case 0x80U: {
+                size_t position = 2U;
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                m_subscribed.push_back(Read_String(body, position));
+                Send_Packet(0x90U, { body[0U], body[1U], 0U });
+                break;
+            }
+            case 0xC0U:
+                // Counted after the PINGRESP has been sent, which ensures it can already be read by the client once the ping has been counted
+                Send_Packet(0xD0U, {});
+                m_pings++;
+                break;
+            default:
+                break;
+        }
+    }
+
+    const uint8_t                 m_connack_return_code; // Return code the CONNECT is answered with
+    const int                     m_listener;            // Socket listening on the loopback interface
+    std::atomic<int>              m_connection;          // Socket of the accepted connection, -1 until the client has connected
+    uint16_t                      m_port;                // Port the broker listens on
+    std::mutex                    m_mutex;               // Protects the recorded state, which is written by the background thread
+    std::string                   m_client_id;           // Client id of the received CONNECT
+    std::string                   m_user_name;           // User name of the received CONNECT
+    std::vector<Received_Message> m_published;           // Every received PUBLISH
+    std::vector<std::string>      m_subscribed;          // Every subscribed topic
+    std::atomic<size_t>           m_pings;               // Amount of received PINGREQ
+    std::thread                   m_thread;              // Background thread accepting and handling the connection
+};
+
+/// @brief Calls loop() of the given client until the given condition is met or the expectation timeout has passed, while waiting for received data in between
+template <typename Condition>
+static bool Loop_Until(Linux_MQTT_Client& client, const Condition& condition) {
+    const auto deadline = std::chrono::steady_clock::now() + EXPECTATION_TIMEOUT;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        (void)client.wait(10);
+        (void)client.loop();
+    }
+    return true;
+}
+
+TEST(Linux_MQTT_Client_Test, Connects_And_Publishes) {
+    Loopback_Broker broker;
+    ASSERT_NE(broker.Get_Port(), 0U);
+    Linux_MQTT_Client client;
+    client.set_server(BROKER_ADDRESS, broker.Get_Port());
+    ASSERT_TRUE(client.connect(CLIENT_ID, ACCESS_TOKEN, nullptr));
+    EXPECT_TRUE(client.connected());
+    EXPECT_GE(client.get_file_descriptor(), 0);
+    EXPECT_EQ(broker.Get_Client_Id(), CLIENT_ID);
+    EXPECT_EQ(broker.Get_User_Name(), ACCESS_TOKEN);
+
+    ASSERT_TRUE(client.publish(TELEMETRY_TOPIC, reinterpret_cast<const uint8_t *>(TELEMETRY_PAYLOAD), strlen(TELEMETRY_PAYLOAD)));
+    ASSERT_TRUE(Loop_Until(client, [&broker]() { return !broker.Get_Published().empty(); }));
+    const std::vector<Received_Message> published = broker.Get_Published();
+    ASSERT_EQ(published.size(), 1U);
+    EXPECT_EQ(published.front().topic, TELEMETRY_TOPIC);
+    EXPECT_EQ(published.front().payload, TELEMETRY_PAYLOAD);
+
+    client.disconnect();
+    EXPECT_FALSE(client.connected());
+    EXPECT_EQ(client.get_file_descriptor(), -1);
+}
+
+TEST(Linux_MQTT_Client_Test, Receives_Messages_Of_Subscribed_Topics) {
+    Loopback_Broker broker;
+    ASSERT_NE(broker.Get_Port(), 0U);
+    Linux_MQTT_Client client;
+    std::vector<Received_Message> received;
+    client.set_callback([&received](char *topic, uint8_t *payload, unsigned int length) {
+        received.push_back({ topic, std::string(reinterpret_cast<const char *>(payload), length) });
+    });
+    client.set_server(BROKER_ADDRESS, broker.Get_Port());
+    ASSERT_TRUE(client.connect(CLIENT_ID, ACCESS_TOKEN, nullptr));
+    ASSERT_TRUE(client.subscribe(ATTRIBUTE_TOPIC));
+
+    ASSERT_TRUE(client.publish(TELEMETRY_TOPIC, reinterpret_cast<const uint8_t *>(TELEMETRY_PAYLOAD), strlen(TELEMETRY_PAYLOAD)));
+    ASSERT_TRUE(client.publish(ATTRIBUTE_TOPIC, reinterpret_cast<const uint8_t *>(TELEMETRY_PAYLOAD), strlen(TELEMETRY_PAYLOAD)));
+    ASSERT_TRUE(Loop_Until(client, [&received]() { return !received.empty(); }));
+    ASSERT_EQ(received.size(), 1U);
+    EXPECT_EQ(received.front().topic, ATTRIBUTE_TOPIC);
+    EXPECT_EQ(received.front().payload, TELEMETRY_PAYLOAD);
+}
+
+TEST(Linux_MQTT_Client_Test, Rejects_Refused_Connection) {
+    // Return code 5 of the CONNACK means the client is not authorized to connect, which ThingsBoard answers an unknown access token with
+    Loopback_Broker broker(5U);
+    ASSERT_NE(broker.Get_Port(), 0U);
+    Linux_MQTT_Client client;
+    client.set_server(BROKER_ADDRESS, broker.Get_Port());
+    EXPECT_FALSE(client.connect(CLIENT_ID, ACCESS_TOKEN, nullptr));
+    EXPECT_FALSE(client.connected());
+    EXPECT_EQ(client.get_file_descriptor(), -1);
+}
+
+TEST(Linux_MQTT_Client_Test, Detects_Connection_Closed_By_Broker) {
+    Loopback_Broker broker;
+    ASSERT_NE(broker.Get_Port(), 0U);
+    Linux_MQTT_Client client;
+    client.set_server(BROKER_ADDRESS, broker.Get_Port());
+    ASSERT_TRUE(client.connect(CLIENT_ID, ACCESS_TOKEN, nullptr));
+
+    broker.Close_Connection();
+    EXPECT_TRUE(Loop_Until(client, [&client]() { return !client.connected(); }));
+    EXPECT_FALSE(client.publish(TELEMETRY_TOPIC, reinterpret_cast<const uint8_t *>(TELEMETRY_PAYLOAD), strlen(TELEMETRY_PAYLOAD)));
+}
+
+TEST(Linux_MQTT_Client_Test, Refuses_Messages_Bigger_Than_Buffer) {
+    Loopback_Broker broker;
+    ASSERT_NE(broker.Get_Port(), 0U);
+    Linux_MQTT_Client client;
+    ASSERT_TRUE(client.set_buffer_size(32U));
+    client.set_server(BROKER_ADDRESS, broker.Get_Port());
+    ASSERT_TRUE(client.connect(CLIENT_ID, ACCESS_TOKEN, nullptr));
+    EXPECT_FALSE(client.publish(TELEMETRY_TOPIC, reinterpret_cast<const uint8_t *>(TELEMETRY_PAYLOAD), strlen(TELEMETRY_PAYLOAD)));
+    EXPECT_TRUE(client.connected());
+}
+
+TEST(Linux_MQTT_Client_Test, Sends_Keep_Alive_Pings) {
+    // The keep alive mechanism is based on Helper::getMicroseconds(), therefore the simulated clock allows to let the keep alive timeout pass without waiting for it
+    Fake_Clock::Install();
+    Fake_Clock::Set(0U);
+    Loopback_Broker broker;
+    ASSERT_NE(broker.Get_Port(), 0U);
+    Linux_MQTT_Client client;
+    client.set_keep_alive_timeout(1U);
+    client.set_server(BROKER_ADDRESS, broker.Get_Port());
+    ASSERT_TRUE(client.connect(CLIENT_ID, ACCESS_TOKEN, nullptr));
+
+    // Every answered PINGREQ keeps the connection alive, while another one is sent once the keep alive timeout has passed again,
+    // the PINGRESP of the previous ping is read by the same call to loop() that sends the next one
+    for (size_t ping = 1U; ping <= 3U; ping++) {
+        Fake_Clock::Advance(1000U * 1000U);
+        EXPECT_TRUE(client.loop());
+        EXPECT_TRUE(Loop_Until(client, [&broker, &ping]() { return broker.Get_Ping_Count() == ping; }));
+    }
+    EXPECT_TRUE(client.connected());
+    Fake_Clock::Uninstall();
+}
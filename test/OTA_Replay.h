@@ -0,0 +1,166 @@
+#ifndef OTA_Replay_h
+#define OTA_Replay_h
+
+// Local includes.
+#include "Fake_Clock.h"
+#include "Fake_MQTT_Client.h"
+#include "HashGenerator.h"
+#include "OTA_Handler.h"
+#include "RAM_Updater.h"
+#include "Silent_Logger.h"
+#include "Timer_Wheel.h"
+
+// Library includes.
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+
+/// @brief Result of replaying a complete OTA update
+struct OTA_Replay_Result {
+    bool     finished;       // Whether the update has ended before the simulated time limit has been reached
+    bool     success;        // Whether the update has reported success to the user callback
+    bool     matches;        // Whether the written binary is byte for byte the same as the served one
+    uint64_t simulated_time; // Simulated microseconds the update took
+    size_t   chunk_requests; // Amount of chunk requests that have reached the simulated server
+    size_t   lost_messages;  // Amount of messages that have been lost in either direction
+};
+
+/// @brief Replays a complete OTA update of a generated binary between an OTA_Handler and a simulated server, connected over the Fake_MQTT_Client and driven by the Fake_Clock.
+/// The handler requests the chunks over the same topics as the ThingsBoard class, while the simulated server answers every chunk request with the requested part of the binary.
+/// Because the handler is used directly, the attribute request that normally starts the update is skipped, which keeps the replay independent of the JSON payloads
+class OTA_Replay {
+  public:
+    /// @brief Constructor, generates the binary and connects the handler to the simulated server
+    /// @param binary_size Size of the binary that is served
+    /// @param chunk_size Size of the chunks the binary is requested in
+    /// @param timeout Timeout in microseconds until a chunk is requested again
+    /// @param chunk_retries Amount of retries per chunk, until the update fails
+    OTA_Replay(const size_t& binary_size, const uint16_t& chunk_size, const uint64_t& timeout, const uint8_t& chunk_retries = CHUNK_RETRIES)
+      : m_binary(binary_size)
+      // One additional byte ensures the updater receives valid memory even for an empty binary, where data() of an empty vector might be a nullptr
+      , m_written(binary_size + 1U)
+      , m_checksum()
+      , m_client()
+      , m_timer_wheel()
+      , m_updater(m_written.data(), m_written.size())
+      , m_callback([this](const bool& success) { m_finished = true; m_success = success; }, "replay", "1.0", &m_updater, chunk_retries, chunk_size, timeout)
+      , m_handler(m_timer_wheel, [this](const size_t& chunk) { return Request_Chunk(chunk); }, [](const char *, const char *) { return true; }, []() { return true; })
+      , m_finished(false)
+      , m_success(false)
+      , m_chunk_requests(0U)
+    {
+        for (size_t i = 0U; i < m_binary.size(); i++) {
+            m_binary[i] = static_cast<uint8_t>((i * 7U) + (i >> 11U));
+        }
+        HashGenerator hash;
+        hash.start(MBEDTLS_MD_SHA256);
+        (void)hash.update(m_binary.data(), m_binary.size());
+        uint8_t digest[MBEDTLS_MD_MAX_SIZE] = {};
+        const size_t digest_size = hash.get_hash(digest);
+        char hex[(MBEDTLS_MD_MAX_SIZE * 2U) + 1U] = {};
+        HashGenerator::encode_hex(digest, digest_size, hex);
+        m_checksum = hex;
+
+        // Every replay starts at the same simulated time, because the timer wheel rounds the timeouts to its ticks, which would otherwise change the timing between replays.
+        // Resetting the time is safe, because the timer wheel of the replay is constructed new and has not processed any tick yet
+        Fake_Clock::Install();
+        Fake_Clock::Set(0U);
+        m_client.set_buffer_size(chunk_size + 64U);
+        m_client.set_callback([this](char *topic, uint8_t *payload, unsigned int length) {
+            unsigned int chunk = 0U;
+            if (sscanf(topic, "v2/fw/response/0/chunk/%u", &chunk) == 1) {
+                m_handler.Process_Packet(chunk, payload, length);
+            }
+        });
+        m_client.set_responder([this](Fake_MQTT_Client& client, const char *topic, const uint8_t *payload, const size_t& length) {
+            unsigned int chunk = 0U;
+            if (sscanf(topic, "v2/fw/request/0/chunk/%u", &chunk) != 1) {
+                return;
+            }
+            m_chunk_requests++;
+            const size_t requested_size = strtoul(std::string(reinterpret_cast<const char *>(payload), length).c_str(), nullptr, 10);
+            const size_t start = std::min(m_binary.size(), requested_size * chunk);
+            char response_topic[64U] = {};
+            snprintf(response_topic, sizeof(response_topic), "v2/fw/response/0/chunk/%u", chunk);
+            client.deliver(response_topic, m_binary.data() + start, std::min(requested_size, m_binary.size() - start));
+        });
+        (void)m_client.connect("replay", nullptr, nullptr);
+        (void)m_client.subscribe("v2/fw/response/0/chunk/+");
+    }
+
+    /// @brief Gets the simulated connection, allows to configure its impairments before the replay is started
+    /// @return Simulated connection between the handler and the server
+    Fake_MQTT_Client& Get_Client() {
+        return m_client;
+    }
+
+    /// @brief Gets the callback the update is started with, allows to configure it before the replay is started
+    /// @return Configuration of the update
+    OTA_Update_Callback& Get_Callback() {
+        return m_callback;
+    }
+
+    /// @brief Gets the updater the received binary is written into, allows to wrap it in a decorator that is then set as the updater of the callback
+    /// @return Updater writing the received binary into memory
+    RAM_Updater& Get_Updater() {
+        return m_updater;
+    }
+
+    /// @brief Gets the served binary
+    /// @return Binary the simulated server answers the chunk requests with
+    const std::vector<uint8_t>& Get_Binary() const {
+        return m_binary;
+    }
+
+    /// @brief Starts the update and advances the simulated time in steps of the given size, until the update has ended or the given limit has been reached
+    /// @param step Simulated microseconds that pass between two calls to loop() and Timer_Wheel::Process()
+    /// @param limit Simulated microseconds after which the replay is aborted
+    /// @return Result of the replay
+    OTA_Replay_Result Run(const uint64_t& step = 1000U, const uint64_t& limit = 3600U * 1000U * 1000U) {
+        const uint64_t start = Fake_Clock::Now();
+        m_handler.Start_Update(&m_callback, m_binary.size(), "SHA256", m_checksum.c_str(), MBEDTLS_MD_SHA256);
+        while (!m_finished && Fake_Clock::Now() - start < limit) {
+            (void)m_client.loop();
+            m_timer_wheel.Process();
+            Fake_Clock::Advance(step);
+        }
+
+        OTA_Replay_Result result = {};
+        result.finished = m_finished;
+        result.success = m_success;
+        result.matches = m_updater.Get_Size() == m_binary.size() && std::equal(m_binary.begin(), m_binary.end(), m_written.begin());
+        result.simulated_time = Fake_Clock::Now() - start;
+        result.chunk_requests = m_chunk_requests;
+        result.lost_messages = m_client.get_lost_count();
+        return result;
+    }
+
+  private:
+    /// @brief Publishes the request for the given chunk, the same way the ThingsBoard class does
+    /// @param chunk Index of the requested chunk
+    /// @return Whether publishing the request was successful or not
+    bool Request_Chunk(const size_t& chunk) {
+        char topic[64U] = {};
+        snprintf(topic, sizeof(topic), "v2/fw/request/0/chunk/%zu", chunk);
+        char payload[8U] = {};
+        const int length = snprintf(payload, sizeof(payload), "%u", m_callback.Get_Chunk_Size());
+        return m_client.publish(topic, reinterpret_cast<const uint8_t *>(payload), length);
+    }
+
+    std::vector<uint8_t>        m_binary;         // Binary served by the simulated server
+    std::vector<uint8_t>        m_written;        // Memory the updater writes the received binary into
+    std::string                 m_checksum;       // SHA-256 of the binary as a hex string
+    Fake_MQTT_Client            m_client;         // Simulated connection between the handler and the server
+    Timer_Wheel                 m_timer_wheel;    // Timer wheel the chunk timeouts of the handler are scheduled on
+    RAM_Updater                 m_updater;        // Updater writing the received binary into memory
+    OTA_Update_Callback         m_callback;       // Configuration of the update
+    OTA_Handler<Silent_Logger>  m_handler;        // Handler under test
+    bool                        m_finished;       // Whether the update has ended
+    bool                        m_success;        // Whether the update has reported success
+    size_t                      m_chunk_requests; // Amount of chunk requests that have reached the simulated server
+};
+
+#endif // OTA_Replay_h
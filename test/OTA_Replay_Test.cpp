@@ -0,0 +1,157 @@
+// Local includes.
+#include "Heatshrink_Updater.h"
+#include "Helper.h"
+#include "OTA_Replay.h"
+#include "Page_Buffered_Updater.h"
+
+// Library includes.
+#include <gtest/gtest.h>
+
+constexpr size_t REPLAY_BINARY_SIZE = 2U * 1024U * 1024U;
+constexpr uint16_t REPLAY_CHUNK_SIZE = 4U * 1024U;
+constexpr uint64_t REPLAY_TIMEOUT = 5U * 1000U * 1000U;
+constexpr uint64_t REPLAY_MINIMUM_LATENCY = 20U * 1000U;
+constexpr uint64_t REPLAY_MAXIMUM_LATENCY = 80U * 1000U;
+constexpr float REPLAY_LOSS_RATE = 0.05f;
+
+TEST(OTA_Replay_Test, Completes_Without_Loss) {
+    OTA_Replay replay(REPLAY_BINARY_SIZE, REPLAY_CHUNK_SIZE, REPLAY_TIMEOUT);
+    replay.Get_Client().set_latency(REPLAY_MINIMUM_LATENCY, REPLAY_MAXIMUM_LATENCY);
+    const OTA_Replay_Result result = replay.Run();
+    EXPECT_TRUE(result.finished);
+    EXPECT_TRUE(result.success);
+    EXPECT_TRUE(result.matches);
+    EXPECT_EQ(result.lost_messages, 0U);
+    // Without any loss no chunk has to be requested more than once, meaning no timeout may have passed either
+    EXPECT_LT(result.simulated_time, REPLAY_TIMEOUT * 100U);
+}
+
+TEST(OTA_Replay_Test, Completes_Under_Loss) {
+    for (uint32_t seed = 1U; seed <= 5U; seed++) {
+        OTA_Replay replay(REPLAY_BINARY_SIZE, REPLAY_CHUNK_SIZE, REPLAY_TIMEOUT);
+        replay.Get_Client().set_seed(seed);
+        replay.Get_Client().set_latency(REPLAY_MINIMUM_LATENCY, REPLAY_MAXIMUM_LATENCY);
+        replay.Get_Client().set_loss_rate(REPLAY_LOSS_RATE);
+        const OTA_Replay_Result result = replay.Run();
+        EXPECT_TRUE(result.finished) << "seed " << seed;
+        EXPECT_TRUE(result.success) << "seed " << seed;
+        EXPECT_TRUE(result.matches) << "seed " << seed;
+        EXPECT_GT(result.lost_messages, 0U) << "seed " << seed;
+    }
+}
+
+TEST(OTA_Replay_Test, Completes_Under_Reordering) {
+    OTA_Replay replay(REPLAY_BINARY_SIZE, REPLAY_CHUNK_SIZE, REPLAY_TIMEOUT);
+    replay.Get_Client().set_latency(REPLAY_MINIMUM_LATENCY, REPLAY_MAXIMUM_LATENCY);
+    replay.Get_Client().set_loss_rate(REPLAY_LOSS_RATE);
+    // Held back responses arrive after the chunk has already been requested again, which the handler has to discard
+    replay.Get_Client().set_reorder_rate(0.1f, REPLAY_TIMEOUT + REPLAY_MAXIMUM_LATENCY);
+    const OTA_Replay_Result result = replay.Run();
+    EXPECT_TRUE(result.success);
+    EXPECT_TRUE(result.matches);
+}
+
+TEST(OTA_Replay_Test, Same_Seed_Replays_Identically) {
+    OTA_Replay_Result results[2U] = {};
+    for (OTA_Replay_Result& result : results) {
+        OTA_Replay replay(REPLAY_BINARY_SIZE, REPLAY_CHUNK_SIZE, REPLAY_TIMEOUT);
+        replay.Get_Client().set_seed(42U);
+        replay.Get_Client().set_latency(REPLAY_MINIMUM_LATENCY, REPLAY_MAXIMUM_LATENCY);
+        replay.Get_Client().set_loss_rate(REPLAY_LOSS_RATE);
+        result = replay.Run();
+    }
+    EXPECT_EQ(results[0U].simulated_time, results[1U].simulated_time);
+    EXPECT_EQ(results[0U].chunk_requests, results[1U].chunk_requests);
+    EXPECT_EQ(results[0U].lost_messages, results[1U].lost_messages);
+}
+
+TEST(OTA_Replay_Test, Fails_Once_Retries_Are_Exhausted) {
+    constexpr uint64_t timeout = 100U * 1000U;
+    constexpr uint8_t retries = 3U;
+    OTA_Replay replay(16U * 1024U, REPLAY_CHUNK_SIZE, timeout, retries);
+    replay.Get_Client().set_loss_rate(1.0f);
+    const OTA_Replay_Result result = replay.Run();
+    EXPECT_TRUE(result.finished);
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.chunk_requests, 0U);
+    // The first request and every retry each wait for the complete timeout, which the timer wheel may exceed by one tick
+    EXPECT_GE(result.simulated_time, (retries + 1U) * timeout);
+    EXPECT_LE(result.simulated_time, (retries + 1U) * (timeout + 20U * 1000U));
+}
+
+TEST(OTA_Replay_Test, Requests_Each_Chunk_Once) {
+    // Binary sizes that are a multiple of the chunk size may not request an additional empty chunk past the end of the binary
+    const size_t sizes[] = { REPLAY_BINARY_SIZE, REPLAY_BINARY_SIZE - 1U, REPLAY_BINARY_SIZE + 1U, REPLAY_CHUNK_SIZE, 1U };
+    for (const size_t& size : sizes) {
+        OTA_Replay replay(size, REPLAY_CHUNK_SIZE, REPLAY_TIMEOUT);
+        const OTA_Replay_Result result = replay.Run();
+        EXPECT_TRUE(result.success) << "size " << size;
+        EXPECT_TRUE(result.matches) << "size " << size;
+        EXPECT_EQ(result.chunk_requests, (size + REPLAY_CHUNK_SIZE - 1U) / REPLAY_CHUNK_SIZE) << "size " << size;
+    }
+}
+
+TEST(OTA_Replay_Test, Empty_Binary_Requests_Single_Chunk) {
+    OTA_Replay replay(0U, REPLAY_CHUNK_SIZE, REPLAY_TIMEOUT);
+    const OTA_Replay_Result result = replay.Run();
+    EXPECT_TRUE(result.finished);
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.chunk_requests, 1U);
+}
+
+TEST(OTA_Replay_Test, Written_Data_Is_Hashed_Through_Page_Buffer) {
+    // Chunks that are not a multiple of the page size leave a partially filled last page, which has to be written before the data is read back
+    OTA_Replay replay(REPLAY_BINARY_SIZE + 123U, 1000U, REPLAY_TIMEOUT);
+    Page_Buffered_Updater<> updater(replay.Get_Updater());
+    replay.Get_Callback().Set_Updater(&updater);
+    replay.Get_Callback().Set_Hash_Mode(OTA_Hash_Mode::WRITTEN_DATA);
+    const OTA_Replay_Result result = replay.Run();
+    EXPECT_TRUE(result.success);
+    EXPECT_TRUE(result.matches);
+    EXPECT_EQ(result.chunk_requests, (REPLAY_BINARY_SIZE + 123U + 999U) / 1000U);
+}
+
+TEST(OTA_Replay_Test, Written_Data_Is_Rejected_By_Transforming_Updater) {
+    OTA_Replay replay(REPLAY_BINARY_SIZE, REPLAY_CHUNK_SIZE, REPLAY_TIMEOUT);
+    Heatshrink_Updater<> updater(replay.Get_Updater());
+    replay.Get_Callback().Set_Updater(&updater);
+    replay.Get_Callback().Set_Hash_Mode(OTA_Hash_Mode::WRITTEN_DATA);
+    const OTA_Replay_Result result = replay.Run();
+    // The update has to fail before the first chunk is requested, instead of only once the complete binary has been downloaded
+    EXPECT_TRUE(result.finished);
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.chunk_requests, 0U);
+    EXPECT_LT(result.simulated_time, REPLAY_TIMEOUT);
+}
+
+TEST(OTA_Replay_Test, Chunk_Checksums_Are_Verified) {
+    OTA_Replay replay(16U * 1024U, REPLAY_CHUNK_SIZE, REPLAY_TIMEOUT);
+    const std::vector<uint8_t>& binary = replay.Get_Binary();
+    std::vector<uint32_t> checksums;
+    for (size_t start = 0U; start < binary.size(); start += REPLAY_CHUNK_SIZE) {
+        checksums.push_back(Helper::calculateCrc32(binary.data() + start, std::min<size_t>(REPLAY_CHUNK_SIZE, binary.size() - start)));
+    }
+    // A chunk that never matches its expected CRC-32 is requested again until its retries are exhausted, which shows the verification is enabled
+    checksums.back() ^= 1U;
+    replay.Get_Callback().Set_Chunk_Checksums(checksums.data(), checksums.size());
+    const OTA_Replay_Result result = replay.Run();
+    EXPECT_TRUE(result.finished);
+    EXPECT_FALSE(result.success);
+    EXPECT_GT(result.chunk_requests, checksums.size());
+}
+
+TEST(OTA_Replay_Test, Chunk_Checksums_Of_Other_Chunk_Size_Are_Ignored) {
+    OTA_Replay replay(16U * 1024U, REPLAY_CHUNK_SIZE, REPLAY_TIMEOUT);
+    const std::vector<uint8_t>& binary = replay.Get_Binary();
+    std::vector<uint32_t> checksums;
+    for (size_t start = 0U; start < binary.size(); start += REPLAY_CHUNK_SIZE) {
+        checksums.push_back(Helper::calculateCrc32(binary.data() + start, std::min<size_t>(REPLAY_CHUNK_SIZE, binary.size() - start)));
+    }
+    replay.Get_Callback().Set_Chunk_Checksums(checksums.data(), checksums.size());
+    // Changing the chunk size afterwards would otherwise fail the verification of every chunk, therefore the update has to disable it and still succeed
+    replay.Get_Callback().Set_Chunk_Size(REPLAY_CHUNK_SIZE / 2U);
+    const OTA_Replay_Result result = replay.Run();
+    EXPECT_TRUE(result.success);
+    EXPECT_TRUE(result.matches);
+    EXPECT_EQ(result.chunk_requests, 2U * checksums.size());
+}
@@ -0,0 +1,159 @@
+// Local includes.
+#include "Fake_Clock.h"
+#include "Fake_MQTT_Client.h"
+#include "Silent_Logger.h"
+#include "ThingsBoard.h"
+
+// Library includes.
+#include <gtest/gtest.h>
+#include <vector>
+
+constexpr uint64_t MICROSECONDS_PER_SECOND = 1000U * 1000U;
+// Timeouts are only handled once the tick of the timer wheel they expire in has been processed, which is at most one tick late
+constexpr uint64_t TIMER_WHEEL_TOLERANCE = 10U * 1000U;
+constexpr uint64_t LOOP_STEP = 1000U;
+constexpr char REQUEST_METHOD[] = "getTime";
+constexpr char REQUEST_ATTRIBUTE[] = "fwVersion";
+
+using Test_ThingsBoard = ThingsBoardSized<Default_Fields_Amt, Silent_Logger>;
+
+/// @brief Starts the simulated clock at 0 and connects the given instance to the simulated broker, which is required to subscribe the response topics
+static void Connect(Test_ThingsBoard& tb) {
+    Fake_Clock::Install();
+    Fake_Clock::Set(0U);
+    ASSERT_TRUE(tb.connect("localhost", "token"));
+}
+
+/// @brief Calls loop() until the simulated clock has reached the given time, the same way the application would call it periodically
+static void Run_Until(Test_ThingsBoard& tb, const uint64_t& microseconds) {
+    while (Fake_Clock::Now() < microseconds) {
+        Fake_Clock::Advance(LOOP_STEP);
+        (void)tb.loop();
+    }
+}
+
+/// @brief Sends a client-side RPC request with the given timeout, that appends the given label to the given order once it timed out.
+/// The result of sending is not checked, because the request is registered and its deadline started before its payload is serialized
+static void Send_RPC_Request(Test_ThingsBoard& tb, const uint64_t& timeout, std::vector<int>& order, const int& label) {
+    RPC_Request_Callback callback(REQUEST_METHOD, [](const JsonVariantConst& data) { (void)data; });
+    callback.Set_Timeout(timeout);
+    callback.Set_Timeout_Callback([&order, label]() { order.push_back(label); });
+    (void)tb.RPC_Request(callback);
+}
+
+/// @brief Sends a shared attribute request with the given timeout, that appends the given label to the given order once it timed out
+static void Send_Attribute_Request(Test_ThingsBoard& tb, const uint64_t& timeout, std::vector<int>& order, const int& label) {
+    static const char *const keys[1U] = { REQUEST_ATTRIBUTE };
+    Attribute_Request_Callback callback([](const Attribute_Data& data) { (void)data; }, keys, keys + 1U);
+    callback.Set_Timeout(timeout);
+    callback.Set_Timeout_Callback([&order, label]() { order.push_back(label); });
+    (void)tb.Shared_Attributes_Request(callback);
+}
+
+TEST(Request_Timeout_Test, Expires_Once_Deadline_Has_Passed) {
+    Fake_MQTT_Client client;
+    Test_ThingsBoard tb(client);
+    Connect(tb);
+    std::vector<int> order;
+    Send_RPC_Request(tb, MICROSECONDS_PER_SECOND, order, 1);
+
+    Run_Until(tb, MICROSECONDS_PER_SECOND - LOOP_STEP);
+    EXPECT_TRUE(order.empty());
+    Run_Until(tb, MICROSECONDS_PER_SECOND + TIMER_WHEEL_TOLERANCE);
+    EXPECT_EQ(order, std::vector<int>({ 1 }));
+
+    // The request has been removed, therefore its timeout callback is never called again
+    Run_Until(tb, 10U * MICROSECONDS_PER_SECOND);
+    EXPECT_EQ(order, std::vector<int>({ 1 }));
+}
+
+TEST(Request_Timeout_Test, Request_Without_Timeout_Never_Expires) {
+    Fake_MQTT_Client client;
+    Test_ThingsBoard tb(client);
+    Connect(tb);
+    std::vector<int> order;
+    Send_RPC_Request(tb, 0U, order, 1);
+
+    Run_Until(tb, 60U * MICROSECONDS_PER_SECOND);
+    EXPECT_TRUE(order.empty());
+    EXPECT_TRUE(client.has_subscription(RPC_RESPONSE_SUBSCRIBE_TOPIC));
+}
+
+TEST(Request_Timeout_Test, Reschedules_To_Next_Deadline) {
+    Fake_MQTT_Client client;
+    Test_ThingsBoard tb(client);
+    Connect(tb);
+    std::vector<int> order;
+    // Deadlines of both request types are driven by the same watchdog, which has to be scheduled to the earliest one of them after every expiry
+    Send_RPC_Request(tb, 3U * MICROSECONDS_PER_SECOND, order, 3);
+    Send_Attribute_Request(tb, 1U * MICROSECONDS_PER_SECOND, order, 1);
+    Send_RPC_Request(tb, 2U * MICROSECONDS_PER_SECOND, order, 2);
+
+    Run_Until(tb, 1U * MICROSECONDS_PER_SECOND + TIMER_WHEEL_TOLERANCE);
+    EXPECT_EQ(order, std::vector<int>({ 1 }));
+    Run_Until(tb, 2U * MICROSECONDS_PER_SECOND + TIMER_WHEEL_TOLERANCE);
+    EXPECT_EQ(order, std::vector<int>({ 1, 2 }));
+    Run_Until(tb, 3U * MICROSECONDS_PER_SECOND + TIMER_WHEEL_TOLERANCE);
+    EXPECT_EQ(order, std::vector<int>({ 1, 2, 3 }));
+}
+
+TEST(Request_Timeout_Test, Later_Request_With_Earlier_Deadline_Reschedules) {
+    Fake_MQTT_Client client;
+    Test_ThingsBoard tb(client);
+    Connect(tb);
+    std::vector<int> order;
+    Send_RPC_Request(tb, 10U * MICROSECONDS_PER_SECOND, order, 2);
+    Run_Until(tb, MICROSECONDS_PER_SECOND);
+    Send_RPC_Request(tb, MICROSECONDS_PER_SECOND, order, 1);
+
+    // The watchdog was scheduled to the deadline at 10 seconds, but has to expire at the earlier deadline of the request sent afterwards
+    Run_Until(tb, 2U * MICROSECONDS_PER_SECOND + TIMER_WHEEL_TOLERANCE);
+    EXPECT_EQ(order, std::vector<int>({ 1 }));
+    Run_Until(tb, 10U * MICROSECONDS_PER_SECOND + TIMER_WHEEL_TOLERANCE);
+    EXPECT_EQ(order, std::vector<int>({ 1, 2 }));
+}
+
+TEST(Request_Timeout_Test, Unsubscribes_Once_Last_Request_Expired) {
+    Fake_MQTT_Client client;
+    Test_ThingsBoard tb(client);
+    Connect(tb);
+    std::vector<int> order;
+    Send_RPC_Request(tb, 1U * MICROSECONDS_PER_SECOND, order, 1);
+    Send_RPC_Request(tb, 2U * MICROSECONDS_PER_SECOND, order, 2);
+    Send_Attribute_Request(tb, 1U * MICROSECONDS_PER_SECOND, order, 3);
+    EXPECT_TRUE(client.has_subscription(RPC_RESPONSE_SUBSCRIBE_TOPIC));
+    EXPECT_TRUE(client.has_subscription(ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC));
+
+    // The attribute response topic is not needed anymore, but the client-side RPC response topic still waits for the second request
+    Run_Until(tb, 1U * MICROSECONDS_PER_SECOND + TIMER_WHEEL_TOLERANCE);
+    EXPECT_EQ(order.size(), 2U);
+    EXPECT_TRUE(client.has_subscription(RPC_RESPONSE_SUBSCRIBE_TOPIC));
+    EXPECT_FALSE(client.has_subscription(ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC));
+
+    Run_Until(tb, 2U * MICROSECONDS_PER_SECOND + TIMER_WHEEL_TOLERANCE);
+    EXPECT_EQ(order.size(), 3U);
+    EXPECT_FALSE(client.has_subscription(RPC_RESPONSE_SUBSCRIBE_TOPIC));
+}
+
+TEST(Request_Timeout_Test, Request_Sent_From_Timeout_Callback_Keeps_Subscription) {
+    Fake_MQTT_Client client;
+    Test_ThingsBoard tb(client);
+    Connect(tb);
+    std::vector<int> order;
+    RPC_Request_Callback callback(REQUEST_METHOD, [](const JsonVariantConst& data) { (void)data; });
+    callback.Set_Timeout(MICROSECONDS_PER_SECOND);
+    // Retries the request once it timed out, which is sent while the expired request has already been removed
+    callback.Set_Timeout_Callback([&tb, &order]() {
+        order.push_back(1);
+        Send_RPC_Request(tb, MICROSECONDS_PER_SECOND, order, 2);
+    });
+    (void)tb.RPC_Request(callback);
+
+    Run_Until(tb, 1U * MICROSECONDS_PER_SECOND + TIMER_WHEEL_TOLERANCE);
+    EXPECT_EQ(order, std::vector<int>({ 1 }));
+    EXPECT_TRUE(client.has_subscription(RPC_RESPONSE_SUBSCRIBE_TOPIC));
+
+    Run_Until(tb, 2U * MICROSECONDS_PER_SECOND + (2U * TIMER_WHEEL_TOLERANCE));
+    EXPECT_EQ(order, std::vector<int>({ 1, 2 }));
+    EXPECT_FALSE(client.has_subscription(RPC_RESPONSE_SUBSCRIBE_TOPIC));
+}
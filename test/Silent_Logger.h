@@ -0,0 +1,12 @@
+#ifndef Silent_Logger_h
+#define Silent_Logger_h
+
+/// @brief Logger that discards every message, because the tests and benchmarks would otherwise flood their output with the messages of every processed packet
+class Silent_Logger {
+  public:
+    static void log(const char *msg) {
+        (void)msg;
+    }
+};
+
+#endif // Silent_Logger_h
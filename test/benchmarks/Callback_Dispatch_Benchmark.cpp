@@ -0,0 +1,94 @@
+// Local includes.
+#include "Inplace_Function.h"
+
+// Library includes.
+#include <chrono>
+#include <functional>
+#include <stdio.h>
+#include <string.h>
+
+constexpr size_t BENCHMARK_CALLBACKS = 8U;
+constexpr size_t BENCHMARK_DISPATCHES = 10U * 1000U * 1000U;
+constexpr size_t BENCHMARK_SUBSCRIPTIONS = 1000U * 1000U;
+constexpr const char *BENCHMARK_METHODS[BENCHMARK_CALLBACKS] = { "getValue", "setValue", "getState", "setState", "reboot", "getConfig", "setConfig", "ping" };
+
+/// @brief Subscribed callbacks with the same layout as the RPC and attribute callbacks of the ThingsBoard class, meaning a name and the callable object,
+/// which are dispatched the same way process_rpc_message() does it, by comparing the name of every subscribed callback with strncmp() and calling the first match
+/// @tparam Function Type the callable object is stored in
+template <typename Function>
+class Dispatch_Table {
+  public:
+    /// @brief Copies the given callback into the table, the same way subscribing copies it into the internal array of the ThingsBoard class
+    void Subscribe(const size_t& index, const char *name, const Function& callback) {
+        m_names[index] = name;
+        m_callbacks[index] = callback;
+    }
+
+    /// @brief Calls the callback subscribed with the given name
+    int Dispatch(const char *name, const int& argument) const {
+        for (size_t i = 0U; i < BENCHMARK_CALLBACKS; i++) {
+            if (strncmp(m_names[i], name, strlen(m_names[i])) != 0) {
+                continue;
+            }
+            return m_callbacks[i](argument);
+        }
+        return 0;
+    }
+
+  private:
+    const char *m_names[BENCHMARK_CALLBACKS] = {};
+    Function m_callbacks[BENCHMARK_CALLBACKS] = {};
+};
+
+/// @brief Measures subscribing and dispatching callbacks stored in the given type, with a lambda that captures the given state, and prints the nanoseconds per subscription and per dispatch
+template <typename Function, typename State>
+static void Measure(const char *storage, const char *capture, const State& state) {
+    Dispatch_Table<Function> table;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0U; i < BENCHMARK_SUBSCRIPTIONS; i++) {
+        const size_t index = i % BENCHMARK_CALLBACKS;
+        table.Subscribe(index, BENCHMARK_METHODS[index], [state, index](const int& argument) { return state.Get(index, argument); });
+    }
+    const double subscribe = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / BENCHMARK_SUBSCRIPTIONS;
+
+    int sum = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0U; i < BENCHMARK_DISPATCHES; i++) {
+        sum += table.Dispatch(BENCHMARK_METHODS[i % BENCHMARK_CALLBACKS], static_cast<int>(i));
+    }
+    const double dispatch = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / BENCHMARK_DISPATCHES;
+    printf("%-16s %-10s %-14.1f %-13.1f %d\n", storage, capture, subscribe, dispatch, sum);
+}
+
+/// @brief State captured by the lambda of a member callback, [this]
+struct Small_State {
+    int *value;
+    int Get(const size_t& index, const int& argument) const { return *value + static_cast<int>(index) + argument; }
+};
+
+/// @brief State captured by a lambda that additionally references a few values, [this, &a, &b], which exceeds the small buffer of most std::function implementations
+struct Large_State {
+    int *value;
+    int *offset;
+    int *scale;
+    int Get(const size_t& index, const int& argument) const { return (*value + static_cast<int>(index) + argument) * *scale + *offset; }
+};
+
+/// @brief Compares storing RPC and attribute callbacks in a std::function with storing them in an Inplace_Function, like the Callback class does it.
+/// Subscribing copies the callback into the table, dispatching searches the method name in 8 subscribed callbacks and calls the match.
+/// Only the callback storage and dispatch are measured, deserializing the received json payload is the same for both and therefore not part of the benchmark
+int main() {
+    int value = 1;
+    int offset = 2;
+    int scale = 3;
+    const Small_State small_state = { &value };
+    const Large_State large_state = { &value, &offset, &scale };
+
+    printf("%-16s %-10s %-14s %-13s %s\n", "storage", "capture", "subscribe ns", "dispatch ns", "checksum");
+    Measure<std::function<int(const int&)>>("std::function", "[this]", small_state);
+    Measure<Inplace_Function<int(const int&)>>("Inplace_Function", "[this]", small_state);
+    Measure<std::function<int(const int&)>>("std::function", "3 pointers", large_state);
+    Measure<Inplace_Function<int(const int&)>>("Inplace_Function", "3 pointers", large_state);
+    return 0;
+}
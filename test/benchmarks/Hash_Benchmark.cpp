@@ -0,0 +1,60 @@
+// Local includes.
+#include "OTA_Replay.h"
+
+// Library includes.
+#include <chrono>
+#include <stdio.h>
+
+constexpr size_t BENCHMARK_HASHED_SIZE = 64U * 1024U * 1024U;
+constexpr size_t BENCHMARK_BINARY_SIZE = 2U * 1024U * 1024U;
+constexpr uint16_t BENCHMARK_CHUNK_SIZE = 4U * 1024U;
+constexpr uint64_t BENCHMARK_TIMEOUT = 5U * 1000U * 1000U;
+
+/// @brief Measures the throughput of the HashGenerator for the supported algorithms in the block sizes the received chunks and the written data are hashed in,
+/// afterwards replays a 2 MB OTA update without loss once for each OTA_Hash_Mode and prints the wall time the replay took
+int main() {
+    struct Algorithm {
+        const char        *name;
+        mbedtls_md_type_t type;
+    };
+    const Algorithm algorithms[] = {
+        { "MD5", MBEDTLS_MD_MD5 },
+        { "SHA256", MBEDTLS_MD_SHA256 },
+        { "SHA384", MBEDTLS_MD_SHA384 },
+        { "SHA512", MBEDTLS_MD_SHA512 },
+    };
+    const size_t block_sizes[] = { 256U, HASH_BLOCK_SIZE, BENCHMARK_CHUNK_SIZE };
+
+    std::vector<uint8_t> data(BENCHMARK_CHUNK_SIZE);
+    for (size_t i = 0U; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 31U);
+    }
+
+    printf("%-10s %-12s %s\n", "algorithm", "block bytes", "MB/s");
+    for (const Algorithm& algorithm : algorithms) {
+        for (const size_t& block_size : block_sizes) {
+            HashGenerator hash;
+            const auto start = std::chrono::steady_clock::now();
+            hash.start(algorithm.type);
+            for (size_t hashed = 0U; hashed < BENCHMARK_HASHED_SIZE; hashed += block_size) {
+                (void)hash.update(data.data(), block_size);
+            }
+            uint8_t digest[MBEDTLS_MD_MAX_SIZE] = {};
+            (void)hash.get_hash(digest);
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            printf("%-10s %-12zu %.0f\n", algorithm.name, block_size, BENCHMARK_HASHED_SIZE / seconds / 1e6);
+        }
+    }
+
+    printf("\n%-14s %-8s %s\n", "hash mode", "success", "wall ms");
+    const OTA_Hash_Mode hash_modes[] = { OTA_Hash_Mode::RECEIVED_DATA, OTA_Hash_Mode::WRITTEN_DATA };
+    for (const OTA_Hash_Mode& hash_mode : hash_modes) {
+        OTA_Replay replay(BENCHMARK_BINARY_SIZE, BENCHMARK_CHUNK_SIZE, BENCHMARK_TIMEOUT);
+        replay.Get_Callback().Set_Hash_Mode(hash_mode);
+        const auto start = std::chrono::steady_clock::now();
+        const OTA_Replay_Result result = replay.Run();
+        const double wall = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        printf("%-14s %-8s %.1f\n", hash_mode == OTA_Hash_Mode::RECEIVED_DATA ? "RECEIVED_DATA" : "WRITTEN_DATA", (result.success && result.matches) ? "yes" : "no", wall);
+    }
+    return 0;
+}
@@ -0,0 +1,45 @@
+// Local includes.
+#include "OTA_Replay.h"
+
+// Library includes.
+#include <chrono>
+#include <stdio.h>
+
+constexpr size_t BENCHMARK_BINARY_SIZE = 2U * 1024U * 1024U;
+constexpr uint16_t BENCHMARK_CHUNK_SIZE = 4U * 1024U;
+constexpr uint64_t BENCHMARK_TIMEOUT = 5U * 1000U * 1000U;
+
+/// @brief Replays a 2 MB OTA update with 20 - 80 ms latency per direction under different loss and reordering rates
+/// and prints how much simulated time the update took compared to the wall time the replay took
+int main() {
+    struct Scenario {
+        float    loss_rate;
+        float    reorder_rate;
+        uint32_t seed;
+    };
+    const Scenario scenarios[] = {
+        { 0.0f, 0.0f, 1U },
+        { 0.05f, 0.0f, 1U },
+        { 0.05f, 0.0f, 2U },
+        { 0.05f, 0.0f, 3U },
+        { 0.05f, 0.1f, 1U },
+        { 0.2f, 0.0f, 1U },
+    };
+
+    printf("%-6s %-8s %-5s %-8s %-12s %-10s %-15s %s\n", "loss", "reorder", "seed", "success", "simulated s", "wall ms", "chunk requests", "lost");
+    for (const Scenario& scenario : scenarios) {
+        OTA_Replay replay(BENCHMARK_BINARY_SIZE, BENCHMARK_CHUNK_SIZE, BENCHMARK_TIMEOUT);
+        Fake_MQTT_Client& client = replay.Get_Client();
+        client.set_seed(scenario.seed);
+        client.set_latency(20U * 1000U, 80U * 1000U);
+        client.set_loss_rate(scenario.loss_rate);
+        client.set_reorder_rate(scenario.reorder_rate, 200U * 1000U);
+
+        const auto start = std::chrono::steady_clock::now();
+        const OTA_Replay_Result result = replay.Run();
+        const double wall = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        printf("%-6.2f %-8.2f %-5u %-8s %-12.1f %-10.1f %-15zu %zu\n", scenario.loss_rate, scenario.reorder_rate, scenario.seed,
+          (result.success && result.matches) ? "yes" : "no", result.simulated_time / 1e6, wall, result.chunk_requests, result.lost_messages);
+    }
+    return 0;
+}
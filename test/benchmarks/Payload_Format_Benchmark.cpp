@@ -0,0 +1,85 @@
+// Local includes.
+#include "Payload_Format.h"
+
+// Library includes.
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+constexpr size_t BENCHMARK_ITERATIONS = 1000U * 1000U;
+constexpr size_t BENCHMARK_BUFFER_SIZE = 256U;
+constexpr size_t BENCHMARK_DOCUMENT_SIZE = JSON_OBJECT_SIZE(16U);
+
+// message SensorValues { optional float temperature = 1; optional uint32 humidity = 2; optional double pressure = 3; optional sint32 rssi = 4; optional uint64 uptime = 5; optional string status = 6; }
+constexpr Protobuf_Field BENCHMARK_TELEMETRY_SCHEMA[] = {
+    { "temperature", 1U, Protobuf_Field_Type::FLOAT },
+    { "humidity", 2U, Protobuf_Field_Type::UINT32 },
+    { "pressure", 3U, Protobuf_Field_Type::DOUBLE },
+    { "rssi", 4U, Protobuf_Field_Type::SINT32 },
+    { "uptime", 5U, Protobuf_Field_Type::UINT64 },
+    { "status", 6U, Protobuf_Field_Type::STRING }
+};
+
+/// @brief Encodes the given source with the given payload format policy as often as the benchmark requires and decodes the encoded payload the same amount of times,
+/// every decode works on a fresh copy of the payload, because the policies null terminate the received strings in place. Prints the encoded size,
+/// the nanoseconds per encode and decode, and whether the decoded params of an RPC request are an object, like the json payload format decodes them
+/// @tparam Format Payload format policy that is measured
+template <typename Format>
+static void Measure(const char *name, const char *message, const Format& format, const Payload_Type& type, const JsonDocument& source) {
+    uint8_t encoded[BENCHMARK_BUFFER_SIZE] = {};
+    const size_t size = format.Measure(type, source, measureJson(source) + 1U);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0U; i < BENCHMARK_ITERATIONS; i++) {
+        (void)format.Serialize(type, source, encoded, sizeof(encoded));
+    }
+    const double encode = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / BENCHMARK_ITERATIONS;
+
+    uint8_t received[BENCHMARK_BUFFER_SIZE] = {};
+    StaticJsonDocument<BENCHMARK_DOCUMENT_SIZE> decoded;
+    bool valid = true;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0U; i < BENCHMARK_ITERATIONS; i++) {
+        memcpy(received, encoded, size);
+        valid &= !format.Deserialize(type, decoded, received, size);
+    }
+    const double decode = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / BENCHMARK_ITERATIONS;
+
+    const char *params = type != Payload_Type::RPC_REQUEST ? "-" : (decoded["params"].is<JsonObjectConst>() ? "object" : "string");
+    printf("%-10s %-10s %-6zu %-10.0f %-10.0f %-6s %s\n", message, name, size, encode, decode, valid ? "yes" : "no", params);
+}
+
+/// @brief Measures the encoded size and the encode and decode time of a telemetry message with typical sensor values and of a server-side RPC request
+/// with the json, MessagePack and protobuf payload formats. The telemetry message is decoded as well, even though the library only sends it,
+/// because decoding it measures the cost of the format itself without the nested params of the RPC request. The RPC request is encoded with the default schema,
+/// which serializes the params into a json string the same way ThingsBoard sends them
+int main() {
+    StaticJsonDocument<BENCHMARK_DOCUMENT_SIZE> telemetry;
+    telemetry["temperature"] = 23.5f;
+    telemetry["humidity"] = 41U;
+    telemetry["pressure"] = 1013.25;
+    telemetry["rssi"] = -67;
+    telemetry["uptime"] = 86400U;
+    telemetry["status"] = "running";
+
+    StaticJsonDocument<BENCHMARK_DOCUMENT_SIZE> request;
+    request["method"] = "setValue";
+    request["requestId"] = 42;
+    JsonObject params = request.createNestedObject("params");
+    params["pin"] = 4;
+    params["enabled"] = true;
+
+    const Json_Payload_Format json;
+    const MsgPack_Payload_Format msgpack;
+    Protobuf_Payload_Format protobuf;
+    protobuf.Set_Schema(Payload_Type::TELEMETRY, BENCHMARK_TELEMETRY_SCHEMA);
+
+    printf("%-10s %-10s %-6s %-10s %-10s %-6s %s\n", "message", "format", "bytes", "encode ns", "decode ns", "valid", "params");
+    Measure("json", "telemetry", json, Payload_Type::TELEMETRY, telemetry);
+    Measure("msgpack", "telemetry", msgpack, Payload_Type::TELEMETRY, telemetry);
+    Measure("protobuf", "telemetry", protobuf, Payload_Type::TELEMETRY, telemetry);
+    Measure("json", "rpc", json, Payload_Type::RPC_REQUEST, request);
+    Measure("msgpack", "rpc", msgpack, Payload_Type::RPC_REQUEST, request);
+    Measure("protobuf", "rpc", protobuf, Payload_Type::RPC_REQUEST, request);
+    return 0;
+}
@@ -0,0 +1,27 @@
+// Header include.
+#include "Fake_Clock.h"
+
+// Local includes.
+#include "Helper.h"
+
+uint64_t Fake_Clock::m_now = 0U;
+
+void Fake_Clock::Install() {
+    Helper::setClock(&Fake_Clock::Now);
+}
+
+void Fake_Clock::Uninstall() {
+    Helper::setClock(nullptr);
+}
+
+uint64_t Fake_Clock::Now() {
+    return m_now;
+}
+
+void Fake_Clock::Set(const uint64_t& microseconds) {
+    m_now = microseconds;
+}
+
+void Fake_Clock::Advance(const uint64_t& microseconds) {
+    m_now += microseconds;
+}
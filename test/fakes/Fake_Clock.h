@@ -0,0 +1,43 @@
+#ifndef Fake_Clock_h
+#define Fake_Clock_h
+
+// Local include.
+#include "Configuration.h"
+
+#if !THINGSBOARD_ENABLE_CLOCK_OVERRIDE
+#error "The Fake_Clock replaces the time source with Helper::setClock(), which requires THINGSBOARD_ENABLE_CLOCK_OVERRIDE to be set"
+#endif // !THINGSBOARD_ENABLE_CLOCK_OVERRIDE
+
+// Library includes.
+#include <stdint.h>
+
+
+/// @brief Simulated monotonic clock, that only moves forward if it is advanced explicitly. Once installed with Install() it replaces the time source of Helper::getMicroseconds(),
+/// which every timeout of the library is based on, meaning the OTA retry and request timeout logic or any Callback_Watchdog can be tested deterministically and without waiting for real time to pass.
+/// Meant to be used in combination with the Fake_MQTT_Client, the simulated time passes by calling Advance() in between calls to the loop() method of the ThingsBoard instance,
+/// for example advancing the time by 10 seconds takes as long as calling loop() once, instead of 10 seconds of real time
+class Fake_Clock {
+  public:
+    /// @brief Replaces the time source of Helper::getMicroseconds() with the simulated clock, should be called before the loop() method of any ThingsBoard instance is called the first time
+    static void Install();
+
+    /// @brief Restores the default time source of the platform for Helper::getMicroseconds()
+    static void Uninstall();
+
+    /// @brief Gets the current simulated time
+    /// @return Microseconds that have been advanced since the simulated clock has been started or set the last time
+    static uint64_t Now();
+
+    /// @brief Sets the simulated time to the given value, should only be used before any timeout has been started, because moving the time backwards delays every already started timeout
+    /// @param microseconds Simulated time in microseconds
+    static void Set(const uint64_t& microseconds);
+
+    /// @brief Moves the simulated time forward by the given amount, timeouts that have passed because of it are handled the next time the loop() method of the ThingsBoard instance is called
+    /// @param microseconds Amount of microseconds the simulated time should move forward
+    static void Advance(const uint64_t& microseconds);
+
+  private:
+    static uint64_t m_now; // Current simulated time in microseconds
+};
+
+#endif // Fake_Clock_h
@@ -0,0 +1,337 @@
+// Header include.
+#include "Fake_MQTT_Client.h"
+
+#if THINGSBOARD_ENABLE_STL
+
+// Local includes.
+#include "Helper.h"
+
+// Library includes.
+#include <string.h>
+#include <utility>
+
+constexpr uint16_t DEFAULT_BUFFER_SIZE = 256U;
+constexpr uint32_t DEFAULT_SEED = 1U;
+// Amount of bytes the length of the topic takes up in the variable header of a PUBLISH control packet
+constexpr size_t TOPIC_LENGTH_BYTES = 2U;
+
+/// @brief Checks whether the given topic matches the given topic filter, where + matches exactly one level and # matches every remaining level
+/// @param filter Topic filter that has been subscribed
+/// @param topic Topic a message has been sent over
+/// @return Whether the topic matches the filter or not
+static bool topic_matches(const char *filter, const char *topic) {
+    while (*filter != '\0') {
+        if (*filter == '#') {
+            return true;
+        }
+        else if (*filter == '+') {
+            while (*topic != '\0' && *topic != '/') {
+                topic++;
+            }
+            filter++;
+            continue;
+        }
+        else if (*filter != *topic) {
+            return false;
+        }
+        filter++;
+        topic++;
+    }
+    return *topic == '\0';
+}
+
+Fake_MQTT_Client::Fake_MQTT_Client() :
+    m_received_data_callback(nullptr),
+    m_responder(nullptr),
+    m_buffer_size(DEFAULT_BUFFER_SIZE),
+    m_connected(false),
+    m_minimum_latency(0U),
+    m_maximum_latency(0U),
+    m_loss_rate(0.0f),
+    m_reorder_rate(0.0f),
+    m_reorder_delay(0U),
+    m_disconnect_rate(0.0f),
+    m_random_state(DEFAULT_SEED),
+    m_sequence(0U),
+    m_pending(),
+    m_subscriptions(),
+    m_published_count(0U),
+    m_received_count(0U),
+    m_lost_count(0U)
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+    ,
+    m_stream_topic(),
+    m_stream_payload(),
+    m_stream_length(0U)
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+{
+    // Nothing to do
+}
+
+void Fake_MQTT_Client::set_responder(responder responder) {
+    m_responder = responder;
+}
+
+void Fake_MQTT_Client::set_latency(const uint64_t& minimum_microseconds, const uint64_t& maximum_microseconds) {
+    m_minimum_latency = minimum_microseconds;
+    m_maximum_latency = maximum_microseconds < minimum_microseconds ? minimum_microseconds : maximum_microseconds;
+}
+
+void Fake_MQTT_Client::set_loss_rate(const float& rate) {
+    m_loss_rate = rate;
+}
+
+void Fake_MQTT_Client::set_reorder_rate(const float& rate, const uint64_t& delay_microseconds) {
+    m_reorder_rate = rate;
+    m_reorder_delay = delay_microseconds;
+}
+
+void Fake_MQTT_Client::set_disconnect_rate(const float& rate) {
+    m_disconnect_rate = rate;
+}
+
+void Fake_MQTT_Client::set_seed(const uint32_t& seed) {
+    m_random_state = seed != 0U ? seed : DEFAULT_SEED;
+}
+
+void Fake_MQTT_Client::deliver(const char *topic, const uint8_t *payload, const size_t& length) {
+    enqueue(false, topic, payload, length);
+}
+
+void Fake_MQTT_Client::drop_connection() {
+    m_connected = false;
+    m_pending.clear();
+    m_subscriptions.clear();
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+    m_stream_topic.clear();
+    m_stream_payload.clear();
+    m_stream_length = 0U;
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+}
+
+size_t Fake_MQTT_Client::get_published_count() const {
+    return m_published_count;
+}
+
+size_t Fake_MQTT_Client::get_received_count() const {
+    return m_received_count;
+}
+
+size_t Fake_MQTT_Client::get_lost_count() const {
+    return m_lost_count;
+}
+
+size_t Fake_MQTT_Client::get_pending_count() const {
+    return m_pending.size();
+}
+
+bool Fake_MQTT_Client::has_subscription(const char *topic_filter) const {
+    for (const std::string& subscription : m_subscriptions) {
+        if (subscription == topic_filter) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Fake_MQTT_Client::set_callback(function callback) {
+    m_received_data_callback = callback;
+}
+
+bool Fake_MQTT_Client::set_buffer_size(const uint16_t& buffer_size) {
+    m_buffer_size = buffer_size;
+    return true;
+}
+
+uint16_t Fake_MQTT_Client::get_buffer_size() {
+    return m_buffer_size;
+}
+
+void Fake_MQTT_Client::set_server(const char *domain, const uint16_t& port) {
+    // Nothing to do, because the broker is simulated in memory
+    (void)domain;
+    (void)port;
+}
+
+bool Fake_MQTT_Client::connect(const char *client_id, const char *user_name, const char *password) {
+    (void)client_id;
+    (void)user_name;
+    (void)password;
+    m_connected = true;
+    return true;
+}
+
+void Fake_MQTT_Client::disconnect() {
+    drop_connection();
+}
+
+bool Fake_MQTT_Client::loop() {
+    const uint64_t now = Helper::getMicroseconds();
+    // Messages sent while handling another message are only passed on in the next call, same as they would only arrive in a later read from a real connection
+    const uint64_t sequence_limit = m_sequence;
+
+    while (m_connected) {
+        // Messages are searched linearly, because only a handful are ever in flight at the same time
+        size_t next = m_pending.size();
+        for (size_t i = 0U; i < m_pending.size(); i++) {
+            const Pending_Message& message = m_pending[i];
+            if (message.delivery_time > now || message.sequence >= sequence_limit) {
+                continue;
+            }
+            else if (next == m_pending.size() || message.delivery_time < m_pending[next].delivery_time ||
+              (message.delivery_time == m_pending[next].delivery_time && message.sequence < m_pending[next].sequence)) {
+                next = i;
+            }
+        }
+        if (next == m_pending.size()) {
+            break;
+        }
+
+        // Moved out of the container before it is handled, because the responder and the received data callback may send additional messages
+        Pending_Message message = std::move(m_pending[next]);
+        m_pending.erase(m_pending.begin() + next);
+        if (chance(m_disconnect_rate)) {
+            drop_connection();
+            break;
+        }
+
+        if (message.to_server) {
+            if (m_responder) {
+                m_responder(*this, message.topic.c_str(), message.payload.data(), message.payload.size());
+            }
+        }
+        else if (m_received_data_callback && is_subscribed(message.topic.c_str()) && TOPIC_LENGTH_BYTES + message.topic.size() + message.payload.size() <= m_buffer_size) {
+            m_received_count++;
+            m_received_data_callback(&message.topic[0], message.payload.data(), message.payload.size());
+        }
+    }
+    return m_connected;
+}
+
+bool Fake_MQTT_Client::publish(const char *topic, const uint8_t *payload, const size_t& length) {
+    if (!m_connected || TOPIC_LENGTH_BYTES + strlen(topic) + length > m_buffer_size) {
+        return false;
+    }
+    m_published_count++;
+    enqueue(true, topic, payload, length);
+    return true;
+}
+
+bool Fake_MQTT_Client::subscribe(const char *topic) {
+    if (!m_connected) {
+        return false;
+    }
+    for (const std::string& subscription : m_subscriptions) {
+        if (subscription == topic) {
+            return true;
+        }
+    }
+    m_subscriptions.emplace_back(topic);
+    return true;
+}
+
+bool Fake_MQTT_Client::unsubscribe(const char *topic) {
+    if (!m_connected) {
+        return false;
+    }
+    for (size_t i = 0U; i < m_subscriptions.size(); i++) {
+        if (m_subscriptions[i] == topic) {
+            m_subscriptions.erase(m_subscriptions.begin() + i);
+            break;
+        }
+    }
+    return true;
+}
+
+bool Fake_MQTT_Client::connected() {
+    return m_connected;
+}
+
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+
+bool Fake_MQTT_Client::begin_publish(const char *topic, const size_t& length) {
+    if (!m_connected) {
+        return false;
+    }
+    m_stream_topic = topic;
+    m_stream_payload.clear();
+    m_stream_length = length;
+    return true;
+}
+
+bool Fake_MQTT_Client::end_publish() {
+    // Streamed messages are not limited by the buffer size, therefore they are queued directly instead of with publish()
+    const bool result = m_connected && m_stream_payload.size() == m_stream_length;
+    if (result) {
+        m_published_count++;
+        enqueue(true, m_stream_topic.c_str(), m_stream_payload.data(), m_stream_payload.size());
+    }
+    m_stream_topic.clear();
+    m_stream_payload.clear();
+    m_stream_length = 0U;
+    return result;
+}
+
+size_t Fake_MQTT_Client::write(uint8_t payload_byte) {
+    return write(&payload_byte, 1U);
+}
+
+size_t Fake_MQTT_Client::write(const uint8_t *buffer, size_t size) {
+    if (!m_connected || m_stream_payload.size() + size > m_stream_length) {
+        return 0U;
+    }
+    m_stream_payload.insert(m_stream_payload.end(), buffer, buffer + size);
+    return size;
+}
+
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+
+uint32_t Fake_MQTT_Client::next_random() {
+    m_random_state ^= m_random_state << 13U;
+    m_random_state ^= m_random_state >> 17U;
+    m_random_state ^= m_random_state << 5U;
+    return m_random_state;
+}
+
+bool Fake_MQTT_Client::chance(const float& rate) {
+    if (rate <= 0.0f) {
+        return false;
+    }
+    return static_cast<double>(next_random()) < static_cast<double>(rate) * UINT32_MAX;
+}
+
+void Fake_MQTT_Client::enqueue(const bool& to_server, const char *topic, const uint8_t *payload, const size_t& length) {
+    if (chance(m_loss_rate)) {
+        m_lost_count++;
+        return;
+    }
+
+    uint64_t latency = m_minimum_latency;
+    if (m_maximum_latency > m_minimum_latency) {
+        latency += next_random() % (m_maximum_latency - m_minimum_latency + 1U);
+    }
+    if (chance(m_reorder_rate)) {
+        latency += m_reorder_delay;
+    }
+
+    Pending_Message message;
+    message.to_server = to_server;
+    message.delivery_time = Helper::getMicroseconds() + latency;
+    message.sequence = m_sequence++;
+    message.topic = topic;
+    if (length != 0U) {
+        message.payload.assign(payload, payload + length);
+    }
+    m_pending.push_back(std::move(message));
+}
+
+bool Fake_MQTT_Client::is_subscribed(const char *topic) const {
+    for (const std::string& subscription : m_subscriptions) {
+        if (topic_matches(subscription.c_str(), topic)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // THINGSBOARD_ENABLE_STL
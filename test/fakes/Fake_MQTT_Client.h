@@ -0,0 +1,187 @@
+#ifndef Fake_MQTT_Client_h
+#define Fake_MQTT_Client_h
+
+// Local include.
+#include "Configuration.h"
+
+// The simulated broker keeps the messages that are in flight and the subscribed topics in dynamic containers, which requires the C++ STL
+#if THINGSBOARD_ENABLE_STL
+
+// Local includes.
+#include "IMQTT_Client.h"
+
+// Library includes.
+#include <string>
+#include <vector>
+
+
+/// @brief MQTT Client interface implementation that does not open any connection, instead it simulates the broker and the server in memory.
+/// Every published message is passed to the responder set with set_responder(), which plays the role of the server and can answer with deliver(),
+/// the answer is then received over the callback set with set_callback(), as long as the topic it is delivered on has been subscribed before.
+/// Both directions can be impaired with latency, loss, reordering and disconnects, the decision which message is impaired is made by a seeded pseudo random number generator,
+/// meaning the same seed always results in the same messages being lost or reordered. Because messages are only ever passed on from inside of loop()
+/// and only once their latency has passed according to Helper::getMicroseconds(), the client should be used in combination with the Fake_Clock,
+/// which allows to replay even long running transfers like OTA updates under bad network conditions in a fraction of the time they would take on real hardware
+class Fake_MQTT_Client : public IMQTT_Client {
+  public:
+    /// @brief Responder signature, receives the client itself to allow answering with deliver(), as well as the topic and payload of the published message
+    using responder = std::function<void(Fake_MQTT_Client& client, const char *topic, const uint8_t *payload, const size_t& length)>;
+
+    /// @brief Constructs a IMQTT_Client implementation without any impairments, where every message is passed on the next time loop() is called
+    Fake_MQTT_Client();
+
+    /// @brief Sets the responder that is called with every published message that reached the simulated server,
+    /// it can answer with deliver() which subjects the answer to the same impairments in the other direction
+    /// @param responder Method that should be called for every published message that has not been lost
+    void set_responder(responder responder);
+
+    /// @brief Sets the latency every message is delayed by in each direction, the exact value is picked for each message between the given minimum and maximum
+    /// @param minimum_microseconds Minimum amount of microseconds a message is delayed by
+    /// @param maximum_microseconds Maximum amount of microseconds a message is delayed by, has to be bigger or equal to the minimum
+    void set_latency(const uint64_t& minimum_microseconds, const uint64_t& maximum_microseconds);
+
+    /// @brief Sets the probability of each message in each direction to be silently lost
+    /// @param rate Probability between 0.0 and 1.0, where 0.05 loses every 20th message on average
+    void set_loss_rate(const float& rate);
+
+    /// @brief Sets the probability of each message in each direction to be held back for the given additional amount of time, which allows messages sent after it to overtake it
+    /// @param rate Probability between 0.0 and 1.0 that a message is held back
+    /// @param delay_microseconds Additional amount of microseconds a held back message is delayed by
+    void set_reorder_rate(const float& rate, const uint64_t& delay_microseconds);
+
+    /// @brief Sets the probability of the connection being lost whenever a message is passed on, in which case every message that is still in flight is lost,
+    /// every subscription is removed and connected() returns false until connect() is called again, same as a broker with a clean session would behave
+    /// @param rate Probability between 0.0 and 1.0 that the connection is lost
+    void set_disconnect_rate(const float& rate);
+
+    /// @brief Sets the seed of the pseudo random number generator that decides which messages are impaired, the same seed always results in the same sequence of impairments
+    /// @param seed Seed that should be used, 0 is replaced with 1 because the generator would otherwise only ever return 0
+    void set_seed(const uint32_t& seed);
+
+    /// @brief Sends the given message from the simulated server to the client, it is received over the callback set with set_callback() once its latency has passed,
+    /// if it has not been lost, the topic has been subscribed and it fits into the buffer. Can be called from inside of the responder or directly to simulate server-side events
+    /// @param topic Topic the message is sent over
+    /// @param payload Payload of the message, is copied and therefore does not need to be kept alive
+    /// @param length Length of the payload in bytes
+    void deliver(const char *topic, const uint8_t *payload, const size_t& length);
+
+    /// @brief Loses the connection immediately, every message that is still in flight is lost and every subscription is removed
+    void drop_connection();
+
+    /// @brief Gets the amount of messages that have been published successfully by the client
+    /// @return Amount of published messages, including messages that have been lost afterwards
+    size_t get_published_count() const;
+
+    /// @brief Gets the amount of messages that have been received over the callback set with set_callback()
+    /// @return Amount of received messages
+    size_t get_received_count() const;
+
+    /// @brief Gets the amount of messages that have been lost in either direction because of the loss rate
+    /// @return Amount of lost messages
+    size_t get_lost_count() const;
+
+    /// @brief Gets the amount of messages that are still in flight in either direction
+    /// @return Amount of messages that have not been passed on yet
+    size_t get_pending_count() const;
+
+    /// @brief Gets whether the given topic filter is currently subscribed, compared as is without considering the MQTT wildcards
+    /// @param topic_filter Topic filter that should have been subscribed
+    /// @return Whether subscribe() has been called with the given topic filter, without it being unsubscribed or the connection being lost since
+    bool has_subscription(const char *topic_filter) const;
+
+    void set_callback(function callback) override;
+
+    bool set_buffer_size(const uint16_t& buffer_size) override;
+
+    uint16_t get_buffer_size() override;
+
+    void set_server(const char *domain, const uint16_t& port) override;
+
+    bool connect(const char *client_id, const char *user_name, const char *password) override;
+
+    void disconnect() override;
+
+    bool loop() override;
+
+    bool publish(const char *topic, const uint8_t *payload, const size_t& length) override;
+
+    bool subscribe(const char *topic) override;
+
+    bool unsubscribe(const char *topic) override;
+
+    bool connected() override;
+
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+
+    bool begin_publish(const char *topic, const size_t& length) override;
+
+    bool end_publish() override;
+
+    //----------------------------------------------------------------------------
+    // Print interface
+    //----------------------------------------------------------------------------
+
+    size_t write(uint8_t payload_byte) override;
+
+    size_t write(const uint8_t *buffer, size_t size) override;
+
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+
+  private:
+    /// @brief Message that is in flight between the client and the simulated server
+    struct Pending_Message {
+        bool                 to_server;     // Whether the message has been published by the client or delivered by the simulated server
+        uint64_t             delivery_time; // Time in microseconds the message is passed on
+        uint64_t             sequence;      // Order the messages have been sent in, messages with the same delivery time are passed on in that order
+        std::string          topic;         // Topic the message is sent over
+        std::vector<uint8_t> payload;       // Payload of the message
+    };
+
+    function                     m_received_data_callback; // Callback that will be called as soon as the mqtt client receives any data
+    responder                    m_responder;              // Simulated server that is called with every published message
+    uint16_t                     m_buffer_size;            // Size of the buffer, limits the topic and payload of sent and received messages, received messages that are bigger are discarded
+    bool                         m_connected;              // Whether the client is currently connected to the simulated broker
+    uint64_t                     m_minimum_latency;        // Minimum amount of microseconds a message is delayed by
+    uint64_t                     m_maximum_latency;        // Maximum amount of microseconds a message is delayed by
+    float                        m_loss_rate;              // Probability of a message being lost
+    float                        m_reorder_rate;           // Probability of a message being held back
+    uint64_t                     m_reorder_delay;          // Additional amount of microseconds a held back message is delayed by
+    float                        m_disconnect_rate;        // Probability of the connection being lost whenever a message is passed on
+    uint32_t                     m_random_state;           // State of the xorshift pseudo random number generator
+    uint64_t                     m_sequence;               // Sequence number of the next sent message
+    std::vector<Pending_Message> m_pending;                // Messages that are in flight in either direction
+    std::vector<std::string>     m_subscriptions;          // Topic filters that have been subscribed, may contain the MQTT wildcards + and #
+    size_t                       m_published_count;        // Amount of messages that have been published successfully
+    size_t                       m_received_count;         // Amount of messages that have been passed to the received data callback
+    size_t                       m_lost_count;             // Amount of messages that have been lost because of the loss rate
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+    std::string                  m_stream_topic;           // Topic of the message started with begin_publish()
+    std::vector<uint8_t>         m_stream_payload;         // Payload written with write() since begin_publish() has been called
+    size_t                       m_stream_length;          // Length of the payload announced with begin_publish()
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+
+    /// @brief Gets the next value of the xorshift pseudo random number generator
+    /// @return Pseudo random number between 1 and 2^32 - 1
+    uint32_t next_random();
+
+    /// @brief Decides with the pseudo random number generator whether an event with the given probability happens
+    /// @param rate Probability between 0.0 and 1.0 of the event
+    /// @return Whether the event happens or not, always false for a probability of 0.0 without advancing the generator
+    bool chance(const float& rate);
+
+    /// @brief Applies the loss, latency and reordering impairments to the given message and queues it, if it has not been lost
+    /// @param to_server Whether the message has been published by the client or delivered by the simulated server
+    /// @param topic Topic the message is sent over
+    /// @param payload Payload of the message
+    /// @param length Length of the payload in bytes
+    void enqueue(const bool& to_server, const char *topic, const uint8_t *payload, const size_t& length);
+
+    /// @brief Checks whether the given topic has been subscribed by any of the topic filters, considering the MQTT wildcards + and #
+    /// @param topic Topic the received message has been sent over
+    /// @return Whether the message should be passed to the received data callback or not
+    bool is_subscribed(const char *topic) const;
+};
+
+#endif // THINGSBOARD_ENABLE_STL
+
+#endif // Fake_MQTT_Client_h